@@ -0,0 +1,925 @@
+/**
+  * @file aggregator.cpp
+  * This is the documentation of the `aggregator.cpp` file
+  *
+  * @brief Description
+  * Implementation of the Aggregator class methods, the partial aggregates of the
+  * clusters and the merge of their partitions
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <thread>
+#include <utility>
+
+// Nativite engine imports
+#include "aggregator.hpp"
+#include "../Dictionary/dictionary.hpp"
+#include "../Compression/compression.hpp"
+
+
+// The largest dictionary whose groups are added in an array before the table
+static constexpr size_t DICTIONARY_GROUPS = 65536;
+
+// The largest `radix_bits`, more partitions only cost memory
+static constexpr size_t MAXIMUM_RADIX_BITS = 12;
+
+
+// Adds `value` to the integer sum `sum`, returns false without adding it if it overflows
+static bool addSum(int64_t& sum, int64_t value) {
+  if (
+    (value > 0 && sum > std::numeric_limits<int64_t>::max() - value) ||
+    (value < 0 && sum < std::numeric_limits<int64_t>::min() - value)
+  ) {
+    return false;
+  }
+
+  sum += value;
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::state_t::addInteger` and `Aggregator::state_t::addReal` methods
+  * are internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Adds a number to the state, an integer that would overflow the integer sum is
+  * added to the real sum, then the sum is a real number
+  *
+  * @return
+  * This function does not return anything, since it
+  * only updates the state
+*/
+
+
+void Aggregator::state_t::addInteger(int64_t value) {
+  count++;
+  numbers++;
+
+  if (!addSum(integer_sum, value)) {
+    real_sum += static_cast<double>(value);
+    overflow  = true;
+  }
+
+  integer_minimum = std::min(integer_minimum, value);
+  integer_maximum = std::max(integer_maximum, value);
+}
+
+
+void Aggregator::state_t::addReal(double value) {
+  count++;
+  numbers++;
+
+  real_sum    += value;
+  real_minimum = std::min(real_minimum, value);
+  real_maximum = std::max(real_maximum, value);
+  has_real     = true;
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::state_t::merge` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Adds the partial state `other` of the same aggregate and group to this state
+  *
+  * @return
+  * This function does not return anything, since it
+  * only updates the state
+*/
+
+
+void Aggregator::state_t::merge(const state_t& other) {
+  if (!addSum(integer_sum, other.integer_sum)) {
+    real_sum += static_cast<double>(other.integer_sum);
+    overflow  = true;
+  }
+
+  count          += other.count;
+  numbers        += other.numbers;
+  real_sum       += other.real_sum;
+  integer_minimum = std::min(integer_minimum, other.integer_minimum);
+  integer_maximum = std::max(integer_maximum, other.integer_maximum);
+  real_minimum    = std::min(real_minimum, other.real_minimum);
+  real_maximum    = std::max(real_maximum, other.real_maximum);
+  has_real        = has_real || other.has_real;
+  overflow        = overflow || other.overflow;
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::state_t::result` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Computes the value of the aggregate `function` from the state
+  *
+  * @return
+  * Returns a new astruct, the null astruct if the aggregate has no number
+*/
+
+
+Astruct* Aggregator::state_t::result(function_t function) const {
+  if (function == function_t::count) {
+    return new Astruct(count);
+  }
+  if (numbers == 0) {
+    return new Astruct(nullptr);
+  }
+
+  // The integers are in the state if its integer minimum is set
+  const bool HAS_INTEGER = integer_minimum <= integer_maximum;
+
+  switch (function) {
+    case function_t::sum:
+      return has_real || overflow
+        ? new Astruct(real_sum + static_cast<double>(integer_sum))
+        : new Astruct(integer_sum);
+
+    case function_t::minimum:
+      if (!has_real) {
+        return new Astruct(integer_minimum);
+      }
+      return new Astruct(HAS_INTEGER ? std::min(real_minimum, static_cast<double>(integer_minimum)) : real_minimum);
+
+    case function_t::maximum:
+      if (!has_real) {
+        return new Astruct(integer_maximum);
+      }
+      return new Astruct(HAS_INTEGER ? std::max(real_maximum, static_cast<double>(integer_maximum)) : real_maximum);
+
+    default:
+      return new Astruct((real_sum + static_cast<double>(integer_sum)) / static_cast<double>(numbers));
+  }
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::readColumn` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Reads the rows `first` to `first + count` of the stack `stack_index` to `column`
+  * whatever its layer is, a compressed stack decodes the block of the rows once.
+  * The strings are views of the bucket, they are valid while its locks are held
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `column`
+*/
+
+
+void Aggregator::readColumn(const Bucket* bucket_, size_t stack_index, size_t first, size_t count, column_t& column) {
+  column.kinds.assign(count, column_t::empty);
+  column.integers.resize(std::max(count, NumericLayer::block_size));
+  column.numbers.resize(std::max(count, NumericLayer::block_size));
+  column.strings.resize(count);
+
+  if (stack_index >= bucket_->bucket.size()) {
+    return;
+  }
+
+  if (bucket_->isNumericStack(stack_index)) {
+    const NumericLayer* layer = bucket_->numeric_layers[stack_index];
+
+    if (first >= layer->size) {
+      return;
+    }
+
+    const size_t BLOCK   = first / NumericLayer::block_size;
+    const bool   INTEGER = layer->kind == NumericLayer::numeric_kind_t::integer;
+    const size_t DECODED = std::min(
+      count,
+      INTEGER ? layer->decodeBlock(BLOCK, column.integers.data()) : layer->decodeBlock(BLOCK, column.numbers.data())
+    );
+
+    for (size_t offset = 0; offset < DECODED; offset++) {
+      if (!layer->isValid(first + offset)) {
+        continue;
+      }
+
+      if (INTEGER) {
+        column.kinds[offset]   = static_cast<uint8_t>(Astruct::astruct_kind_t::integer);
+        column.numbers[offset] = static_cast<double>(column.integers[offset]);
+      } else {
+        column.kinds[offset] = static_cast<uint8_t>(Astruct::astruct_kind_t::real);
+      }
+    }
+    return;
+  }
+
+  if (bucket_->isDictionaryStack(stack_index)) {
+    const DictionaryLayer* layer = bucket_->dictionary_layers[stack_index];
+    const size_t           LAST  = std::min(first + count, layer->codes.size());
+
+    for (size_t row = first; row < LAST; row++) {
+      if (Dictionary::isString(layer->codes[row])) {
+        column.kinds[row - first]   = static_cast<uint8_t>(Astruct::astruct_kind_t::string);
+        column.strings[row - first] = layer->dictionary->decode(layer->codes[row]);
+      } else if (layer->codes[row] == Dictionary::json_null_code) {
+        column.kinds[row - first] = static_cast<uint8_t>(Astruct::astruct_kind_t::null);
+      }
+    }
+    return;
+  }
+
+  const Bucket::stack_t& stack = bucket_->bucket[stack_index];
+  const size_t           LAST  = std::min(first + count, stack.size());
+
+  for (size_t row = first; row < LAST; row++) {
+    const Astruct* astruct = stack[row];
+    const size_t   OFFSET  = row - first;
+
+    if (astruct == nullptr) {
+      continue;
+    }
+
+    column.kinds[OFFSET] = static_cast<uint8_t>(astruct->kind());
+
+    switch (astruct->kind()) {
+      case Astruct::astruct_kind_t::boolean:
+        column.integers[OFFSET] = std::get<bool>(astruct->astruct) ? 1 : 0;
+        break;
+
+      case Astruct::astruct_kind_t::integer:
+        column.integers[OFFSET] = std::get<int64_t>(astruct->astruct);
+        column.numbers[OFFSET]  = static_cast<double>(column.integers[OFFSET]);
+        break;
+
+      case Astruct::astruct_kind_t::real:
+        column.numbers[OFFSET] = std::get<double>(astruct->astruct);
+        break;
+
+      case Astruct::astruct_kind_t::string:
+        column.strings[OFFSET] = std::get<std::string>(astruct->astruct);
+        break;
+
+      default:
+        break;
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::appendString` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Appends a string value to the group key `key`, its kind, its length and its bytes
+  *
+  * @return
+  * This function does not return anything, since it
+  * only extends `key`
+*/
+
+
+void Aggregator::appendString(std::string& key, std::string_view value) {
+  const uint32_t LENGTH = static_cast<uint32_t>(value.size());
+
+  key.push_back(static_cast<char>(Astruct::astruct_kind_t::string));
+  key.append(reinterpret_cast<const char*>(&LENGTH), sizeof(LENGTH));
+  key.append(value);
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::appendKey` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Appends the value of the row `row` of `column` to the group key `key`, its kind
+  * and its bytes, the empty slots are nulls, the zeros of both signs are the same
+  * group and the arrays and objects only their kind
+  *
+  * @return
+  * This function does not return anything, since it
+  * only extends `key`
+*/
+
+
+void Aggregator::appendKey(std::string& key, const column_t& column, size_t row) {
+  const uint8_t KIND = column.kinds[row] == column_t::empty
+    ? static_cast<uint8_t>(Astruct::astruct_kind_t::null)
+    : column.kinds[row];
+
+  switch (static_cast<Astruct::astruct_kind_t>(KIND)) {
+    case Astruct::astruct_kind_t::boolean:
+    case Astruct::astruct_kind_t::integer:
+      key.push_back(static_cast<char>(KIND));
+      key.append(reinterpret_cast<const char*>(&column.integers[row]), sizeof(int64_t));
+      break;
+
+    case Astruct::astruct_kind_t::real: {
+      // The zeros are the same key, whatever their sign
+      const double VALUE = column.numbers[row] + 0.0;
+
+      key.push_back(static_cast<char>(KIND));
+      key.append(reinterpret_cast<const char*>(&VALUE), sizeof(VALUE));
+      break;
+    }
+
+    case Astruct::astruct_kind_t::string:
+      appendString(key, column.strings[row]);
+      break;
+
+    default:
+      key.push_back(static_cast<char>(KIND));
+      break;
+  }
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::decodeKey` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Appends the group values of the group key `key` to `row`, an array or an object
+  * group is an empty array or object
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `row`
+*/
+
+
+void Aggregator::decodeKey(std::string_view key, row_t& row) {
+  size_t position = 0;
+
+  while (position < key.size()) {
+    const auto KIND = static_cast<Astruct::astruct_kind_t>(key[position++]);
+
+    switch (KIND) {
+      case Astruct::astruct_kind_t::boolean:
+      case Astruct::astruct_kind_t::integer: {
+        int64_t value;
+        std::memcpy(&value, key.data() + position, sizeof(value));
+        position += sizeof(value);
+
+        row.push_back(KIND == Astruct::astruct_kind_t::boolean ? new Astruct(value != 0) : new Astruct(value));
+        break;
+      }
+
+      case Astruct::astruct_kind_t::real: {
+        double value;
+        std::memcpy(&value, key.data() + position, sizeof(value));
+        position += sizeof(value);
+
+        row.push_back(new Astruct(value));
+        break;
+      }
+
+      case Astruct::astruct_kind_t::string: {
+        uint32_t length;
+        std::memcpy(&length, key.data() + position, sizeof(length));
+        position += sizeof(length);
+
+        row.push_back(new Astruct(std::string(key.substr(position, length))));
+        position += length;
+        break;
+      }
+
+      case Astruct::astruct_kind_t::array:
+        row.push_back(new Astruct(Astruct::astruct_array_t{}));
+        break;
+
+      case Astruct::astruct_kind_t::object:
+        row.push_back(new Astruct(Astruct::astruct_object_t{}));
+        break;
+
+      default:
+        row.push_back(new Astruct(nullptr));
+        break;
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::mayMatchBucket` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Evaluates the ranges with the zone maps of a sealed bucket
+  *
+  * @return
+  * Returns a boolean, false if no row of the bucket can match the ranges
+*/
+
+
+bool Aggregator::mayMatchBucket(const Bucket* bucket_) const {
+  for (const auto& range : ranges) {
+    if (range.stack_index >= bucket_->bucket.size() || !bucket_->mayContainRange(range.stack_index, range.minimum, range.maximum)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::mayMatchChunk` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Evaluates the ranges of the compressed stacks with the statistics of the block
+  * of the chunk that starts at the row `first`
+  *
+  * @return
+  * Returns a boolean, false if no row of the chunk can match the ranges
+*/
+
+
+bool Aggregator::mayMatchChunk(const Bucket* bucket_, size_t first) const {
+  for (const auto& range : ranges) {
+    if (!bucket_->isNumericStack(range.stack_index)) {
+      continue;
+    }
+
+    const NumericLayer* layer = bucket_->numeric_layers[range.stack_index];
+    const size_t        BLOCK = first / NumericLayer::block_size;
+
+    if (BLOCK >= layer->blockCount()) {
+      return false;
+    }
+
+    const NumericLayer::numeric_block_t& block = layer->blocks[BLOCK];
+
+    if (!block.has_values || range.minimum > block.real_maximum || range.maximum < block.real_minimum) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::matches` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Evaluates the ranges on the row `row` of the chunk columns of `partial`
+  *
+  * @return
+  * Returns a boolean, true if the row has a number in every range
+*/
+
+
+bool Aggregator::matches(const partial_t& partial, size_t row) const {
+  for (size_t index = 0; index < ranges.size(); index++) {
+    const column_t& column = partial.columns[range_columns[index]];
+    const auto      KIND   = static_cast<Astruct::astruct_kind_t>(column.kinds[row]);
+
+    if (
+      (KIND != Astruct::astruct_kind_t::integer && KIND != Astruct::astruct_kind_t::real) ||
+      column.numbers[row] < ranges[index].minimum ||
+      column.numbers[row] > ranges[index].maximum
+    ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::addRow` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Adds the row `row` of the chunk columns of `partial` to the states of its group,
+  * one per aggregate
+  *
+  * @return
+  * This function does not return anything, since it
+  * only updates `states`
+*/
+
+
+void Aggregator::addRow(const partial_t& partial, size_t row, state_t* states) const {
+  for (size_t index = 0; index < aggregates.size(); index++) {
+    if (aggregate_columns[index] == SIZE_MAX) {
+      states[index].count++;
+      continue;
+    }
+
+    const column_t& column = partial.columns[aggregate_columns[index]];
+    const auto      KIND   = static_cast<Astruct::astruct_kind_t>(column.kinds[row]);
+
+    if (KIND == Astruct::astruct_kind_t::integer) {
+      states[index].addInteger(column.integers[row]);
+    } else if (KIND == Astruct::astruct_kind_t::real) {
+      states[index].addReal(column.numbers[row]);
+    } else if (column.kinds[row] != column_t::empty && KIND != Astruct::astruct_kind_t::null) {
+      states[index].count++;
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::findGroup` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Finds the states of the group `key` in the partition of the high bits of its
+  * hash, a new group is inserted with empty states
+  *
+  * @return
+  * Returns the states of the group, one per aggregate
+*/
+
+
+Aggregator::state_t* Aggregator::findGroup(partial_t& partial, const std::string& key) const {
+  const size_t HASH      = std::hash<std::string>{}(key);
+  const size_t PARTITION = partial.partitions.size() == 1
+    ? 0
+    : HASH >> (sizeof(size_t) * 8 - std::countr_zero(partial.partitions.size()));
+
+  auto [iterator, inserted] = partial.partitions[PARTITION].try_emplace(key);
+
+  if (inserted) {
+    iterator->second.resize(aggregates.size());
+  }
+  return iterator->second.data();
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::aggregateBucket` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Adds the rows of a bucket that match the ranges to the partial aggregates of the
+  * thread, chunk by chunk. A bucket whose only group stack is dictionary encoded adds
+  * its rows to an array indexed by code and inserts every code in the table once
+  *
+  * @return
+  * This function does not return anything, since it
+  * only updates `partial`
+*/
+
+
+void Aggregator::aggregateBucket(const Bucket* bucket_, partial_t& partial) {
+  const size_t HEIGHT = bucket_->height();
+  const size_t CHUNKS = (HEIGHT + NumericLayer::block_size - 1) / NumericLayer::block_size;
+
+  if (!mayMatchBucket(bucket_)) {
+    pruned_chunks.fetch_add(CHUNKS, std::memory_order_relaxed);
+    return;
+  }
+
+  const DictionaryLayer* codes = nullptr;
+
+  if (
+    group_stacks.size() == 1 &&
+    bucket_->isDictionaryStack(group_stacks[0]) &&
+    bucket_->dictionary_layers[group_stacks[0]]->dictionary->size() < DICTIONARY_GROUPS
+  ) {
+    codes = bucket_->dictionary_layers[group_stacks[0]];
+  }
+
+  // The states of every code, the last code is the null group
+  const size_t          NULL_GROUP = codes != nullptr ? codes->dictionary->size() : 0;
+  std::vector<state_t>  code_states(codes != nullptr ? (NULL_GROUP + 1) * aggregates.size() : 0);
+  std::vector<uint8_t>  seen(codes != nullptr ? NULL_GROUP + 1 : 0);
+  std::vector<size_t>   groups;
+  std::string           key;
+  size_t                rows = 0;
+
+  for (size_t first = 0; first < HEIGHT; first += NumericLayer::block_size) {
+    const size_t COUNT = std::min(NumericLayer::block_size, HEIGHT - first);
+
+    if (!mayMatchChunk(bucket_, first)) {
+      pruned_chunks.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    for (size_t index = 0; index < stacks.size(); index++) {
+      readColumn(bucket_, stacks[index], first, COUNT, partial.columns[index]);
+    }
+
+    for (size_t row = 0; row < COUNT; row++) {
+      if (!matches(partial, row)) {
+        continue;
+      }
+
+      rows++;
+
+      if (group_stacks.empty()) {
+        addRow(partial, row, partial.totals.data());
+        continue;
+      }
+
+      if (codes != nullptr) {
+        const size_t   ROW   = first + row;
+        const uint32_t CODE  = ROW < codes->codes.size() ? codes->codes[ROW] : Dictionary::null_code;
+        const size_t   GROUP = Dictionary::isString(CODE) ? CODE : NULL_GROUP;
+
+        if (seen[GROUP] == 0) {
+          seen[GROUP] = 1;
+          groups.push_back(GROUP);
+        }
+
+        addRow(partial, row, &code_states[GROUP * aggregates.size()]);
+        continue;
+      }
+
+      key.clear();
+      for (const auto column : group_columns) {
+        appendKey(key, partial.columns[column], row);
+      }
+      addRow(partial, row, findGroup(partial, key));
+    }
+  }
+
+  for (const auto group : groups) {
+    key.clear();
+
+    if (group == NULL_GROUP) {
+      key.push_back(static_cast<char>(Astruct::astruct_kind_t::null));
+    } else {
+      appendString(key, codes->dictionary->decode(static_cast<uint32_t>(group)));
+    }
+
+    state_t* states = findGroup(partial, key);
+
+    for (size_t index = 0; index < aggregates.size(); index++) {
+      states[index].merge(code_states[group * aggregates.size() + index]);
+    }
+  }
+
+  aggregated_rows.fetch_add(rows, std::memory_order_relaxed);
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::aggregateClusters` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * The loop of an aggregation thread, it takes the next cluster and adds its buckets
+  * to the partial aggregates of the thread holding the locks of the cluster shared
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `partial`
+*/
+
+
+void Aggregator::aggregateClusters(partial_t& partial) {
+  for (
+    size_t cluster_index = next_cluster.fetch_add(1, std::memory_order_relaxed);
+    cluster_index < cluster_count;
+    cluster_index = next_cluster.fetch_add(1, std::memory_order_relaxed)
+  ) {
+    brain->readCluster(cluster_index, [&](Cluster* cluster_) {
+      cluster_->forEachBucket([&](const Bucket* bucket_) {
+        aggregateBucket(bucket_, partial);
+      });
+    });
+  }
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::mergePartitions` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * The loop of a merge thread, it takes the next partition, merges the tables of
+  * that partition of every thread in the table of the first thread and writes a
+  * result row per group. No other thread reads the tables of the partition
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `merged`
+*/
+
+
+void Aggregator::mergePartitions(std::vector<partial_t>& partials, std::vector<std::vector<row_t>>& merged) {
+  const size_t PARTITIONS = partials[0].partitions.size();
+
+  for (
+    size_t partition = next_partition.fetch_add(1, std::memory_order_relaxed);
+    partition < PARTITIONS;
+    partition = next_partition.fetch_add(1, std::memory_order_relaxed)
+  ) {
+    table_t& target = partials[0].partitions[partition];
+
+    for (size_t index = 1; index < partials.size(); index++) {
+      for (auto& [key, states] : partials[index].partitions[partition]) {
+        auto [iterator, inserted] = target.try_emplace(key);
+
+        if (inserted) {
+          iterator->second = std::move(states);
+          continue;
+        }
+
+        for (size_t aggregate = 0; aggregate < states.size(); aggregate++) {
+          iterator->second[aggregate].merge(states[aggregate]);
+        }
+      }
+      table_t().swap(partials[index].partitions[partition]);
+    }
+
+    merged[partition].reserve(target.size());
+
+    for (const auto& [key, states] : target) {
+      row_t row;
+      row.reserve(group_stacks.size() + aggregates.size());
+
+      decodeKey(key, row);
+
+      for (size_t aggregate = 0; aggregate < aggregates.size(); aggregate++) {
+        row.push_back(states[aggregate].result(aggregates[aggregate].function));
+      }
+      merged[partition].push_back(std::move(row));
+    }
+    table_t().swap(target);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::compute` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Aggregates the clusters in parallel and merges the partial aggregates of the
+  * threads into the `results` field, in parallel by partition for the groups.
+  * Without groups the result is a single row, even if no row matched. The rows
+  * of the last aggregation are deleted first
+  *
+  * @return
+  * Returns the `results` field, a row per group
+*/
+
+
+std::vector<Aggregator::row_t>& Aggregator::compute() {
+  clear();
+
+  {
+    auto structure = brain->lockStructureShared();
+    cluster_count  = brain->brain.size();
+  }
+
+  // Every stack is read once per chunk, even if it is a group, an aggregate and a range
+  const auto columnOf = [&](size_t stack_index) {
+    const auto found = std::find(stacks.begin(), stacks.end(), stack_index);
+
+    if (found != stacks.end()) {
+      return static_cast<size_t>(found - stacks.begin());
+    }
+
+    stacks.push_back(stack_index);
+    return stacks.size() - 1;
+  };
+
+  stacks.clear();
+  group_columns.clear();
+  aggregate_columns.clear();
+  range_columns.clear();
+
+  for (const auto stack_index : group_stacks) {
+    group_columns.push_back(columnOf(stack_index));
+  }
+  for (const auto& aggregate : aggregates) {
+    aggregate_columns.push_back(
+      aggregate.stack_index == Bucket::no_key ? SIZE_MAX : columnOf(aggregate.stack_index)
+    );
+  }
+  for (const auto& range : ranges) {
+    range_columns.push_back(columnOf(range.stack_index));
+  }
+
+  next_cluster.store(0, std::memory_order_relaxed);
+  next_partition.store(0, std::memory_order_relaxed);
+  aggregated_rows.store(0, std::memory_order_relaxed);
+  pruned_chunks.store(0, std::memory_order_relaxed);
+
+  const size_t THREADS = std::clamp<size_t>(
+    threads != 0 ? threads : std::thread::hardware_concurrency(),
+    1,
+    std::max<size_t>(1, cluster_count)
+  );
+  const size_t PARTITIONS = group_stacks.empty()
+    ? 0
+    : size_t{1} << std::min(radix_bits, MAXIMUM_RADIX_BITS);
+
+  std::vector<partial_t>   partials(THREADS);
+  std::vector<std::thread> workers;
+
+  for (auto& partial : partials) {
+    partial.totals.resize(aggregates.size());
+    partial.partitions.resize(PARTITIONS);
+    partial.columns.resize(stacks.size());
+  }
+
+  for (size_t index = 1; index < THREADS; index++) {
+    workers.emplace_back(&Aggregator::aggregateClusters, this, std::ref(partials[index]));
+  }
+  aggregateClusters(partials[0]);
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+  workers.clear();
+
+  if (group_stacks.empty()) {
+    row_t row;
+
+    for (size_t index = 1; index < THREADS; index++) {
+      for (size_t aggregate = 0; aggregate < aggregates.size(); aggregate++) {
+        partials[0].totals[aggregate].merge(partials[index].totals[aggregate]);
+      }
+    }
+    for (size_t aggregate = 0; aggregate < aggregates.size(); aggregate++) {
+      row.push_back(partials[0].totals[aggregate].result(aggregates[aggregate].function));
+    }
+
+    results.push_back(std::move(row));
+    return results;
+  }
+
+  std::vector<std::vector<row_t>> merged(PARTITIONS);
+  const size_t                    MERGERS = std::min(THREADS, PARTITIONS);
+
+  for (size_t index = 1; index < MERGERS; index++) {
+    workers.emplace_back(&Aggregator::mergePartitions, this, std::ref(partials), std::ref(merged));
+  }
+  mergePartitions(partials, merged);
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (auto& rows : merged) {
+    std::move(rows.begin(), rows.end(), std::back_inserter(results));
+  }
+  return results;
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::clear` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * Deletes the rows of the last aggregation
+  *
+  * @return
+  * This function does not return anything, since it
+  * only empties the `results` field
+*/
+
+
+void Aggregator::clear() {
+  for (auto& row : results) {
+    for (auto astruct : row) {
+      delete astruct;
+    }
+  }
+  results.clear();
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::Aggregator` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * The constructor of the `Aggregator` class, the aggregation runs with
+  * `Aggregator::compute`
+*/
+
+
+Aggregator::Aggregator(Brain* brain_v) {
+  brain = brain_v;
+}
+
+
+/**
+  * @internal
+  * The `Aggregator::~Aggregator` method is internal of the `Aggregator` class
+  *
+  * @brief Description
+  * The destructor of the `Aggregator` class, it deletes the rows of the results
+*/
+
+
+Aggregator::~Aggregator() noexcept {
+  clear();
+}
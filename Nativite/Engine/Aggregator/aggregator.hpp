@@ -0,0 +1,179 @@
+/**
+  * @file aggregator.hpp
+  * This is the documentation of the `aggregator.hpp` file
+  *
+  * @brief Description
+  * Implementation of the Aggregator class, the parallel aggregates and groups
+  * of the rows of a brain in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Nativite engine imports
+#include "../Brain/brain.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Astruct/astruct.hpp"
+
+
+/**
+ * @internal
+ * The Aggregator class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Computes COUNT, SUM, MIN, MAX and AVG aggregates over the stacks of a brain,
+ * for all the rows or for every group of the values of the `group_stacks` field
+ *
+ * @details
+ * The clusters are aggregated in parallel, every thread adds the rows of the clusters
+ * it takes to its own partial aggregates, so the threads never share a table. The
+ * rows are read in chunks of `NumericLayer::block_size` rows, a compressed stack
+ * decodes one block per chunk and the chunks and the sealed buckets whose zone maps
+ * do not match the `ranges` field are skipped without decoding them.
+ *
+ * The groups of a thread are split in `2^radix_bits` partitions by the high bits of
+ * the hash of their key, then every partition is merged by a single thread from the
+ * tables of all the threads, so the merge is also parallel and without locks. When
+ * the only group stack of a bucket is dictionary encoded, the rows are added by
+ * code and the table is only updated once per code of the bucket.
+ *
+ * A group key is typed, the integer 1 and the real 1.0 are different groups, the
+ * empty slots and the nulls are the same group and the arrays and the objects are
+ * grouped by their kind, as an empty array or object. SUM, MIN, MAX and AVG only add numbers, their result is null
+ * if a group has none, SUM, MIN and MAX are integers if the group has no real number.
+*/
+
+
+class Aggregator {
+  // Types
+  public:
+    // The aggregate functions
+    enum class function_t : uint8_t {
+      count   = 0,
+      sum     = 1,
+      minimum = 2,
+      maximum = 3,
+      average = 4
+    };
+
+    // An aggregate of a stack, COUNT without a stack counts the rows
+    struct aggregate_t {
+      function_t function;
+      size_t     stack_index = Bucket::no_key;
+    };
+
+    // A condition of the rows, the number in the stack `stack_index` must be
+    // between `minimum` and `maximum`
+    struct range_t {
+      size_t stack_index;
+      double minimum;
+      double maximum;
+    };
+
+    // A result row, the group values followed by the aggregates, it is owned by the caller
+    using row_t = std::vector<Astruct*>;
+
+    // The partial state of an aggregate of a group
+    struct state_t {
+      uint64_t count           = 0; /**< The values that are not null, or the rows */
+      uint64_t numbers         = 0;
+      int64_t  integer_sum     = 0;
+      double   real_sum        = 0; /**< The reals and the integers that overflowed the integer sum */
+      int64_t  integer_minimum = std::numeric_limits<int64_t>::max();
+      int64_t  integer_maximum = std::numeric_limits<int64_t>::min();
+      double   real_minimum    = std::numeric_limits<double>::infinity();
+      double   real_maximum    = -std::numeric_limits<double>::infinity();
+      bool     has_real        = false;
+      bool     overflow        = false;
+
+      void addInteger(int64_t value);
+      void addReal(double value);
+      void merge(const state_t& other);
+
+      Astruct* result(function_t function) const;
+    };
+
+  protected:
+    // The values of a stack in a chunk of rows, the slots without a value have
+    // no kind and the numbers of the integers are also kept exactly
+    struct column_t {
+      static constexpr uint8_t empty = 0xFF;
+
+      std::vector<uint8_t>          kinds;
+      std::vector<int64_t>          integers;
+      std::vector<double>           numbers;
+      std::vector<std::string_view> strings;
+    };
+
+    // The groups of a partition, the states of the aggregates of every group key
+    using table_t = std::unordered_map<std::string, std::vector<state_t>>;
+
+    // The partial aggregates of a thread
+    struct partial_t {
+      std::vector<state_t> totals;     /**< The aggregates without groups */
+      std::vector<table_t> partitions; /**< The groups split by the high bits of their hash */
+      std::vector<column_t> columns;   /**< The chunk columns, reused between chunks */
+    };
+
+    // Internal functions of the class
+    static void readColumn(const Bucket* bucket_, size_t stack_index, size_t first, size_t count, column_t& column);
+    static void appendString(std::string& key, std::string_view value);
+    static void appendKey(std::string& key, const column_t& column, size_t row);
+    static void decodeKey(std::string_view key, row_t& row);
+
+    bool mayMatchBucket(const Bucket* bucket_) const;
+    bool mayMatchChunk(const Bucket* bucket_, size_t first) const;
+    bool matches(const partial_t& partial, size_t row) const;
+
+    void     addRow(const partial_t& partial, size_t row, state_t* states) const;
+    state_t* findGroup(partial_t& partial, const std::string& key) const;
+
+    void aggregateBucket(const Bucket* bucket_, partial_t& partial);
+    void aggregateClusters(partial_t& partial);
+    void mergePartitions(std::vector<partial_t>& partials, std::vector<std::vector<row_t>>& merged);
+
+    std::vector<size_t> stacks;            /**< The stacks read by the aggregation, once each */
+    std::vector<size_t> group_columns;     /**< The column of every group stack */
+    std::vector<size_t> aggregate_columns; /**< The column of every aggregate, SIZE_MAX to count the rows */
+    std::vector<size_t> range_columns;     /**< The column of every range */
+    std::atomic<size_t> next_partition{0}; /**< The next partition to merge */
+    std::atomic<size_t> next_cluster{0}; /**< The next cluster to aggregate */
+    size_t              cluster_count = 0;
+
+  public:
+    Brain*                   brain;            /**< The aggregated brain */
+    std::vector<size_t>      group_stacks;     /**< The stacks of the group keys, empty for one group */
+    std::vector<aggregate_t> aggregates;       /**< The aggregates of every group */
+    std::vector<range_t>     ranges;           /**< The conditions of the aggregated rows */
+    size_t                   threads    = 0;   /**< The aggregation threads, 0 is one per hardware thread */
+    size_t                   radix_bits = 6;   /**< The partitions of the groups are `2^radix_bits` */
+
+    std::vector<row_t> results; /**< The rows of the last aggregation, the groups are not ordered */
+
+    std::atomic<size_t> aggregated_rows{0}; /**< The rows that matched the ranges */
+    std::atomic<size_t> pruned_chunks{0};   /**< The chunks skipped by the zone maps */
+
+    std::vector<row_t>& compute();
+    void                clear();
+
+    Aggregator(Brain* brain_v);
+
+    Aggregator(const Aggregator&)            = delete;
+    Aggregator& operator=(const Aggregator&) = delete;
+
+    ~Aggregator() noexcept;
+};
@@ -0,0 +1,321 @@
+/**
+  * @file append_buffer.cpp
+  * This is the documentation of the `append_buffer.cpp` file
+  *
+  * @brief Description
+  * Implementation of the AppendBuffer class methods, the reservation and the
+  * publication of the rows, the close and the conversion to a bucket
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+// Nativite engine imports
+#include "append_buffer.hpp"
+#include "../Astruct/astruct.hpp"
+#include "../Bucket/bucket.hpp"
+
+
+/**
+  * @internal
+  * The `AppendBuffer::chunkAt` method is internal of the `AppendBuffer` class
+  *
+  * @brief Description
+  * Returns the chunk `chunk_index`, allocating it if it does not exist, when two
+  * producers allocate it at the same time the loser frees its chunk
+  *
+  * @return
+  * Returns the chunk
+*/
+
+
+AppendBuffer::chunk_t* AppendBuffer::chunkAt(size_t chunk_index) {
+  chunk_t* chunk = chunks[chunk_index].load(std::memory_order_acquire);
+
+  if (chunk != nullptr) {
+    return chunk;
+  }
+
+  chunk_t* created = new chunk_t{
+    new std::atomic<bool>[chunk_rows](),
+    new Astruct*[chunk_rows * width]()
+  };
+
+  if (chunks[chunk_index].compare_exchange_strong(
+    chunk,
+    created,
+    std::memory_order_acq_rel,
+    std::memory_order_acquire
+  )) {
+    return created;
+  }
+
+  delete[] created->ready;
+  delete[] created->values;
+  delete created;
+
+  return chunk;
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::isReady` method is internal of the `AppendBuffer` class
+  *
+  * @return
+  * Returns a boolean, true if the row `row` was written by its producer
+*/
+
+
+bool AppendBuffer::isReady(size_t row) const {
+  const chunk_t* chunk = chunks[row / chunk_rows].load(std::memory_order_acquire);
+
+  return
+    chunk != nullptr &&
+    chunk->ready[row % chunk_rows].load(std::memory_order_acquire);
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::reservedRows` method is internal of the `AppendBuffer` class
+  *
+  * @return
+  * Returns the number of reserved rows that fit in the buffer
+*/
+
+
+size_t AppendBuffer::reservedRows() const {
+  return std::min<uint64_t>(reserved.load(std::memory_order_acquire) & ~closed_bit, max_rows);
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::advance` method is internal of the `AppendBuffer` class
+  *
+  * @brief Description
+  * Moves the `published` watermark over the ready rows, it stops at the first row
+  * that is still being written, its producer moves it when it finishes
+  *
+  * @return
+  * This function does not return anything, since it
+  * only moves the watermark
+*/
+
+
+void AppendBuffer::advance() {
+  uint64_t row = published.load(std::memory_order_acquire);
+
+  while (row < reservedRows() && isReady(row)) {
+    // On failure `row` is the watermark moved by another producer
+    published.compare_exchange_weak(row, row + 1, std::memory_order_acq_rel, std::memory_order_acquire);
+  }
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::appendRow` method is internal of the `AppendBuffer` class
+  *
+  * @brief Description
+  * Appends a row with `values` as its first stacks, the missing stacks are empty
+  * slots. The row is reserved with one atomic increment and published once it
+  * is written, the buffer takes the ownership of the astructs
+  *
+  * @return
+  * Returns false if the buffer is full or closed or the row is wider than `width`,
+  * in that case the caller keeps the ownership of the astructs
+*/
+
+
+bool AppendBuffer::appendRow(std::span<Astruct* const> values) {
+  if (values.size() > width) {
+    return false;
+  }
+
+  const uint64_t ROW = reserved.fetch_add(1, std::memory_order_acq_rel);
+
+  if ((ROW & closed_bit) != 0 || ROW >= max_rows) {
+    return false;
+  }
+
+  chunk_t*  chunk = chunkAt(ROW / chunk_rows);
+  Astruct** slots = chunk->values + (ROW % chunk_rows) * width;
+
+  std::copy(values.begin(), values.end(), slots);
+
+  chunk->ready[ROW % chunk_rows].store(true, std::memory_order_release);
+  advance();
+
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::close` method is internal of the `AppendBuffer` class
+  *
+  * @brief Description
+  * Refuses the next reservations and waits until the rows reserved before are
+  * published, the producers never wait, so the wait is short
+  *
+  * @return
+  * Returns the number of rows of the buffer
+*/
+
+
+size_t AppendBuffer::close() {
+  reserved.fetch_or(closed_bit, std::memory_order_acq_rel);
+
+  const size_t ROWS = reservedRows();
+
+  while (published.load(std::memory_order_acquire) < ROWS) {
+    advance();
+    std::this_thread::yield();
+  }
+  return ROWS;
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::isClosed` method is internal of the `AppendBuffer` class
+  *
+  * @return
+  * Returns a boolean, true if `AppendBuffer::close` was called
+*/
+
+
+bool AppendBuffer::isClosed() const {
+  return (reserved.load(std::memory_order_acquire) & closed_bit) != 0;
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::size` method is internal of the `AppendBuffer` class
+  *
+  * @return
+  * Returns the number of published rows
+*/
+
+
+size_t AppendBuffer::size() const {
+  return published.load(std::memory_order_acquire);
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::at` method is internal of the `AppendBuffer` class
+  *
+  * @return
+  * Returns the astruct of the stack `stack_index` of the row `row`, or nullptr if
+  * the row is not published or the slot is empty
+*/
+
+
+Astruct* AppendBuffer::at(size_t row, size_t stack_index) const {
+  if (row >= size() || stack_index >= width) {
+    return nullptr;
+  }
+
+  const chunk_t* chunk = chunks[row / chunk_rows].load(std::memory_order_acquire);
+  return chunk->values[(row % chunk_rows) * width + stack_index];
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::toBucket` method is internal of the `AppendBuffer` class
+  *
+  * @brief Description
+  * Moves the rows of a closed buffer to a new mutable bucket with `width` stacks,
+  * the readers of the buffer can still read its rows, they are not changed
+  *
+  * @return
+  * Returns the bucket, or nullptr if the buffer is not closed or was already moved
+*/
+
+
+Bucket* AppendBuffer::toBucket() {
+  if (!isClosed() || moved) {
+    return nullptr;
+  }
+
+  const size_t     ROWS = size();
+  Bucket::bucket_t stacks(width);
+
+  for (auto& stack : stacks) {
+    stack.reserve(ROWS);
+  }
+
+  forEachRow([&](size_t, Astruct* const* values) {
+    for (size_t index = 0; index < width; index++) {
+      stacks[index].push_back(values[index]);
+    }
+  });
+
+  moved = true;
+
+  return new Bucket(&stacks, width);
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::AppendBuffer` method is internal of the `AppendBuffer` class
+  *
+  * @brief Description
+  * The constructor of the `AppendBuffer` class, the first chunk is allocated
+  * now so the first producers do not race to allocate it
+*/
+
+
+AppendBuffer::AppendBuffer(size_t width_v, size_t max_rows_v) {
+  width       = std::max<size_t>(1, width_v);
+  max_rows    = std::max<size_t>(1, max_rows_v);
+  chunk_count = (max_rows + chunk_rows - 1) / chunk_rows;
+  chunks      = new std::atomic<chunk_t*>[chunk_count]();
+
+  chunkAt(0);
+}
+
+
+/**
+  * @internal
+  * The `AppendBuffer::~AppendBuffer` method is internal of the `AppendBuffer` class
+  *
+  * @brief Description
+  * The destructor of the `AppendBuffer` class, deletes the astructs of the rows
+  * that were not moved to a bucket and the chunks
+*/
+
+
+AppendBuffer::~AppendBuffer() noexcept {
+  if (!moved) {
+    forEachRow([&](size_t, Astruct* const* values) {
+      for (size_t index = 0; index < width; index++) {
+        delete values[index];
+      }
+    });
+  }
+
+  for (size_t index = 0; index < chunk_count; index++) {
+    chunk_t* chunk = chunks[index].load(std::memory_order_relaxed);
+
+    if (chunk != nullptr) {
+      delete[] chunk->ready;
+      delete[] chunk->values;
+      delete chunk;
+    }
+  }
+  delete[] chunks;
+}
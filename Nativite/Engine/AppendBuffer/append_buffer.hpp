@@ -0,0 +1,116 @@
+/**
+  * @file append_buffer.hpp
+  * This is the documentation of the `append_buffer.hpp` file
+  *
+  * @brief Description
+  * Implementation of the AppendBuffer class, the lock free appends of rows to the
+  * vertical stacks of a cluster by many producers in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+// Forward reference to `Astruct` and `Bucket`
+class Astruct;
+class Bucket;
+
+
+/**
+ * @internal
+ * The AppendBuffer class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * The open bucket of a cluster, the producers append rows of `width` stacks to it
+ * without locks and it becomes a bucket when it is full or flushed
+ *
+ * @details
+ * A producer reserves a row with one atomic increment of `reserved`, writes the
+ * astructs of the row in its slots of a pre-allocated chunk and marks the row ready.
+ * The `published` watermark only moves over ready rows, any producer moves it after
+ * marking its row, so the readers see the rows under the watermark and never a
+ * row that is being written. The chunks are allocated the first time one of their
+ * rows is reserved and never move.
+ *
+ * `AppendBuffer::close` sets the closed bit of `reserved` in the same atomic as the
+ * reservations, so every row is either reserved before the close and published
+ * before it returns, or refused. A closed buffer is turned into a bucket with
+ * `AppendBuffer::toBucket`.
+*/
+
+
+class AppendBuffer {
+  // Types
+  public:
+    // The rows of a chunk
+    static constexpr size_t chunk_rows = 4096;
+
+    // The bit of `reserved` set by `AppendBuffer::close`
+    static constexpr uint64_t closed_bit = uint64_t(1) << 63;
+
+    // The rows of a chunk, `values` has `width` astructs per row
+    struct chunk_t {
+      std::atomic<bool>* ready;
+      Astruct**          values;
+    };
+
+  protected:
+    // Internal functions of the class
+    chunk_t* chunkAt(size_t chunk_index);
+    bool     isReady(size_t row) const;
+    size_t   reservedRows() const;
+    void     advance();
+
+    std::atomic<chunk_t*>* chunks;        /**< The chunks, allocated on demand */
+    size_t                 chunk_count;   /**< The size of the `chunks` field */
+    std::atomic<uint64_t>  reserved{0};   /**< The reserved rows and the closed bit */
+    std::atomic<uint64_t>  published{0};  /**< The rows that can be read */
+    bool                   moved = false; /**< The astructs were moved to a bucket */
+
+  public:
+    size_t width;    /**< The stacks of a row */
+    size_t max_rows; /**< The rows of a full buffer */
+
+    bool appendRow(std::span<Astruct* const> values);
+
+    size_t close();
+    bool   isClosed() const;
+    size_t size() const;
+
+    Astruct* at(size_t row, size_t stack_index) const;
+
+    /**
+      * @internal
+      * The `AppendBuffer::forEachRow` method is internal of the `AppendBuffer` class
+      *
+      * @brief Description
+      * Calls `function(row, values)` for every published row, `values` has `width`
+      * astructs. The rows published during the call may not be visited
+    */
+    template <typename Function>
+    void forEachRow(Function&& function) const {
+      const size_t ROWS = size();
+
+      for (size_t row = 0; row < ROWS; row++) {
+        const chunk_t* chunk = chunks[row / chunk_rows].load(std::memory_order_acquire);
+        function(row, static_cast<Astruct* const*>(chunk->values + (row % chunk_rows) * width));
+      }
+    }
+
+    Bucket* toBucket();
+
+    AppendBuffer(size_t width_v, size_t max_rows_v = 16 * chunk_rows);
+
+    AppendBuffer(const AppendBuffer&)            = delete;
+    AppendBuffer& operator=(const AppendBuffer&) = delete;
+
+    ~AppendBuffer() noexcept;
+};
@@ -0,0 +1,706 @@
+/**
+  * @file arrow_exporter.cpp
+  * This is the documentation of the `arrow_exporter.cpp` file
+  *
+  * @brief Description
+  * Implementation of the ArrowExporter class methods, the arrays and schemas of
+  * the layers and stacks, their release callbacks and the pins of the clusters
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <utility>
+
+// Nativite engine imports
+#include "arrow_exporter.hpp"
+#include "../Astruct/astruct.hpp"
+#include "../Dictionary/dictionary.hpp"
+#include "../Compression/compression.hpp"
+#include "../Epoch/epoch.hpp"
+
+
+// The memory of an exported array, the buffers made by the export, the hold of
+// the buffers of the engine and the children, it is the `private_data` of the array
+struct array_holder_t {
+  const void*              buffers[3] = {nullptr, nullptr, nullptr};
+  std::vector<ArrowArray*> children;
+  ArrowArray*              dictionary = nullptr;
+  MemoryHold*              hold       = nullptr;
+
+  std::vector<uint64_t> validity;
+  std::vector<uint64_t> booleans;
+  std::vector<int64_t>  integers;
+  std::vector<double>   reals;
+  std::vector<int32_t>  offsets;
+  std::vector<char>     bytes;
+};
+
+
+// The memory of an exported schema, it is the `private_data` of the schema
+struct schema_holder_t {
+  std::string               format;
+  std::string               name;
+  std::vector<ArrowSchema*> children;
+  ArrowSchema*              dictionary = nullptr;
+};
+
+
+// The data buffer of the empty strings and codes, Arrow expects a pointer even without values
+alignas(8) static const char empty_bytes[8] = {0};
+
+
+// The release callback of the arrays, it releases the children that were not
+// moved by the consumer, the hold of the buffers of the engine and the holder
+static void releaseArray(ArrowArray* array) {
+  auto* holder = static_cast<array_holder_t*>(array->private_data);
+
+  for (ArrowArray* child : holder->children) {
+    if (child->release != nullptr) {
+      child->release(child);
+    }
+    delete child;
+  }
+
+  if (holder->dictionary != nullptr) {
+    if (holder->dictionary->release != nullptr) {
+      holder->dictionary->release(holder->dictionary);
+    }
+    delete holder->dictionary;
+  }
+
+  if (holder->hold != nullptr) {
+    holder->hold->release();
+  }
+
+  delete holder;
+  array->release = nullptr;
+}
+
+
+// The release callback of the schemas
+static void releaseSchema(ArrowSchema* schema) {
+  auto* holder = static_cast<schema_holder_t*>(schema->private_data);
+
+  for (ArrowSchema* child : holder->children) {
+    if (child->release != nullptr) {
+      child->release(child);
+    }
+    delete child;
+  }
+
+  if (holder->dictionary != nullptr) {
+    if (holder->dictionary->release != nullptr) {
+      holder->dictionary->release(holder->dictionary);
+    }
+    delete holder->dictionary;
+  }
+
+  delete holder;
+  schema->release = nullptr;
+}
+
+
+// Fills `array` with its holder, the buffers are set by the caller
+static array_holder_t* newArray(ArrowArray* array, size_t length, size_t buffers) {
+  auto* holder = new array_holder_t();
+
+  *array = ArrowArray{
+    static_cast<int64_t>(length),
+    0,
+    0,
+    static_cast<int64_t>(buffers),
+    0,
+    holder->buffers,
+    nullptr,
+    nullptr,
+    releaseArray,
+    holder
+  };
+  return holder;
+}
+
+
+// Fills `schema` with its holder, the children are added by the caller
+static schema_holder_t* newSchema(ArrowSchema* schema, std::string format, std::string name, int64_t flags) {
+  auto* holder = new schema_holder_t{std::move(format), std::move(name), {}, nullptr};
+
+  *schema = ArrowSchema{
+    holder->format.c_str(),
+    holder->name.c_str(),
+    nullptr,
+    flags,
+    0,
+    nullptr,
+    nullptr,
+    releaseSchema,
+    holder
+  };
+  return holder;
+}
+
+
+// Appends the JSON text of `astruct` to `bytes`, the values of a stack of mixed
+// kinds are exported as their JSON text
+static void appendJson(const Astruct* astruct, std::vector<char>& bytes) {
+  using kind_t = Astruct::astruct_kind_t;
+
+  auto appendText = [&](std::string_view text) {
+    bytes.insert(bytes.end(), text.begin(), text.end());
+  };
+
+  auto appendString = [&](const std::string& value) {
+    bytes.push_back('"');
+
+    for (char character : value) {
+      if (character == '"' || character == '\\') {
+        bytes.push_back('\\');
+        bytes.push_back(character);
+      } else if (static_cast<unsigned char>(character) < 0x20) {
+        constexpr char HEX[] = "0123456789abcdef";
+
+        appendText("\\u00");
+        bytes.push_back(HEX[character >> 4]);
+        bytes.push_back(HEX[character & 15]);
+      } else {
+        bytes.push_back(character);
+      }
+    }
+    bytes.push_back('"');
+  };
+
+  char text[32];
+
+  switch (astruct->kind()) {
+    case kind_t::null:
+      appendText("null");
+      break;
+    case kind_t::boolean:
+      appendText(std::get<bool>(astruct->astruct) ? "true" : "false");
+      break;
+    case kind_t::integer: {
+      auto result = std::to_chars(text, text + sizeof(text), std::get<int64_t>(astruct->astruct));
+      appendText(std::string_view(text, result.ptr - text));
+      break;
+    }
+    case kind_t::real: {
+      const double VALUE = std::get<double>(astruct->astruct);
+
+      // JSON has no NaN nor infinities
+      if (VALUE != VALUE || VALUE - VALUE != 0) {
+        appendText("null");
+        break;
+      }
+      auto result = std::to_chars(text, text + sizeof(text), VALUE);
+      appendText(std::string_view(text, result.ptr - text));
+      break;
+    }
+    case kind_t::string:
+      appendString(std::get<std::string>(astruct->astruct));
+      break;
+    case kind_t::array: {
+      const auto& array = std::get<Astruct::astruct_array_t>(astruct->astruct);
+
+      bytes.push_back('[');
+      for (size_t index = 0; index < array.size(); index++) {
+        if (index > 0) {
+          bytes.push_back(',');
+        }
+        if (array[index] == nullptr) {
+          appendText("null");
+        } else {
+          appendJson(array[index], bytes);
+        }
+      }
+      bytes.push_back(']');
+      break;
+    }
+    case kind_t::object: {
+      const auto& object = std::get<Astruct::astruct_object_t>(astruct->astruct);
+
+      bytes.push_back('{');
+      for (size_t index = 0; index < object.size(); index++) {
+        if (index > 0) {
+          bytes.push_back(',');
+        }
+        appendString(object[index].first);
+        bytes.push_back(':');
+
+        if (object[index].second == nullptr) {
+          appendText("null");
+        } else {
+          appendJson(object[index].second, bytes);
+        }
+      }
+      bytes.push_back('}');
+      break;
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `ArrowExporter::stackName` method is internal of the `ArrowExporter` class
+  *
+  * @return
+  * Returns the name of the stack `stack_index` in the schemas
+*/
+
+
+std::string ArrowExporter::stackName(size_t stack_index) const {
+  if (stack_index < names.size() && !names[stack_index].empty()) {
+    return names[stack_index];
+  }
+  return std::to_string(stack_index);
+}
+
+
+/**
+  * @internal
+  * The `ArrowExporter::exportDictionaryLayer` method is internal of the `ArrowExporter` class
+  *
+  * @brief Description
+  * Exports the codes of `layer` as the unsigned 32 bits indices of a dictionary
+  * array and its dictionary as a string array, the codes and the bytes and offsets
+  * of the Dictionary class are already the layout of Arrow, so the arrays point to
+  * them and hold them. Only the validity bitmap is made, for the null codes
+  *
+  * @return
+  * Returns the Arrow format of the indices
+*/
+
+
+const char* ArrowExporter::exportDictionaryLayer(const DictionaryLayer* layer, ArrowArray* array) const {
+  const size_t      LENGTH     = layer->codes.size();
+  const Dictionary* dictionary = layer->dictionary;
+  array_holder_t*   holder     = newArray(array, LENGTH, 2);
+
+  const size_t NULLS = std::count_if(
+    layer->codes.begin(),
+    layer->codes.end(),
+    [](auto code) { return !Dictionary::isString(code); }
+  );
+
+  if (NULLS > 0) {
+    holder->validity.assign((LENGTH + 63) / 64, 0);
+
+    for (size_t row = 0; row < LENGTH; row++) {
+      if (Dictionary::isString(layer->codes[row])) {
+        holder->validity[row >> 6] |= uint64_t(1) << (row & 63);
+      }
+    }
+    holder->buffers[0] = holder->validity.data();
+  }
+
+  array->null_count  = static_cast<int64_t>(NULLS);
+  holder->hold       = layer->export_hold.share();
+  holder->buffers[1] = LENGTH == 0 ? static_cast<const void*>(empty_bytes) : layer->codes.data();
+
+  ArrowArray*     strings        = new ArrowArray();
+  array_holder_t* strings_holder = newArray(strings, dictionary->size(), 3);
+
+  strings_holder->hold       = dictionary->export_hold.share();
+  strings_holder->buffers[1] = dictionary->offsets.data();
+  strings_holder->buffers[2] = dictionary->bytes.empty() ? empty_bytes : dictionary->bytes.data();
+
+  holder->dictionary = strings;
+  array->dictionary  = strings;
+
+  return "I";
+}
+
+
+/**
+  * @internal
+  * The `ArrowExporter::exportNumericLayer` method is internal of the `ArrowExporter` class
+  *
+  * @brief Description
+  * Exports `layer` as an array of 64 bits integers or doubles, the validity bitmap
+  * of the layer is already the Arrow bitmap, so the array points to it and holds it,
+  * and the compressed blocks are decoded once to the data buffer of the array
+  *
+  * @return
+  * Returns the Arrow format of the values
+*/
+
+
+const char* ArrowExporter::exportNumericLayer(const NumericLayer* layer, ArrowArray* array) const {
+  const size_t    LENGTH = layer->size;
+  array_holder_t* holder = newArray(array, LENGTH, 2);
+
+  if (!layer->validity.empty()) {
+    size_t valid = 0;
+
+    for (size_t word = 0; word < LENGTH / 64; word++) {
+      valid += std::popcount(layer->validity[word]);
+    }
+
+    if (LENGTH % 64 != 0) {
+      valid += std::popcount(layer->validity[LENGTH / 64] & ((uint64_t(1) << (LENGTH % 64)) - 1));
+    }
+
+    array->null_count  = static_cast<int64_t>(LENGTH - valid);
+    holder->hold       = layer->export_hold.share();
+    holder->buffers[0] = layer->validity.data();
+  }
+
+  const size_t BLOCKS = layer->blockCount();
+  size_t       row    = 0;
+
+  if (layer->kind == NumericLayer::numeric_kind_t::integer) {
+    holder->integers.resize(std::max<size_t>(1, BLOCKS * NumericLayer::block_size));
+
+    for (size_t block = 0; block < BLOCKS; block++) {
+      row += layer->decodeBlock(block, holder->integers.data() + row);
+    }
+    holder->buffers[1] = holder->integers.data();
+
+    return "l";
+  }
+
+  holder->reals.resize(std::max<size_t>(1, BLOCKS * NumericLayer::block_size));
+
+  for (size_t block = 0; block < BLOCKS; block++) {
+    row += layer->decodeBlock(block, holder->reals.data() + row);
+  }
+  holder->buffers[1] = holder->reals.data();
+
+  return "g";
+}
+
+
+/**
+  * @internal
+  * The `ArrowExporter::exportAstructStack` method is internal of the `ArrowExporter` class
+  *
+  * @brief Description
+  * Copies a plain stack of `length` rows to Arrow buffers, the stacks of integers are
+  * 64 bits integers, the stacks with real numbers are doubles, the stacks of strings
+  * are strings and the stacks of booleans are bit packed booleans. The stacks of
+  * arrays, of objects or of values of different kinds are strings with the JSON
+  * text of every value. The empty slots, the null astructs and the rows over the
+  * height of the stack are nulls, a stack without values is a null array
+  *
+  * @return
+  * Returns the Arrow format of the values
+*/
+
+
+const char* ArrowExporter::exportAstructStack(const Bucket::stack_t& stack, size_t length, ArrowArray* array) const {
+  using kind_t = Astruct::astruct_kind_t;
+
+  bool integers = false, reals = false, strings = false, booleans = false, others = false;
+
+  for (const Astruct* astruct : stack) {
+    if (astruct == nullptr) {
+      continue;
+    }
+
+    switch (astruct->kind()) {
+      case kind_t::null:    break;
+      case kind_t::integer: integers = true; break;
+      case kind_t::real:    reals    = true; break;
+      case kind_t::string:  strings  = true; break;
+      case kind_t::boolean: booleans = true; break;
+      default:              others   = true; break;
+    }
+  }
+
+  const bool NUMBERS = integers || reals;
+  const int  KINDS   = int(NUMBERS) + int(strings) + int(booleans) + int(others);
+
+  if (KINDS == 0) {
+    newArray(array, length, 0);
+    array->null_count = static_cast<int64_t>(length);
+
+    return "n";
+  }
+
+  const bool JSON = others || KINDS > 1;
+
+  strings = strings || JSON;
+
+  const size_t    WORDS  = std::max<size_t>(1, (length + 63) / 64);
+  array_holder_t* holder = newArray(array, length, strings ? 3 : 2);
+  size_t          nulls  = 0;
+
+  holder->validity.assign(WORDS, 0);
+
+  if (strings) {
+    holder->offsets.reserve(length + 1);
+    holder->offsets.push_back(0);
+  } else if (booleans) {
+    holder->booleans.assign(WORDS, 0);
+  } else if (reals) {
+    holder->reals.assign(std::max<size_t>(1, length), 0);
+  } else {
+    holder->integers.assign(std::max<size_t>(1, length), 0);
+  }
+
+  for (size_t row = 0; row < length; row++) {
+    const Astruct* astruct = row < stack.size() ? stack[row] : nullptr;
+    const bool     VALID   = astruct != nullptr && astruct->kind() != kind_t::null;
+
+    if (VALID) {
+      holder->validity[row >> 6] |= uint64_t(1) << (row & 63);
+    } else {
+      nulls++;
+    }
+
+    if (strings) {
+      if (VALID && JSON) {
+        appendJson(astruct, holder->bytes);
+      } else if (VALID) {
+        const std::string& value = std::get<std::string>(astruct->astruct);
+        holder->bytes.insert(holder->bytes.end(), value.begin(), value.end());
+      }
+      holder->offsets.push_back(static_cast<int32_t>(holder->bytes.size()));
+    } else if (!VALID) {
+      continue;
+    } else if (booleans) {
+      if (std::get<bool>(astruct->astruct)) {
+        holder->booleans[row >> 6] |= uint64_t(1) << (row & 63);
+      }
+    } else if (reals) {
+      holder->reals[row] = astruct->kind() == kind_t::real
+        ? std::get<double>(astruct->astruct)
+        : static_cast<double>(std::get<int64_t>(astruct->astruct));
+    } else {
+      holder->integers[row] = std::get<int64_t>(astruct->astruct);
+    }
+  }
+
+  array->null_count  = static_cast<int64_t>(nulls);
+  holder->buffers[0] = nulls > 0 ? holder->validity.data() : nullptr;
+
+  if (strings) {
+    holder->buffers[1] = holder->offsets.data();
+    holder->buffers[2] = holder->bytes.empty() ? empty_bytes : holder->bytes.data();
+    return "u";
+  }
+
+  if (booleans) {
+    holder->buffers[1] = holder->booleans.data();
+    return "b";
+  }
+
+  if (reals) {
+    holder->buffers[1] = holder->reals.data();
+    return "g";
+  }
+
+  holder->buffers[1] = holder->integers.data();
+  return "l";
+}
+
+
+/**
+  * @internal
+  * The `ArrowExporter::exportStackOf` method is internal of the `ArrowExporter` class
+  *
+  * @brief Description
+  * Exports the stack `stack_index` of `bucket_` as an array of `length` rows and
+  * its schema, a layer whose size is not `length` is exported as a null array
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `array` and `schema`
+*/
+
+
+void ArrowExporter::exportStackOf(
+  const Bucket* bucket_,
+  size_t stack_index,
+  size_t length,
+  ArrowArray* array,
+  ArrowSchema* schema
+) const {
+  const char* format     = "n";
+  bool        dictionary = false;
+
+  *array = ArrowArray{};
+
+  if (bucket_->isDictionaryStack(stack_index)) {
+    const DictionaryLayer* layer = bucket_->dictionary_layers[stack_index];
+
+    if (layer->codes.size() == length) {
+      format     = exportDictionaryLayer(layer, array);
+      dictionary = true;
+    }
+  } else if (bucket_->isNumericStack(stack_index)) {
+    const NumericLayer* layer = bucket_->numeric_layers[stack_index];
+
+    if (layer->size == length) {
+      format = exportNumericLayer(layer, array);
+    }
+  } else {
+    format = exportAstructStack(bucket_->bucket[stack_index], length, array);
+  }
+
+  // A layer of another height is a null array
+  if (array->release == nullptr) {
+    newArray(array, length, 0);
+    array->null_count = static_cast<int64_t>(length);
+  }
+
+  schema_holder_t* holder = newSchema(schema, format, stackName(stack_index), ARROW_FLAG_NULLABLE);
+
+  if (dictionary) {
+    holder->dictionary = new ArrowSchema();
+    newSchema(holder->dictionary, "u", "", ARROW_FLAG_NULLABLE);
+
+    schema->dictionary = holder->dictionary;
+  }
+}
+
+
+/**
+  * @internal
+  * The `ArrowExporter::exportBucketOf` method is internal of the `ArrowExporter` class
+  *
+  * @brief Description
+  * Exports `bucket_` as a struct array with one child per stack, the record batch
+  * of Arrow, every child has the height of the bucket
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `array` and `schema`
+*/
+
+
+void ArrowExporter::exportBucketOf(const Bucket* bucket_, ArrowArray* array, ArrowSchema* schema) const {
+  const size_t     LENGTH        = bucket_->height();
+  const size_t     STACKS        = bucket_->stackCount();
+  array_holder_t*  holder        = newArray(array, LENGTH, 1);
+  schema_holder_t* schema_holder = newSchema(schema, "+s", "", 0);
+
+  for (size_t stack_index = 0; stack_index < STACKS; stack_index++) {
+    ArrowArray*  child        = new ArrowArray();
+    ArrowSchema* child_schema = new ArrowSchema();
+
+    exportStackOf(bucket_, stack_index, LENGTH, child, child_schema);
+
+    holder->children.push_back(child);
+    schema_holder->children.push_back(child_schema);
+  }
+
+  array->n_children  = static_cast<int64_t>(STACKS);
+  array->children    = holder->children.data();
+  schema->n_children = static_cast<int64_t>(STACKS);
+  schema->children   = schema_holder->children.data();
+}
+
+
+/**
+  * @internal
+  * The `ArrowExporter::exportStack` method is internal of the `ArrowExporter` class
+  *
+  * @brief Description
+  * Exports the stack `stack_index` of the bucket of the slot `bucket_index`, the
+  * consumer calls the release callbacks of `array` and `schema` when it is done
+  *
+  * @return
+  * Returns false if the bucket or the stack do not exist
+*/
+
+
+bool ArrowExporter::exportStack(size_t bucket_index, size_t stack_index, ArrowArray* array, ArrowSchema* schema) const {
+  auto lock = cluster->lockBucketsShared();
+
+  if (
+    bucket_index >= cluster->cluster.size() ||
+    cluster->cluster[bucket_index] == nullptr ||
+    !cluster->cluster[bucket_index]->isLive()
+  ) {
+    return false;
+  }
+
+  const Bucket* bucket_ = cluster->cluster[bucket_index];
+
+  if (stack_index >= bucket_->stackCount()) {
+    return false;
+  }
+
+  exportStackOf(bucket_, stack_index, bucket_->stackHeight(stack_index), array, schema);
+
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `ArrowExporter::exportBucket` method is internal of the `ArrowExporter` class
+  *
+  * @brief Description
+  * Exports the bucket of the slot `bucket_index` as a struct array, the consumer
+  * calls the release callbacks of `array` and `schema` when it is done
+  *
+  * @return
+  * Returns false if the bucket does not exist
+*/
+
+
+bool ArrowExporter::exportBucket(size_t bucket_index, ArrowArray* array, ArrowSchema* schema) const {
+  auto lock = cluster->lockBucketsShared();
+
+  if (
+    bucket_index >= cluster->cluster.size() ||
+    cluster->cluster[bucket_index] == nullptr ||
+    !cluster->cluster[bucket_index]->isLive()
+  ) {
+    return false;
+  }
+
+  exportBucketOf(cluster->cluster[bucket_index], array, schema);
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `ArrowExporter::exportCluster` method is internal of the `ArrowExporter` class
+  *
+  * @brief Description
+  * Exports every bucket of the cluster as a struct array, one array and one schema
+  * per bucket are appended to `arrays` and `schemas`, the buckets can have different
+  * schemas. The rows of the append buffer are flushed to a bucket first
+  *
+  * @return
+  * Returns the number of exported buckets
+*/
+
+
+size_t ArrowExporter::exportCluster(std::vector<ArrowArray>& arrays, std::vector<ArrowSchema>& schemas) const {
+  cluster->flushAppends();
+
+  auto   lock     = cluster->lockBucketsShared();
+  size_t exported = 0;
+
+  cluster->forEachBucket([&](const Bucket* bucket_) {
+    arrays.emplace_back();
+    schemas.emplace_back();
+
+    exportBucketOf(bucket_, &arrays.back(), &schemas.back());
+    exported++;
+  });
+
+  return exported;
+}
+
+
+/**
+  * @internal
+  * The `ArrowExporter::ArrowExporter` method is internal of the `ArrowExporter` class
+  *
+  * @brief Description
+  * The constructor of the `ArrowExporter` class, the buckets of `cluster_v` are exported
+*/
+
+
+ArrowExporter::ArrowExporter(Cluster* cluster_v) : cluster(cluster_v) {}
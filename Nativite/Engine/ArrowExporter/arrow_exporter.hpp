@@ -0,0 +1,117 @@
+/**
+  * @file arrow_exporter.hpp
+  * This is the documentation of the `arrow_exporter.hpp` file
+  *
+  * @brief Description
+  * Implementation of the ArrowExporter class, the export of the stacks of the
+  * buckets as arrays of the Arrow C data interface in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+
+
+// The structures of the Arrow C data interface, they are defined by the Arrow
+// specification and the guard is the one of the specification, so they can be
+// included with the Arrow headers
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+  const char*          format;
+  const char*          name;
+  const char*          metadata;
+  int64_t              flags;
+  int64_t              n_children;
+  struct ArrowSchema** children;
+  struct ArrowSchema*  dictionary;
+
+  void (*release)(struct ArrowSchema*);
+  void* private_data;
+};
+
+struct ArrowArray {
+  int64_t             length;
+  int64_t             null_count;
+  int64_t             offset;
+  int64_t             n_buffers;
+  int64_t             n_children;
+  const void**        buffers;
+  struct ArrowArray** children;
+  struct ArrowArray*  dictionary;
+
+  void (*release)(struct ArrowArray*);
+  void* private_data;
+};
+
+#endif
+
+
+/**
+ * @internal
+ * The ArrowExporter class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Exports the stacks of the buckets of a cluster as Arrow arrays, a bucket is a
+ * struct array, the record batch of Arrow, with one child per stack
+ *
+ * @details
+ * A dictionary layer is a dictionary array whose indices are its codes and whose
+ * dictionary is its strings, the bytes and offsets of the Dictionary class are already
+ * the layout of an Arrow string array. The validity bitmap of a numeric layer is already
+ * the Arrow bitmap too, but its blocks are compressed, so they are decoded once to a
+ * buffer of the export. The plain stacks of integers, real numbers, booleans or strings
+ * are converted to the Arrow buffers of their kind and the stacks of arrays, objects or
+ * mixed kinds to strings of JSON text.
+ *
+ * The codes, the strings and the validity bitmaps are not copied, the arrays point
+ * to the buffers of the layers and take a reference of their MemoryHold while the lock
+ * of the cluster is held. A layer or a dictionary that would free or reallocate a held
+ * buffer moves it to the hold instead, so the export does not hold an epoch that would
+ * stop the reclamation of the whole engine, the Compactor can change the layers
+ * meanwhile and the export can outlive its buckets and its cluster. Only the decoded
+ * blocks and the converted plain stacks are buffers of the export.
+*/
+
+
+class ArrowExporter {
+  protected:
+    // Internal functions of the class
+    std::string stackName(size_t stack_index) const;
+
+    const char* exportDictionaryLayer(const DictionaryLayer* layer, ArrowArray* array) const;
+    const char* exportNumericLayer(const NumericLayer* layer, ArrowArray* array) const;
+    const char* exportAstructStack(const Bucket::stack_t& stack, size_t length, ArrowArray* array) const;
+
+    void exportStackOf(const Bucket* bucket_, size_t stack_index, size_t length, ArrowArray* array, ArrowSchema* schema) const;
+    void exportBucketOf(const Bucket* bucket_, ArrowArray* array, ArrowSchema* schema) const;
+
+  public:
+    Cluster* cluster = nullptr; /**< The cluster whose buckets are exported */
+
+    std::vector<std::string> names; /**< The names of the stacks in the schemas,
+                                         the stacks without a name are named by their index */
+
+    bool   exportStack(size_t bucket_index, size_t stack_index, ArrowArray* array, ArrowSchema* schema) const;
+    bool   exportBucket(size_t bucket_index, ArrowArray* array, ArrowSchema* schema) const;
+    size_t exportCluster(std::vector<ArrowArray>& arrays, std::vector<ArrowSchema>& schemas) const;
+
+    ArrowExporter(Cluster* cluster_v);
+};
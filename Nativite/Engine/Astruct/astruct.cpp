@@ -0,0 +1,175 @@
+/**
+  * @file astruct.cpp
+  * This is the documentation of the `astruct.cpp` file
+  *
+  * @brief Description
+  * Implementation of the Astruct class methods, its constructors and its destructor
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <utility>
+
+// Nativite engine imports
+#include "astruct.hpp"
+
+
+/**
+  * @internal
+  * The `Astruct::isSubValueNullptr` method is internal of the `Astruct` class
+  *
+  * @brief Description
+  * Evaluates if the suggested `astruct_subv_t value` is `nullptr` or is `NULL`
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool Astruct::isSubValueNullptr(astruct_subv_t value) {
+  return
+    value == nullptr ||
+    value == NULL;
+}
+
+
+/**
+  * @internal
+  * The `Astruct::deleteInternalObject` method is internal of the `Astruct` class
+  *
+  * @brief Description
+  * delete the suggested child astruct using `delete value;`
+  *
+  * @return
+  * This function does not return anything, since it
+  * only delete the suggested value
+*/
+
+
+void Astruct::deleteInternalObject(astruct_subv_t value) {
+  delete value;
+  value = nullptr;
+}
+
+
+/**
+  * @internal
+  * The `Astruct::destroy` method is internal of the `Astruct` class
+  *
+  * @brief Description
+  * destroy the children of the astruct if it is an array or an object,
+  * the rest of the kinds do not own memory
+  *
+  * @return
+  * This function does not return anything, since it
+  * only delete the children of the astruct
+*/
+
+
+void Astruct::destroy() {
+  if (auto* array = std::get_if<astruct_array_t>(&astruct)) {
+    for (auto child : *array) {
+      if (!isSubValueNullptr(child)) {
+        deleteInternalObject(child);
+      }
+    }
+    array->clear();
+  } else if (auto* object = std::get_if<astruct_object_t>(&astruct)) {
+    for (auto& member : *object) {
+      if (!isSubValueNullptr(member.second)) {
+        deleteInternalObject(member.second);
+      }
+    }
+    object->clear();
+  }
+}
+
+
+/**
+  * @internal
+  * The `Astruct::Astruct` constructors are internal of the `Astruct` class
+  *
+  * @brief Description
+  * The constructors of the `Astruct` class, one for each kind of value,
+  * arrays and objects take the ownership of their children
+*/
+
+
+Astruct::Astruct(std::nullptr_t value) : astruct(value) {}
+Astruct::Astruct(bool value) : astruct(value) {}
+Astruct::Astruct(double value) : astruct(value) {}
+Astruct::Astruct(std::string value) : astruct(std::move(value)) {}
+Astruct::Astruct(const char* value) : astruct(std::string(value)) {}
+Astruct::Astruct(astruct_array_t value) : astruct(std::move(value)) {}
+Astruct::Astruct(astruct_object_t value) : astruct(std::move(value)) {}
+
+
+/**
+  * @internal
+  * The `Astruct::clone` method is internal of the `Astruct` class
+  *
+  * @brief Description
+  * Makes a deep copy of the astruct, the children of arrays and objects
+  * are copied too, so the copy does not share memory with the original
+  *
+  * @return
+  * Returns a new `Astruct*` that is owned by the caller
+*/
+
+
+Astruct* Astruct::clone() const {
+  switch (kind()) {
+    case astruct_kind_t::array: {
+      astruct_array_t array;
+      array.reserve(std::get<astruct_array_t>(astruct).size());
+
+      for (auto child : std::get<astruct_array_t>(astruct)) {
+        array.push_back(child == nullptr ? nullptr : child->clone());
+      }
+      return new Astruct(std::move(array));
+    }
+    case astruct_kind_t::object: {
+      astruct_object_t object;
+      object.reserve(std::get<astruct_object_t>(astruct).size());
+
+      for (auto& member : std::get<astruct_object_t>(astruct)) {
+        object.emplace_back(
+          member.first,
+          member.second == nullptr ? nullptr : member.second->clone()
+        );
+      }
+      return new Astruct(std::move(object));
+    }
+    case astruct_kind_t::boolean:
+      return new Astruct(std::get<bool>(astruct));
+    case astruct_kind_t::integer:
+      return new Astruct(std::get<int64_t>(astruct));
+    case astruct_kind_t::real:
+      return new Astruct(std::get<double>(astruct));
+    case astruct_kind_t::string:
+      return new Astruct(std::get<std::string>(astruct));
+    default:
+      return new Astruct(nullptr);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Astruct::~Astruct` method is internal of the `Astruct` class
+  *
+  * @brief Description
+  * The destructor of the `Astruct` class
+  *
+  * @details
+  * Deletes the children of arrays and objects, skipping the nullptr or NULL
+  * children to avoid unnecessary memory frees
+*/
+
+
+Astruct::~Astruct() noexcept {
+  destroy();
+}
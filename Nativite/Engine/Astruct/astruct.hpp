@@ -0,0 +1,107 @@
+/**
+  * @file astruct.hpp
+  * This is the documentation of the `astruct.hpp` file
+  *
+  * @brief Description
+  * Implementation of the Astruct class, its constructors and destructor, and its undefined methods
+  * in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+
+/**
+ * @internal
+ * The Astruct class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * The minimum unit of information, it can be a null, a boolean, an integer,
+ * a real number, a string, an array of astructs or an object of astructs
+*/
+
+
+class Astruct {
+  // Types
+  public:
+    // The kind of value held by the astruct, the order is the same
+    // as the alternatives of `astruct_t`
+    enum class astruct_kind_t : uint8_t {
+      null    = 0,
+      boolean = 1,
+      integer = 2,
+      real    = 3,
+      string  = 4,
+      array   = 5,
+      object  = 6
+    };
+
+    // The subvalue type of arrays and objects
+    using astruct_subv_t   = Astruct*;
+
+    using astruct_array_t  = std::vector<astruct_subv_t>;
+    using astruct_member_t = std::pair<std::string, astruct_subv_t>;
+    using astruct_object_t = std::vector<astruct_member_t>;
+
+    // The `astruct` field type
+    using astruct_t = std::variant<
+      std::nullptr_t,
+      bool,
+      int64_t,
+      double,
+      std::string,
+      astruct_array_t,
+      astruct_object_t
+    >;
+
+  protected:
+    // Internal functions of the class
+    bool isSubValueNullptr(astruct_subv_t value);
+
+    void deleteInternalObject(astruct_subv_t value);
+
+    // Abstract destructor
+    void destroy();
+
+  public:
+    astruct_t astruct; /**< The value of the astruct, the children of arrays and objects
+                            are owned by the astruct */
+
+    Astruct(std::nullptr_t value);
+    Astruct(bool value);
+    Astruct(double value);
+    Astruct(std::string value);
+    Astruct(const char* value);
+    Astruct(astruct_array_t value);
+    Astruct(astruct_object_t value);
+
+    template <std::integral T>
+      requires (!std::same_as<T, bool>)
+    Astruct(T value) : astruct(static_cast<int64_t>(value)) {}
+
+    Astruct() = default;
+
+    Astruct(const Astruct&) = delete;
+    Astruct& operator=(const Astruct&) = delete;
+
+    // The kind is taken in every scan and serialization, so it is inline
+    astruct_kind_t kind() const {
+      return static_cast<astruct_kind_t>(astruct.index());
+    }
+
+    Astruct* clone() const;
+
+    ~Astruct() noexcept;
+};
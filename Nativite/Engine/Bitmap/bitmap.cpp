@@ -0,0 +1,197 @@
+/**
+  * @file bitmap.cpp
+  * This is the documentation of the `bitmap.cpp` file
+  *
+  * @brief Description
+  * Implementation of the SlotBitmap class methods
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+
+// Nativite engine imports
+#include "bitmap.hpp"
+
+
+/**
+  * @internal
+  * The `SlotBitmap::resize` method is internal of the `SlotBitmap` class
+  *
+  * @brief Description
+  * Changes the number of slots, the new slots are free and the removed
+  * slots are not counted as used anymore
+  *
+  * @return
+  * This function does not return anything, since it
+  * only resizes the `words` field
+*/
+
+
+void SlotBitmap::resize(size_t size_v) {
+  for (size_t slot = size_v; slot < size; slot++) {
+    if (test(slot)) {
+      used--;
+    }
+  }
+
+  words.resize((size_v + 63) / 64, 0);
+  size = size_v;
+
+  // The bits after the last slot are always 0
+  if ((size & 63) != 0) {
+    words.back() &= (uint64_t(1) << (size & 63)) - 1;
+  }
+  first_free_word = std::min(first_free_word, size >> 6);
+}
+
+
+/**
+  * @internal
+  * The `SlotBitmap::clear` method is internal of the `SlotBitmap` class
+  *
+  * @brief Description
+  * Removes all the slots
+  *
+  * @return
+  * This function does not return anything, since it
+  * only clears the bitmap
+*/
+
+
+void SlotBitmap::clear() {
+  words.clear();
+  size            = 0;
+  used            = 0;
+  first_free_word = 0;
+}
+
+
+/**
+  * @internal
+  * The `SlotBitmap::set` method is internal of the `SlotBitmap` class
+  *
+  * @brief Description
+  * Marks the slot `slot` as used, the bitmap grows if `slot` is after the last slot
+  *
+  * @return
+  * This function does not return anything, since it
+  * only sets the bit of the slot
+*/
+
+
+void SlotBitmap::set(size_t slot) {
+  if (slot >= size) {
+    resize(slot + 1);
+  }
+  if (!test(slot)) {
+    words[slot >> 6] |= uint64_t(1) << (slot & 63);
+    used++;
+  }
+}
+
+
+/**
+  * @internal
+  * The `SlotBitmap::setRange` method is internal of the `SlotBitmap` class
+  *
+  * @brief Description
+  * Marks the slots from `first` to `last - 1` as used a word at a time, the
+  * bitmap grows if `last` is after the last slot
+  *
+  * @return
+  * This function does not return anything, since it
+  * only sets the bits of the slots
+*/
+
+
+void SlotBitmap::setRange(size_t first, size_t last) {
+  if (first >= last) {
+    return;
+  }
+  if (last > size) {
+    resize(last);
+  }
+
+  for (size_t word = first >> 6; word <= (last - 1) >> 6; word++) {
+    const size_t   FROM = std::max(first, word << 6) & 63;
+    const size_t   TO   = std::min(last, (word + 1) << 6) - (word << 6);
+    const uint64_t MASK = (TO == 64 ? ~uint64_t(0) : (uint64_t(1) << TO) - 1) & ~((uint64_t(1) << FROM) - 1);
+
+    used        += std::popcount(MASK & ~words[word]);
+    words[word] |= MASK;
+  }
+}
+
+
+/**
+  * @internal
+  * The `SlotBitmap::reset` method is internal of the `SlotBitmap` class
+  *
+  * @brief Description
+  * Marks the slot `slot` as free
+  *
+  * @return
+  * This function does not return anything, since it
+  * only resets the bit of the slot
+*/
+
+
+void SlotBitmap::reset(size_t slot) {
+  if (slot >= size || !test(slot)) {
+    return;
+  }
+
+  words[slot >> 6] &= ~(uint64_t(1) << (slot & 63));
+  used--;
+  first_free_word = std::min(first_free_word, slot >> 6);
+}
+
+
+/**
+  * @internal
+  * The `SlotBitmap::test` method is internal of the `SlotBitmap` class
+  *
+  * @brief Description
+  * Evaluates if the slot `slot` is used
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool SlotBitmap::test(size_t slot) const {
+  return
+    slot < size &&
+    ((words[slot >> 6] >> (slot & 63)) & 1) != 0;
+}
+
+
+/**
+  * @internal
+  * The `SlotBitmap::findFirstFree` method is internal of the `SlotBitmap` class
+  *
+  * @brief Description
+  * Finds the first free slot with a find first set over the inverted words,
+  * starting from the first word that may have a free slot
+  *
+  * @return
+  * Returns the first free slot, or `size` if every slot is used
+*/
+
+
+size_t SlotBitmap::findFirstFree() {
+  while (first_free_word < words.size()) {
+    const uint64_t FREE = ~words[first_free_word];
+
+    if (FREE != 0) {
+      const size_t SLOT = (first_free_word << 6) + std::countr_zero(FREE);
+      return std::min(SLOT, size);
+    }
+    first_free_word++;
+  }
+  return size;
+}
@@ -0,0 +1,99 @@
+/**
+  * @file bitmap.hpp
+  * This is the documentation of the `bitmap.hpp` file
+  *
+  * @brief Description
+  * Implementation of the SlotBitmap class, the bitmap of the used slots of the
+  * `brain` and `cluster` vectors in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @internal
+ * The SlotBitmap class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * One bit per slot of a vector of pointers, bit `n` of the word `n / 64` is 1 if
+ * the slot `n` is used, so a free slot is found with a find first set over the
+ * inverted words and the used slots are iterated word by word
+ *
+ * @details
+ * The `first_free_word` field remembers the first word that may have a free slot,
+ * it only moves back when a slot is released, so finding a free slot is O(1)
+ * amortized when the slots are filled in order.
+*/
+
+
+class SlotBitmap {
+  protected:
+    size_t first_free_word = 0; /**< No word before it has a free slot */
+
+  public:
+    std::vector<uint64_t> words;    /**< The bits of the slots */
+    size_t                size = 0; /**< The number of slots */
+    size_t                used = 0; /**< The number of used slots */
+
+    void resize(size_t size_v);
+    void clear();
+
+    void set(size_t slot);
+    void setRange(size_t first, size_t last);
+    void reset(size_t slot);
+    bool test(size_t slot) const;
+
+    size_t findFirstFree();
+
+    /**
+      * @internal
+      * The `SlotBitmap::rebuild` method is internal of the `SlotBitmap` class
+      *
+      * @brief Description
+      * Builds the bitmap again from `slots`, a slot is used if it is not nullptr,
+      * it is needed after writing the vector without the bitmap
+    */
+    template <typename Slots>
+    void rebuild(const Slots& slots) {
+      clear();
+      resize(slots.size());
+
+      for (size_t slot = 0; slot < slots.size(); slot++) {
+        if (slots[slot] != nullptr) {
+          set(slot);
+        }
+      }
+    }
+
+    /**
+      * @internal
+      * The `SlotBitmap::forEachUsed` method is internal of the `SlotBitmap` class
+      *
+      * @brief Description
+      * Calls `function(slot)` for every used slot in order, the empty words
+      * are skipped without testing their slots
+    */
+    template <typename Function>
+    void forEachUsed(Function&& function) const {
+      for (size_t word = 0; word < words.size(); word++) {
+        uint64_t bits = words[word];
+
+        while (bits != 0) {
+          function((word << 6) + std::countr_zero(bits));
+          bits &= bits - 1;
+        }
+      }
+    }
+
+    SlotBitmap() = default;
+};
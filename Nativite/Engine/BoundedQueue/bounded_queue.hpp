@@ -0,0 +1,136 @@
+/**
+  * @file bounded_queue.hpp
+  * This is the documentation of the `bounded_queue.hpp` file
+  *
+  * @brief Description
+  * Implementation of the BoundedQueue class, a blocking queue with a fixed capacity
+  * between the stages of a pipeline in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+
+/**
+ * @internal
+ * The BoundedQueue class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * A queue of at most `capacity` items shared by producers and consumers, a producer
+ * waits while it is full and a consumer waits while it is empty
+ *
+ * @details
+ * The waits are the backpressure of a pipeline, a slow stage makes the stages before
+ * it wait instead of growing its queue. `BoundedQueue::close` wakes everyone, after it
+ * the pushes fail and the pops return the remaining items and then fail.
+*/
+
+
+template <typename T>
+class BoundedQueue {
+  protected:
+    mutable std::mutex      mutex;     /**< Protects the `items` and `closed` fields */
+    std::condition_variable not_full;  /**< Wakes the waiting producers */
+    std::condition_variable not_empty; /**< Wakes the waiting consumers */
+    std::deque<T>           items;
+    bool                    closed = false;
+
+  public:
+    size_t capacity; /**< The maximum number of items */
+
+    /**
+      * @internal
+      * The `BoundedQueue::push` method is internal of the `BoundedQueue` class
+      *
+      * @brief Description
+      * Adds `item` at the end of the queue, waiting while the queue is full
+      *
+      * @return
+      * Returns false if the queue is closed, in that case `item` is not moved
+    */
+    bool push(T&& item) {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      not_full.wait(lock, [&]() { return closed || items.size() < capacity; });
+
+      if (closed) {
+        return false;
+      }
+
+      items.push_back(std::move(item));
+      lock.unlock();
+
+      not_empty.notify_one();
+      return true;
+    }
+
+    /**
+      * @internal
+      * The `BoundedQueue::pop` method is internal of the `BoundedQueue` class
+      *
+      * @brief Description
+      * Moves the first item of the queue to `item`, waiting while the queue is empty
+      *
+      * @return
+      * Returns false if the queue is closed and empty
+    */
+    bool pop(T& item) {
+      std::unique_lock<std::mutex> lock(mutex);
+
+      not_empty.wait(lock, [&]() { return closed || !items.empty(); });
+
+      if (items.empty()) {
+        return false;
+      }
+
+      item = std::move(items.front());
+      items.pop_front();
+      lock.unlock();
+
+      not_full.notify_one();
+      return true;
+    }
+
+    /**
+      * @internal
+      * The `BoundedQueue::close` method is internal of the `BoundedQueue` class
+      *
+      * @brief Description
+      * Refuses the next pushes and wakes every waiting producer and consumer
+    */
+    void close() {
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+      }
+      not_full.notify_all();
+      not_empty.notify_all();
+    }
+
+    /**
+      * @internal
+      * The `BoundedQueue::size` method is internal of the `BoundedQueue` class
+      *
+      * @return
+      * Returns the number of queued items
+    */
+    size_t size() const {
+      std::lock_guard<std::mutex> lock(mutex);
+      return items.size();
+    }
+
+    BoundedQueue(size_t capacity_v) : capacity(capacity_v == 0 ? 1 : capacity_v) {}
+
+    BoundedQueue(const BoundedQueue&)            = delete;
+    BoundedQueue& operator=(const BoundedQueue&) = delete;
+};
@@ -12,12 +12,15 @@
 */
 
 // C++ libraries imports
-#include <cmath>
+#include <algorithm>
 #include <iostream>
+#include <iterator>
 #include <ostream>
 
 // Nativite engine imports
 #include "brain.hpp"
+#include "../Printer/printer.hpp"
+#include "../Cluster/cluster.hpp"
 
 /**
   * @internal
@@ -61,7 +64,7 @@ bool Brain::isSubValueNullptr(brain_subv_t value) {
   * The `Brain::hasDisponibleCapacity` method is internal of the `Brain` class
   * 
   * @brief Description
-  * Evaluates if `brain.size()` is less than the capacity field
+  * Evaluates if the used slots of the `brain` field are less than the capacity field
   * 
   * @return
   * Returns a boolean, true if value if the previous expresion is right
@@ -69,7 +72,7 @@ bool Brain::isSubValueNullptr(brain_subv_t value) {
 
 
 bool Brain::hasDisponibleCapacity() {
-  return brain.size() < brain_capacity;
+  return cluster_slots.used < brain_capacity;
 }
 
 
@@ -90,6 +93,7 @@ bool Brain::hasDisponibleCapacity() {
 void Brain::resizeVec() {
   brain_capacity += 15;
   brain.resize(brain_capacity);
+  cluster_slots.resize(brain.size());
 }
 
 
@@ -108,6 +112,8 @@ void Brain::resizeVec() {
 
 void Brain::newVec() {
   brain = std::vector<Cluster*>(brain_capacity);
+  cluster_slots.clear();
+  cluster_slots.resize(brain.size());
 }
 
 
@@ -167,7 +173,8 @@ void Brain::evaluateNullptrInAssignation(brain_subv_t value) {
   * 
   * @brief Description
   * push to `brain` the `value`, this function is
-  * used to push the value if `value` is not nullptr or NULL
+  * used to push the value if `value` is not nullptr or NULL,
+  * the first empty slot is reused before growing the vector
   * 
   * @return
   * This function does not return anything, since it
@@ -176,7 +183,7 @@ void Brain::evaluateNullptrInAssignation(brain_subv_t value) {
 
 
 void Brain::pushObjectValue(brain_subv_t value) {
-  brain.push_back(value);
+  placeCluster(value);
 }
 
 
@@ -245,16 +252,17 @@ void Brain::defaultNullptrVec() {
   * The `Brain::deleteInternalObject` method is internal of the `Brain` class
   * 
   * @brief Description
-  * delete the suggested value using `delete value;` and `value = nullptr;`
+  * retire the suggested value to the global `EpochManager`, it is deleted once
+  * no reader that could reach it is running
   * 
   * @return
   * This function does not return anything, since it
-  * only delete the suggested value
+  * only retire the suggested value
 */
 
 
 void Brain::deleteInternalObject(brain_subv_t value) {
-  delete value;
+  EpochManager::global().retire(value);
   value = nullptr;
 }
 
@@ -274,10 +282,128 @@ void Brain::deleteInternalObject(brain_subv_t value) {
 
 void Brain::deleteAllFields() {
   brain.clear();
+  cluster_slots.clear();
   brain_capacity = 0;
 }
 
 
+/**
+  * @internal
+  * The `Brain::adoptClusters` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * Appends the clusters of `value` to the `brain` field, if the `brain` field is
+  * empty the storage of `value` is taken instead of copying it. The nullptr or NULL
+  * slots are removed in a single pass and the capacity grows to fit the clusters
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the clusters
+*/
+
+
+void Brain::adoptClusters(brain_t&& value) {
+  if (!brain.empty()) {
+    appendClusters(value);
+    value.clear();
+    return;
+  }
+
+  brain = std::move(value);
+  value.clear();
+
+  std::erase(brain, nullptr);
+
+  brain_capacity = std::max(brain_capacity, brain.size());
+  cluster_slots.clear();
+  cluster_slots.setRange(0, brain.size());
+
+  if (directory != nullptr) {
+    directory->rebuild(this);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Brain::appendClusters` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * Appends the clusters of `value` after the last slot of the `brain` field with
+  * a single reservation, skipping the nullptr or NULL slots in the same pass
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the clusters
+*/
+
+
+void Brain::appendClusters(std::span<const brain_subv_t> value) {
+  // The bitmap is stale if the vector was written directly
+  if (cluster_slots.size != brain.size()) {
+    rebuildClusterSlots();
+  }
+
+  const size_t FIRST = brain.size();
+
+  brain.reserve(FIRST + value.size());
+  std::copy_if(
+    value.begin(),
+    value.end(),
+    std::back_inserter(brain),
+    [](brain_subv_t cluster) { return cluster != nullptr; }
+  );
+
+  brain_capacity = std::max(brain_capacity, brain.size());
+  cluster_slots.setRange(FIRST, brain.size());
+
+  for (size_t index = FIRST; index < brain.size(); index++) {
+    refreshDirectory(index);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Brain::append` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * Appends the clusters of `brain_v` to the brain, which takes their ownership,
+  * the storage of `brain_v` is taken if the brain is empty. The structure lock
+  * is held exclusively
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the clusters
+*/
+
+
+void Brain::append(brain_t&& brain_v) {
+  auto structure = lockStructure();
+  adoptClusters(std::move(brain_v));
+}
+
+
+/**
+  * @internal
+  * The `Brain::append` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * Appends the clusters of `brain_v` to the brain, which takes their ownership,
+  * the structure lock is held exclusively
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the clusters
+*/
+
+
+void Brain::append(std::span<const brain_subv_t> brain_v) {
+  auto structure = lockStructure();
+  appendClusters(brain_v);
+}
+
+
 /**
   * @internal
   * The `Brain::build` method is internal of the `Brain` class
@@ -333,7 +459,7 @@ void Brain::build(
   * The `Brain::destroy` method is internal of the `Brain` class
   * 
   * @brief Description
-  * destroy the `brain` deleting all `Cluster*` objects and reset the 
+  * destroy the `brain` deleting all `Cluster*` objects and the directory and reset the 
   * `brain_capacity` field to 0
   * 
   * @return
@@ -351,160 +477,352 @@ void Brain::destroy() {
       deleteInternalObject(cluster);
     }
   }
+
+  delete directory;
+  directory = nullptr;
+
   deleteAllFields();
+
+  // Without readers the clusters are deleted at once
+  EpochManager::global().collect();
 }
 
 /**
   * @internal
-  * The `Brain::Brain` method is internal of the `Brain` class
+  * The `Brain::insertCluster` method is internal of the `Brain` class
   *
   * @brief Description
-  * The constructor of the `Brain` class
+  * Puts `value` in the first empty slot of the `brain` field holding the
+  * structure lock exclusively, see `Brain::placeCluster`
   *
-  * @details
-  * It handles several things, such as checking if the value to be assigned is
-  * nullptr or NULL, it also handles capacity assignment, creating a new vector
-  * for `brain`, resizing the `brain` vector.
+  * @return
+  * Returns the slot of `value`, or the size of the `brain` field if `value`
+  * is nullptr or NULL and was not inserted
 */
 
 
-Brain::Brain(
-  brain_t* brain_v,
-  size_t capacity
-) {
-  build(brain_v, capacity);
+size_t Brain::insertCluster(brain_subv_t value) {
+  auto structure = lockStructure();
+  return placeCluster(value);
 }
 
 
 /**
   * @internal
-  * The `Brain::~Brain` method is internal of the `Brain` class
+  * The `Brain::placeCluster` method is internal of the `Brain` class
   *
   * @brief Description
-  * The destructor of the `Brain` class
+  * Puts `value` in the first empty slot of the `brain` field, found with the
+  * `cluster_slots` field, the vector only grows if there is no empty slot.
+  * The caller holds the structure lock exclusively or owns the brain alone
   *
-  * @details
-  * It handles how to check if a value is nullptr or NULL when deleting one by one
-  * This prevents freeing memory to nullptr or NULL pointers although it is safe,
-  * it is done to avoid unnecessary memory frees
+  * @return
+  * Returns the slot of `value`, or the size of the `brain` field if `value`
+  * is nullptr or NULL and was not inserted
 */
 
 
-Brain::~Brain() noexcept {
-  destroy();
+size_t Brain::placeCluster(brain_subv_t value) {
+  if (isSubValueNullptr(value)) {
+    return brain.size();
+  }
+
+  // The bitmap is stale if the vector was written directly
+  if (cluster_slots.size != brain.size()) {
+    rebuildClusterSlots();
+  }
+
+  size_t slot = cluster_slots.findFirstFree();
+
+  if (slot < brain.size() && !isSubValueNullptr(brain[slot])) {
+    rebuildClusterSlots();
+    slot = cluster_slots.findFirstFree();
+  }
+
+  if (slot < brain.size()) {
+    brain[slot] = value;
+  } else {
+    slot = brain.size();
+    brain.push_back(value);
+  }
+  cluster_slots.set(slot);
+  refreshDirectory(slot);
+
+  return slot;
 }
 
-//////////////////////////////////
-// ////////// OPERATORS //////////
-//////////////////////////////////
 
-// operator<< functions
+/**
+  * @internal
+  * The `Brain::removeCluster` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * Empties the slot `index` of the `brain` field, the slot is reused by the next
+  * insertion, the cluster is not deleted. The structure lock is held exclusively,
+  * so no reader is using the cluster when it is returned
+  *
+  * @return
+  * Returns the removed cluster, the caller takes its ownership
+*/
+
+
+Brain::brain_subv_t Brain::removeCluster(size_t index) {
+  auto structure = lockStructure();
+
+  if (index >= brain.size()) {
+    return nullptr;
+  }
+
+  brain_subv_t value = brain[index];
+
+  brain[index] = nullptr;
+  cluster_slots.reset(index);
+
+  if (directory != nullptr) {
+    directory->remove(index);
+  }
+
+  return value;
+}
 
 
 /**
-   * @internal
-  * The `Brain::printNewRow` method is internal of the `Brain` class
+  * @internal
+  * The `Brain::compactClusters` method is internal of the `Brain` class
   *
   * @brief Description
-  * Prints a new line, printing a line break, and also printing a 2-indent tab stop
+  * Packs the clusters at the start of the `brain` field keeping their order
+  * and removes the empty slots, so the traversals do not test them anymore,
+  * the structure lock is held exclusively
   *
   * @return
-  * This function does not return anything, it just prints to the console with std::ostream&
+  * Returns the number of removed empty slots
 */
 
 
-void Brain::printNewRow(
-  std::ostream& ostream,
-  size_t square_counter,
-  size_t BRAIN_SIZE,
-  size_t index
-) {
-  ostream << "\n";
-  if (index < BRAIN_SIZE) {
-    ostream << "  ";
+size_t Brain::compactClusters() {
+  auto   structure = lockStructure();
+  size_t kept      = 0;
+
+  for (size_t index = 0; index < brain.size(); index++) {
+    if (!isSubValueNullptr(brain[index])) {
+      brain[kept++] = brain[index];
+    }
+  }
+
+  const size_t REMOVED = brain.size() - kept;
+
+  brain.resize(kept);
+  rebuildClusterSlots();
+
+  if (directory != nullptr) {
+    directory->rebuild(this);
   }
+
+  return REMOVED;
 }
 
 
 /**
-   * @internal
-  * The `Brain::printSlot` method is internal of the `Brain` class
+  * @internal
+  * The `Brain::rebuildClusterSlots` method is internal of the `Brain` class
   *
   * @brief Description
-  * Prints an empty slot by printing 'empty' to the console or if the value is not nullptr or NULL
-  * prints the respective value
+  * Builds the `cluster_slots` field again from the `brain` field
   *
   * @return
-  * This function does not return anything, it just prints to the console with std::ostream&
+  * This function does not return anything, since it
+  * only rebuilds the bitmap
 */
 
 
-void Brain::printSlot(
-  std::ostream& ostream,
-  brain_subv_t brain_
-) {
-  if (
-    isSubValueNullptr(
-      brain_
-    )
-  ) {
-    ostream << "empty";
-  } else {
-    ostream << "item";
+void Brain::rebuildClusterSlots() {
+  cluster_slots.rebuild(brain);
+}
+
+
+/**
+  * @internal
+  * The `Brain::refreshDirectory` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * Builds the `directory` field again from every cluster holding the structure
+  * lock exclusively, it is created the first time, after that the insertions and
+  * removals keep it updated. The readers of the directory hold the structure lock shared
+  *
+  * @return
+  * Returns the directory of the brain
+*/
+
+
+ClusterDirectory* Brain::refreshDirectory() {
+  auto structure = lockStructure();
+
+  if (directory == nullptr) {
+    directory = new ClusterDirectory();
   }
+  directory->rebuild(this);
+
+  return directory;
 }
 
 
 /**
-   * @internal
-  * The `Brain::printComma` method is internal of the `Brain` class
+  * @internal
+  * The `Brain::refreshDirectory` method is internal of the `Brain` class
   *
   * @brief Description
-  * Prints ', ' as an element separator when printing empty elements
+  * Reads again the metadata of the cluster of the slot `index` into the
+  * `directory` field, it does nothing if the directory was not created.
+  * The caller holds the structure lock exclusively
   *
   * @return
-  * This function does not return anything, it just prints to the console with std::ostream&
+  * This function does not return anything, since it
+  * only refreshes the slot of the directory
 */
 
 
-void Brain::printComma(
-  std::ostream& ostream,
-  size_t index,
-  size_t size
-) {
-  if (
-    index < size
-  ) {
-    ostream << ", ";
+void Brain::refreshDirectory(size_t index) {
+  if (directory != nullptr && index < brain.size()) {
+    directory->refresh(index, brain[index]);
   }
 }
 
 
 /**
-   * @internal
-  * The `Brain::takeSquareRootOfBrainSize` method is internal of the `Brain` class
+  * @internal
+  * The `Brain::lockStructureShared` method is internal of the `Brain` class
   *
   * @brief Description
-  * Takes the square root of the size of `brain` and rounds it so it is not decimal.
-  * This is useful for very legible printing, since when printed it looks like a square
-  * and not a flat array.
+  * Takes the structure lock shared, the readers and the writers of the
+  * clusters take it shared, so they never block each other
   *
   * @return
-  * Returns a double which contains the square root of the size of `brain`
+  * Returns the lock, it is released when it is destroyed
 */
 
 
-size_t Brain::takeSquareRootOfBrainSize(
-  brain_t brain_
-) {
-  return std::ceil(
-    std::sqrt(
-    brain_.size()
-    )
+std::shared_lock<std::shared_mutex> Brain::lockStructureShared() const {
+  return std::shared_lock<std::shared_mutex>(structure_mutex);
+}
+
+
+/**
+  * @internal
+  * The `Brain::lockStructure` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * Takes the structure lock exclusively, only to add or remove clusters, and moves
+  * the `structure_version` field, so the rows cached before are stale
+  *
+  * @return
+  * Returns the lock, it is released when it is destroyed
+*/
+
+
+std::unique_lock<std::shared_mutex> Brain::lockStructure() const {
+  std::unique_lock<std::shared_mutex> lock(structure_mutex);
+
+  structure_version.store(
+    Cluster::write_clock.fetch_add(1, std::memory_order_acq_rel) + 1,
+    std::memory_order_release
   );
+  return lock;
+}
+
+
+/**
+  * @internal
+  * The `Brain::Brain` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * The constructor of the `Brain` class
+  *
+  * @details
+  * It handles several things, such as checking if the value to be assigned is
+  * nullptr or NULL, it also handles capacity assignment, creating a new vector
+  * for `brain`, resizing the `brain` vector.
+*/
+
+
+Brain::Brain(
+  brain_t* brain_v,
+  size_t capacity
+) {
+  build(brain_v, capacity);
+}
+
+
+/**
+  * @internal
+  * The `Brain::Brain` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * The move constructor of the `Brain` class
+  *
+  * @details
+  * Takes the storage of `brain_v` instead of copying it slot by slot, the only
+  * work is removing its nullptr or NULL slots. The capacity is `capacity`
+  * or the number of clusters if it is bigger
+*/
+
+
+Brain::Brain(
+  brain_t&& brain_v,
+  size_t capacity
+) :
+  brain_capacity(capacity) {
+  adoptClusters(std::move(brain_v));
+}
+
+
+/**
+  * @internal
+  * The `Brain::Brain` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * The constructor of the `Brain` class from a range of clusters
+  *
+  * @details
+  * Copies the non nullptr or NULL slots of `brain_v` with a single reservation,
+  * the brain takes the ownership of the clusters
+*/
+
+
+Brain::Brain(
+  std::span<const brain_subv_t> brain_v,
+  size_t capacity
+) :
+  brain_capacity(capacity) {
+  appendClusters(brain_v);
 }
 
 
+/**
+  * @internal
+  * The `Brain::~Brain` method is internal of the `Brain` class
+  *
+  * @brief Description
+  * The destructor of the `Brain` class
+  *
+  * @details
+  * It handles how to check if a value is nullptr or NULL when deleting one by one
+  * This prevents freeing memory to nullptr or NULL pointers although it is safe,
+  * it is done to avoid unnecessary memory frees
+*/
+
+
+Brain::~Brain() noexcept {
+  destroy();
+}
+
+//////////////////////////////////
+// ////////// OPERATORS //////////
+//////////////////////////////////
+
+// operator<< functions
+
+
 /**
    * @internal
   * The `Brain::brainExitOperator` method is internal of the `Brain` class
@@ -522,58 +840,9 @@ std::ostream& Brain::brainExitOperator(
   std::ostream& ostream,
   Brain*& brain_
 ) {
-  // The following variable is to print the commas correctly, so that the
-  // commas are not printed after the last element, 2 was put and not 1 because
-  // 1 had no effect.
-
-  const size_t SQUARE_ROOT_OF_BRAIN_SIZE = takeSquareRootOfBrainSize(brain_->brain);
-  const int BRAIN_SIZE_LESS_ONE = brain_->brain.size() - 1;
-  const int EMPTY = -1;
-  size_t square_counter = 0;
-  
-  ostream << "Brain([";
-
-  if (BRAIN_SIZE_LESS_ONE > EMPTY) {
-    ostream << "\n";
-  }
-
-  size_t index = 0;
-
-  while(index < brain_->brain.size()) {
-    // Execute the functions that print the object, it is executed in the order of 
-    // new slot -> comma, and so that it looks good and ordered,
-    // what `printNewRow` and if the square counter is the square root a new line is printed
-
-    if (index == 0) {
-      ostream << "  ";
-    }
-
-    if (
-      square_counter == SQUARE_ROOT_OF_BRAIN_SIZE
-    ) {
-      printNewRow(
-        ostream,
-        square_counter,
-        brain_->brain.size(),
-        index
-      );
-
-      square_counter = 0;
-    }
-
-    brain_->printSlot(ostream, brain_->brain[index]);
-    
-    brain_->printComma(ostream, index, BRAIN_SIZE_LESS_ONE);
-
-    square_counter++;
-    index++;
-  }
-
-  if (BRAIN_SIZE_LESS_ONE > EMPTY) {
-    ostream << "\n";
-  }
-
-  ostream << "])";
+  // The printer of the thread streams through its buffer, so the `brain` field
+  // is never copied and the buffer is not allocated again on every print
+  Printer::threadPrinter(ostream).print(brain_);
 
   return ostream;
 }
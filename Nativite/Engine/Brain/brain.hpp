@@ -14,10 +14,20 @@
 #pragma once
 
 // C++ libraries imports
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
+#include <mutex>
 #include <ostream>
+#include <shared_mutex>
+#include <span>
 #include <vector>
 
+// Nativite engine imports
+#include "../Bitmap/bitmap.hpp"
+#include "../Directory/directory.hpp"
+#include "../Epoch/epoch.hpp"
+
 
 // Forward reference to `Cluster`
 class Cluster;
@@ -78,6 +88,11 @@ class Brain {
     
     virtual void deleteAllFields();
 
+    size_t placeCluster(brain_subv_t value);
+
+    void adoptClusters(brain_t&& value);
+    void appendClusters(std::span<const brain_subv_t> value);
+
     // Core functions that abstract all
     // responsibilities into a single function, 
     // They are also virtual functions
@@ -98,36 +113,142 @@ class Brain {
     // about doing it from scratch
 
     // operator<< functions
-    void printNewRow(
-      std::ostream& ostream,
-      size_t square_counter,
-      size_t size,
-      size_t index
-    );
-
-    void printSlot(
-      std::ostream& ostream,
-      brain_subv_t brain_
-    );
-    
-    void printComma(
-      std::ostream& ostream,
-      size_t index,
-      size_t size
-    );
-
-    size_t takeSquareRootOfBrainSize(
-      brain_t brain_
-    );
-    
     std::ostream& brainExitOperator(std::ostream& ostream, Brain*& brain_);
 
   public:
-    size_t  brain_capacity /**< The capacity of the `brain` field */;
+    size_t  brain_capacity = 0 /**< The capacity of the `brain` field */;
     brain_t brain;         /**< The main field of the `Brain` class It is the second largest
                                 unit of information in the engine, after the database bucket. */;
 
+    SlotBitmap cluster_slots; /**< The used slots of the `brain` field, it must be rebuilt
+                                   with `Brain::rebuildClusterSlots` after writing the
+                                   `brain` field directly */
+
+    mutable std::shared_mutex structure_mutex; /**< The lock of the `brain` field, it is taken
+                                                    exclusively only to add or remove clusters */
+
+    mutable std::atomic<uint64_t> structure_version{0}; /**< The `Cluster::write_clock` of the last
+                                                             exclusive structure lock */
+
+    ClusterDirectory* directory = nullptr; /**< The metadata of the clusters in parallel arrays,
+                                                it is created by `Brain::refreshDirectory` */
+
+    size_t       insertCluster(brain_subv_t value);
+    brain_subv_t removeCluster(size_t index);
+    size_t       compactClusters();
+    void         rebuildClusterSlots();
+
+    ClusterDirectory* refreshDirectory();
+    void              refreshDirectory(size_t index);
+
+    std::shared_lock<std::shared_mutex> lockStructureShared() const;
+    std::unique_lock<std::shared_mutex> lockStructure() const;
+
+    /**
+      * @internal
+      * The `Brain::readClusters` method is internal of the `Brain` class
+      *
+      * @brief Description
+      * Calls `function(cluster)` for every cluster holding the structure lock and
+      * the lock of the cluster shared, so the readers never block each other. The
+      * locks already keep the writers out, so no epoch guard is taken here. The
+      * rows of the append buffer that are not flushed yet are not in the buckets,
+      * the function reads them with `Cluster::forEachAppendedRow`
+    */
+    template <typename Function>
+    void readClusters(Function&& function) const {
+      auto structure = lockStructureShared();
+
+      forEachCluster([&](auto* cluster_) {
+        auto lock = cluster_->lockBucketsShared();
+        function(cluster_);
+      });
+    }
+
+    /**
+      * @internal
+      * The `Brain::readCluster` method is internal of the `Brain` class
+      *
+      * @brief Description
+      * Calls `function(cluster)` for the cluster of the slot `index` holding the
+      * structure lock and the lock of the cluster shared, it does not flush the
+      * append buffer either, see `Brain::readClusters`
+      *
+      * @return
+      * Returns false if the slot is empty
+    */
+    template <typename Function>
+    bool readCluster(size_t index, Function&& function) const {
+      auto structure = lockStructureShared();
+
+      if (index >= brain.size() || brain[index] == nullptr) {
+        return false;
+      }
+
+      auto apply = [&](auto* cluster_) {
+        auto lock = cluster_->lockBucketsShared();
+        function(cluster_);
+      };
+      apply(brain[index]);
+      return true;
+    }
+
+    /**
+      * @internal
+      * The `Brain::writeCluster` method is internal of the `Brain` class
+      *
+      * @brief Description
+      * Calls `function(cluster)` for the cluster of the slot `index` holding the
+      * structure lock shared and the lock of the cluster exclusively, the writers
+      * of different clusters do not block each other
+      *
+      * @return
+      * Returns false if the slot is empty
+    */
+    template <typename Function>
+    bool writeCluster(size_t index, Function&& function) {
+      auto structure = lockStructureShared();
+
+      if (index >= brain.size() || brain[index] == nullptr) {
+        return false;
+      }
+
+      auto apply = [&](auto* cluster_) {
+        auto lock = cluster_->lockBuckets();
+        function(cluster_);
+      };
+      apply(brain[index]);
+      return true;
+    }
+
+    /**
+      * @internal
+      * The `Brain::forEachCluster` method is internal of the `Brain` class
+      *
+      * @brief Description
+      * Calls `function(cluster)` for every cluster of the `brain` field in order,
+      * the empty slots are skipped 64 at a time with the `cluster_slots` field
+    */
+    template <typename Function>
+    void forEachCluster(Function&& function) const {
+      // The vector was written directly, so the bitmap can not be trusted
+      if (cluster_slots.size != brain.size()) {
+        for (auto cluster_ : brain) {
+          if (cluster_ != nullptr) {
+            function(cluster_);
+          }
+        }
+        return;
+      }
+      cluster_slots.forEachUsed([&](size_t slot) { function(brain[slot]); });
+    }
+
+    void append(brain_t&& brain_v);
+    void append(std::span<const brain_subv_t> brain_v);
+
     Brain(brain_t* brain_v, size_t capacity);
+    Brain(brain_t&& brain_v, size_t capacity = 0);
+    Brain(std::span<const brain_subv_t> brain_v, size_t capacity = 0);
     Brain() = default;
     
     virtual ~Brain() noexcept;
@@ -0,0 +1,1355 @@
+/**
+  * @file bucket.cpp
+  * This is the documentation of the `bucket.cpp` file
+  *
+  * @brief Description
+  * Implementation of the Bucket class methods, its constructor and its destructor
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+// Nativite engine imports
+#include "bucket.hpp"
+
+
+/**
+  * @internal
+  * The `Bucket::isValueNullptr` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates if the suggested `bucket_t* value` is `nullptr` or is `NULL`
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool Bucket::isValueNullptr(bucket_t* value) {
+  return
+    value == nullptr ||
+    value == NULL;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::isSubValueNullptr` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates if the suggested `bucket_subv_t value` is `nullptr` or is `NULL`
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool Bucket::isSubValueNullptr(bucket_subv_t value) {
+  return
+    value == nullptr ||
+    value == NULL;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::hasDisponibleCapacity` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates if `bucket.size()` is less than the capacity field
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool Bucket::hasDisponibleCapacity() {
+  return bucket.size() < bucket_capacity;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::resizeVec` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Adds more capacity of stacks to the `bucket` field vector
+  *
+  * @return
+  * This function does not return anything, since it
+  * only reserves capacity to the vector.
+*/
+
+
+void Bucket::resizeVec() {
+  bucket_capacity += 8;
+  bucket.reserve(bucket_capacity);
+}
+
+
+/**
+  * @internal
+  * The `Bucket::newVec` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Create a new empty vector for the `bucket` field with `bucket_capacity`
+  * stacks reserved
+  *
+  * @return
+  * This function does not return anything, since it
+  * only creates a new vector for the `bucket` field
+*/
+
+
+void Bucket::newVec() {
+  bucket = bucket_t();
+  bucket.reserve(bucket_capacity);
+}
+
+
+/**
+  * @internal
+  * The `Bucket::evaluateCapacity` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates with a switch case, if the capacity parameter is zero,
+  * calls `Bucket::assignDefaultCapacity` to assign a default capacity, in the default case,
+  * calls `Bucket::assignCapacity` with the `capacity` param
+  *
+  * @return
+  * This function does not return anything, since it
+  * only evaluates with a switch case the capacity
+*/
+
+
+void Bucket::evaluateCapacity(size_t capacity) {
+  switch (capacity) {
+    case 0:
+      assignDefaultCapacity();
+      break;
+    default:
+      assignCapacity(capacity);
+      break;
+  }
+}
+
+
+/**
+  * @internal
+  * The `Bucket::assignDefaultCapacity` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * assign a default capacity to the `bucket_capacity` field the capacity: 8
+  *
+  * @return
+  * This function does not return anything, since it
+  * only assign 8 to the `bucket_capacity` field
+*/
+
+
+void Bucket::assignDefaultCapacity() {
+  bucket_capacity = 8;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::assignCapacity` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * assign a capacity to the `bucket_capacity` field the suggested capacity
+  *
+  * @return
+  * This function does not return anything, since it
+  * only assign the suggested capacity to the `bucket_capacity` field
+*/
+
+
+void Bucket::assignCapacity(size_t capacity) {
+  bucket_capacity = capacity;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::deleteInternalObject` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * delete the suggested value using `delete value;` and `value = nullptr;`
+  *
+  * @return
+  * This function does not return anything, since it
+  * only delete the suggested value
+*/
+
+
+void Bucket::deleteInternalObject(bucket_subv_t value) {
+  delete value;
+  value = nullptr;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::deleteAllFields` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * reset all fields, cleaning the `bucket` field and reset to 0 the `bucket_capacity` field
+  *
+  * @return
+  * This function does not return anything, since it
+  * only delete all fields of the class
+*/
+
+
+void Bucket::deleteAllFields() {
+  bucket.clear();
+  dictionary_layers.clear();
+  numeric_layers.clear();
+  filters.clear();
+  sealed          = false;
+  sort_key        = no_key;
+  bucket_capacity = 0;
+  version_begin   = 0;
+  version_end     = live_version;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::isDictionaryCandidate` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates if every slot of `stack` is a string, a null astruct or nullptr,
+  * those are the only stacks that can be dictionary encoded
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool Bucket::isDictionaryCandidate(const stack_t& stack) {
+  for (auto astruct : stack) {
+    if (
+      !isSubValueNullptr(astruct) &&
+      astruct->kind() != Astruct::astruct_kind_t::string &&
+      astruct->kind() != Astruct::astruct_kind_t::null
+    ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::isNumericCandidate` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates if every value of `stack` is an integer, or if every value is a real
+  * number, skipping the null astructs and nullptr slots, the type found is
+  * assigned to `kind`
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right and the
+  * stack has at least one number
+*/
+
+
+bool Bucket::isNumericCandidate(const stack_t& stack, NumericLayer::numeric_kind_t& kind) {
+  bool has_integers = false;
+  bool has_reals    = false;
+
+  for (auto astruct : stack) {
+    if (isSubValueNullptr(astruct)) {
+      continue;
+    }
+
+    switch (astruct->kind()) {
+      case Astruct::astruct_kind_t::null:
+        break;
+      case Astruct::astruct_kind_t::integer:
+        has_integers = true;
+        break;
+      case Astruct::astruct_kind_t::real:
+        has_reals = true;
+        break;
+      default:
+        return false;
+    }
+  }
+
+  kind = has_reals
+    ? NumericLayer::numeric_kind_t::real
+    : NumericLayer::numeric_kind_t::integer;
+
+  return has_integers != has_reals;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::isAstructLess` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * The order of the rows of a sealed bucket, the astructs are ordered by type
+  * (booleans, numbers, strings, arrays, objects and nulls) and then by value,
+  * the integers and the real numbers are compared as numbers with NaN after
+  * every other number, and the empty slots go last with the null astructs
+  *
+  * @return
+  * Returns a boolean, true if `left` goes before `right`
+*/
+
+
+bool Bucket::isAstructLess(const Astruct* left, const Astruct* right) {
+  auto rank = [](const Astruct* astruct) {
+    if (astruct == nullptr) {
+      return 5;
+    }
+
+    switch (astruct->kind()) {
+      case Astruct::astruct_kind_t::boolean:
+        return 0;
+      case Astruct::astruct_kind_t::integer:
+      case Astruct::astruct_kind_t::real:
+        return 1;
+      case Astruct::astruct_kind_t::string:
+        return 2;
+      case Astruct::astruct_kind_t::array:
+        return 3;
+      case Astruct::astruct_kind_t::object:
+        return 4;
+      default:
+        return 5;
+    }
+  };
+
+  const int LEFT_RANK  = rank(left);
+  const int RIGHT_RANK = rank(right);
+
+  if (LEFT_RANK != RIGHT_RANK) {
+    return LEFT_RANK < RIGHT_RANK;
+  }
+
+  switch (LEFT_RANK) {
+    case 0:
+      return std::get<bool>(left->astruct) < std::get<bool>(right->astruct);
+
+    case 1:
+      if (
+        left->kind() == Astruct::astruct_kind_t::integer &&
+        right->kind() == Astruct::astruct_kind_t::integer
+      ) {
+        return std::get<int64_t>(left->astruct) < std::get<int64_t>(right->astruct);
+      }
+      return std::visit(
+        [](auto left_, auto right_) {
+          if constexpr (std::is_arithmetic_v<decltype(left_)> && std::is_arithmetic_v<decltype(right_)>) {
+            const double LEFT  = static_cast<double>(left_);
+            const double RIGHT = static_cast<double>(right_);
+
+            // NaN is not ordered by `<`, it goes after every other number so
+            // the order stays a strict weak ordering for the sort
+            if (std::isnan(LEFT) || std::isnan(RIGHT)) {
+              return !std::isnan(LEFT);
+            }
+            return LEFT < RIGHT;
+          }
+          return false;
+        },
+        left->astruct,
+        right->astruct
+      );
+
+    case 2:
+      return std::get<std::string>(left->astruct) < std::get<std::string>(right->astruct);
+
+    default:
+      return false;
+  }
+}
+
+
+/**
+  * @internal
+  * The `Bucket::alignStacks` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Fills the raw stacks with empty slots until all of them have the height
+  * of the bucket, so the astructs at the same height form a row
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the stacks
+*/
+
+
+void Bucket::alignStacks() {
+  const size_t HEIGHT = height();
+
+  for (size_t index = 0; index < bucket.size(); index++) {
+    if (!isDictionaryStack(index) && !isNumericStack(index)) {
+      bucket[index].resize(HEIGHT, nullptr);
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Bucket::removeEmptyRows` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Removes the rows whose slots are all empty, the stacks must be raw
+  * and aligned, the remaining rows keep their order
+  *
+  * @return
+  * This function does not return anything, since it
+  * only removes the empty rows
+*/
+
+
+void Bucket::removeEmptyRows() {
+  const size_t HEIGHT = height();
+  size_t       kept   = 0;
+
+  for (size_t row = 0; row < HEIGHT; row++) {
+    bool is_empty = true;
+
+    for (const auto& stack : bucket) {
+      if (!isSubValueNullptr(stack[row])) {
+        is_empty = false;
+        break;
+      }
+    }
+
+    if (is_empty) {
+      continue;
+    }
+
+    for (auto& stack : bucket) {
+      stack[kept] = stack[row];
+    }
+    kept++;
+  }
+
+  for (auto& stack : bucket) {
+    stack.resize(kept);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Bucket::sortRows` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Sorts the rows by the astructs of the stack `key_stack` with a stable sort,
+  * the stacks must be raw and aligned
+  *
+  * @return
+  * This function does not return anything, since it
+  * only sorts the rows
+*/
+
+
+void Bucket::sortRows(size_t key_stack) {
+  const size_t          HEIGHT = height();
+  const stack_t&        key    = bucket[key_stack];
+  std::vector<uint32_t> order(HEIGHT);
+
+  for (size_t row = 0; row < HEIGHT; row++) {
+    order[row] = static_cast<uint32_t>(row);
+  }
+
+  std::stable_sort(
+    order.begin(),
+    order.end(),
+    [&key](uint32_t left, uint32_t right) {
+      return isAstructLess(key[left], key[right]);
+    }
+  );
+
+  stack_t sorted(HEIGHT);
+
+  for (auto& stack : bucket) {
+    for (size_t row = 0; row < HEIGHT; row++) {
+      sorted[row] = stack[order[row]];
+    }
+    stack.swap(sorted);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Bucket::build` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * build the `bucket` field, if `value` is not nullptr or NULL its stacks
+  * are moved to the bucket, which takes the ownership of their astructs
+  *
+  * @return
+  * This function does not return anything, since it
+  * only build the `bucket` field
+*/
+
+
+void Bucket::build(
+  bucket_t* value,
+  size_t capacity
+) {
+  evaluateCapacity(capacity);
+  newVec();
+
+  if (isValueNullptr(value)) {
+    return;
+  }
+
+  for (auto& stack : *value) {
+    pushStack(std::move(stack));
+  }
+  value->clear();
+}
+
+
+/**
+  * @internal
+  * The `Bucket::destroy` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * destroy the `bucket` deleting its older versions and all `Astruct*` objects of
+  * every stack and reset the `bucket_capacity` field to 0
+  *
+  * @return
+  * This function does not return anything, since it
+  * only destroy the `bucket` field
+*/
+
+
+void Bucket::destroy() {
+  // The chain is deleted one version at a time, so it does not recurse
+  while (older_version != nullptr) {
+    Bucket* older = older_version;
+
+    older_version        = older->older_version;
+    older->older_version = nullptr;
+    delete older;
+  }
+
+  for (auto& stack : bucket) {
+    for (auto astruct : stack) {
+      if (!isSubValueNullptr(astruct)) {
+        deleteInternalObject(astruct);
+      }
+    }
+  }
+  for (auto layer : dictionary_layers) {
+    delete layer;
+  }
+  for (auto layer : numeric_layers) {
+    delete layer;
+  }
+  deleteAllFields();
+}
+
+
+/**
+  * @internal
+  * The `Bucket::pushStack` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * push a new 3D vertical stack to the `bucket` field, resizing the
+  * capacity if there is no disponible capacity
+  *
+  * @return
+  * This function does not return anything, since it
+  * only push the stack to the `bucket` field
+*/
+
+
+void Bucket::pushStack(stack_t stack) {
+  if (!hasDisponibleCapacity()) {
+    resizeVec();
+  }
+  bucket.push_back(std::move(stack));
+}
+
+
+/**
+  * @internal
+  * The `Bucket::pushAstruct` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * push `value` to the top of the stack `stack_index`, the missing stacks
+  * until `stack_index` are created empty
+  *
+  * @return
+  * Returns false if the bucket is sealed, in that case the caller keeps
+  * the ownership of `value`
+*/
+
+
+bool Bucket::pushAstruct(size_t stack_index, bucket_subv_t value) {
+  if (sealed) {
+    return false;
+  }
+
+  while (bucket.size() <= stack_index) {
+    pushStack(stack_t());
+  }
+
+  if (isDictionaryStack(stack_index)) {
+    DictionaryLayer* layer = dictionary_layers[stack_index];
+
+    if (isSubValueNullptr(value) || value->kind() == Astruct::astruct_kind_t::null) {
+      layer->pushCode(isSubValueNullptr(value) ? Dictionary::null_code : Dictionary::json_null_code);
+      delete value;
+      return true;
+    }
+    if (value->kind() == Astruct::astruct_kind_t::string) {
+      layer->pushCode(layer->dictionary->encode(std::get<std::string>(value->astruct)));
+      delete value;
+      return true;
+    }
+
+    // The value is not a string, so the stack can not be encoded anymore
+    decodeDictionaryStack(stack_index);
+  }
+
+  // The blocks are immutable, so the stack is decompressed before writing to it
+  decompressNumericStack(stack_index);
+
+  bucket[stack_index].push_back(value);
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::stackCount` method is internal of the `Bucket` class
+  *
+  * @return
+  * Returns the number of 3D vertical stacks of the bucket
+*/
+
+
+size_t Bucket::stackCount() const {
+  return bucket.size();
+}
+
+
+/**
+  * @internal
+  * The `Bucket::height` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Takes the height of the highest stack, that is the number of rows of the bucket
+  *
+  * @return
+  * Returns the height of the highest stack
+*/
+
+
+size_t Bucket::height() const {
+  size_t height_ = 0;
+
+  for (size_t index = 0; index < bucket.size(); index++) {
+    height_ = std::max(height_, stackHeight(index));
+  }
+  return height_;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::stackHeight` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Takes the height of a stack, if the stack is dictionary encoded its height
+  * is the number of codes, if it is compressed its height is the size of the layer
+  *
+  * @return
+  * Returns the height of the stack `stack_index`
+*/
+
+
+size_t Bucket::stackHeight(size_t stack_index) const {
+  if (isDictionaryStack(stack_index)) {
+    return dictionary_layers[stack_index]->codes.size();
+  }
+  if (isNumericStack(stack_index)) {
+    return numeric_layers[stack_index]->size;
+  }
+  return bucket[stack_index].size();
+}
+
+
+/**
+  * @internal
+  * The `Bucket::isDictionaryStack` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates if the stack `stack_index` is dictionary encoded
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool Bucket::isDictionaryStack(size_t stack_index) const {
+  return
+    stack_index < dictionary_layers.size() &&
+    dictionary_layers[stack_index] != nullptr;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::encodeDictionaryStack` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Replaces the astructs of the stack `stack_index` by codes of `dictionary`,
+  * if `dictionary` is nullptr or NULL the stack creates its own dictionary.
+  * The empty slots are encoded as `Dictionary::null_code` and the null astructs
+  * as `Dictionary::json_null_code`, so both are decoded as they were
+  *
+  * @return
+  * Returns false if the stack has astructs that are not strings, in that case
+  * the stack is not changed
+*/
+
+
+bool Bucket::encodeDictionaryStack(size_t stack_index, Dictionary* dictionary) {
+  if (stack_index >= bucket.size()) {
+    return false;
+  }
+  if (isDictionaryStack(stack_index)) {
+    return true;
+  }
+  if (isNumericStack(stack_index)) {
+    return false;
+  }
+
+  stack_t& stack = bucket[stack_index];
+
+  if (!isDictionaryCandidate(stack)) {
+    return false;
+  }
+
+  DictionaryLayer* layer = new DictionaryLayer(dictionary);
+  layer->codes.reserve(stack.size());
+
+  for (auto astruct : stack) {
+    if (isSubValueNullptr(astruct)) {
+      layer->codes.push_back(Dictionary::null_code);
+    } else if (astruct->kind() == Astruct::astruct_kind_t::null) {
+      layer->codes.push_back(Dictionary::json_null_code);
+    } else {
+      layer->codes.push_back(layer->dictionary->encode(std::get<std::string>(astruct->astruct)));
+    }
+    delete astruct;
+  }
+
+  // The heap strings are freed, only the codes are kept
+  stack_t().swap(stack);
+
+  if (dictionary_layers.size() < bucket.size()) {
+    dictionary_layers.resize(bucket.size(), nullptr);
+  }
+  dictionary_layers[stack_index] = layer;
+
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::decodeDictionaryStack` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Replaces the codes of the stack `stack_index` by string astructs again,
+  * the null codes are decoded as empty slots and the JSON null codes as null astructs
+  *
+  * @return
+  * This function does not return anything, since it
+  * only decodes the stack
+*/
+
+
+void Bucket::decodeDictionaryStack(size_t stack_index) {
+  if (!isDictionaryStack(stack_index)) {
+    return;
+  }
+
+  DictionaryLayer* layer = dictionary_layers[stack_index];
+  stack_t&         stack = bucket[stack_index];
+
+  stack.reserve(stack.size() + layer->codes.size());
+
+  for (auto code : layer->codes) {
+    if (code == Dictionary::null_code) {
+      stack.push_back(nullptr);
+    } else if (code == Dictionary::json_null_code) {
+      stack.push_back(new Astruct(nullptr));
+    } else {
+      stack.push_back(new Astruct(std::string(layer->dictionary->decode(code))));
+    }
+  }
+
+  delete layer;
+  dictionary_layers[stack_index] = nullptr;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::isNumericStack` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates if the stack `stack_index` is compressed in a numeric layer
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool Bucket::isNumericStack(size_t stack_index) const {
+  return
+    stack_index < numeric_layers.size() &&
+    numeric_layers[stack_index] != nullptr;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::compressNumericStack` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Replaces the astructs of the stack `stack_index` by a numeric layer, every block
+  * of the layer chooses its own encoding. The null astructs and the empty slots are
+  * both marked as invalid rows in the validity bitmap of the layer
+  *
+  * @return
+  * Returns false if the stack is not only integers or only real numbers, in that
+  * case the stack is not changed
+*/
+
+
+bool Bucket::compressNumericStack(size_t stack_index) {
+  if (stack_index >= bucket.size() || isDictionaryStack(stack_index)) {
+    return false;
+  }
+  if (isNumericStack(stack_index)) {
+    return true;
+  }
+
+  stack_t&                     stack = bucket[stack_index];
+  NumericLayer::numeric_kind_t kind;
+
+  if (!isNumericCandidate(stack, kind)) {
+    return false;
+  }
+
+  const size_t          SIZE = stack.size();
+  std::vector<uint64_t> validity((SIZE + 63) / 64, 0);
+  bool                  has_nulls = false;
+
+  for (size_t row = 0; row < SIZE; row++) {
+    Astruct* astruct = stack[row];
+
+    if (isSubValueNullptr(astruct) || astruct->kind() == Astruct::astruct_kind_t::null) {
+      has_nulls = true;
+    } else {
+      validity[row >> 6] |= uint64_t(1) << (row & 63);
+    }
+  }
+
+  NumericLayer* layer = new NumericLayer();
+
+  if (kind == NumericLayer::numeric_kind_t::integer) {
+    std::vector<int64_t> values(SIZE, 0);
+
+    for (size_t row = 0; row < SIZE; row++) {
+      if ((validity[row >> 6] >> (row & 63)) & 1) {
+        values[row] = std::get<int64_t>(stack[row]->astruct);
+      }
+    }
+    layer->compress(values.data(), SIZE, has_nulls ? validity.data() : nullptr);
+  } else {
+    std::vector<double> values(SIZE, 0);
+
+    for (size_t row = 0; row < SIZE; row++) {
+      if ((validity[row >> 6] >> (row & 63)) & 1) {
+        values[row] = std::get<double>(stack[row]->astruct);
+      }
+    }
+    layer->compress(values.data(), SIZE, has_nulls ? validity.data() : nullptr);
+  }
+
+  for (auto astruct : stack) {
+    delete astruct;
+  }
+
+  // The astructs are freed, only the blocks are kept
+  stack_t().swap(stack);
+
+  if (numeric_layers.size() < bucket.size()) {
+    numeric_layers.resize(bucket.size(), nullptr);
+  }
+  numeric_layers[stack_index] = layer;
+
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::decompressNumericStack` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Replaces the numeric layer of the stack `stack_index` by astructs again,
+  * the invalid rows are decoded as empty slots
+  *
+  * @return
+  * This function does not return anything, since it
+  * only decompresses the stack
+*/
+
+
+void Bucket::decompressNumericStack(size_t stack_index) {
+  if (!isNumericStack(stack_index)) {
+    return;
+  }
+
+  NumericLayer* layer = numeric_layers[stack_index];
+  stack_t&      stack = bucket[stack_index];
+  size_t        row   = 0;
+
+  stack.reserve(stack.size() + layer->size);
+
+  if (layer->kind == NumericLayer::numeric_kind_t::integer) {
+    int64_t values[NumericLayer::block_size];
+
+    for (size_t block = 0; block < layer->blockCount(); block++) {
+      const size_t COUNT = layer->decodeBlock(block, values);
+
+      for (size_t index = 0; index < COUNT; index++, row++) {
+        stack.push_back(layer->isValid(row) ? new Astruct(values[index]) : nullptr);
+      }
+    }
+  } else {
+    double values[NumericLayer::block_size];
+
+    for (size_t block = 0; block < layer->blockCount(); block++) {
+      const size_t COUNT = layer->decodeBlock(block, values);
+
+      for (size_t index = 0; index < COUNT; index++, row++) {
+        stack.push_back(layer->isValid(row) ? new Astruct(values[index]) : nullptr);
+      }
+    }
+  }
+
+  delete layer;
+  numeric_layers[stack_index] = nullptr;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::seal` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Turns the bucket into a sealed and immutable bucket optimized for reads: the rows
+  * without values are removed, the rows are sorted by the stack `key_stack` if it is
+  * not `no_key`, the numeric stacks are compressed, the string stacks are dictionary
+  * encoded with `dictionary` (or their own dictionary if it is nullptr or NULL) and
+  * the filters of the stacks are built
+  *
+  * @return
+  * This function does not return anything, since it
+  * only seals the bucket
+*/
+
+
+void Bucket::seal(size_t key_stack, Dictionary* dictionary) {
+  if (sealed) {
+    return;
+  }
+
+  for (size_t index = 0; index < bucket.size(); index++) {
+    decodeDictionaryStack(index);
+    decompressNumericStack(index);
+  }
+
+  alignStacks();
+  removeEmptyRows();
+
+  if (key_stack < bucket.size()) {
+    sortRows(key_stack);
+    sort_key = key_stack;
+  }
+
+  for (size_t index = 0; index < bucket.size(); index++) {
+    if (bucket[index].empty() || compressNumericStack(index)) {
+      continue;
+    }
+    if (!encodeDictionaryStack(index, dictionary)) {
+      bucket[index].shrink_to_fit();
+    }
+  }
+
+  buildFilters();
+  sealed = true;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::unseal` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Turns a sealed bucket into a mutable bucket again, decoding all of its stacks
+  * and dropping its filters
+  *
+  * @return
+  * This function does not return anything, since it
+  * only unseals the bucket
+*/
+
+
+void Bucket::unseal() {
+  for (size_t index = 0; index < bucket.size(); index++) {
+    decodeDictionaryStack(index);
+    decompressNumericStack(index);
+  }
+
+  filters.clear();
+  sealed   = false;
+  sort_key = no_key;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::buildFilters` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Builds the filter of every stack, the zone map of a compressed stack is taken
+  * from the statistics of its blocks and the bitmap of a dictionary encoded stack
+  * marks the codes of its strings. The raw stacks have no filter
+  *
+  * @return
+  * This function does not return anything, since it
+  * only builds the `filters` field
+*/
+
+
+void Bucket::buildFilters() {
+  filters.assign(bucket.size(), stack_filter_t());
+
+  for (size_t index = 0; index < bucket.size(); index++) {
+    stack_filter_t& filter = filters[index];
+
+    if (isNumericStack(index)) {
+      for (const auto& block : numeric_layers[index]->blocks) {
+        if (!block.has_values) {
+          continue;
+        }
+
+        filter.minimum    = filter.has_values ? std::min(filter.minimum, block.real_minimum) : block.real_minimum;
+        filter.maximum    = filter.has_values ? std::max(filter.maximum, block.real_maximum) : block.real_maximum;
+        filter.has_values = true;
+      }
+    } else if (isDictionaryStack(index)) {
+      const DictionaryLayer* layer = dictionary_layers[index];
+
+      filter.codes.assign((layer->dictionary->size() + 63) / 64, 0);
+
+      for (auto code : layer->codes) {
+        if (Dictionary::isString(code)) {
+          filter.codes[code >> 6] |= uint64_t(1) << (code & 63);
+          filter.has_values = true;
+        }
+      }
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Bucket::clone` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Copies the stacks, the layers and the filters of the bucket, the astructs are
+  * cloned and a dictionary owned by a layer is copied, a shared dictionary stays
+  * shared. The versions are not copied
+  *
+  * @return
+  * Returns the new bucket, the caller takes its ownership
+*/
+
+
+Bucket* Bucket::clone() const {
+  Bucket* copy = new Bucket();
+
+  copy->bucket_capacity = bucket_capacity;
+  copy->bucket.reserve(bucket.size());
+
+  for (const auto& stack : bucket) {
+    stack_t& target = copy->bucket.emplace_back();
+    target.reserve(stack.size());
+
+    for (auto astruct : stack) {
+      target.push_back(astruct == nullptr ? nullptr : astruct->clone());
+    }
+  }
+
+  copy->dictionary_layers.assign(dictionary_layers.size(), nullptr);
+
+  for (size_t index = 0; index < dictionary_layers.size(); index++) {
+    const DictionaryLayer* layer = dictionary_layers[index];
+
+    if (layer == nullptr) {
+      continue;
+    }
+
+    DictionaryLayer* target = new DictionaryLayer(
+      layer->owns_dictionary ? new Dictionary(*layer->dictionary) : layer->dictionary
+    );
+    target->owns_dictionary = layer->owns_dictionary;
+    target->codes           = layer->codes;
+
+    copy->dictionary_layers[index] = target;
+  }
+
+  copy->numeric_layers.assign(numeric_layers.size(), nullptr);
+
+  for (size_t index = 0; index < numeric_layers.size(); index++) {
+    if (numeric_layers[index] != nullptr) {
+      copy->numeric_layers[index] = new NumericLayer(*numeric_layers[index]);
+    }
+  }
+
+  copy->sealed   = sealed;
+  copy->sort_key = sort_key;
+  copy->filters  = filters;
+
+  return copy;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::appendRows` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Moves the rows of `other` after the rows of the bucket, both buckets are unsealed
+  * first and `other` is left empty, it is used to merge small buckets
+  *
+  * @return
+  * This function does not return anything, since it
+  * only moves the rows
+*/
+
+
+void Bucket::appendRows(Bucket* other) {
+  unseal();
+  other->unseal();
+  alignStacks();
+
+  const size_t HEIGHT = height();
+
+  for (size_t index = 0; index < other->bucket.size(); index++) {
+    while (bucket.size() <= index) {
+      pushStack(stack_t(HEIGHT, nullptr));
+    }
+
+    stack_t& stack = bucket[index];
+    stack.insert(stack.end(), other->bucket[index].begin(), other->bucket[index].end());
+  }
+
+  other->deleteAllFields();
+  alignStacks();
+}
+
+
+/**
+  * @internal
+  * The `Bucket::isLive` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates if the bucket is the current version of its slot, a bucket removed
+  * or replaced by a transaction is only read by the snapshots that still see it
+  *
+  * @return
+  * Returns a boolean, true if the `version_end` field is `live_version`
+*/
+
+
+bool Bucket::isLive() const {
+  return version_end == live_version;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::mayContain` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates with the filter of the stack `stack_index` if it may have the
+  * string `value`, only the dictionary encoded and the compressed stacks of
+  * a sealed bucket can be skipped
+  *
+  * @return
+  * Returns a boolean, false if the stack surely does not have `value`
+*/
+
+
+bool Bucket::mayContain(size_t stack_index, std::string_view value) const {
+  if (!sealed || stack_index >= filters.size()) {
+    return true;
+  }
+  if (isNumericStack(stack_index)) {
+    return false;
+  }
+  if (!isDictionaryStack(stack_index)) {
+    return true;
+  }
+
+  const stack_filter_t&   filter = filters[stack_index];
+  const Dictionary::code_t CODE  = dictionary_layers[stack_index]->dictionary->find(value);
+
+  // The codes added to a shared dictionary after the sealing are not in the bucket
+  return
+    CODE != Dictionary::null_code &&
+    (CODE >> 6) < filter.codes.size() &&
+    ((filter.codes[CODE >> 6] >> (CODE & 63)) & 1) != 0;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::mayContainRange` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Evaluates with the zone map of the stack `stack_index` if it may have numbers
+  * between `minimum` and `maximum`, only the dictionary encoded and the compressed
+  * stacks of a sealed bucket can be skipped
+  *
+  * @return
+  * Returns a boolean, false if the stack surely does not have numbers in the range
+*/
+
+
+bool Bucket::mayContainRange(size_t stack_index, double minimum, double maximum) const {
+  if (!sealed || stack_index >= filters.size()) {
+    return true;
+  }
+  if (isDictionaryStack(stack_index)) {
+    return false;
+  }
+  if (!isNumericStack(stack_index)) {
+    return true;
+  }
+
+  const stack_filter_t& filter = filters[stack_index];
+
+  return
+    filter.has_values &&
+    minimum <= filter.maximum &&
+    maximum >= filter.minimum;
+}
+
+
+/**
+  * @internal
+  * The `Bucket::filterEquals` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * Appends to `rows` the rows of the stack `stack_index` whose string is `value`,
+  * dictionary encoded stacks compare integer codes, the rest compare strings
+  *
+  * @return
+  * This function does not return anything, the matches are appended to `rows`
+*/
+
+
+void Bucket::filterEquals(
+  size_t stack_index,
+  std::string_view value,
+  std::vector<uint32_t>& rows
+) const {
+  if (stack_index >= bucket.size() || !mayContain(stack_index, value)) {
+    return;
+  }
+
+  if (isDictionaryStack(stack_index)) {
+    dictionary_layers[stack_index]->filterEquals(value, rows);
+    return;
+  }
+
+  const stack_t& stack = bucket[stack_index];
+
+  for (size_t row = 0; row < stack.size(); row++) {
+    const Astruct* astruct = stack[row];
+
+    if (
+      astruct != nullptr &&
+      astruct->kind() == Astruct::astruct_kind_t::string &&
+      std::get<std::string>(astruct->astruct) == value
+    ) {
+      rows.push_back(static_cast<uint32_t>(row));
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Bucket::Bucket` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * The constructor of the `Bucket` class
+  *
+  * @details
+  * It handles the capacity assignment and moves the stacks of `bucket_v`
+  * to the `bucket` field if it is not nullptr or NULL
+*/
+
+
+Bucket::Bucket(
+  bucket_t* bucket_v,
+  size_t capacity
+) {
+  build(bucket_v, capacity);
+}
+
+
+/**
+  * @internal
+  * The `Bucket::~Bucket` method is internal of the `Bucket` class
+  *
+  * @brief Description
+  * The destructor of the `Bucket` class
+  *
+  * @details
+  * Deletes every astruct of every stack, skipping nullptr or NULL slots
+*/
+
+
+Bucket::~Bucket() noexcept {
+  destroy();
+}
@@ -0,0 +1,172 @@
+/**
+  * @file bucket.hpp
+  * This is the documentation of the `bucket.hpp` file
+  *
+  * @brief Description
+  * Implementation of the Bucket class, its constructor and destructor, and its undefined methods
+  * in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Nativite engine imports
+#include "../Astruct/astruct.hpp"
+#include "../Dictionary/dictionary.hpp"
+#include "../Compression/compression.hpp"
+
+
+/**
+ * @internal
+ * The Bucket class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * The equivalent of the dendrites, a container of 3D vertical stacks of astructs,
+ * each vertical stack is also called a layer, the astructs at the same height
+ * of every layer form a row
+ *
+ * @details
+ * A stack of strings can be dictionary encoded, then the `Astruct*` of the stack
+ * are replaced by small integer codes in the `dictionary_layers` field and the
+ * equality filters compare codes instead of strings. A stack of integers or of real
+ * numbers can be compressed, then its values are kept in blocks of the `numeric_layers`
+ * field, see the NumericLayer class.
+ *
+ * A bucket starts mutable and optimized for appends, once it is full it is sealed:
+ * the rows without values are removed, the rows are sorted by a key stack, every stack
+ * is compressed or dictionary encoded and a filter is built for every stack. A sealed
+ * bucket is immutable, it has to be unsealed before appending to it again.
+ *
+ * The buckets written through the Mvcc class are versions, a writer publishes a
+ * new bucket and links the replaced one in `older_version`, the snapshots read
+ * the version whose timestamps contain theirs. A bucket owns its older versions.
+*/
+
+
+class Bucket {
+  // Types
+  public:
+    // The subvalue type of a vertical stack
+    using bucket_subv_t = Astruct*;
+
+    // A 3D vertical stack or layer of astructs
+    using stack_t  = std::vector<bucket_subv_t>;
+
+    // The `bucket` field type
+    using bucket_t = std::vector<stack_t>;
+
+    // The key stack of a bucket whose rows are not sorted
+    static constexpr size_t no_key = SIZE_MAX;
+
+    // The end of the version of a bucket that was not replaced or removed
+    static constexpr uint64_t live_version = UINT64_MAX;
+
+    // The filter of a stack of a sealed bucket, a zone map of the numbers and a
+    // bitmap of the codes that appear if the stack is dictionary encoded
+    struct stack_filter_t {
+      bool                  has_values = false;
+      double                minimum    = 0;
+      double                maximum    = 0;
+      std::vector<uint64_t> codes;
+    };
+
+  protected:
+    // Internal functions of the class
+    bool isValueNullptr(bucket_t* value);
+    bool isSubValueNullptr(bucket_subv_t value);
+
+    bool hasDisponibleCapacity();
+    void resizeVec();
+
+    void newVec();
+
+    void evaluateCapacity(size_t capacity);
+
+    void assignDefaultCapacity();
+    void assignCapacity(size_t capacity);
+
+    void deleteInternalObject(bucket_subv_t value);
+
+    void deleteAllFields();
+
+    bool isDictionaryCandidate(const stack_t& stack);
+    bool isNumericCandidate(const stack_t& stack, NumericLayer::numeric_kind_t& kind);
+
+    static bool isAstructLess(const Astruct* left, const Astruct* right);
+
+    void alignStacks();
+    void removeEmptyRows();
+    void sortRows(size_t key_stack);
+
+    // Abstract constructor
+    void build(
+      bucket_t* value,
+      size_t capacity
+    );
+
+    // Abstract destructor
+    void destroy();
+
+  public:
+    size_t   bucket_capacity = 0; /**< The capacity of stacks of the `bucket` field */
+    bucket_t bucket;              /**< The 3D vertical stacks of the bucket */
+
+    std::vector<DictionaryLayer*> dictionary_layers; /**< The dictionary encoded stacks, the slot
+                                                          of a stack that is not encoded is nullptr */
+    std::vector<NumericLayer*>    numeric_layers;    /**< The compressed numeric stacks, the slot
+                                                          of a stack that is not compressed is nullptr */
+
+    bool                        sealed   = false;  /**< Indicates if the bucket is sealed and immutable */
+    size_t                      sort_key = no_key; /**< The stack that sorts the rows of a sealed bucket */
+    std::vector<stack_filter_t> filters;           /**< The filters of the stacks of a sealed bucket */
+
+    uint64_t version_begin = 0;            /**< The commit that published this version */
+    uint64_t version_end   = live_version; /**< The commit that replaced or removed it */
+    Bucket*  older_version = nullptr;      /**< The replaced version, kept for the snapshots */
+
+    void pushStack(stack_t stack);
+    bool pushAstruct(size_t stack_index, bucket_subv_t value);
+
+    size_t stackCount() const;
+    size_t stackHeight(size_t stack_index) const;
+    size_t height() const;
+
+    bool isDictionaryStack(size_t stack_index) const;
+    bool encodeDictionaryStack(size_t stack_index, Dictionary* dictionary = nullptr);
+    void decodeDictionaryStack(size_t stack_index);
+
+    bool isNumericStack(size_t stack_index) const;
+    bool compressNumericStack(size_t stack_index);
+    void decompressNumericStack(size_t stack_index);
+
+    void seal(size_t key_stack = no_key, Dictionary* dictionary = nullptr);
+    void unseal();
+    void buildFilters();
+    void appendRows(Bucket* other);
+
+    Bucket* clone() const;
+    bool    isLive() const;
+
+    bool mayContain(size_t stack_index, std::string_view value) const;
+    bool mayContainRange(size_t stack_index, double minimum, double maximum) const;
+
+    void filterEquals(
+      size_t stack_index,
+      std::string_view value,
+      std::vector<uint32_t>& rows
+    ) const;
+
+    Bucket(bucket_t* bucket_v, size_t capacity);
+    Bucket() = default;
+
+    ~Bucket() noexcept;
+};
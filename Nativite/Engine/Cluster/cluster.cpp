@@ -12,11 +12,19 @@
 */
 
 // C++ libraries imports
+#include <algorithm>
 #include <iostream>
-#include <cmath>
+#include <iterator>
 
 // Nativite engine imports
 #include "cluster.hpp"
+#include "../Printer/printer.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Dictionary/dictionary.hpp"
+#include "../Epoch/epoch.hpp"
+#include "../ShardedTerminal/sharded_terminal.hpp"
+#include "../AppendBuffer/append_buffer.hpp"
+#include "../Mvcc/mvcc.hpp"
 
 /**
   * @internal
@@ -61,7 +69,7 @@ bool Cluster::isSubValueNullptr(cluster_subv_t value) {
   * The `Cluster::hasDisponibleCapacity` method is internal of the `Cluster` class
   * 
   * @brief Description
-  * Evaluates if `cluster.size()` is less than the capacity field
+  * Evaluates if the used slots of the `cluster` field are less than the capacity field
   * 
   * @return
   * Returns a boolean, true if value if the previous expresion is right
@@ -69,7 +77,7 @@ bool Cluster::isSubValueNullptr(cluster_subv_t value) {
 
 
 bool Cluster::hasDisponibleCapacity() {
-  return cluster.size() < cluster_capacity;
+  return bucket_slots.used < cluster_capacity;
 }
 
 
@@ -90,6 +98,7 @@ bool Cluster::hasDisponibleCapacity() {
 void Cluster::resizeVec() {
   cluster_capacity += 15;
   cluster.resize(cluster_capacity);
+  bucket_slots.resize(cluster.size());
 }
 
 
@@ -107,7 +116,10 @@ void Cluster::resizeVec() {
 
 
 void Cluster::newVec() {
-  cluster = std::vector<Bucket*>(cluster_capacity);
+  cluster.clear();
+  cluster.resize(cluster_capacity);
+  bucket_slots.clear();
+  bucket_slots.resize(cluster.size());
 }
 
 
@@ -167,7 +179,8 @@ void Cluster::evaluateNullptrInAssignation(cluster_subv_t value) {
   * 
   * @brief Description
   * push to `cluster` the `value`, this function is
-  * used to push the value if `value` is not nullptr or NULL
+  * used to push the value if `value` is not nullptr or NULL,
+  * the first empty slot is reused before growing the vector
   * 
   * @return
   * This function does not return anything, since it
@@ -176,7 +189,7 @@ void Cluster::evaluateNullptrInAssignation(cluster_subv_t value) {
 
 
 void Cluster::pushObjectValue(cluster_subv_t value) {
-  cluster.push_back(value);
+  placeBucket(value);
 }
 
 
@@ -245,16 +258,17 @@ void Cluster::defaultNullptrVec() {
   * The `Cluster::deleteInternalObject` method is internal of the `Cluster` class
   * 
   * @brief Description
-  * delete the suggested value using `delete value;` and `value = nullptr;`
+  * retire the suggested value to the global `EpochManager`, it is deleted once
+  * no reader that could reach it is running
   * 
   * @return
   * This function does not return anything, since it
-  * only delete the suggested value
+  * only retire the suggested value
 */
 
 
 void Cluster::deleteInternalObject(cluster_subv_t value) {
-  delete value;
+  EpochManager::global().retire(value);
   value = nullptr;
 }
 
@@ -273,45 +287,11 @@ void Cluster::deleteInternalObject(cluster_subv_t value) {
 
 void Cluster::deleteAllFields() {
   cluster.clear();
+  bucket_slots.clear();
   cluster_capacity = 0;
 }
 
 
-/**
-  * @internal
-  * The `Cluster::pushClusterObjectToBrain` method is internal of the `Cluster` class
-  * 
-  * @brief Description
-  * add to the `Brain` class the actual `Cluster` object
-  * 
-  * @return
-  * This function does not return anything, since it
-  * only add to the `Brain` class the `Cluster` object
-*/
-
-
-void Cluster::pushClusterObjectToBrain() {
-  brain.push_back(this);
-}
-
-
-/**
-  * @internal
-  * The `Cluster::newTerminal` method is internal of the `Cluster` class
-  * @brief Description
-  * create a new `Terminal` object that is a cache for the most consulted elements in queries
-  * 
-  * @return
-  * This function does not return anything, since it
-  * only create a new `Terminal` object
-*/
-
-
-void Cluster::newTerminal() {
-  terminal = new Terminal(nullptr);
-}
-
-
 /**
   * @internal
   * The `Cluster::abstractBuild` method is internal of the `Cluster` class
@@ -365,34 +345,21 @@ void Cluster::abstractBuild(
   * 
   * @brief Description
   * build the `cluster` field according to different conditions, this function
-  * uses the function `Cluster::abstractBuild` To avoid repeating the logic twice,
-  * the cluster type object is also added to the Brain.
+  * uses the function `Cluster::abstractBuild` To avoid repeating the logic twice.
+  * The cluster is not pushed to its own `Brain` part, since the `Brain` part
+  * deletes its clusters and the cluster would be deleted twice
   * 
   * @return
   * This function does not return anything, since it
-  * only build the `cluster` field and add to the `Brain` the
-  * `Cluster` object
+  * only build the `cluster` field
 */
 
 
 void Cluster::build(
   cluster_t* value,
-  size_t capacity,
-  bool add
+  size_t capacity
 ) {
-  if (
-    add == true
-  ) {
-    abstractBuild(value, capacity);
-    if (brain.size() < brain_capacity) {
-      pushClusterObjectToBrain();
-    } else {
-      resizeVec();
-      pushClusterObjectToBrain();
-    }
-  } else {
-    abstractBuild(value, capacity);
-  }
+  abstractBuild(value, capacity);
 }
 
 
@@ -412,6 +379,15 @@ void Cluster::build(
 
 
 void Cluster::destroy() {
+  // The rows of the append buffer become a bucket, so they are deleted with the
+  // other buckets, there are no producers left
+  if (AppendBuffer* buffer = append_buffer.exchange(nullptr); buffer != nullptr) {
+    if (buffer->close() > 0) {
+      placeBucket(buffer->toBucket());
+    }
+    EpochManager::global().retire(buffer);
+  }
+
   for (
     auto bucket : cluster
   ) {
@@ -419,179 +395,691 @@ void Cluster::destroy() {
       deleteInternalObject(bucket);
     }
   }
+
+  // The buckets only borrow the dictionary, so it is retired after them
+  if (dictionary != nullptr) {
+    EpochManager::global().retire(dictionary);
+    dictionary = nullptr;
+  }
+
+  // The readers of the sharded terminal and of the append buffer do not lock the cluster
+  EpochManager::global().retire(sharded_terminal);
+  sharded_terminal = nullptr;
+
   deleteAllFields();
+
+  // Without readers the buckets are deleted at once
+  EpochManager::global().collect();
 }
 
 
 /**
   * @internal
-  * The `Cluster::Cluster` method is internal of the `Cluster` class
+  * The `Cluster::shardTerminal` method is internal of the `Cluster` class
   *
-  * The constructor of the `Cluster` class
+  * @brief Description
+  * Creates the `sharded_terminal` field the first time, with `terminal_capacity`
+  * slots split in `shard_count` shards, see the ShardedTerminal class. It is
+  * used when many threads read the same hot cluster
   *
-  * It handles several things, such as checking if the value to be assigned is
-  * nullptr or NULL, it also handles capacity assignment, creating a new vector
-  * for `cluster`, resizing the `cluster` vector.
+  * @return
+  * Returns the sharded terminal of the cluster
 */
 
 
-Cluster::Cluster(
-  cluster_t* cluster_v,
-  size_t capacity
-) : 
-  Brain(),
-  Terminal() {
-  build(cluster_v, capacity, true);
+ShardedTerminal* Cluster::shardTerminal(size_t shard_count) {
+  auto lock = lockBuckets();
+
+  if (sharded_terminal == nullptr) {
+    sharded_terminal = new ShardedTerminal(cluster.lean->terminal_capacity, shard_count);
+  }
+  return sharded_terminal;
 }
 
 
 /**
   * @internal
-  * The `Cluster::~Cluster` method is internal of the `Cluster` class
+  * The `Cluster::terminalCapacity` method is internal of the `Cluster` class
   *
-  * The destructor of the `Cluster` class
+  * @return
+  * Returns the slots of the terminal of the cluster
+*/
+
+
+size_t Cluster::terminalCapacity() const {
+  return cluster.lean->terminal_capacity;
+}
+
+
+/**
+  * @internal
+  * The `Cluster::automaticTerminal` method is internal of the `Cluster` class
   *
-  * It handles how to check if a value is nullptr or NULL when deleting one by one
-  * This prevents freeing memory to nullptr or NULL pointers although it is safe,
-  * it is done to avoid unnecessary memory frees
+  * @return
+  * Returns true if the terminal of the cluster is handled automatically
 */
 
 
-Cluster::~Cluster() noexcept {
-  destroy();
+bool Cluster::automaticTerminal() const {
+  return cluster.lean->automaticTerminalManagment;
 }
 
-//////////////////////////////////
-// ////////// OPERATORS //////////
-//////////////////////////////////
 
-// operator<< functions
+/**
+  * @internal
+  * The `Cluster::configureTerminal` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Gives `terminal_capacity_v` slots to the terminal of the cluster, which moves
+  * the lean allocation if the capacity changes, see `LeanCluster::resizeTerminal`.
+  * The lock of the cluster is held exclusively
+  *
+  * @return
+  * This function does not return anything, since it
+  * only configures the terminal
+*/
+
+
+void Cluster::configureTerminal(size_t terminal_capacity_v, bool automatic) {
+  auto lock = lockBuckets();
+
+  cluster.lean = LeanCluster::resizeTerminal(cluster.lean, terminal_capacity_v);
+  cluster.lean->automaticTerminalManagment = automatic;
+}
 
 
 /**
-   * @internal
-  * The `Cluster::printSlot` method is internal of the `Cluster` class
+  * @internal
+  * The `Cluster::enableAppends` method is internal of the `Cluster` class
   *
   * @brief Description
-  * Prints an empty slot by printing 'empty' to the console or if the value is not nullptr or NULL
-  * prints the respective value
+  * Creates the `append_buffer` field the first time, with rows of `width` stacks,
+  * after that `Cluster::appendRow` appends without locks
   *
   * @return
-  * This function does not return anything, it just prints to the console with std::ostream&
+  * Returns the append buffer of the cluster
 */
 
 
-void Cluster::printSlot(
-  std::ostream& ostream,
-  cluster_subv_t bucket_
-) {
-  if (
-    isSubValueNullptr(
-      bucket_
-    )
-  ) {
-    ostream << "empty";
+AppendBuffer* Cluster::enableAppends(size_t width) {
+  auto lock = lockBuckets();
+
+  AppendBuffer* buffer = append_buffer.load(std::memory_order_acquire);
+
+  if (buffer == nullptr) {
+    buffer = new AppendBuffer(width);
+    append_buffer.store(buffer, std::memory_order_release);
   }
+  return buffer;
 }
 
 
 /**
-   * @internal
-  * The `Cluster::takeSquareRootOfClusterSize` method is internal of the `Cluster` class
+  * @internal
+  * The `Cluster::appendRow` method is internal of the `Cluster` class
   *
   * @brief Description
-  * Takes the square root of the size of `cluster` and rounds it so it is not decimal.
-  * This is useful for very legible printing, since when printed it looks like a square
-  * and not a flat array.
+  * Appends a row to the append buffer without locks, many producers can append
+  * to the same cluster at once. A full buffer is flushed to a bucket by the
+  * producer that finds it full. The caller must not hold the lock of the cluster
   *
   * @return
-  * Returns a double which contains the square root of the size of `cluster`
+  * Returns false if the appends are not enabled or the row is wider than the
+  * buffer, in that case the caller keeps the ownership of the astructs
 */
 
 
-size_t Cluster::takeSquareRootOfClusterSize(
-  cluster_t cluster_
-) {
-  return std::ceil(
-    std::sqrt(
-      cluster_.size()
-    )
-  );
+bool Cluster::appendRow(std::span<Astruct* const> values) {
+  EpochGuard guard;
+
+  while (true) {
+    AppendBuffer* buffer = append_buffer.load(std::memory_order_acquire);
+
+    if (buffer == nullptr || values.size() > buffer->width) {
+      return false;
+    }
+
+    if (buffer->appendRow(values)) {
+      return true;
+    }
+    flushAppendBuffer(buffer);
+  }
 }
 
 
 /**
-   * @internal
-  * The `Cluster::brainExitOperator` method is internal of the `Cluster` class
+  * @internal
+  * The `Cluster::flushAppends` method is internal of the `Cluster` class
   *
   * @brief Description
-  * Prints on the console what a brain looks like, its buckets, its empty slots
-  * in a very legible way
+  * Moves the published rows of the append buffer to a new bucket of the cluster.
+  * Only the writers flush, the producer that fills the buffer, the Ingestor after
+  * a batch, the Compactor and the Serializer, the ColumnarFile and the ArrowExporter
+  * before they persist the cluster, the readers see the rows that are not flushed
+  * with `Cluster::forEachAppendedRow`. The caller must not hold the lock of the cluster
   *
   * @return
-  * Returns a std::ostream& with what has been printed
+  * Returns the number of moved rows
 */
 
 
-std::ostream& Cluster::clusterExitOperator(
-  std::ostream& ostream,
-  Cluster*& cluster_
-) {
-  // The following variable is to print the commas correctly, so that the
-  // commas are not printed after the last element, 2 was put and not 1 because
-  // 1 had no effect.
-
-  const size_t SQUARE_ROOT_OF_CLUSTER_SIZE = takeSquareRootOfClusterSize(cluster_->cluster);
-  const int CLUSTER_SIZE_LESS_ONE = cluster_->cluster.size() - 1;
-  const int EMPTY = -1;
-  size_t square_counter = 0;
-  
-  ostream << "Cluster([";
-
-  if (CLUSTER_SIZE_LESS_ONE > EMPTY) {
-    ostream << "\n";
+size_t Cluster::flushAppends() {
+  // Most clusters never enable the appends
+  if (append_buffer.load(std::memory_order_acquire) == nullptr) {
+    return 0;
   }
 
-  size_t index = 0;
+  EpochGuard guard;
 
-  while (index < cluster_->cluster.size()) {
-    // Execute the functions that print the object, it is executed in the order of 
-    // new slot -> comma, and so that it looks good and ordered,
-    // what `printNewRow` and if the square counter is the square root a new line is printed
+  AppendBuffer* buffer = append_buffer.load(std::memory_order_acquire);
 
-    if (index == 0) {
-      ostream << "  ";
-    }
+  // An empty buffer is not replaced, the rows still being written are not published
+  if (buffer == nullptr || buffer->size() == 0) {
+    return 0;
+  }
+  return flushAppendBuffer(buffer);
+}
+
+
+/**
+  * @internal
+  * The `Cluster::flushAppendBuffer` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Moves the rows of `expected` to a new bucket with `Cluster::moveAppendBuffer`.
+  * If a Mvcc is attached the move is a commit, the bucket gets its timestamp and
+  * the snapshots pinned before it do not see the rows
+  *
+  * @return
+  * Returns the number of moved rows, 0 if another thread already flushed `expected`
+*/
+
+
+size_t Cluster::flushAppendBuffer(AppendBuffer* expected) {
+  if (expected == nullptr) {
+    return 0;
+  }
+
+  Mvcc*  versions = mvcc.load(std::memory_order_acquire);
+  size_t rows     = 0;
+
+  if (versions == nullptr) {
+    return moveAppendBuffer(expected, 0);
+  }
+
+  versions->commitWith([&](uint64_t timestamp) {
+    rows = moveAppendBuffer(expected, timestamp);
+    return rows > 0;
+  });
+  return rows;
+}
+
+
+/**
+  * @internal
+  * The `Cluster::moveAppendBuffer` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Replaces `expected` with an empty buffer, closes it and inserts its rows as a
+  * new bucket published at `timestamp`, the closed buffer is retired. The lock of
+  * the cluster is held exclusively from the swap to the insertion, so a reader
+  * that holds it shared sees the rows in the buffer or in the bucket. Only one of
+  * the producers that find the same full buffer moves it
+  *
+  * @return
+  * Returns the number of moved rows, 0 if another thread already flushed `expected`
+*/
+
+
+size_t Cluster::moveAppendBuffer(AppendBuffer* expected, uint64_t timestamp) {
+  AppendBuffer* fresh = new AppendBuffer(expected->width, expected->max_rows);
+  auto          lock  = lockBuckets();
+
+  if (!append_buffer.compare_exchange_strong(expected, fresh, std::memory_order_acq_rel)) {
+    delete fresh;
+    return 0;
+  }
+
+  const size_t ROWS = expected->close();
+
+  if (ROWS > 0) {
+    Bucket* bucket_ = expected->toBucket();
+
+    bucket_->version_begin = timestamp;
+    placeBucket(bucket_);
+  }
+  lock.unlock();
+
+  EpochManager::global().retire(expected);
+  return ROWS;
+}
+
+
+/**
+  * @internal
+  * The `Cluster::lockBucketsShared` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Takes the lock of the cluster shared, to read the buckets or the terminal,
+  * the readers never block each other
+  *
+  * @return
+  * Returns the lock, it is released when it is destroyed
+*/
+
+
+std::shared_lock<std::shared_mutex> Cluster::lockBucketsShared() const {
+  return std::shared_lock<std::shared_mutex>(cluster_mutex);
+}
+
+
+/**
+  * @internal
+  * The `Cluster::lockBuckets` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Takes the lock of the cluster exclusively, to write the buckets or the terminal,
+  * and moves the `write_version` field, so the rows cached before are stale
+  *
+  * @return
+  * Returns the lock, it is released when it is destroyed
+*/
+
+
+std::unique_lock<std::shared_mutex> Cluster::lockBuckets() const {
+  std::unique_lock<std::shared_mutex> lock(cluster_mutex);
+
+  write_version.store(write_clock.fetch_add(1, std::memory_order_acq_rel) + 1, std::memory_order_release);
+  return lock;
+}
+
+
+/**
+  * @internal
+  * The `Cluster::encodeStringStacks` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Dictionary encodes every stack of strings of every bucket of the cluster
+  * with the `dictionary` field, which is created the first time, so the same
+  * string is stored once for the whole cluster, the lock of the cluster is
+  * held exclusively
+  *
+  * @return
+  * Returns the number of stacks that were encoded
+*/
+
+
+size_t Cluster::encodeStringStacks() {
+  auto   lock    = lockBuckets();
+  size_t encoded = 0;
 
-    if (
-      square_counter == SQUARE_ROOT_OF_CLUSTER_SIZE
-    ) {
-      cluster_->printNewRow(
-        ostream,
-        square_counter,
-        cluster_->cluster.size(),
-        index
-      );
-
-      square_counter = 0;
+  if (dictionary == nullptr) {
+    dictionary = new Dictionary();
+  }
+
+  forEachBucket([this, &encoded](Bucket* bucket) {
+    for (size_t index = 0; index < bucket->stackCount(); index++) {
+      if (
+        !bucket->isDictionaryStack(index) &&
+        bucket->stackHeight(index) > 0 &&
+        bucket->encodeDictionaryStack(index, dictionary)
+      ) {
+        encoded++;
+      }
     }
+  });
+  return encoded;
+}
 
-    cluster_->printSlot(ostream, cluster_->cluster[index]);
-    
-    // NOTE: It was decided to put brain.size() - 2 and not - 1 because - 1 did
-    // not make a change and caused the comma to be printed even after the last element,
-    // the solution was to put - 2 and not - 1
-    printComma(ostream, index, CLUSTER_SIZE_LESS_ONE);
 
-    square_counter++;
-    index++;
+/**
+  * @internal
+  * The `Cluster::adoptBuckets` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Appends the buckets of `value` to the `cluster` field and empties `value`, the
+  * slots live in the lean allocation of the cluster, so the pointers are copied
+  * with `Cluster::appendBuckets` instead of taking the storage of `value`
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the buckets
+*/
+
+
+void Cluster::adoptBuckets(cluster_t&& value) {
+  appendBuckets(value);
+  value.clear();
+}
+
+
+/**
+  * @internal
+  * The `Cluster::appendBuckets` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Appends the buckets of `value` after the last slot of the `cluster` field with
+  * a single reservation, skipping the nullptr or NULL slots in the same pass
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the buckets
+*/
+
+
+void Cluster::appendBuckets(std::span<const cluster_subv_t> value) {
+  // The bitmap is stale if the vector was written directly
+  if (bucket_slots.size != cluster.size()) {
+    rebuildBucketSlots();
   }
 
-  if (CLUSTER_SIZE_LESS_ONE > EMPTY) {
-    ostream << "\n";
+  const size_t FIRST = cluster.size();
+
+  cluster.reserve(FIRST + value.size());
+  std::copy_if(
+    value.begin(),
+    value.end(),
+    std::back_inserter(cluster),
+    [](cluster_subv_t bucket) { return bucket != nullptr; }
+  );
+
+  cluster_capacity = std::max(cluster_capacity, cluster.size());
+  bucket_slots.setRange(FIRST, cluster.size());
+}
+
+
+/**
+  * @internal
+  * The `Cluster::append` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Appends the buckets of `cluster_v` to the cluster, which takes their ownership,
+  * `cluster_v` is left empty. The lock of the cluster is held exclusively
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the buckets
+*/
+
+
+void Cluster::append(cluster_t&& cluster_v) {
+  auto lock = lockBuckets();
+  adoptBuckets(std::move(cluster_v));
+}
+
+
+/**
+  * @internal
+  * The `Cluster::append` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Appends the buckets of `cluster_v` to the cluster, which takes their ownership,
+  * the lock of the cluster is held exclusively
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the buckets
+*/
+
+
+void Cluster::append(std::span<const cluster_subv_t> cluster_v) {
+  auto lock = lockBuckets();
+  appendBuckets(cluster_v);
+}
+
+
+/**
+  * @internal
+  * The `Cluster::insertBucket` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Puts `value` in the first empty slot of the `cluster` field holding the
+  * lock of the cluster exclusively, see `Cluster::placeBucket`
+  *
+  * @return
+  * Returns the slot of `value`, or the size of the `cluster` field if `value`
+  * is nullptr or NULL and was not inserted
+*/
+
+
+size_t Cluster::insertBucket(cluster_subv_t value) {
+  auto lock = lockBuckets();
+  return placeBucket(value);
+}
+
+
+/**
+  * @internal
+  * The `Cluster::placeBucket` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Puts `value` in the first empty slot of the `cluster` field, found with the
+  * `bucket_slots` field, the vector only grows if there is no empty slot.
+  * The caller holds the lock of the cluster exclusively or owns the cluster alone
+  *
+  * @return
+  * Returns the slot of `value`, or the size of the `cluster` field if `value`
+  * is nullptr or NULL and was not inserted
+*/
+
+
+size_t Cluster::placeBucket(cluster_subv_t value) {
+  if (isSubValueNullptr(value)) {
+    return cluster.size();
+  }
+
+  // The bitmap is stale if the vector was written directly
+  if (bucket_slots.size != cluster.size()) {
+    rebuildBucketSlots();
+  }
+
+  size_t slot = bucket_slots.findFirstFree();
+
+  if (slot < cluster.size() && !isSubValueNullptr(cluster[slot])) {
+    rebuildBucketSlots();
+    slot = bucket_slots.findFirstFree();
+  }
+
+  if (slot < cluster.size()) {
+    cluster[slot] = value;
+  } else {
+    slot = cluster.size();
+    cluster.push_back(value);
+  }
+  bucket_slots.set(slot);
+
+  return slot;
+}
+
+
+/**
+  * @internal
+  * The `Cluster::removeBucket` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Empties the slot `index` of the `cluster` field, the slot is reused by the next
+  * insertion, the bucket is not deleted. The lock of the cluster is held exclusively
+  *
+  * @return
+  * Returns the removed bucket, the caller takes its ownership
+*/
+
+
+Cluster::cluster_subv_t Cluster::removeBucket(size_t index) {
+  auto lock = lockBuckets();
+
+  if (index >= cluster.size()) {
+    return nullptr;
+  }
+
+  cluster_subv_t value = cluster[index];
+
+  cluster[index] = nullptr;
+  bucket_slots.reset(index);
+
+  return value;
+}
+
+
+/**
+  * @internal
+  * The `Cluster::compactBuckets` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Packs the buckets at the start of the `cluster` field keeping their order
+  * and removes the empty slots, so the traversals do not test them anymore,
+  * the lock of the cluster is held exclusively
+  *
+  * @return
+  * Returns the number of removed empty slots
+*/
+
+
+size_t Cluster::compactBuckets() {
+  auto   lock = lockBuckets();
+  size_t kept = 0;
+
+  for (size_t index = 0; index < cluster.size(); index++) {
+    if (!isSubValueNullptr(cluster[index])) {
+      cluster[kept++] = cluster[index];
+    }
   }
-  
-  ostream << "])";
+
+  const size_t REMOVED = cluster.size() - kept;
+
+  cluster.resize(kept);
+  rebuildBucketSlots();
+
+  return REMOVED;
+}
+
+
+/**
+  * @internal
+  * The `Cluster::rebuildBucketSlots` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Builds the `bucket_slots` field again from the `cluster` field
+  *
+  * @return
+  * This function does not return anything, since it
+  * only rebuilds the bitmap
+*/
+
+
+void Cluster::rebuildBucketSlots() {
+  bucket_slots.rebuild(cluster);
+}
+
+
+/**
+  * @internal
+  * The `Cluster::Cluster` method is internal of the `Cluster` class
+  *
+  * The constructor of the `Cluster` class
+  *
+  * It handles several things, such as checking if the value to be assigned is
+  * nullptr or NULL, it also handles capacity assignment, creating a new vector
+  * for `cluster`, resizing the `cluster` vector.
+*/
+
+
+Cluster::Cluster(
+  cluster_t* cluster_v,
+  size_t capacity
+) {
+  build(cluster_v, capacity);
+}
+
+
+/**
+  * @internal
+  * The `Cluster::Cluster` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * The move constructor of the `Cluster` class
+  *
+  * @details
+  * Copies the non nullptr or NULL slots of `cluster_v` to the lean allocation of
+  * the cluster with a single reservation and empties `cluster_v`. The capacity is
+  * `capacity` or the number of buckets if it is bigger
+*/
+
+
+Cluster::Cluster(
+  cluster_t&& cluster_v,
+  size_t capacity
+) {
+  cluster_capacity = capacity;
+  adoptBuckets(std::move(cluster_v));
+}
+
+
+/**
+  * @internal
+  * The `Cluster::Cluster` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * The constructor of the `Cluster` class from a range of buckets
+  *
+  * @details
+  * Copies the non nullptr or NULL slots of `cluster_v` with a single reservation,
+  * the cluster takes the ownership of the buckets
+*/
+
+
+Cluster::Cluster(
+  std::span<const cluster_subv_t> cluster_v,
+  size_t capacity
+) {
+  cluster_capacity = capacity;
+  appendBuckets(cluster_v);
+}
+
+
+/**
+  * @internal
+  * The `Cluster::~Cluster` method is internal of the `Cluster` class
+  *
+  * The destructor of the `Cluster` class
+  *
+  * It handles how to check if a value is nullptr or NULL when deleting one by one
+  * This prevents freeing memory to nullptr or NULL pointers although it is safe,
+  * it is done to avoid unnecessary memory frees
+*/
+
+
+Cluster::~Cluster() noexcept {
+  destroy();
+}
+
+//////////////////////////////////
+// ////////// OPERATORS //////////
+//////////////////////////////////
+
+// operator<< functions
+
+
+/**
+   * @internal
+  * The `Cluster::clusterExitOperator` method is internal of the `Cluster` class
+  *
+  * @brief Description
+  * Prints on the console what a brain looks like, its buckets, its empty slots
+  * in a very legible way
+  *
+  * @return
+  * Returns a std::ostream& with what has been printed
+*/
+
+
+std::ostream& Cluster::clusterExitOperator(
+  std::ostream& ostream,
+  Cluster*& cluster_
+) {
+  // The printer of the thread streams through its buffer, so the `cluster` field
+  // is never copied and the buffer is not allocated again on every print
+  Printer::threadPrinter(ostream).print(cluster_);
 
   return ostream;
 }
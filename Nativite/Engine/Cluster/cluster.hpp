@@ -14,11 +14,24 @@
 #pragma once
 
 // C++ libraries imports
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <shared_mutex>
+#include <span>
 #include <vector>
 
 // Nativite engine imports
-#include "../Brain/brain.hpp"
-#include "../Terminal/terminal.hpp"
+#include "../Bitmap/bitmap.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../LeanCluster/lean_cluster.hpp"
+#include "../AppendBuffer/append_buffer.hpp"
+#include "../Epoch/epoch.hpp"
+
+// Forward reference to `Dictionary`, `ShardedTerminal` and `Mvcc`
+class Dictionary;
+class ShardedTerminal;
+class Mvcc;
 
 /**
  *
@@ -27,55 +40,63 @@
  *
  * @brief Description
  * The information unit that contains buckets, clusters simulates neurons
+ *
+ * @details
+ * The bucket slots and the one terminal of the cluster are a single LeanCluster
+ * allocation, the `cluster` field, the object only adds the locks, the slot
+ * bitmap and the append buffer.
 */
 
 
-class Cluster : protected virtual Brain, public Terminal {
+class Cluster {
   // Types
   public:
     using cluster_subv_t = Bucket*;
     using cluster_t = std::vector<Bucket*>;
   // Operators
   public:
-    // Operator << implementation for the `Brain` class
+    // Operator << implementation for the `Cluster` class
     friend std::ostream& operator<<(
       std::ostream& ostream,
       Cluster*& cluster_
     );
   protected:
-    // Internal functions of the class, although they are
-    // virtual functions for polymorphism in child classes
+    // Internal functions of the class
     bool isValueNullptr(cluster_t* value);
     bool isSubValueNullptr(cluster_subv_t value);
     
-    virtual bool hasDisponibleCapacity() override;
-    virtual void resizeVec() override;
+    bool hasDisponibleCapacity();
+    void resizeVec();
 
-    virtual void newVec() override;
+    void newVec();
 
-    virtual void evaluateCapacity(size_t capacity) override;
+    void evaluateCapacity(size_t capacity);
     void evaluateNullptrInAssignation(cluster_subv_t value);
 
     void pushObjectValue(cluster_subv_t value);
     
-    virtual void assignDefaultCapacity() override;
-    virtual void assignCapacity(size_t capacity) override;
+    void assignDefaultCapacity();
+    void assignCapacity(size_t capacity);
 
-    virtual void defaultNullptrVec() override;
+    void defaultNullptrVec();
 
     void deleteInternalObject(cluster_subv_t value);
     
-    virtual void deleteAllFields() override;
+    void deleteAllFields();
+
+    size_t placeBucket(cluster_subv_t value);
 
-    virtual void pushClusterObjectToBrain();
+    size_t flushAppendBuffer(AppendBuffer* expected);
+    size_t moveAppendBuffer(AppendBuffer* expected, uint64_t timestamp);
+
+    void adoptBuckets(cluster_t&& value);
+    void appendBuckets(std::span<const cluster_subv_t> value);
 
     // Non virtual functions
     void abstractBuild(
       cluster_t* value,
       size_t capacity
     );
-    
-    void newTerminal();
 
     // Core functions that abstract all
     // responsibilities into a single function, 
@@ -87,37 +108,144 @@ class Cluster : protected virtual Brain, public Terminal {
     // Abstract constructor
     virtual void build(
       cluster_t* value,
-      size_t capacity,
-      bool add=false
+      size_t capacity
     );
     
     // Abstract destructor
     virtual void destroy();
 
     // operator<< functions
-    virtual void printSlot(
-      std::ostream& ostream,
-      cluster_subv_t brain_
-    );
-
-    size_t takeSquareRootOfClusterSize(
-      cluster_t cluster_
-    );
-    
     std::ostream& clusterExitOperator(std::ostream& ostream, Cluster*& cluster_);
 
   public:
-    cluster_t cluster;          /**< The cluster field that is a array of buckets */
-    size_t    cluster_capacity; /**< The cluster capacity */
-
-    Terminal* terminal; /**< The terminal or cache of the cluster, equivalent
-                             of the axon because it is an output */
+    LeanSlots cluster;              /**< The cluster field that is a array of buckets, the slots
+                                         and the terminal are one LeanCluster allocation */
+    size_t    cluster_capacity = 0; /**< The cluster capacity */
+
+    SlotBitmap bucket_slots; /**< The used slots of the `cluster` field, it must be rebuilt
+                                  with `Cluster::rebuildBucketSlots` after writing the
+                                  `cluster` field directly */
+
+    mutable std::shared_mutex cluster_mutex; /**< The lock of the buckets and the terminal of the
+                                                  cluster, the readers take it shared */
+
+    static inline std::atomic<uint64_t> write_clock{0}; /**< Moves on every exclusive lock of a cluster
+                                                             or of the structure of a brain */
+
+    mutable std::atomic<uint64_t> write_version{0}; /**< The `write_clock` of the last exclusive lock,
+                                                         the caches of the rows compare it */
+
+    Dictionary* dictionary = nullptr; /**< The dictionary shared by the string stacks
+                                           of all the buckets of the cluster */
+
+    ShardedTerminal* sharded_terminal = nullptr; /**< The terminal of a hot cluster, created by
+                                                      `Cluster::shardTerminal`, it is read without
+                                                      the lock of the cluster */
+
+    ShardedTerminal* shardTerminal(size_t shard_count = 0);
+
+    size_t terminalCapacity() const;
+    bool   automaticTerminal() const;
+    void   configureTerminal(size_t terminal_capacity_v, bool automatic);
+
+    std::atomic<AppendBuffer*> append_buffer{nullptr}; /**< The open bucket of the lock free appends,
+                                                            created by `Cluster::enableAppends` */
+
+    std::atomic<Mvcc*> mvcc{nullptr}; /**< The Mvcc that stamps the flushed buckets with a commit,
+                                           set by `Mvcc::attachAppends`, it must outlive the cluster */
+
+    AppendBuffer* enableAppends(size_t width);
+    bool          appendRow(std::span<Astruct* const> values);
+    size_t        flushAppends();
+
+    /**
+      * @internal
+      * The `Cluster::forEachAppendedRow` method is internal of the `Cluster` class
+      *
+      * @brief Description
+      * Calls `function(row, values)` for every published row of the append buffer
+      * that is not flushed to a bucket yet, under an epoch guard, so the buffer is
+      * alive even if a writer flushes it. With the lock of the cluster held shared
+      * every row is either in a bucket or visited here, never both
+      *
+      * @return
+      * Returns the number of visited rows
+    */
+    template <typename Function>
+    size_t forEachAppendedRow(Function&& function) const {
+      EpochGuard    guard;
+      AppendBuffer* buffer = append_buffer.load(std::memory_order_acquire);
+      size_t        rows   = 0;
+
+      if (buffer == nullptr) {
+        return 0;
+      }
+      buffer->forEachRow([&](size_t row, Astruct* const* values) {
+        function(row, values);
+        rows++;
+      });
+      return rows;
+    }
+
+    std::atomic<size_t> pinned_exports{0}; /**< The cursors that read the cluster between batches,
+                                                the Compactor skips the cluster meanwhile */
+
+    std::shared_lock<std::shared_mutex> lockBucketsShared() const;
+    std::unique_lock<std::shared_mutex> lockBuckets() const;
+
+    size_t encodeStringStacks();
+
+    size_t         insertBucket(cluster_subv_t value);
+    cluster_subv_t removeBucket(size_t index);
+    size_t         compactBuckets();
+    void           rebuildBucketSlots();
+
+    /**
+      * @internal
+      * The `Cluster::forEachBucket` method is internal of the `Cluster` class
+      *
+      * @brief Description
+      * Calls `function(bucket)` for every live bucket of the `cluster` field in order,
+      * the empty slots are skipped 64 at a time with the `bucket_slots` field. The
+      * buckets removed by a transaction stay in their slots until `Mvcc::collect`,
+      * they are skipped too, only a Snapshot reads them
+    */
+    template <typename Function>
+    void forEachBucket(Function&& function) const {
+      // The vector was written directly, so the bitmap can not be trusted
+      if (bucket_slots.size != cluster.size()) {
+        for (auto bucket_ : cluster) {
+          if (bucket_ != nullptr && bucket_->isLive()) {
+            function(bucket_);
+          }
+        }
+        return;
+      }
+      bucket_slots.forEachUsed([&](size_t slot) {
+        if (cluster[slot]->isLive()) {
+          function(cluster[slot]);
+        }
+      });
+    }
     
+    void append(cluster_t&& cluster_v);
+    void append(std::span<const cluster_subv_t> cluster_v);
+
     Cluster(
       cluster_t* cluster_v,
       size_t capacity
     );
 
+    Cluster(
+      cluster_t&& cluster_v,
+      size_t capacity = 0
+    );
+
+    Cluster(
+      std::span<const cluster_subv_t> cluster_v,
+      size_t capacity = 0
+    );
+
     Cluster() = default;
 
     virtual ~Cluster() noexcept;
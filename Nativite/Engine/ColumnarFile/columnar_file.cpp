@@ -0,0 +1,682 @@
+/**
+  * @file columnar_file.cpp
+  * This is the documentation of the `columnar_file.cpp` file
+  *
+  * @brief Description
+  * Implementation of the ColumnarFile class methods, the writing of the column
+  * chunks and of the footer, and the parallel loads with projections and ranges
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <thread>
+
+// Nativite engine imports
+#include "columnar_file.hpp"
+#include "../MappedFile/mapped_file.hpp"
+
+// The magic bytes at the start and at the end of a file
+static constexpr char COLUMNAR_MAGIC[4] = {'N', 'T', 'V', 'P'};
+
+// The size of the trailer, the size of the footer and the magic bytes
+static constexpr size_t TRAILER_SIZE = sizeof(uint64_t) + sizeof(COLUMNAR_MAGIC);
+
+// Widens the zone map of `column` to the numbers between `minimum` and `maximum`
+static void widenRange(ColumnarFile::column_chunk_t& column, double minimum, double maximum) {
+  column.minimum    = column.has_values ? std::min(column.minimum, minimum) : minimum;
+  column.maximum    = column.has_values ? std::max(column.maximum, maximum) : maximum;
+  column.has_values = true;
+}
+
+
+/**
+  * @internal
+  * The `ColumnarFile::computeStatistics` method is internal of the `ColumnarFile` class
+  *
+  * @brief Description
+  * Counts the rows and the nulls of the stack `stack_index` and builds the zone map
+  * of its numbers, a compressed stack takes it from the statistics of its blocks
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the statistics of `column`
+*/
+
+
+void ColumnarFile::computeStatistics(const Bucket* bucket_, size_t stack_index, column_chunk_t& column) {
+  if (bucket_->isNumericStack(stack_index)) {
+    const NumericLayer* layer = bucket_->numeric_layers[stack_index];
+    size_t              valid = layer->size;
+
+    if (!layer->validity.empty()) {
+      valid = 0;
+      for (auto word : layer->validity) {
+        valid += std::popcount(word);
+      }
+    }
+
+    column.rows  = layer->size;
+    column.nulls = layer->size - std::min(valid, layer->size);
+
+    for (const auto& block : layer->blocks) {
+      if (block.has_values) {
+        widenRange(column, block.real_minimum, block.real_maximum);
+      }
+    }
+    return;
+  }
+
+  if (bucket_->isDictionaryStack(stack_index)) {
+    const auto& codes = bucket_->dictionary_layers[stack_index]->codes;
+
+    column.rows  = codes.size();
+    column.nulls = std::count_if(codes.begin(), codes.end(), [](auto code) { return !Dictionary::isString(code); });
+    return;
+  }
+
+  const Bucket::stack_t& stack = bucket_->bucket[stack_index];
+
+  column.rows = stack.size();
+
+  for (auto astruct : stack) {
+    if (astruct == nullptr || astruct->kind() == Astruct::astruct_kind_t::null) {
+      column.nulls++;
+    } else if (astruct->kind() == Astruct::astruct_kind_t::integer) {
+      const double VALUE = static_cast<double>(std::get<int64_t>(astruct->astruct));
+      widenRange(column, VALUE, VALUE);
+    } else if (astruct->kind() == Astruct::astruct_kind_t::real) {
+      const double VALUE = std::get<double>(astruct->astruct);
+      widenRange(column, VALUE, VALUE);
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `ColumnarFile::writeFooter` method is internal of the `ColumnarFile` class
+  *
+  * @brief Description
+  * Writes the `clusters` field as the footer, followed by the size of the footer
+  * and the magic bytes, so a reader finds the footer from the end of the file
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the footer to the `buffer` field
+*/
+
+
+void ColumnarFile::writeFooter() {
+  const size_t START = position;
+
+  writeVarint(brain_capacity);
+  writeVarint(clusters.size());
+
+  for (const auto& entry : clusters) {
+    if (!entry.present) {
+      writeByte(0x00);
+      continue;
+    }
+
+    writeByte(0x01);
+    writeVarint(entry.capacity);
+    writeVarint(entry.terminal_capacity);
+    writeByte(entry.automatic_managment ? 1 : 0);
+
+    if (entry.dictionary_length == 0) {
+      writeByte(0x00);
+    } else {
+      writeByte(0x01);
+      writeVarint(entry.dictionary_offset);
+      writeVarint(entry.dictionary_length);
+    }
+
+    writeVarint(entry.row_groups.size());
+
+    for (const auto& row_group : entry.row_groups) {
+      writeVarint(row_group.capacity);
+      writeByte(row_group.sealed ? 1 : 0);
+      writeVarint(row_group.sort_key == Bucket::no_key ? 0 : row_group.sort_key + 1);
+      writeVarint(row_group.rows);
+      writeVarint(row_group.columns.size());
+
+      for (const auto& column : row_group.columns) {
+        writeVarint(column.offset);
+        writeVarint(column.length);
+        writeByte(column.encoding);
+        writeVarint(column.rows);
+        writeVarint(column.nulls);
+        writeByte(column.has_values ? 1 : 0);
+        writeBytes(&column.minimum, sizeof(double));
+        writeBytes(&column.maximum, sizeof(double));
+      }
+    }
+  }
+
+  const uint64_t FOOTER_SIZE = position - START;
+
+  writeBytes(&FOOTER_SIZE, sizeof(FOOTER_SIZE));
+  writeBytes(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+}
+
+
+/**
+  * @internal
+  * The `ColumnarFile::readFooter` method is internal of the `ColumnarFile` class
+  *
+  * @brief Description
+  * Checks the magic bytes and the version of a file and reads its footer into the
+  * `clusters` field, every chunk must be inside the chunks of the file
+  *
+  * @return
+  * Returns false if the file is malformed or truncated
+*/
+
+
+bool ColumnarFile::readFooter(const uint8_t* data, size_t size) {
+  uint64_t version     = 0;
+  uint64_t footer_size = 0;
+  uint64_t slots       = 0;
+
+  clusters.clear();
+  beginRead(data, size);
+
+  if (
+    size < sizeof(COLUMNAR_MAGIC) + 1 + TRAILER_SIZE ||
+    std::memcmp(data, COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC)) != 0 ||
+    std::memcmp(data + size - sizeof(COLUMNAR_MAGIC), COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC)) != 0
+  ) {
+    return false;
+  }
+
+  cursor += sizeof(COLUMNAR_MAGIC);
+  std::memcpy(&footer_size, data + size - TRAILER_SIZE, sizeof(footer_size));
+
+  const uint64_t CHUNKS_BEGIN = readVarint(version) ? cursor - data : size;
+
+  if (version != columnar_version || footer_size > size - TRAILER_SIZE - CHUNKS_BEGIN) {
+    return false;
+  }
+
+  const uint64_t CHUNKS_END = size - TRAILER_SIZE - footer_size;
+
+  auto isChunk = [&](uint64_t offset, uint64_t length) {
+    return offset >= CHUNKS_BEGIN && offset <= CHUNKS_END && length <= CHUNKS_END - offset;
+  };
+
+  beginRead(data + CHUNKS_END, footer_size);
+
+  if (
+    !readVarint(brain_capacity) ||
+    !readVarint(slots) ||
+    slots > static_cast<uint64_t>(end - cursor)
+  ) {
+    return false;
+  }
+
+  clusters.resize(slots);
+
+  for (auto& entry : clusters) {
+    uint8_t  present        = 0;
+    uint8_t  automatic      = 0;
+    uint8_t  has_dictionary = 0;
+    uint64_t row_groups     = 0;
+
+    if (!readByte(present) || present > 1) {
+      return false;
+    }
+    if (present == 0) {
+      continue;
+    }
+
+    if (
+      !readVarint(entry.capacity) ||
+      !readVarint(entry.terminal_capacity) ||
+      !readByte(automatic) ||
+      !readByte(has_dictionary) ||
+      has_dictionary > 1 ||
+      entry.terminal_capacity > LeanCluster::max_terminal_capacity
+    ) {
+      return false;
+    }
+
+    entry.present             = true;
+    entry.automatic_managment = automatic != 0;
+
+    if (
+      has_dictionary == 1 && (
+        !readVarint(entry.dictionary_offset) ||
+        !readVarint(entry.dictionary_length) ||
+        entry.dictionary_length == 0 ||
+        !isChunk(entry.dictionary_offset, entry.dictionary_length)
+      )
+    ) {
+      return false;
+    }
+
+    if (!readVarint(row_groups) || row_groups > static_cast<uint64_t>(end - cursor)) {
+      return false;
+    }
+
+    entry.row_groups.resize(row_groups);
+
+    for (auto& row_group : entry.row_groups) {
+      uint8_t  sealed   = 0;
+      uint64_t sort_key = 0;
+      uint64_t columns_ = 0;
+
+      if (
+        !readVarint(row_group.capacity) ||
+        !readByte(sealed) ||
+        !readVarint(sort_key) ||
+        !readVarint(row_group.rows) ||
+        !readVarint(columns_) ||
+        sealed > 1 ||
+        sort_key > columns_ ||
+        columns_ > static_cast<uint64_t>(end - cursor)
+      ) {
+        return false;
+      }
+
+      row_group.sealed   = sealed == 1;
+      row_group.sort_key = sort_key == 0 ? Bucket::no_key : sort_key - 1;
+      row_group.columns.resize(columns_);
+
+      for (auto& column : row_group.columns) {
+        uint8_t has_values = 0;
+
+        if (
+          !readVarint(column.offset) ||
+          !readVarint(column.length) ||
+          !readByte(column.encoding) ||
+          !readVarint(column.rows) ||
+          !readVarint(column.nulls) ||
+          !readByte(has_values) ||
+          !readBytes(&column.minimum, sizeof(double)) ||
+          !readBytes(&column.maximum, sizeof(double)) ||
+          column.encoding > 3 ||
+          (column.encoding == 2 && entry.dictionary_length == 0) ||
+          !isChunk(column.offset, column.length)
+        ) {
+          return false;
+        }
+
+        column.has_values = has_values != 0;
+      }
+    }
+  }
+
+  return cursor == end;
+}
+
+
+/**
+  * @internal
+  * The `ColumnarFile::isProjected` method is internal of the `ColumnarFile` class
+  *
+  * @return
+  * Returns a boolean, true if the loads read the stack `stack_index`
+*/
+
+
+bool ColumnarFile::isProjected(size_t stack_index) const {
+  return columns.empty() || std::find(columns.begin(), columns.end(), stack_index) != columns.end();
+}
+
+
+/**
+  * @internal
+  * The `ColumnarFile::mayMatch` method is internal of the `ColumnarFile` class
+  *
+  * @brief Description
+  * Evaluates the `ranges` field with the zone maps of a row group, a row group
+  * without the stack of a range has no numbers in it
+  *
+  * @return
+  * Returns a boolean, false if some range surely has no rows in the row group
+*/
+
+
+bool ColumnarFile::mayMatch(const row_group_t& row_group) const {
+  for (const auto& range : ranges) {
+    if (range.stack_index >= row_group.columns.size()) {
+      return false;
+    }
+
+    const column_chunk_t& column = row_group.columns[range.stack_index];
+
+    if (!column.has_values || range.minimum > column.maximum || range.maximum < column.minimum) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `ColumnarFile::loadRowGroup` method is internal of the `ColumnarFile` class
+  *
+  * @brief Description
+  * Decodes the projected column chunks of a row group into a new bucket, the other
+  * stacks are left empty. A sealed row group builds its filters again
+  *
+  * @return
+  * Returns the new bucket, throws if a chunk is malformed
+*/
+
+
+Bucket* ColumnarFile::loadRowGroup(const uint8_t* data, const row_group_t& row_group, Dictionary* shared) {
+  Bucket* bucket_ = new Bucket();
+
+  bucket_->bucket_capacity = row_group.capacity;
+  bucket_->bucket.resize(row_group.columns.size());
+
+  try {
+    for (size_t index = 0; index < row_group.columns.size(); index++) {
+      if (!isProjected(index)) {
+        continue;
+      }
+
+      const column_chunk_t& column = row_group.columns[index];
+
+      beginRead(data + column.offset, column.length);
+      readStack(bucket_, index, shared);
+
+      if (cursor != end) {
+        throw std::runtime_error("column length mismatch");
+      }
+    }
+  } catch (...) {
+    delete bucket_;
+    throw;
+  }
+
+  if (row_group.sealed) {
+    bucket_->sort_key = row_group.sort_key;
+    bucket_->sealed   = true;
+    bucket_->buildFilters();
+  }
+  return bucket_;
+}
+
+
+/**
+  * @internal
+  * The `ColumnarFile::write` method is internal of the `ColumnarFile` class
+  *
+  * @brief Description
+  * Writes the brain to the `buffer` field, every stack of every bucket is a column
+  * chunk and the footer is built in the `clusters` field meanwhile. The structure
+  * lock and the lock of every cluster are held shared, so the queries keep running
+  *
+  * @return
+  * This function does not return anything, the output is in the `buffer` field
+*/
+
+
+void ColumnarFile::write(Brain* brain_) {
+  auto structure = brain_->lockStructureShared();
+
+  beginWrite();
+  writeBytes(COLUMNAR_MAGIC, sizeof(COLUMNAR_MAGIC));
+  writeVarint(columnar_version);
+
+  brain_capacity = brain_->brain_capacity;
+  clusters.assign(brain_->brain.size(), cluster_entry_t());
+
+  for (size_t cluster_index = 0; cluster_index < brain_->brain.size(); cluster_index++) {
+    Cluster*         cluster_ = brain_->brain[cluster_index];
+    cluster_entry_t& entry    = clusters[cluster_index];
+
+    if (cluster_ == nullptr) {
+      continue;
+    }
+
+    // The appended rows are written too
+    cluster_->flushAppends();
+
+    auto lock = cluster_->lockBucketsShared();
+
+    entry.present             = true;
+    entry.capacity            = cluster_->cluster_capacity;
+    entry.terminal_capacity   = cluster_->terminalCapacity();
+    entry.automatic_managment = cluster_->automaticTerminal();
+
+    if (cluster_->dictionary != nullptr) {
+      entry.dictionary_offset = position;
+      writeDictionary(cluster_->dictionary);
+      entry.dictionary_length = position - entry.dictionary_offset;
+    }
+
+    for (const Bucket* bucket_ : cluster_->cluster) {
+      if (bucket_ == nullptr || !bucket_->isLive()) {
+        continue;
+      }
+
+      row_group_t& row_group = entry.row_groups.emplace_back();
+
+      row_group.capacity = bucket_->bucket_capacity;
+      row_group.sealed   = bucket_->sealed;
+      row_group.sort_key = bucket_->sort_key;
+      row_group.rows     = bucket_->height();
+      row_group.columns.resize(bucket_->bucket.size());
+
+      for (size_t index = 0; index < bucket_->bucket.size(); index++) {
+        column_chunk_t& column = row_group.columns[index];
+
+        column.offset = position;
+        writeStack(bucket_, index, cluster_->dictionary);
+        column.length   = position - column.offset;
+        column.encoding = buffer[column.offset];
+
+        computeStatistics(bucket_, index, column);
+      }
+    }
+  }
+
+  writeFooter();
+  endWrite();
+}
+
+
+/**
+  * @internal
+  * The `ColumnarFile::writeFile` method is internal of the `ColumnarFile` class
+  *
+  * @brief Description
+  * Writes the brain to the file `path`, replacing it
+  *
+  * @return
+  * Returns false if the file could not be written
+*/
+
+
+bool ColumnarFile::writeFile(Brain* brain_, const std::string& path) {
+  write(brain_);
+
+  std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+  file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+  return static_cast<bool>(file);
+}
+
+
+/**
+  * @internal
+  * The `ColumnarFile::load` method is internal of the `ColumnarFile` class
+  *
+  * @brief Description
+  * Loads a brain from a file written by `ColumnarFile::write`. Only the footer,
+  * the projected chunks of the row groups that match the `ranges` field and the
+  * shared dictionaries they use are read, the row groups are decoded in parallel
+  * and every cluster keeps the order of its row groups
+  *
+  * @return
+  * Returns a new `Brain*` owned by the caller, or nullptr if the input is
+  * malformed or truncated, in that case nothing is leaked
+*/
+
+
+Brain* ColumnarFile::load(const uint8_t* data, size_t size) {
+  // A row group to decode and the cluster it goes to
+  struct task_t {
+    size_t             cluster_index;
+    const row_group_t* row_group;
+  };
+
+  loaded_row_groups  = 0;
+  skipped_row_groups = 0;
+
+  if (!readFooter(data, size)) {
+    return nullptr;
+  }
+
+  Brain*              brain_ = new Brain();
+  std::vector<task_t> tasks;
+
+  brain_->brain_capacity = brain_capacity;
+  brain_->brain.reserve(clusters.size());
+
+  try {
+    for (size_t cluster_index = 0; cluster_index < clusters.size(); cluster_index++) {
+      const cluster_entry_t& entry = clusters[cluster_index];
+
+      if (!entry.present) {
+        brain_->brain.push_back(nullptr);
+        continue;
+      }
+
+      Cluster* cluster_ = new Cluster();
+      bool     shared   = false;
+
+      cluster_->cluster_capacity = entry.capacity;
+      cluster_->configureTerminal(entry.terminal_capacity, entry.automatic_managment);
+      brain_->brain.push_back(cluster_);
+
+      for (const auto& row_group : entry.row_groups) {
+        if (!mayMatch(row_group)) {
+          skipped_row_groups++;
+          continue;
+        }
+
+        tasks.push_back({cluster_index, &row_group});
+
+        for (size_t index = 0; index < row_group.columns.size(); index++) {
+          shared = shared || (row_group.columns[index].encoding == 2 && isProjected(index));
+        }
+      }
+
+      // The shared dictionary is only read if a projected chunk uses it
+      if (shared) {
+        cluster_->dictionary = new Dictionary();
+
+        beginRead(data + entry.dictionary_offset, entry.dictionary_length);
+        readDictionary(cluster_->dictionary);
+
+        if (cursor != end) {
+          throw std::runtime_error("dictionary length mismatch");
+        }
+      }
+    }
+  } catch (...) {
+    delete brain_;
+    return nullptr;
+  }
+
+  const size_t THREADS = std::min(
+    std::max<size_t>(1, tasks.size()),
+    threads != 0 ? threads : std::max<size_t>(1, std::thread::hardware_concurrency())
+  );
+
+  std::vector<Bucket*>     buckets(tasks.size(), nullptr);
+  std::atomic<size_t>      next{0};
+  std::atomic<bool>        failed{false};
+  std::vector<std::thread> workers;
+
+  // Every thread decodes with its own reader, the row groups are taken in order
+  auto decode = [&]() {
+    ColumnarFile reader;
+    reader.columns = columns;
+
+    for (
+      size_t index = next.fetch_add(1, std::memory_order_relaxed);
+      index < tasks.size() && !failed.load(std::memory_order_relaxed);
+      index = next.fetch_add(1, std::memory_order_relaxed)
+    ) {
+      try {
+        buckets[index] = reader.loadRowGroup(
+          data,
+          *tasks[index].row_group,
+          brain_->brain[tasks[index].cluster_index]->dictionary
+        );
+      } catch (...) {
+        failed.store(true, std::memory_order_relaxed);
+      }
+    }
+  };
+
+  for (size_t thread = 1; thread < THREADS; thread++) {
+    workers.emplace_back(decode);
+  }
+  decode();
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  if (failed.load()) {
+    for (auto bucket_ : buckets) {
+      delete bucket_;
+    }
+    delete brain_;
+    return nullptr;
+  }
+
+  for (size_t index = 0; index < tasks.size(); index++) {
+    brain_->brain[tasks[index].cluster_index]->cluster.push_back(buckets[index]);
+  }
+
+  for (auto cluster_ : brain_->brain) {
+    if (cluster_ != nullptr) {
+      cluster_->rebuildBucketSlots();
+    }
+  }
+  brain_->rebuildClusterSlots();
+
+  loaded_row_groups = tasks.size();
+  return brain_;
+}
+
+
+/**
+  * @internal
+  * The `ColumnarFile::loadFile` method is internal of the `ColumnarFile` class
+  *
+  * @brief Description
+  * Loads a brain from the file `path`, the file is mapped so the chunks that
+  * are not read are not loaded from the disk
+  *
+  * @return
+  * Returns a new `Brain*` owned by the caller, or nullptr if the file can not be
+  * opened or is malformed
+*/
+
+
+Brain* ColumnarFile::loadFile(const std::string& path) {
+  MappedFile file;
+
+  if (!file.open(path)) {
+    return nullptr;
+  }
+  return load(reinterpret_cast<const uint8_t*>(file.data), file.size);
+}
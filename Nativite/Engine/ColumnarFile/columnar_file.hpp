@@ -0,0 +1,142 @@
+/**
+  * @file columnar_file.hpp
+  * This is the documentation of the `columnar_file.hpp` file
+  *
+  * @brief Description
+  * Implementation of the ColumnarFile class, a columnar file format for the
+  * snapshots of a brain with statistics and projections in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "../Serializer/serializer.hpp"
+
+
+/**
+ * @internal
+ * The ColumnarFile class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Writes a brain to a columnar file and loads it back, it is used for the cold
+ * archives and the fast reloads. A load can read only some of the stacks and
+ * skip the buckets whose statistics do not match its ranges
+ *
+ * @details
+ * Every bucket is a row group and every 3D vertical stack of a bucket is a column
+ * chunk, written with the stack encodings of the Serializer class, so a dictionary
+ * encoded stack keeps its codes and a compressed stack keeps its blocks. The chunks
+ * come first and the footer at the end has the offset, the length and the statistics
+ * of every chunk, so a load reads the footer and then only the chunks it needs, with
+ * a mapped file the other chunks are never read from the disk. The layout is:
+ *
+ * <pre>
+ *   file      := "NTVP" varint(version) { chunk } footer u64(footer_size) "NTVP"
+ *   chunk     := dictionary | stack
+ *   footer    := varint(capacity) varint(slots) { 0x00 | 0x01 cluster }
+ *   cluster   := varint(capacity) varint(terminal_capacity) byte(automatic_managment)
+ *                (0x00 | 0x01 varint(offset) varint(length)) varint(row_groups) { row_group }
+ *   row_group := varint(capacity) byte(sealed) varint(sort_key + 1) varint(rows)
+ *                varint(columns) { column }
+ *   column    := varint(offset) varint(length) byte(encoding) varint(rows) varint(nulls)
+ *                byte(has_values) f64(minimum) f64(maximum)
+ * </pre>
+ *
+ * The offsets are from the start of the file, the `dictionary` and `stack` chunks
+ * are the ones of the Serializer class and the optional chunk of a cluster is its
+ * shared dictionary. The minimum and the maximum of a column are the zone map of
+ * its numbers, like the filters of a sealed bucket. The row groups are decoded in
+ * parallel, every thread has its own reader.
+*/
+
+
+class ColumnarFile : protected Serializer {
+  // Types
+  public:
+    // The version written after the magic bytes
+    static constexpr uint64_t columnar_version = 1;
+
+    // The position and the statistics of a column chunk
+    struct column_chunk_t {
+      uint64_t offset     = 0;
+      uint64_t length     = 0;
+      uint8_t  encoding   = 0;     /**< The stack encoding of the Serializer class */
+      uint64_t rows       = 0;
+      uint64_t nulls      = 0;     /**< The empty slots and the null astructs */
+      bool     has_values = false; /**< If the column has numbers */
+      double   minimum    = 0;
+      double   maximum    = 0;
+    };
+
+    // A row group, a bucket of a cluster
+    struct row_group_t {
+      uint64_t                    capacity = 0;
+      bool                        sealed   = false;
+      size_t                      sort_key = Bucket::no_key;
+      uint64_t                    rows     = 0;
+      std::vector<column_chunk_t> columns;
+    };
+
+    // A cluster slot of the brain, `dictionary_length` is 0 without a shared dictionary
+    struct cluster_entry_t {
+      bool                     present             = false;
+      uint64_t                 capacity            = 0;
+      uint64_t                 terminal_capacity   = 0;
+      bool                     automatic_managment = false;
+      uint64_t                 dictionary_offset   = 0;
+      uint64_t                 dictionary_length   = 0;
+      std::vector<row_group_t> row_groups;
+    };
+
+    // A condition of the loads, the row groups whose column `stack_index` surely
+    // has no number between `minimum` and `maximum` are skipped
+    struct range_t {
+      size_t stack_index;
+      double minimum;
+      double maximum;
+    };
+
+  protected:
+    // Internal functions of the class
+    static void computeStatistics(const Bucket* bucket_, size_t stack_index, column_chunk_t& column);
+
+    void writeFooter();
+    bool readFooter(const uint8_t* data, size_t size);
+
+    bool isProjected(size_t stack_index) const;
+    bool mayMatch(const row_group_t& row_group) const;
+
+    Bucket* loadRowGroup(const uint8_t* data, const row_group_t& row_group, Dictionary* shared);
+
+  public:
+    using Serializer::buffer;
+
+    std::vector<size_t>  columns; /**< The stacks read by the loads, empty to read all of them,
+                                       the other stacks are loaded empty so the indexes do not move */
+    std::vector<range_t> ranges;  /**< The conditions that skip the row groups of the loads */
+    size_t               threads = 0; /**< The decoding threads, 0 is one per hardware thread */
+
+    uint64_t                     brain_capacity = 0; /**< The capacity of the brain of the last file */
+    std::vector<cluster_entry_t> clusters;           /**< The footer of the last written or loaded file */
+
+    size_t loaded_row_groups  = 0; /**< The row groups decoded by the last load */
+    size_t skipped_row_groups = 0; /**< The row groups skipped by the ranges in the last load */
+
+    void write(Brain* brain_);
+    bool writeFile(Brain* brain_, const std::string& path);
+
+    Brain* load(const uint8_t* data, size_t size);
+    Brain* loadFile(const std::string& path);
+
+    ColumnarFile() = default;
+};
@@ -0,0 +1,398 @@
+/**
+  * @file compactor.cpp
+  * This is the documentation of the `compactor.cpp` file
+  *
+  * @brief Description
+  * Implementation of the Compactor class methods, the sealing and merging passes
+  * and the background thread
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <vector>
+
+// Nativite engine imports
+#include "compactor.hpp"
+#include "../Dictionary/dictionary.hpp"
+#include "../Epoch/epoch.hpp"
+#include "../Mvcc/mvcc.hpp"
+
+
+/**
+  * @internal
+  * The `Compactor::isFull` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * Evaluates if `bucket_` is a mutable and live bucket with at least `seal_height` rows
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool Compactor::isFull(const Bucket* bucket_) const {
+  return
+    !bucket_->sealed &&
+    bucket_->version_end == Bucket::live_version &&
+    bucket_->height() >= seal_height;
+}
+
+
+/**
+  * @internal
+  * The `Compactor::isSmall` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * Evaluates if `bucket_` is a sealed and live bucket with less than `merge_height`
+  * rows, a removed version must keep its rows for the snapshots
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool Compactor::isSmall(const Bucket* bucket_) const {
+  return
+    bucket_->sealed &&
+    bucket_->version_end == Bucket::live_version &&
+    bucket_->height() < merge_height;
+}
+
+
+/**
+  * @internal
+  * The `Compactor::clusterDictionary` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * Takes the dictionary shared by the buckets of `cluster_`, creating it the
+  * first time like `Cluster::encodeStringStacks`
+  *
+  * @return
+  * Returns the dictionary of the cluster
+*/
+
+
+Dictionary* Compactor::clusterDictionary(Cluster* cluster_) {
+  if (cluster_->dictionary == nullptr) {
+    cluster_->dictionary = new Dictionary();
+  }
+  return cluster_->dictionary;
+}
+
+
+/**
+  * @internal
+  * The `Compactor::sealFullBuckets` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * Seals every full bucket of `cluster_` with the dictionary of the cluster
+  *
+  * @return
+  * Returns the number of sealed buckets
+*/
+
+
+size_t Compactor::sealFullBuckets(Cluster* cluster_) {
+  size_t sealed = 0;
+
+  cluster_->forEachBucket([&](Bucket* bucket_) {
+    if (isFull(bucket_)) {
+      bucket_->seal(key_stack, clusterDictionary(cluster_));
+      sealed++;
+    }
+  });
+  return sealed;
+}
+
+
+/**
+  * @internal
+  * The `Compactor::mergeSmallBuckets` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * Merges the small sealed buckets of `cluster_` in their order, the rows of the
+  * next small bucket are moved to the current one until it reaches `seal_height`
+  * rows, then the merged bucket is sealed again. The slots of the merged buckets
+  * are removed from the cluster, the rest of the slots keep their order
+  *
+  * @return
+  * Returns the number of buckets that were merged into another one
+*/
+
+
+size_t Compactor::mergeSmallBuckets(Cluster* cluster_) {
+  LeanSlots&        buckets = cluster_->cluster;
+  std::vector<bool> removed(buckets.size(), false);
+  Bucket*           target  = nullptr;
+  size_t            merged  = 0;
+
+  for (size_t index = 0; index < buckets.size(); index++) {
+    Bucket* bucket_ = buckets[index];
+
+    if (bucket_ == nullptr || !isSmall(bucket_)) {
+      continue;
+    }
+
+    if (target == nullptr) {
+      target = bucket_;
+      continue;
+    }
+
+    // The rows are moved, the empty bucket waits for the readers that hold it
+    target->appendRows(bucket_);
+    EpochManager::global().retire(bucket_);
+    removed[index] = true;
+    merged++;
+
+    if (target->height() >= seal_height) {
+      target->seal(key_stack, clusterDictionary(cluster_));
+      target = nullptr;
+    }
+  }
+
+  if (target != nullptr && !target->sealed) {
+    target->seal(key_stack, clusterDictionary(cluster_));
+  }
+
+  if (merged > 0) {
+    size_t kept = 0;
+
+    for (size_t index = 0; index < buckets.size(); index++) {
+      if (!removed[index]) {
+        buckets[kept++] = buckets[index];
+      }
+    }
+    buckets.resize(kept);
+    cluster_->rebuildBucketSlots();
+  }
+  return merged;
+}
+
+
+/**
+  * @internal
+  * The `Compactor::compactCluster` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * Seals the full buckets of `cluster_` and merges its small sealed buckets,
+  * the caller holds the lock of the cluster exclusively
+  *
+  * @return
+  * Returns the number of sealed and merged buckets
+*/
+
+
+size_t Compactor::compactCluster(Cluster* cluster_) {
+  if (cluster_ == nullptr) {
+    return 0;
+  }
+  return sealFullBuckets(cluster_) + mergeSmallBuckets(cluster_);
+}
+
+
+/**
+  * @internal
+  * The `Compactor::compactBrain` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * Flushes the append buffer of every cluster of the `brain` field, runs
+  * `Compactor::compactCluster` over it and refreshes the directory of the brain
+  * for the changed clusters. Only one
+  * cluster is locked at a time, the structure lock is taken exclusively just to
+  * refresh the directory, and the merged buckets are collected at the end
+  *
+  * @return
+  * Returns the number of sealed and merged buckets
+*/
+
+
+size_t Compactor::compactBrain() {
+  size_t compacted = 0;
+
+  if (brain == nullptr) {
+    return 0;
+  }
+
+  for (size_t index = 0; ; index++) {
+    Cluster* cluster_  = nullptr;
+    size_t   changed   = 0;
+    bool     flushed   = false;
+    {
+      auto structure = brain->lockStructureShared();
+
+      if (index >= brain->brain.size()) {
+        break;
+      }
+      cluster_ = brain->brain[index];
+
+      if (cluster_ == nullptr) {
+        continue;
+      }
+
+      // The appended rows become a bucket of the pass, while a snapshot is pinned
+      // only if the Mvcc commits the flush, so the snapshot does not see them
+      if (
+        versions == nullptr ||
+        cluster_->mvcc.load(std::memory_order_acquire) != nullptr ||
+        versions->pinnedCount() == 0
+      ) {
+        flushed = cluster_->flushAppends() > 0;
+      }
+
+      auto lock = cluster_->lockBuckets();
+
+      // A snapshot could be reading the buckets without locks, and a cursor
+      // could be between two batches of the cluster
+      const bool PINNED =
+        (versions != nullptr && versions->pinnedCount() > 0) ||
+        cluster_->pinned_exports.load(std::memory_order_acquire) > 0;
+
+      if (!PINNED) {
+        changed = compactCluster(cluster_);
+      }
+    }
+
+    // The sealed buckets change the zones of the cluster, the slot is
+    // checked again because the cluster can be removed between the locks
+    if (changed > 0 || flushed) {
+      auto structure = brain->lockStructure();
+
+      if (index < brain->brain.size() && brain->brain[index] == cluster_) {
+        auto lock = cluster_->lockBucketsShared();
+        brain->refreshDirectory(index);
+      }
+    }
+    compacted += changed;
+  }
+
+  // The merged buckets are freed once the queries of the pass have finished
+  EpochManager::global().collect();
+
+  return compacted;
+}
+
+
+/**
+  * @internal
+  * The `Compactor::run` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * The loop of the background thread, runs a pass every `interval` until `Compactor::stop` is called
+  *
+  * @return
+  * This function does not return anything, since it
+  * only runs the passes
+*/
+
+
+void Compactor::run() {
+  std::unique_lock<std::mutex> state_lock(state_mutex);
+
+  while (running) {
+    wake.wait_for(state_lock, interval, [this] { return !running; });
+
+    if (!running) {
+      break;
+    }
+
+    state_lock.unlock();
+    compactBrain();
+    state_lock.lock();
+  }
+}
+
+
+/**
+  * @internal
+  * The `Compactor::start` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * Starts the background thread, it does nothing if it is already running
+  *
+  * @return
+  * This function does not return anything, since it
+  * only starts the thread
+*/
+
+
+void Compactor::start() {
+  std::lock_guard<std::mutex> state_lock(state_mutex);
+
+  if (running) {
+    return;
+  }
+
+  running = true;
+  thread  = std::thread(&Compactor::run, this);
+}
+
+
+/**
+  * @internal
+  * The `Compactor::stop` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * Stops the background thread and waits for its current pass
+  *
+  * @return
+  * This function does not return anything, since it
+  * only stops the thread
+*/
+
+
+void Compactor::stop() {
+  {
+    std::lock_guard<std::mutex> state_lock(state_mutex);
+    running = false;
+  }
+  wake.notify_all();
+
+  if (thread.joinable()) {
+    thread.join();
+  }
+}
+
+
+/**
+  * @internal
+  * The `Compactor::isRunning` method is internal of the `Compactor` class
+  *
+  * @return
+  * Returns a boolean, true if the background thread is running
+*/
+
+
+bool Compactor::isRunning() {
+  std::lock_guard<std::mutex> state_lock(state_mutex);
+  return running;
+}
+
+
+/**
+  * @internal
+  * The `Compactor::Compactor` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * The constructor of the `Compactor` class, the background thread
+  * is not started until `Compactor::start` is called
+*/
+
+
+Compactor::Compactor(Brain* brain_v) : brain(brain_v) {}
+
+
+/**
+  * @internal
+  * The `Compactor::~Compactor` method is internal of the `Compactor` class
+  *
+  * @brief Description
+  * The destructor of the `Compactor` class, stops the background thread
+*/
+
+
+Compactor::~Compactor() noexcept {
+  stop();
+}
@@ -0,0 +1,93 @@
+/**
+  * @file compactor.hpp
+  * This is the documentation of the `compactor.hpp` file
+  *
+  * @brief Description
+  * Implementation of the Compactor class, the background task that seals the full
+  * buckets and merges the small sealed buckets of a brain in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+
+// Nativite engine imports
+#include "../Brain/brain.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+
+// Forward reference to `Mvcc`
+class Mvcc;
+
+
+/**
+ * @internal
+ * The Compactor class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Keeps the buckets of a brain dense and read optimized, the mutable buckets that
+ * reach `seal_height` rows are sealed and the sealed buckets with less than
+ * `merge_height` rows are merged into bigger sealed buckets
+ *
+ * @details
+ * The passes can be run by hand with `Compactor::compactBrain` or every `interval`
+ * by a background thread with `Compactor::start`. Every cluster is compacted holding
+ * the structure lock of the brain shared and the lock of the cluster exclusively, so
+ * the queries and the writers of the other clusters keep running during a pass.
+ * The passes change the buckets in place, so a cluster is skipped while a snapshot
+ * of `versions` is pinned, and the removed versions are never sealed or merged.
+*/
+
+
+class Compactor {
+  protected:
+    // Internal functions of the class
+    bool isFull(const Bucket* bucket_) const;
+    bool isSmall(const Bucket* bucket_) const;
+
+    Dictionary* clusterDictionary(Cluster* cluster_);
+
+    size_t sealFullBuckets(Cluster* cluster_);
+    size_t mergeSmallBuckets(Cluster* cluster_);
+
+    // The loop of the background thread
+    void run();
+
+    std::thread             thread;       /**< The background thread */
+    std::mutex              state_mutex;  /**< Protects the `running` field */
+    std::condition_variable wake;         /**< Wakes the background thread to stop it */
+    bool                    running = false;
+
+  public:
+    Brain* brain = nullptr; /**< The brain that is compacted */
+
+    size_t seal_height  = 16 * NumericLayer::block_size; /**< The rows of a full bucket */
+    size_t merge_height = 4 * NumericLayer::block_size;  /**< The rows under which a sealed
+                                                              bucket is merged */
+    size_t key_stack    = Bucket::no_key;                /**< The stack that sorts the rows
+                                                              of the sealed buckets */
+
+    std::chrono::milliseconds interval{100}; /**< The time between background passes */
+
+    const Mvcc* versions = nullptr; /**< The versions of the brain, if it has them */
+
+    size_t compactCluster(Cluster* cluster_);
+    size_t compactBrain();
+
+    void start();
+    void stop();
+    bool isRunning();
+
+    Compactor(Brain* brain_v);
+
+    ~Compactor() noexcept;
+};
@@ -0,0 +1,887 @@
+/**
+  * @file compression.cpp
+  * This is the documentation of the `compression.cpp` file
+  *
+  * @brief Description
+  * Implementation of the NumericLayer class methods, the encoders and decoders
+  * of every block encoding.
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+// Nativite engine imports
+#include "compression.hpp"
+
+// The bits that are used for the length of a run, a block has at most 1024 values
+static constexpr unsigned RUN_LENGTH_BITS = 16;
+
+//////////////////////////////////
+// ////////// BIT STREAM /////////
+//////////////////////////////////
+
+
+/**
+  * @internal
+  * The `NumericLayer::BitStream::write` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Writes the `width` lower bits of `value` at `position`, a value can be split
+  * between two words
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the bits
+*/
+
+
+void NumericLayer::BitStream::write(uint64_t value, unsigned width) {
+  if (width == 0) {
+    return;
+  }
+  if (width < 64) {
+    value &= (uint64_t(1) << width) - 1;
+  }
+
+  const size_t   WORD  = position >> 6;
+  const unsigned SHIFT = position & 63;
+
+  if (WORD + 1 >= data->size()) {
+    data->resize(WORD + 2, 0);
+  }
+
+  (*data)[WORD] |= value << SHIFT;
+  if (SHIFT + width > 64) {
+    (*data)[WORD + 1] |= value >> (64 - SHIFT);
+  }
+  position += width;
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::BitStream::read` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Reads `width` bits from `position`, the inverse of `BitStream::write`
+  *
+  * @return
+  * Returns the read bits in the lower bits of the value
+*/
+
+
+uint64_t NumericLayer::BitStream::read(unsigned width) {
+  if (width == 0) {
+    return 0;
+  }
+
+  const size_t   WORD  = position >> 6;
+  const unsigned SHIFT = position & 63;
+
+  uint64_t value = (*data)[WORD] >> SHIFT;
+  if (SHIFT + width > 64) {
+    value |= (*data)[WORD + 1] << (64 - SHIFT);
+  }
+  if (width < 64) {
+    value &= (uint64_t(1) << width) - 1;
+  }
+  position += width;
+  return value;
+}
+
+//////////////////////////////////
+// ////////// ENCODING ///////////
+//////////////////////////////////
+
+
+/**
+  * @internal
+  * The `NumericLayer::countBits` method is internal of the `NumericLayer` class
+  *
+  * @return
+  * Returns the number of bits needed to store the numbers between 0 and `range`
+*/
+
+
+size_t NumericLayer::countBits(uint64_t range) {
+  return std::bit_width(range);
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::fillNulls` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Replaces the values of the null rows of a block by the previous value, so
+  * the nulls do not break the runs or widen the ranges of the encodings
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the null values of `bits`
+*/
+
+
+void NumericLayer::fillNulls(uint64_t* bits, size_t count) {
+  if (validity.empty()) {
+    return;
+  }
+
+  const size_t FIRST_ROW = blocks.size() * block_size;
+  size_t       first_valid = count;
+
+  for (size_t index = 0; index < count; index++) {
+    if (isValid(FIRST_ROW + index)) {
+      first_valid = index;
+      break;
+    }
+  }
+
+  uint64_t previous = first_valid < count ? bits[first_valid] : 0;
+
+  for (size_t index = 0; index < count; index++) {
+    if (isValid(FIRST_ROW + index)) {
+      previous = bits[index];
+    } else {
+      bits[index] = previous;
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::writePacked` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Bit packs `count` values of `width` bits at the end of the `data` field
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the values to the `data` field
+*/
+
+
+void NumericLayer::writePacked(
+  numeric_block_t& block,
+  const uint64_t* values,
+  size_t count,
+  unsigned width
+) {
+  block.offset    = data.size();
+  block.bit_width = static_cast<uint8_t>(width);
+
+  BitStream stream{&data, block.offset * 64};
+
+  for (size_t index = 0; index < count; index++) {
+    stream.write(values[index], width);
+  }
+  data.resize((stream.position + 63) / 64);
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::writeRunLength` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Writes the runs of equal values of a block as pairs of value and length
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the runs to the `data` field
+*/
+
+
+void NumericLayer::writeRunLength(
+  numeric_block_t& block,
+  const uint64_t* values,
+  size_t count
+) {
+  block.offset = data.size();
+  block.runs   = 0;
+
+  BitStream stream{&data, block.offset * 64};
+  size_t    index = 0;
+
+  while (index < count) {
+    size_t length = 1;
+
+    while (index + length < count && values[index + length] == values[index]) {
+      length++;
+    }
+
+    stream.write(values[index], 64);
+    stream.write(length, RUN_LENGTH_BITS);
+    block.runs++;
+    index += length;
+  }
+  data.resize((stream.position + 63) / 64);
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::writeGorilla` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Writes the real numbers of a block with the Gorilla XOR encoding, every value is
+  * XORed with the previous one and only the meaningful bits of the XOR are written,
+  * reusing the window of leading and trailing zeros of the previous XOR if possible
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the values to the `data` field
+*/
+
+
+void NumericLayer::writeGorilla(
+  numeric_block_t& block,
+  const uint64_t* values,
+  size_t count
+) {
+  block.offset = data.size();
+
+  BitStream stream{&data, block.offset * 64};
+  stream.write(values[0], 64);
+
+  unsigned previous_leading  = 64;
+  unsigned previous_trailing = 64;
+
+  for (size_t index = 1; index < count; index++) {
+    const uint64_t XOR = values[index] ^ values[index - 1];
+
+    if (XOR == 0) {
+      stream.write(0, 1);
+      continue;
+    }
+
+    unsigned leading  = std::min<unsigned>(std::countl_zero(XOR), 31);
+    unsigned trailing = std::countr_zero(XOR);
+
+    stream.write(1, 1);
+
+    if (
+      previous_leading != 64 &&
+      leading >= previous_leading &&
+      trailing >= previous_trailing
+    ) {
+      stream.write(0, 1);
+      stream.write(XOR >> previous_trailing, 64 - previous_leading - previous_trailing);
+    } else {
+      const unsigned MEANINGFUL = 64 - leading - trailing;
+
+      stream.write(1, 1);
+      stream.write(leading, 5);
+      stream.write(MEANINGFUL - 1, 6);
+      stream.write(XOR >> trailing, MEANINGFUL);
+
+      previous_leading  = leading;
+      previous_trailing = trailing;
+    }
+  }
+  data.resize((stream.position + 63) / 64);
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::compressIntegerBlock` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Estimates the bits of every integer encoding for the block and writes it
+  * with the smallest one, ties prefer the encodings that decode faster
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the block to the layer
+*/
+
+
+void NumericLayer::compressIntegerBlock(const int64_t* values, size_t count) {
+  numeric_block_t block;
+  uint64_t        bits[block_size];
+  uint64_t        packed[block_size];
+
+  block.count = static_cast<uint32_t>(count);
+  std::memcpy(bits, values, count * sizeof(int64_t));
+  fillNulls(bits, count);
+
+  int64_t minimum       = static_cast<int64_t>(bits[0]);
+  int64_t maximum       = minimum;
+  int64_t delta_minimum = std::numeric_limits<int64_t>::max();
+  int64_t delta_maximum = std::numeric_limits<int64_t>::min();
+  size_t  runs          = 1;
+
+  for (size_t index = 1; index < count; index++) {
+    const int64_t VALUE = static_cast<int64_t>(bits[index]);
+    const int64_t DELTA = static_cast<int64_t>(bits[index] - bits[index - 1]);
+
+    minimum       = std::min(minimum, VALUE);
+    maximum       = std::max(maximum, VALUE);
+    delta_minimum = std::min(delta_minimum, DELTA);
+    delta_maximum = std::max(delta_maximum, DELTA);
+    runs         += bits[index] != bits[index - 1];
+  }
+
+  const unsigned FOR_WIDTH   = countBits(static_cast<uint64_t>(maximum) - static_cast<uint64_t>(minimum));
+  const unsigned DELTA_WIDTH = count > 1
+    ? countBits(static_cast<uint64_t>(delta_maximum) - static_cast<uint64_t>(delta_minimum))
+    : 0;
+
+  const size_t PLAIN_BITS = 64 * count;
+  const size_t FOR_BITS   = FOR_WIDTH * count;
+  const size_t DELTA_BITS = DELTA_WIDTH * (count - 1);
+  const size_t RUN_BITS   = runs * (64 + RUN_LENGTH_BITS);
+
+  const size_t BEST = std::min({PLAIN_BITS, FOR_BITS, DELTA_BITS, RUN_BITS});
+
+  if (FOR_BITS == BEST) {
+    block.encoding = numeric_encoding_t::frame_of_reference;
+    block.base     = minimum;
+
+    for (size_t index = 0; index < count; index++) {
+      packed[index] = bits[index] - static_cast<uint64_t>(minimum);
+    }
+    writePacked(block, packed, count, FOR_WIDTH);
+  } else if (DELTA_BITS == BEST) {
+    block.encoding  = numeric_encoding_t::delta;
+    block.base      = static_cast<int64_t>(bits[0]);
+    block.reference = delta_minimum;
+
+    for (size_t index = 1; index < count; index++) {
+      packed[index - 1] = bits[index] - bits[index - 1] - static_cast<uint64_t>(delta_minimum);
+    }
+    writePacked(block, packed, count - 1, DELTA_WIDTH);
+  } else if (RUN_BITS == BEST) {
+    block.encoding = numeric_encoding_t::run_length;
+    writeRunLength(block, bits, count);
+  } else {
+    block.encoding = numeric_encoding_t::plain;
+    writePacked(block, bits, count, 64);
+  }
+
+  blocks.push_back(block);
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::compressRealBlock` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Writes the block with Gorilla, run length or plain encoding, whichever takes
+  * less bits, Gorilla is measured by encoding it and rolled back if it loses
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the block to the layer
+*/
+
+
+void NumericLayer::compressRealBlock(const double* values, size_t count) {
+  numeric_block_t block;
+  uint64_t        bits[block_size];
+
+  block.count = static_cast<uint32_t>(count);
+  std::memcpy(bits, values, count * sizeof(double));
+  fillNulls(bits, count);
+
+  size_t runs = 1;
+
+  for (size_t index = 1; index < count; index++) {
+    runs += bits[index] != bits[index - 1];
+  }
+
+  const size_t PLAIN_BITS = 64 * count;
+  const size_t RUN_BITS   = runs * (64 + RUN_LENGTH_BITS);
+  const size_t START      = data.size();
+
+  writeGorilla(block, bits, count);
+
+  const size_t GORILLA_BITS = (data.size() - START) * 64;
+
+  if (GORILLA_BITS < std::min(PLAIN_BITS, RUN_BITS)) {
+    block.encoding = numeric_encoding_t::gorilla;
+  } else {
+    data.resize(START);
+
+    if (RUN_BITS < PLAIN_BITS) {
+      block.encoding = numeric_encoding_t::run_length;
+      writeRunLength(block, bits, count);
+    } else {
+      block.encoding = numeric_encoding_t::plain;
+      writePacked(block, bits, count, 64);
+    }
+  }
+
+  blocks.push_back(block);
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::compress` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Compresses `count` integers block by block, `validity_v` is the validity bitmap
+  * of the values or nullptr if every value is valid. The statistics of every block
+  * are taken from the valid values only
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the layer
+*/
+
+
+void NumericLayer::compress(
+  const int64_t* values,
+  size_t count,
+  const uint64_t* validity_v
+) {
+  kind = numeric_kind_t::integer;
+  size = count;
+  blocks.clear();
+  data.clear();
+  export_hold.detach(false, validity);
+  validity.clear();
+
+  if (validity_v != nullptr) {
+    validity.assign(validity_v, validity_v + (count + 63) / 64);
+  }
+
+  for (size_t first = 0; first < count; first += block_size) {
+    const size_t COUNT = std::min(block_size, count - first);
+
+    compressIntegerBlock(values + first, COUNT);
+
+    numeric_block_t& block = blocks.back();
+
+    for (size_t index = 0; index < COUNT; index++) {
+      if (!isValid(first + index)) {
+        continue;
+      }
+
+      const int64_t VALUE = values[first + index];
+
+      block.minimum    = block.has_values ? std::min(block.minimum, VALUE) : VALUE;
+      block.maximum    = block.has_values ? std::max(block.maximum, VALUE) : VALUE;
+      block.has_values = true;
+    }
+    block.real_minimum = static_cast<double>(block.minimum);
+    block.real_maximum = static_cast<double>(block.maximum);
+  }
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::compress` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Compresses `count` real numbers block by block, `validity_v` is the validity
+  * bitmap of the values or nullptr if every value is valid. The NaNs are not in the
+  * statistics of their block, it only records that it has some
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the layer
+*/
+
+
+void NumericLayer::compress(
+  const double* values,
+  size_t count,
+  const uint64_t* validity_v
+) {
+  kind = numeric_kind_t::real;
+  size = count;
+  blocks.clear();
+  data.clear();
+  export_hold.detach(false, validity);
+  validity.clear();
+
+  if (validity_v != nullptr) {
+    validity.assign(validity_v, validity_v + (count + 63) / 64);
+  }
+
+  for (size_t first = 0; first < count; first += block_size) {
+    const size_t COUNT = std::min(block_size, count - first);
+
+    compressRealBlock(values + first, COUNT);
+
+    numeric_block_t& block = blocks.back();
+
+    for (size_t index = 0; index < COUNT; index++) {
+      if (!isValid(first + index)) {
+        continue;
+      }
+
+      const double VALUE = values[first + index];
+
+      if (std::isnan(VALUE)) {
+        block.has_nan = true;
+        continue;
+      }
+
+      block.real_minimum = block.has_values ? std::min(block.real_minimum, VALUE) : VALUE;
+      block.real_maximum = block.has_values ? std::max(block.real_maximum, VALUE) : VALUE;
+      block.has_values   = true;
+    }
+  }
+}
+
+//////////////////////////////////
+// ////////// DECODING ///////////
+//////////////////////////////////
+
+
+/**
+  * @internal
+  * The `NumericLayer::decodeBits` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Decodes the 64 bit patterns of a whole block into `output`, the packed values
+  * are unpacked first and the base is added in a separate loop without branches
+  *
+  * @return
+  * This function does not return anything, since it
+  * only decodes the block to `output`
+*/
+
+
+void NumericLayer::decodeBits(size_t block_index, uint64_t* output) const {
+  const numeric_block_t& block = blocks[block_index];
+
+  BitStream stream{const_cast<std::vector<uint64_t>*>(&data), block.offset * 64};
+
+  switch (block.encoding) {
+    case numeric_encoding_t::plain:
+      std::memcpy(output, data.data() + block.offset, block.count * sizeof(uint64_t));
+      break;
+
+    case numeric_encoding_t::frame_of_reference: {
+      for (size_t index = 0; index < block.count; index++) {
+        output[index] = stream.read(block.bit_width);
+      }
+
+      const uint64_t BASE = static_cast<uint64_t>(block.base);
+      for (size_t index = 0; index < block.count; index++) {
+        output[index] += BASE;
+      }
+      break;
+    }
+
+    case numeric_encoding_t::delta: {
+      output[0] = static_cast<uint64_t>(block.base);
+
+      for (size_t index = 1; index < block.count; index++) {
+        output[index] = stream.read(block.bit_width);
+      }
+
+      const uint64_t REFERENCE = static_cast<uint64_t>(block.reference);
+      for (size_t index = 1; index < block.count; index++) {
+        output[index] += REFERENCE + output[index - 1];
+      }
+      break;
+    }
+
+    case numeric_encoding_t::run_length: {
+      size_t index = 0;
+
+      for (uint32_t run = 0; run < block.runs; run++) {
+        const uint64_t VALUE  = stream.read(64);
+        const uint64_t LENGTH = stream.read(RUN_LENGTH_BITS);
+
+        std::fill(output + index, output + index + LENGTH, VALUE);
+        index += LENGTH;
+      }
+      break;
+    }
+
+    case numeric_encoding_t::gorilla: {
+      unsigned leading  = 0;
+      unsigned trailing = 0;
+
+      output[0] = stream.read(64);
+
+      for (size_t index = 1; index < block.count; index++) {
+        if (stream.read(1) == 0) {
+          output[index] = output[index - 1];
+          continue;
+        }
+
+        if (stream.read(1) == 1) {
+          leading  = static_cast<unsigned>(stream.read(5));
+          trailing = 64 - leading - (static_cast<unsigned>(stream.read(6)) + 1);
+        }
+
+        output[index] = output[index - 1] ^ (stream.read(64 - leading - trailing) << trailing);
+      }
+      break;
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::blockCount` method is internal of the `NumericLayer` class
+  *
+  * @return
+  * Returns the number of blocks of the layer
+*/
+
+
+size_t NumericLayer::blockCount() const {
+  return blocks.size();
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::decodeBlock` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Decodes the block `block_index` as integers into `output`, which must have room
+  * for `block_size` values, the real layers are truncated to integers
+  *
+  * @return
+  * Returns the number of decoded values
+*/
+
+
+size_t NumericLayer::decodeBlock(size_t block_index, int64_t* output) const {
+  uint64_t bits[block_size];
+  const size_t COUNT = blocks[block_index].count;
+
+  decodeBits(block_index, bits);
+
+  if (kind == numeric_kind_t::integer) {
+    std::memcpy(output, bits, COUNT * sizeof(int64_t));
+  } else {
+    for (size_t index = 0; index < COUNT; index++) {
+      output[index] = static_cast<int64_t>(std::bit_cast<double>(bits[index]));
+    }
+  }
+  return COUNT;
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::decodeBlock` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Decodes the block `block_index` as real numbers into `output`, which must have
+  * room for `block_size` values, the integer layers are converted to real numbers
+  *
+  * @return
+  * Returns the number of decoded values
+*/
+
+
+size_t NumericLayer::decodeBlock(size_t block_index, double* output) const {
+  uint64_t bits[block_size];
+  const size_t COUNT = blocks[block_index].count;
+
+  decodeBits(block_index, bits);
+
+  if (kind == numeric_kind_t::real) {
+    std::memcpy(output, bits, COUNT * sizeof(double));
+  } else {
+    for (size_t index = 0; index < COUNT; index++) {
+      output[index] = static_cast<double>(static_cast<int64_t>(bits[index]));
+    }
+  }
+  return COUNT;
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::isValid` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Evaluates if the row `row` has a value, that is it was not an empty slot
+  * or a null astruct
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool NumericLayer::isValid(size_t row) const {
+  return
+    validity.empty() ||
+    ((validity[row >> 6] >> (row & 63)) & 1) != 0;
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::isWellFormed` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * Evaluates if the blocks can be decoded without reading outside of the `data` field
+  * or writing more than `block_size` values, it is used after reading a layer from an
+  * untrusted input. The run length and Gorilla blocks are walked without decoding them.
+  * Every block but the last one must be full, the readers find the block of a row
+  * with `row / block_size`
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool NumericLayer::isWellFormed() const {
+  const size_t DATA_BITS = data.size() * 64;
+  size_t       rows      = 0;
+
+  if (!validity.empty() && validity.size() != (size + 63) / 64) {
+    return false;
+  }
+
+  for (size_t block_index = 0; block_index < blocks.size(); block_index++) {
+    const numeric_block_t& block = blocks[block_index];
+
+    if (
+      block.count == 0 ||
+      block.count > block_size ||
+      (block_index + 1 < blocks.size() && block.count != block_size) ||
+      block.bit_width > 64 ||
+      block.offset > data.size() ||
+      static_cast<uint8_t>(block.encoding) > static_cast<uint8_t>(numeric_encoding_t::gorilla)
+    ) {
+      return false;
+    }
+
+    const size_t FIRST = block.offset * 64;
+
+    BitStream stream{const_cast<std::vector<uint64_t>*>(&data), FIRST};
+
+    // Reads `width` bits only if they are inside the `data` field
+    auto read = [&](unsigned width, uint64_t& value) {
+      if (stream.position + width > DATA_BITS) {
+        return false;
+      }
+      value = stream.read(width);
+      return true;
+    };
+
+    switch (block.encoding) {
+      case numeric_encoding_t::plain:
+        if (FIRST + 64 * size_t(block.count) > DATA_BITS) {
+          return false;
+        }
+        break;
+
+      case numeric_encoding_t::frame_of_reference:
+        if (FIRST + size_t(block.bit_width) * block.count > DATA_BITS) {
+          return false;
+        }
+        break;
+
+      case numeric_encoding_t::delta:
+        if (FIRST + size_t(block.bit_width) * (block.count - 1) > DATA_BITS) {
+          return false;
+        }
+        break;
+
+      case numeric_encoding_t::run_length: {
+        size_t   length_sum = 0;
+        uint64_t value      = 0;
+
+        for (uint32_t run = 0; run < block.runs; run++) {
+          if (!read(64, value) || !read(RUN_LENGTH_BITS, value)) {
+            return false;
+          }
+          length_sum += value;
+        }
+        if (length_sum != block.count) {
+          return false;
+        }
+        break;
+      }
+
+      case numeric_encoding_t::gorilla: {
+        uint64_t value   = 0;
+        unsigned leading = 0, trailing = 0;
+        bool     has_window = false;
+
+        if (!read(64, value)) {
+          return false;
+        }
+
+        for (size_t index = 1; index < block.count; index++) {
+          if (!read(1, value)) {
+            return false;
+          }
+          if (value == 0) {
+            continue;
+          }
+          if (!read(1, value)) {
+            return false;
+          }
+          if (value == 1) {
+            uint64_t meaningful = 0;
+
+            if (!read(5, value) || !read(6, meaningful) || value + meaningful + 1 > 64) {
+              return false;
+            }
+            leading    = static_cast<unsigned>(value);
+            trailing   = 64 - leading - static_cast<unsigned>(meaningful + 1);
+            has_window = true;
+          }
+          if (!has_window || !read(64 - leading - trailing, value)) {
+            return false;
+          }
+        }
+        break;
+      }
+    }
+    rows += block.count;
+  }
+
+  return rows == size;
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::memoryUsage` method is internal of the `NumericLayer` class
+  *
+  * @return
+  * Returns the bytes used by the blocks, the encoded values and the validity bitmap
+*/
+
+
+size_t NumericLayer::memoryUsage() const {
+  return
+    blocks.size() * sizeof(numeric_block_t) +
+    data.size() * sizeof(uint64_t) +
+    validity.size() * sizeof(uint64_t);
+}
+
+
+/**
+  * @internal
+  * The `NumericLayer::~NumericLayer` method is internal of the `NumericLayer` class
+  *
+  * @brief Description
+  * The destructor of the `NumericLayer` class, the validity bitmap held by an
+  * export is moved to its hold instead of being freed
+*/
+
+
+NumericLayer::~NumericLayer() noexcept {
+  export_hold.detach(false, validity);
+}
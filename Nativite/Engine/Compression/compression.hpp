@@ -0,0 +1,135 @@
+/**
+  * @file compression.hpp
+  * This is the documentation of the `compression.hpp` file
+  *
+  * @brief Description
+  * Implementation of the NumericLayer class, the lightweight compression of the numeric
+  * 3D vertical stacks of the buckets (delta, frame of reference, run length and Gorilla) in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Nativite engine imports
+#include "../Epoch/epoch.hpp"
+
+
+/**
+ * @internal
+ * The NumericLayer class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * A compressed stack of integers or real numbers, the values are split in blocks
+ * of `block_size` values and every block chooses the encoding that takes less bits
+ *
+ * @details
+ * The integer blocks can be plain, frame of reference (minimum plus bit packed offsets),
+ * delta (first value plus bit packed differences) or run length encoded. The real blocks
+ * can be plain, run length encoded or Gorilla XOR encoded. The scans decode a whole block
+ * at once into a buffer of `block_size` values, so the loops over the values are tight and
+ * vectorizable. The empty slots and null astructs are marked in the `validity` field,
+ * bit `n` of the word `n / 64` is 1 if the row `n` has a value, the same layout as the
+ * Arrow validity bitmaps, so it is exported without a copy.
+*/
+
+
+class NumericLayer {
+  // Types
+  public:
+    // The number of values of a block
+    static constexpr size_t block_size = 1024;
+
+    // The type of the numbers of the layer
+    enum class numeric_kind_t : uint8_t {
+      integer = 0,
+      real    = 1
+    };
+
+    // The encoding of a block
+    enum class numeric_encoding_t : uint8_t {
+      plain              = 0,
+      frame_of_reference = 1,
+      delta              = 2,
+      run_length         = 3,
+      gorilla            = 4
+    };
+
+    // The metadata of a block, the values are in the `data` field from the word `offset`
+    struct numeric_block_t {
+      numeric_encoding_t encoding  = numeric_encoding_t::plain;
+      uint8_t            bit_width = 0;  /**< The width of the packed values */
+      uint32_t           count     = 0;  /**< The number of values of the block */
+      uint32_t           runs      = 0;  /**< The number of runs of a run length block */
+      size_t             offset    = 0;  /**< The first word of the block in `data` */
+      int64_t            base      = 0;  /**< The minimum of FOR, the first value of delta */
+      int64_t            reference = 0;  /**< The minimum difference of delta */
+
+      int64_t minimum      = 0; /**< The statistics of the block, nulls and NaNs are not counted */
+      int64_t maximum      = 0;
+      double  real_minimum = 0;
+      double  real_maximum = 0;
+      bool    has_values   = false;
+      bool    has_nan      = false; /**< If the block has a NaN, which is in no range */
+    };
+
+  protected:
+    // A stream of bits over the `data` field, the bits are written from the
+    // least significant bit of every word
+    struct BitStream {
+      std::vector<uint64_t>* data;
+      size_t                 position;
+
+      void write(uint64_t value, unsigned width);
+      uint64_t read(unsigned width);
+    };
+
+    // Internal functions of the class
+    void fillNulls(uint64_t* bits, size_t count);
+
+    void compressIntegerBlock(const int64_t* values, size_t count);
+    void compressRealBlock(const double* values, size_t count);
+
+    void writePacked(numeric_block_t& block, const uint64_t* values, size_t count, unsigned width);
+    void writeRunLength(numeric_block_t& block, const uint64_t* values, size_t count);
+    void writeGorilla(numeric_block_t& block, const uint64_t* values, size_t count);
+
+    void decodeBits(size_t block_index, uint64_t* output) const;
+
+  public:
+    numeric_kind_t kind = numeric_kind_t::integer; /**< The type of the numbers of the layer */
+    size_t         size = 0;                       /**< The number of rows of the layer */
+
+    std::vector<numeric_block_t> blocks;   /**< The blocks of the layer */
+    std::vector<uint64_t>        data;     /**< The encoded values of every block */
+    std::vector<uint64_t>        validity; /**< The validity bitmap, empty if every row has a value */
+
+    MemoryHoldSlot export_hold; /**< The hold of `validity` shared with the exports */
+
+    static size_t countBits(uint64_t range);
+
+    void compress(const int64_t* values, size_t count, const uint64_t* validity_v);
+    void compress(const double* values, size_t count, const uint64_t* validity_v);
+
+    size_t blockCount() const;
+    size_t decodeBlock(size_t block_index, int64_t* output) const;
+    size_t decodeBlock(size_t block_index, double* output) const;
+
+    bool isValid(size_t row) const;
+    bool isWellFormed() const;
+
+    size_t memoryUsage() const;
+
+    NumericLayer() = default;
+    NumericLayer(const NumericLayer& other) = default;
+    NumericLayer& operator=(const NumericLayer& other) = delete;
+
+    ~NumericLayer() noexcept;
+};
@@ -0,0 +1,710 @@
+/**
+  * @file csv_importer.cpp
+  * This is the documentation of the `csv_importer.cpp` file
+  *
+  * @brief Description
+  * Implementation of the CsvImporter class methods, the records parsing, the
+  * type inference, the split of the chunks and the typed layers of the buckets
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+// Nativite engine imports
+#include "csv_importer.hpp"
+#include "../Astruct/astruct.hpp"
+#include "../Dictionary/dictionary.hpp"
+#include "../Compression/compression.hpp"
+#include "../MappedFile/mapped_file.hpp"
+
+
+// A blank line is parsed as a record with one missing field
+static bool isBlankRecord(const std::vector<std::string_view>& fields) {
+  return fields.size() == 1 && fields[0].data() == nullptr;
+}
+
+
+// Removes the spaces around a number
+static std::string_view trimSpaces(std::string_view field) {
+  while (!field.empty() && field.front() == ' ') {
+    field.remove_prefix(1);
+  }
+  while (!field.empty() && field.back() == ' ') {
+    field.remove_suffix(1);
+  }
+  return field;
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::parseRecord` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * Parses the record at `cursor` to views of its fields and moves `cursor` after
+  * its newline. An unquoted empty field is a view without data, a quoted field is
+  * viewed in the input unless it has escaped quotes, then it is copied without them
+  * to `unescaped`. A carriage return before the newline is dropped
+  *
+  * @return
+  * Returns false if there are no more records
+*/
+
+
+bool CsvImporter::parseRecord(
+  const char*& cursor,
+  const char* end,
+  std::vector<std::string_view>& fields,
+  std::deque<std::string>& unescaped
+) const {
+  if (cursor >= end) {
+    return false;
+  }
+
+  fields.clear();
+
+  while (true) {
+    if (quote != 0 && cursor < end && *cursor == quote) {
+      const char* start   = cursor + 1;
+      const char* scan    = start;
+      const char* stop    = end;
+      bool        escaped = false;
+
+      while (scan < end) {
+        const char* closing = static_cast<const char*>(std::memchr(scan, quote, end - scan));
+
+        if (closing == nullptr) {
+          break;
+        }
+
+        if (closing + 1 < end && closing[1] == quote) {
+          escaped = true;
+          scan    = closing + 2;
+          continue;
+        }
+
+        stop = closing;
+        break;
+      }
+
+      std::string_view field(start, stop - start);
+
+      if (escaped) {
+        std::string value;
+        value.reserve(field.size());
+
+        for (size_t index = 0; index < field.size(); index++) {
+          value += field[index];
+          index += field[index] == quote ? 1 : 0;
+        }
+
+        unescaped.push_back(std::move(value));
+        field = unescaped.back();
+      }
+
+      fields.push_back(field);
+      cursor = stop < end ? stop + 1 : end;
+
+      // The bytes between the closing quote and the delimiter are dropped
+      while (cursor < end && *cursor != delimiter && *cursor != '\n') {
+        cursor++;
+      }
+    } else {
+      const char* start = cursor;
+
+      while (cursor < end && *cursor != delimiter && *cursor != '\n') {
+        cursor++;
+      }
+
+      const char* stop = cursor;
+
+      if (stop > start && stop[-1] == '\r' && (cursor == end || *cursor == '\n')) {
+        stop--;
+      }
+
+      fields.push_back(stop > start ? std::string_view(start, stop - start) : std::string_view());
+    }
+
+    if (cursor >= end) {
+      return true;
+    }
+
+    if (*cursor++ == '\n') {
+      return true;
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::findRecordStart` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * Walks from `position`, which is inside a quoted field if `in_quote` is true,
+  * to the first newline outside a quoted field
+  *
+  * @return
+  * Returns the byte after that newline, the first byte of a record, or `end`
+*/
+
+
+const char* CsvImporter::findRecordStart(const char* position, const char* end, bool in_quote) const {
+  for (; position < end; position++) {
+    if (quote != 0 && *position == quote) {
+      in_quote = !in_quote;
+    } else if (*position == '\n' && !in_quote) {
+      return position + 1;
+    }
+  }
+  return end;
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::parseBoolean` method is internal of the `CsvImporter` class
+  *
+  * @return
+  * Returns false if `field` is not `true` or `false` in lower, upper or title case
+*/
+
+
+bool CsvImporter::parseBoolean(std::string_view field, bool& value) {
+  if (field == "true" || field == "TRUE" || field == "True") {
+    value = true;
+    return true;
+  }
+
+  if (field == "false" || field == "FALSE" || field == "False") {
+    value = false;
+    return true;
+  }
+  return false;
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::parseInteger` method is internal of the `CsvImporter` class
+  *
+  * @return
+  * Returns false if `field` is not a 64 bits integer, the spaces around it are ignored
+*/
+
+
+bool CsvImporter::parseInteger(std::string_view field, int64_t& value) {
+  field = trimSpaces(field);
+
+  if (!field.empty() && field.front() == '+') {
+    field.remove_prefix(1);
+  }
+
+  const auto [END, ERROR] = std::from_chars(field.data(), field.data() + field.size(), value);
+  return !field.empty() && ERROR == std::errc() && END == field.data() + field.size();
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::parseReal` method is internal of the `CsvImporter` class
+  *
+  * @return
+  * Returns false if `field` is not a decimal real number, the spaces around it are
+  * ignored and the infinities and not a numbers are not accepted
+*/
+
+
+bool CsvImporter::parseReal(std::string_view field, double& value) {
+  field = trimSpaces(field);
+
+  if (!field.empty() && field.front() == '+') {
+    field.remove_prefix(1);
+  }
+
+  if (field.empty() || field.find_first_of("iInN") != std::string_view::npos) {
+    return false;
+  }
+
+  const auto [END, ERROR] = std::from_chars(field.data(), field.data() + field.size(), value);
+  return ERROR == std::errc() && END == field.data() + field.size();
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::inferTypes` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * Parses the first `sample_rows` records from `cursor` and gives every column
+  * the narrowest type of all its values, boolean, integer, real or string. A
+  * column without values is a string column. The columns without a header name
+  * are named by their index
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the `types` and `names` fields
+*/
+
+
+void CsvImporter::inferTypes(const char* cursor, const char* end) {
+  struct sample_t {
+    bool values  = false;
+    bool boolean = true;
+    bool integer = true;
+    bool real    = true;
+  };
+
+  std::vector<sample_t>         samples(names.size());
+  std::vector<std::string_view> fields;
+  std::deque<std::string>       unescaped;
+
+  for (size_t row = 0; row < sample_rows && parseRecord(cursor, end, fields, unescaped);) {
+    if (isBlankRecord(fields)) {
+      continue;
+    }
+
+    if (samples.empty()) {
+      samples.resize(fields.size());
+    }
+
+    for (size_t column = 0; column < std::min(fields.size(), samples.size()); column++) {
+      const std::string_view FIELD = fields[column];
+      sample_t&              sample = samples[column];
+
+      bool    boolean = false;
+      int64_t integer = 0;
+      double  real    = 0;
+
+      if (FIELD.empty()) {
+        continue;
+      }
+
+      sample.values   = true;
+      sample.boolean &= parseBoolean(FIELD, boolean);
+      sample.integer &= parseInteger(FIELD, integer);
+      sample.real    &= parseReal(FIELD, real);
+    }
+    row++;
+  }
+
+  types.clear();
+
+  for (const auto& sample : samples) {
+    if (!sample.values) {
+      types.push_back(column_type_t::string);
+    } else if (sample.boolean) {
+      types.push_back(column_type_t::boolean);
+    } else if (sample.integer) {
+      types.push_back(column_type_t::integer);
+    } else if (sample.real) {
+      types.push_back(column_type_t::real);
+    } else {
+      types.push_back(column_type_t::string);
+    }
+  }
+
+  while (names.size() < types.size()) {
+    names.push_back(std::to_string(names.size()));
+  }
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::writeIntegerLayer` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * Converts the fields of `column` to integers and compresses them to a numeric
+  * layer of the stack `column`, the empty fields are nulls of the validity bitmap
+  *
+  * @return
+  * Returns false if a field is not an integer, nothing is written in that case
+*/
+
+
+bool CsvImporter::writeIntegerLayer(Bucket* bucket_, const segment_t& segment, size_t column) const {
+  const size_t          COLUMNS = types.size();
+  std::vector<int64_t>  values(segment.rows, 0);
+  std::vector<uint64_t> validity((segment.rows + 63) / 64, 0);
+  bool                  has_nulls = false;
+
+  for (size_t row = 0; row < segment.rows; row++) {
+    const std::string_view FIELD = segment.fields[row * COLUMNS + column];
+
+    if (FIELD.empty()) {
+      has_nulls = true;
+      continue;
+    }
+
+    if (!parseInteger(FIELD, values[row])) {
+      return false;
+    }
+    validity[row >> 6] |= uint64_t(1) << (row & 63);
+  }
+
+  NumericLayer* layer = new NumericLayer();
+  layer->compress(values.data(), segment.rows, has_nulls ? validity.data() : nullptr);
+
+  bucket_->numeric_layers[column] = layer;
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::writeRealLayer` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * Converts the fields of `column` to real numbers and compresses them to a
+  * numeric layer of the stack `column`, the empty fields are nulls
+  *
+  * @return
+  * Returns false if a field is not a real number, nothing is written in that case
+*/
+
+
+bool CsvImporter::writeRealLayer(Bucket* bucket_, const segment_t& segment, size_t column) const {
+  const size_t          COLUMNS = types.size();
+  std::vector<double>   values(segment.rows, 0);
+  std::vector<uint64_t> validity((segment.rows + 63) / 64, 0);
+  bool                  has_nulls = false;
+
+  for (size_t row = 0; row < segment.rows; row++) {
+    const std::string_view FIELD = segment.fields[row * COLUMNS + column];
+
+    if (FIELD.empty()) {
+      has_nulls = true;
+      continue;
+    }
+
+    if (!parseReal(FIELD, values[row])) {
+      return false;
+    }
+    validity[row >> 6] |= uint64_t(1) << (row & 63);
+  }
+
+  NumericLayer* layer = new NumericLayer();
+  layer->compress(values.data(), segment.rows, has_nulls ? validity.data() : nullptr);
+
+  bucket_->numeric_layers[column] = layer;
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::writeBooleanStack` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * Converts the fields of `column` to boolean astructs of the stack `column`,
+  * there is no layer for the booleans, the empty fields are empty slots
+  *
+  * @return
+  * Returns false if a field is not a boolean, nothing is written in that case
+*/
+
+
+bool CsvImporter::writeBooleanStack(Bucket* bucket_, const segment_t& segment, size_t column) const {
+  const size_t      COLUMNS = types.size();
+  std::vector<char> values(segment.rows, 0);
+
+  for (size_t row = 0; row < segment.rows; row++) {
+    const std::string_view FIELD = segment.fields[row * COLUMNS + column];
+    bool                   value = false;
+
+    if (FIELD.empty()) {
+      values[row] = 2;
+      continue;
+    }
+
+    if (!parseBoolean(FIELD, value)) {
+      return false;
+    }
+    values[row] = value ? 1 : 0;
+  }
+
+  Bucket::stack_t& stack = bucket_->bucket[column];
+  stack.reserve(segment.rows);
+
+  for (char value : values) {
+    stack.push_back(value == 2 ? nullptr : new Astruct(value == 1));
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::writeDictionaryLayer` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * Encodes the fields of `column` to a dictionary layer of the stack `column` with
+  * its own dictionary, the missing fields are null codes and the quoted empty
+  * fields are empty strings
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the layer
+*/
+
+
+void CsvImporter::writeDictionaryLayer(Bucket* bucket_, const segment_t& segment, size_t column) const {
+  const size_t     COLUMNS = types.size();
+  DictionaryLayer* layer   = new DictionaryLayer(nullptr);
+
+  layer->codes.reserve(segment.rows);
+
+  for (size_t row = 0; row < segment.rows; row++) {
+    const std::string_view FIELD = segment.fields[row * COLUMNS + column];
+
+    layer->codes.push_back(
+      FIELD.data() == nullptr ? Dictionary::null_code : layer->dictionary->encode(FIELD)
+    );
+  }
+
+  bucket_->dictionary_layers[column] = layer;
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::flushSegment` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * Writes the records of `segment` to a new sealed bucket and inserts it in the
+  * cluster. Every column is written with its inferred type, or with the nearest
+  * type that fits all its values in the segment, then the filters are built
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the bucket and empties the segment
+*/
+
+
+void CsvImporter::flushSegment(segment_t& segment) {
+  if (segment.rows == 0) {
+    return;
+  }
+
+  const size_t     COLUMNS = types.size();
+  Bucket::bucket_t stacks(COLUMNS);
+  Bucket*          bucket_ = new Bucket(&stacks, COLUMNS);
+
+  bucket_->numeric_layers.assign(COLUMNS, nullptr);
+  bucket_->dictionary_layers.assign(COLUMNS, nullptr);
+
+  for (size_t column = 0; column < COLUMNS; column++) {
+    bool written = false;
+
+    switch (types[column]) {
+      case column_type_t::boolean:
+        written = writeBooleanStack(bucket_, segment, column);
+        break;
+      case column_type_t::integer:
+        written =
+          writeIntegerLayer(bucket_, segment, column) ||
+          writeRealLayer(bucket_, segment, column);
+        break;
+      case column_type_t::real:
+        written = writeRealLayer(bucket_, segment, column);
+        break;
+      case column_type_t::string:
+        break;
+    }
+
+    if (!written) {
+      writeDictionaryLayer(bucket_, segment, column);
+    }
+  }
+
+  bucket_->buildFilters();
+  bucket_->sealed = true;
+
+  cluster->insertBucket(bucket_);
+
+  imported_rows.fetch_add(segment.rows, std::memory_order_relaxed);
+  buckets.fetch_add(1, std::memory_order_relaxed);
+
+  segment.fields.clear();
+  segment.unescaped.clear();
+  segment.rows = 0;
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::importChunk` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * The loop of a parsing thread, parses the records of the chunk, which starts at a
+  * record, and writes a bucket every `bucket_rows` records. The missing fields of a
+  * record are nulls and its extra fields are dropped
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the buckets
+*/
+
+
+void CsvImporter::importChunk(const char* begin, const char* end) {
+  const size_t                  COLUMNS = types.size();
+  segment_t                     segment;
+  std::vector<std::string_view> fields;
+
+  segment.fields.reserve(bucket_rows * COLUMNS);
+
+  while (parseRecord(begin, end, fields, segment.unescaped)) {
+    if (isBlankRecord(fields)) {
+      continue;
+    }
+
+    if (fields.size() != COLUMNS) {
+      ragged_rows.fetch_add(1, std::memory_order_relaxed);
+      fields.resize(COLUMNS);
+    }
+
+    segment.fields.insert(segment.fields.end(), fields.begin(), fields.end());
+
+    if (++segment.rows >= bucket_rows) {
+      flushSegment(segment);
+    }
+  }
+  flushSegment(segment);
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::import` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * Imports the CSV `input`: reads the header, infers the types and splits the
+  * records in one chunk per thread. The quotes of the chunks are counted at once
+  * first, the parity of the quotes before a chunk tells if it starts inside a quoted
+  * field, then every chunk is moved to the start of its first record and parsed
+  *
+  * @return
+  * Returns the number of imported records
+*/
+
+
+size_t CsvImporter::import(std::string_view input) {
+  const char*  cursor = input.data();
+  const char*  END    = input.data() + input.size();
+  const size_t BEFORE = imported_rows.load(std::memory_order_relaxed);
+
+  // The byte order mark of the UTF-8 files
+  if (input.starts_with("\xEF\xBB\xBF")) {
+    cursor += 3;
+  }
+
+  names.clear();
+  types.clear();
+
+  if (has_header) {
+    std::vector<std::string_view> fields;
+    std::deque<std::string>       unescaped;
+
+    while (parseRecord(cursor, END, fields, unescaped)) {
+      if (!isBlankRecord(fields)) {
+        names.assign(fields.begin(), fields.end());
+        break;
+      }
+    }
+  }
+
+  inferTypes(cursor, END);
+
+  if (types.empty() || cursor >= END) {
+    return 0;
+  }
+
+  const size_t THREADS = threads != 0
+    ? threads
+    : std::max<size_t>(1, std::thread::hardware_concurrency());
+  const size_t SIZE    = END - cursor;
+
+  std::vector<size_t>      quotes(THREADS, 0);
+  std::vector<std::thread> workers;
+
+  auto split = [&](size_t chunk) { return cursor + SIZE / THREADS * chunk; };
+
+  if (quote != 0 && THREADS > 1) {
+    for (size_t chunk = 0; chunk + 1 < THREADS; chunk++) {
+      workers.emplace_back([&, chunk]() {
+        quotes[chunk] = std::count(split(chunk), split(chunk + 1), quote);
+      });
+    }
+
+    for (auto& worker : workers) {
+      worker.join();
+    }
+    workers.clear();
+  }
+
+  std::vector<const char*> starts(THREADS + 1, END);
+  size_t                   parity = 0;
+
+  starts[0] = cursor;
+
+  for (size_t chunk = 1; chunk < THREADS; chunk++) {
+    parity        += quotes[chunk - 1];
+    starts[chunk]  = std::max(starts[chunk - 1], findRecordStart(split(chunk), END, parity & 1));
+  }
+
+  for (size_t chunk = 0; chunk < THREADS; chunk++) {
+    if (starts[chunk] < starts[chunk + 1]) {
+      workers.emplace_back(&CsvImporter::importChunk, this, starts[chunk], starts[chunk + 1]);
+    }
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  return imported_rows.load(std::memory_order_relaxed) - BEFORE;
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::importFile` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * Maps the file `path` and imports it with `CsvImporter::import`, the fields
+  * are viewed in the mapping and never copied
+  *
+  * @return
+  * Returns the number of imported records, 0 if the file can not be opened
+*/
+
+
+size_t CsvImporter::importFile(const std::string& path) {
+  MappedFile file(path);
+
+  if (!file.isOpen()) {
+    return 0;
+  }
+  return import(file.view());
+}
+
+
+/**
+  * @internal
+  * The `CsvImporter::CsvImporter` method is internal of the `CsvImporter` class
+  *
+  * @brief Description
+  * The constructor of the `CsvImporter` class, the buckets are inserted in `cluster_v`
+*/
+
+
+CsvImporter::CsvImporter(Cluster* cluster_v) : cluster(cluster_v) {}
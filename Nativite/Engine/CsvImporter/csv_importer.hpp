@@ -0,0 +1,114 @@
+/**
+  * @file csv_importer.hpp
+  * This is the documentation of the `csv_importer.hpp` file
+  *
+  * @brief Description
+  * Implementation of the CsvImporter class, the parallel import of CSV and TSV
+  * files into buckets with typed layers in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Nativite engine imports
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+
+
+/**
+ * @internal
+ * The CsvImporter class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Imports a CSV or TSV file into sealed buckets of a cluster, column `i` of the
+ * file is stack `i` of every bucket, the integer and real columns are written to
+ * compressed numeric layers and the string columns to dictionary layers
+ *
+ * @details
+ * The types of the columns are inferred from the first `sample_rows` records. The
+ * file is mapped and split in one chunk per thread, the quotes of every chunk are
+ * counted at once and their parity tells if a chunk starts inside a quoted field,
+ * so the chunks are moved to the first newline outside a quoted field and a quoted
+ * newline never splits a record.
+ *
+ * Every thread parses its chunk to views of the fields and every `bucket_rows`
+ * records it converts them straight to the typed layers of a new bucket, no astruct
+ * is created for the numbers and the strings. A bucket whose values do not fit the
+ * inferred type of a column, like a real number in an integer column, keeps that
+ * column with the nearest type that fits, real numbers or strings. The empty fields
+ * are nulls, except the quoted empty strings of the string columns.
+*/
+
+
+class CsvImporter {
+  // Types
+  public:
+    // The inferred type of a column
+    enum class column_type_t : uint8_t {
+      boolean = 0,
+      integer = 1,
+      real    = 2,
+      string  = 3
+    };
+
+    // The fields of the records of a bucket that is being parsed, `fields` has
+    // `columns` views per record, a view without data is a missing field
+    struct segment_t {
+      std::vector<std::string_view> fields;
+      std::deque<std::string>       unescaped; /**< The quoted fields with escaped quotes */
+      size_t                        rows = 0;
+    };
+
+  protected:
+    // Internal functions of the class
+    bool parseRecord(const char*& cursor, const char* end, std::vector<std::string_view>& fields, std::deque<std::string>& unescaped) const;
+    const char* findRecordStart(const char* position, const char* end, bool in_quote) const;
+
+    static bool parseBoolean(std::string_view field, bool& value);
+    static bool parseInteger(std::string_view field, int64_t& value);
+    static bool parseReal(std::string_view field, double& value);
+
+    void inferTypes(const char* cursor, const char* end);
+
+    bool writeIntegerLayer(Bucket* bucket_, const segment_t& segment, size_t column) const;
+    bool writeRealLayer(Bucket* bucket_, const segment_t& segment, size_t column) const;
+    bool writeBooleanStack(Bucket* bucket_, const segment_t& segment, size_t column) const;
+    void writeDictionaryLayer(Bucket* bucket_, const segment_t& segment, size_t column) const;
+
+    void flushSegment(segment_t& segment);
+    void importChunk(const char* begin, const char* end);
+
+  public:
+    Cluster* cluster = nullptr; /**< The cluster that receives the buckets */
+
+    char   delimiter   = ',';   /**< The delimiter of the fields, a tab for TSV */
+    char   quote       = '"';   /**< The quote of the fields, 0 if they are never quoted */
+    bool   has_header  = true;  /**< The first record has the names of the columns */
+    size_t sample_rows = 1000;  /**< The records that infer the types of the columns */
+    size_t bucket_rows = 16 * NumericLayer::block_size; /**< The records of a bucket */
+    size_t threads     = 0;     /**< The parsing threads, 0 is one per hardware thread */
+
+    std::vector<std::string>   names; /**< The names of the columns, set by the import */
+    std::vector<column_type_t> types; /**< The inferred types of the columns */
+
+    std::atomic<size_t> imported_rows{0}; /**< The records written to buckets */
+    std::atomic<size_t> ragged_rows{0};   /**< The records with missing or extra fields */
+    std::atomic<size_t> buckets{0};       /**< The buckets inserted in the cluster */
+
+    size_t import(std::string_view input);
+    size_t importFile(const std::string& path);
+
+    CsvImporter(Cluster* cluster_v);
+};
@@ -0,0 +1,533 @@
+/**
+  * @file cursor.cpp
+  * This is the documentation of the `cursor.cpp` file
+  *
+  * @brief Description
+  * Implementation of the Cursor class methods, the producers that fill the batches
+  * of every cluster and the consumer side of the queue
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <string>
+#include <utility>
+
+// Nativite engine imports
+#include "cursor.hpp"
+#include "../Dictionary/dictionary.hpp"
+#include "../Compression/compression.hpp"
+
+
+/**
+  * @internal
+  * The `Cursor::batch_t::clear` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * Deletes the astructs of the rows that were not moved out and empties the batch
+  *
+  * @return
+  * This function does not return anything, since it
+  * only empties the batch
+*/
+
+
+void Cursor::batch_t::clear() {
+  for (auto& row : rows) {
+    for (auto astruct : row) {
+      delete astruct;
+    }
+  }
+  rows.clear();
+}
+
+
+/**
+  * @internal
+  * The move constructor and assignment of `Cursor::batch_t`, the moved batch is
+  * left empty and the assigned batch deletes its astructs first
+*/
+
+
+Cursor::batch_t::batch_t(batch_t&& other) noexcept
+  : cluster_index(other.cluster_index), rows(std::move(other.rows)) {
+  other.rows.clear();
+}
+
+
+Cursor::batch_t& Cursor::batch_t::operator=(batch_t&& other) noexcept {
+  if (this != &other) {
+    clear();
+
+    cluster_index = other.cluster_index;
+    rows          = std::move(other.rows);
+    other.rows.clear();
+  }
+  return *this;
+}
+
+
+Cursor::batch_t::~batch_t() noexcept {
+  clear();
+}
+
+
+/**
+  * @internal
+  * The `Cursor::viewValue` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * Reads the value of the row `row` of the stack `stack_index` whatever its layer
+  * is without copying it. A plain stack gives its own astruct, a layer writes its
+  * value to the astruct of `cache`, and a compressed stack decodes the whole block
+  * of the row once in `cache`
+  *
+  * @return
+  * Returns the astruct, valid until the next value is viewed with `cache` or the
+  * lock of the cluster is released, or nullptr if the slot is empty
+*/
+
+
+const Astruct* Cursor::viewValue(const Bucket* bucket_, size_t stack_index, size_t row, block_cache_t& cache) {
+  if (!bucket_->isNumericStack(stack_index) && !bucket_->isDictionaryStack(stack_index)) {
+    const Bucket::stack_t& stack = bucket_->bucket[stack_index];
+
+    return row < stack.size() ? stack[row] : nullptr;
+  }
+
+  if (cache.value == nullptr) {
+    cache.value = std::make_unique<Astruct>();
+  }
+
+  Astruct::astruct_t& value = cache.value->astruct;
+
+  if (bucket_->isNumericStack(stack_index)) {
+    const NumericLayer* layer = bucket_->numeric_layers[stack_index];
+    const size_t        BLOCK = row / NumericLayer::block_size;
+
+    if (row >= layer->size || !layer->isValid(row)) {
+      return nullptr;
+    }
+
+    if (cache.layer != layer || cache.block != BLOCK) {
+      cache.layer = layer;
+      cache.block = BLOCK;
+
+      if (layer->kind == NumericLayer::numeric_kind_t::integer) {
+        cache.integers.resize(NumericLayer::block_size);
+        layer->decodeBlock(BLOCK, cache.integers.data());
+      } else {
+        cache.reals.resize(NumericLayer::block_size);
+        layer->decodeBlock(BLOCK, cache.reals.data());
+      }
+    }
+
+    const size_t OFFSET = row % NumericLayer::block_size;
+
+    if (layer->kind == NumericLayer::numeric_kind_t::integer) {
+      value = cache.integers[OFFSET];
+    } else {
+      value = cache.reals[OFFSET];
+    }
+    return cache.value.get();
+  }
+
+  const DictionaryLayer* layer = bucket_->dictionary_layers[stack_index];
+
+  if (row >= layer->codes.size() || layer->codes[row] == Dictionary::null_code) {
+    return nullptr;
+  }
+
+  if (layer->codes[row] == Dictionary::json_null_code) {
+    value = nullptr;
+    return cache.value.get();
+  }
+
+  // The string of the last row keeps its memory
+  if (auto* text = std::get_if<std::string>(&value)) {
+    text->assign(layer->dictionary->decode(layer->codes[row]));
+  } else {
+    value = std::string(layer->dictionary->decode(layer->codes[row]));
+  }
+  return cache.value.get();
+}
+
+
+/**
+  * @internal
+  * The `Cursor::readValue` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * Copies the value of the row `row` of the stack `stack_index`, see `Cursor::viewValue`
+  *
+  * @return
+  * Returns a new astruct, or nullptr if the slot is empty
+*/
+
+
+Astruct* Cursor::readValue(const Bucket* bucket_, size_t stack_index, size_t row, block_cache_t& cache) {
+  const Astruct* value = viewValue(bucket_, stack_index, row, cache);
+
+  return value != nullptr ? value->clone() : nullptr;
+}
+
+
+/**
+  * @internal
+  * The `Cursor::viewRow` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * Views the projected stacks `columns` of the row `row` in `view` without copying
+  * them, every stack of the bucket if `columns` is empty. A projected stack that the
+  * bucket does not have is an empty slot
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `view`
+*/
+
+
+void Cursor::viewRow(
+  const Bucket* bucket_,
+  size_t row,
+  const std::vector<size_t>& columns,
+  std::vector<block_cache_t>& caches,
+  view_t& view
+) {
+  const size_t STACKS = bucket_->bucket.size();
+  const size_t WIDTH  = columns.empty() ? STACKS : columns.size();
+
+  view.assign(WIDTH, nullptr);
+
+  if (caches.size() < WIDTH) {
+    caches.resize(WIDTH);
+  }
+
+  for (size_t index = 0; index < WIDTH; index++) {
+    const size_t STACK = columns.empty() ? index : columns[index];
+
+    if (STACK < STACKS) {
+      view[index] = viewValue(bucket_, STACK, row, caches[index]);
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Cursor::copyRow` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * Copies the astructs of a viewed row to `values`, which owns them
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `values`
+*/
+
+
+void Cursor::copyRow(const view_t& view, row_t& values) {
+  values.resize(view.size());
+
+  for (size_t index = 0; index < view.size(); index++) {
+    values[index] = view[index] != nullptr ? view[index]->clone() : nullptr;
+  }
+}
+
+
+/**
+  * @internal
+  * The `Cursor::readPosition` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * Calls `function(cluster)` for the cluster of `position` holding the locks of
+  * `Brain::readCluster`. If its slot holds another cluster now, it was moved by
+  * `Brain::compactClusters`, so it is looked for by its pointer and `position`
+  * takes its new slot
+  *
+  * @return
+  * Returns false if the cluster was removed from the brain
+*/
+
+
+bool Cursor::readPosition(position_t& position, const std::function<void(Cluster*)>& function) {
+  for (;;) {
+    bool found = false;
+
+    brain->readCluster(position.index, [&](Cluster* cluster_) {
+      if (cluster_ == position.cluster) {
+        found = true;
+        function(cluster_);
+      }
+    });
+
+    if (found) {
+      return true;
+    }
+
+    auto structure = brain->lockStructureShared();
+    auto moved     = std::find(brain->brain.begin(), brain->brain.end(), position.cluster);
+
+    if (moved == brain->brain.end()) {
+      return false;
+    }
+    position.index = static_cast<size_t>(moved - brain->brain.begin());
+  }
+}
+
+
+/**
+  * @internal
+  * The `Cursor::fillBatch` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * Reads the rows of the cluster from `position` into `batch` until it is full,
+  * holding the locks of the cluster shared, wherever the cluster is now. If it was
+  * removed from the brain its scan ends and it is counted in `truncated_clusters`.
+  * The predicate runs on the viewed rows, only the rows that match it are copied.
+  * The decoded blocks are not kept between batches, since the layers can change
+  * once the locks are released
+  *
+  * @return
+  * Returns true if the cluster was read to the end
+*/
+
+
+bool Cursor::fillBatch(position_t& position, batch_t& batch) {
+  std::vector<block_cache_t> caches;
+  view_t                     view;
+  bool                       finished = true;
+
+  const bool FOUND = readPosition(position, [&](Cluster* cluster_) {
+    const auto& buckets = cluster_->cluster;
+
+    while (
+      position.slot < buckets.size() &&
+      batch.rows.size() < batch_rows &&
+      !cancelled.load(std::memory_order_relaxed)
+    ) {
+      const Bucket* bucket_ = buckets[position.slot];
+
+      if (bucket_ == nullptr || !bucket_->isLive() || position.row >= bucket_->height()) {
+        position.slot++;
+        position.row = 0;
+        continue;
+      }
+
+      viewRow(bucket_, position.row++, columns, caches, view);
+      scanned_rows.fetch_add(1, std::memory_order_relaxed);
+
+      if (!predicate || predicate(view)) {
+        copyRow(view, batch.rows.emplace_back());
+      }
+    }
+
+    finished = position.slot >= buckets.size();
+  });
+
+  if (!FOUND) {
+    truncated_clusters.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  batch.cluster_index = position.index;
+  return finished;
+}
+
+
+/**
+  * @internal
+  * The `Cursor::produce` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * The loop of a producer thread, it takes the next listed cluster, pins it and
+  * scans it batch by batch, pushing every batch with rows and waiting while the
+  * queue is full, then it unpins the cluster wherever it is now. A cluster that
+  * was removed from the brain is owned by the caller of `Brain::removeCluster` and
+  * may be deleted, so it is not touched. The last producer that finishes closes
+  * the queue, so the consumer sees the end
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the queue
+*/
+
+
+void Cursor::produce() {
+  for (
+    size_t target = next_cluster.fetch_add(1, std::memory_order_relaxed);
+    target < targets.size() && !cancelled.load(std::memory_order_relaxed);
+    target = next_cluster.fetch_add(1, std::memory_order_relaxed)
+  ) {
+    position_t position;
+    position.cluster = targets[target];
+
+    const bool PINNED = readPosition(position, [](Cluster* cluster_) {
+      cluster_->pinned_exports.fetch_add(1, std::memory_order_acq_rel);
+    });
+
+    if (!PINNED) {
+      truncated_clusters.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    bool finished = false;
+
+    while (!finished && !cancelled.load(std::memory_order_relaxed)) {
+      batch_t batch;
+
+      finished = fillBatch(position, batch);
+
+      const size_t ROWS = batch.rows.size();
+
+      // A closed queue is a cancelled cursor, the batch deletes its rows
+      if (ROWS != 0 && !queue->push(std::move(batch))) {
+        break;
+      }
+      produced_rows.fetch_add(ROWS, std::memory_order_relaxed);
+    }
+
+    readPosition(position, [](Cluster* cluster_) {
+      cluster_->pinned_exports.fetch_sub(1, std::memory_order_release);
+    });
+  }
+
+  if (running.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    queue->close();
+  }
+}
+
+
+/**
+  * @internal
+  * The `Cursor::open` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * Lists the clusters of the brain and starts the scan with the current
+  * configuration, a cursor that was already open is closed first. The clusters
+  * inserted after this call are not scanned
+  *
+  * @return
+  * This function does not return anything, since it
+  * only starts the producers
+*/
+
+
+void Cursor::open() {
+  close();
+
+  {
+    auto structure = brain->lockStructureShared();
+
+    targets.clear();
+    brain->forEachCluster([this](Cluster* cluster_) { targets.push_back(cluster_); });
+  }
+
+  const size_t THREADS = std::clamp<size_t>(
+    threads != 0 ? threads : std::thread::hardware_concurrency(),
+    1,
+    std::max<size_t>(1, targets.size())
+  );
+
+  batch_rows = std::max<size_t>(1, batch_rows);
+  queue      = std::make_unique<BoundedQueue<batch_t>>(queue_capacity);
+
+  next_cluster.store(0, std::memory_order_relaxed);
+  running.store(THREADS, std::memory_order_relaxed);
+  cancelled.store(false, std::memory_order_relaxed);
+  scanned_rows.store(0, std::memory_order_relaxed);
+  produced_rows.store(0, std::memory_order_relaxed);
+  truncated_clusters.store(0, std::memory_order_relaxed);
+
+  for (size_t index = 0; index < THREADS; index++) {
+    producers.emplace_back(&Cursor::produce, this);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Cursor::next` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * Moves the next batch to `batch`, waiting for the producers if there is none,
+  * the rows left in `batch` by the consumer are deleted
+  *
+  * @return
+  * Returns false when every cluster was scanned and every batch was consumed,
+  * or if the cursor is not open
+*/
+
+
+bool Cursor::next(batch_t& batch) {
+  if (queue == nullptr) {
+    batch.clear();
+    return false;
+  }
+
+  if (!queue->pop(batch)) {
+    batch.clear();
+    return false;
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Cursor::close` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * Stops the scan, the waiting producers are woken, the queued batches are
+  * deleted and the clusters are released
+  *
+  * @return
+  * This function does not return anything, since it
+  * only stops the producers
+*/
+
+
+void Cursor::close() {
+  cancelled.store(true, std::memory_order_relaxed);
+
+  if (queue != nullptr) {
+    queue->close();
+  }
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+
+  producers.clear();
+  queue.reset();
+}
+
+
+/**
+  * @internal
+  * The `Cursor::Cursor` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * The constructor of the `Cursor` class, the scan starts with `Cursor::open`
+*/
+
+
+Cursor::Cursor(Brain* brain_v) {
+  brain = brain_v;
+}
+
+
+/**
+  * @internal
+  * The `Cursor::~Cursor` method is internal of the `Cursor` class
+  *
+  * @brief Description
+  * The destructor of the `Cursor` class, it stops the scan
+*/
+
+
+Cursor::~Cursor() noexcept {
+  close();
+}
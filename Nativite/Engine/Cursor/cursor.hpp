@@ -0,0 +1,154 @@
+/**
+  * @file cursor.hpp
+  * This is the documentation of the `cursor.hpp` file
+  *
+  * @brief Description
+  * Implementation of the Cursor class, the streaming of the rows of a scan of a
+  * brain in bounded batches in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Nativite engine imports
+#include "../Brain/brain.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Astruct/astruct.hpp"
+#include "../BoundedQueue/bounded_queue.hpp"
+
+
+/**
+ * @internal
+ * The Cursor class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Scans all the clusters of a brain at once, like the TPS search, and yields the
+ * rows that match its predicate in batches of at most `batch_rows` rows, so a large
+ * result is never materialized whole
+ *
+ * @details
+ * Every producer thread takes the next cluster and fills a batch holding the locks
+ * of the cluster shared, then it releases them and pushes the batch to a queue of
+ * `queue_capacity` batches. When the consumer is slow the queue is full and the
+ * producers wait without holding any lock, so the writers are not blocked and the
+ * memory of a query is bounded by `(queue_capacity + threads + 1) * batch_rows` rows.
+ *
+ * The clusters of the brain are listed when the cursor is opened, and a producer
+ * resumes its cluster where the last batch ended. The cluster is counted in
+ * `Cluster::pinned_exports` while it is scanned, so the Compactor does not move its
+ * rows between two batches, the rows written by other writers meanwhile can be seen
+ * or not. `Brain::compactClusters` can still move the cluster to another slot, so
+ * every batch looks for the cluster itself, not for its slot. A cluster removed from
+ * the brain before it was read to the end can not be read anymore, it is counted in
+ * `truncated_clusters` so the consumer knows that its rows are missing.
+*/
+
+
+class Cursor {
+  // Types
+  public:
+    // A row of the result, one astruct per projected stack, an empty slot is nullptr
+    using row_t = std::vector<Astruct*>;
+
+    // A row that is not copied, its astructs are the ones of the bucket or the
+    // values of the block caches, they are valid until the next row is viewed
+    using view_t = std::vector<const Astruct*>;
+
+    // The filter of the rows, the rows where it returns false are dropped before
+    // they are copied
+    using predicate_t = std::function<bool(const view_t&)>;
+
+    // A batch of rows of a cluster, it owns the astructs of its rows, the consumer
+    // moves the rows out of it to keep them
+    struct batch_t {
+      size_t             cluster_index = 0;
+      std::vector<row_t> rows;
+
+      void clear();
+
+      batch_t() = default;
+      batch_t(batch_t&& other) noexcept;
+      batch_t& operator=(batch_t&& other) noexcept;
+
+      ~batch_t() noexcept;
+    };
+
+    // The decoded block of a compressed stack, it is reused by the rows of the block
+    struct block_cache_t {
+      const NumericLayer*      layer = nullptr;
+      size_t                   block = SIZE_MAX;
+      std::vector<int64_t>     integers;
+      std::vector<double>      reals;
+      std::unique_ptr<Astruct> value; /**< The last viewed value of a layer */
+    };
+
+  protected:
+    // The position of a producer in its cluster
+    struct position_t {
+      Cluster* cluster = nullptr;
+      size_t   index   = 0; /**< The slot of the cluster in the brain when it was last read */
+      size_t   slot    = 0;
+      size_t   row     = 0;
+    };
+
+    // Internal functions of the class
+    bool readPosition(position_t& position, const std::function<void(Cluster*)>& function);
+    bool fillBatch(position_t& position, batch_t& batch);
+    void produce();
+
+    std::unique_ptr<BoundedQueue<batch_t>> queue;     /**< The batches waiting for the consumer */
+    std::vector<std::thread>               producers;
+    std::atomic<size_t>                    next_cluster{0}; /**< The next cluster to scan */
+    std::atomic<size_t>                    running{0};      /**< The producers that did not finish */
+    std::atomic<bool>                      cancelled{false};
+    std::vector<Cluster*>                  targets; /**< The clusters of the brain when it was opened */
+
+  public:
+    Brain*              brain;          /**< The scanned brain */
+    std::vector<size_t> columns;        /**< The projected stacks, empty to read all of them */
+    predicate_t         predicate;      /**< The filter of the rows, empty to keep all of them */
+    size_t              threads        = 0;    /**< The producer threads, 0 is one per hardware thread */
+    size_t              batch_rows     = 1024; /**< The maximum rows of a batch */
+    size_t              queue_capacity = 4;    /**< The maximum batches waiting for the consumer */
+
+    std::atomic<size_t> scanned_rows{0};       /**< The rows read by the producers */
+    std::atomic<size_t> produced_rows{0};      /**< The rows that matched the predicate */
+    std::atomic<size_t> truncated_clusters{0}; /**< The clusters removed before they were read
+                                                    to the end, their rows are missing */
+
+    static const Astruct* viewValue(const Bucket* bucket_, size_t stack_index, size_t row, block_cache_t& cache);
+    static Astruct*       readValue(const Bucket* bucket_, size_t stack_index, size_t row, block_cache_t& cache);
+
+    static void viewRow(
+      const Bucket* bucket_,
+      size_t row,
+      const std::vector<size_t>& columns,
+      std::vector<block_cache_t>& caches,
+      view_t& view
+    );
+    static void copyRow(const view_t& view, row_t& values);
+
+    void open();
+    bool next(batch_t& batch);
+    void close();
+
+    Cursor(Brain* brain_v);
+
+    Cursor(const Cursor&)            = delete;
+    Cursor& operator=(const Cursor&) = delete;
+
+    ~Cursor() noexcept;
+};
@@ -0,0 +1,278 @@
+/**
+  * @file dictionary.cpp
+  * This is the documentation of the `dictionary.cpp` file
+  *
+  * @brief Description
+  * Implementation of the Dictionary and DictionaryLayer classes methods
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+
+// Nativite engine imports
+#include "dictionary.hpp"
+
+
+/**
+  * @internal
+  * The `Dictionary::encode` method is internal of the `Dictionary` class
+  *
+  * @brief Description
+  * Takes the code of `value`, if the string is not in the dictionary yet
+  * it is appended with the next code. If the strings are exported and would be
+  * reallocated, the exported buffers are moved to their hold first
+  *
+  * @return
+  * Returns the code of `value`
+*/
+
+
+Dictionary::code_t Dictionary::encode(std::string_view value) {
+  auto found = codes.find(value);
+
+  if (found != codes.end()) {
+    return *found;
+  }
+
+  code_t code = static_cast<code_t>(size());
+
+  if (bytes.size() + value.size() > bytes.capacity() || offsets.size() == offsets.capacity()) {
+    export_hold.detach(true, bytes, offsets);
+  }
+
+  // The string is appended first, the set hashes the new code by its string
+  bytes.insert(bytes.end(), value.begin(), value.end());
+  offsets.push_back(static_cast<int32_t>(bytes.size()));
+  codes.insert(code);
+
+  return code;
+}
+
+
+/**
+  * @internal
+  * The `Dictionary::find` method is internal of the `Dictionary` class
+  *
+  * @brief Description
+  * Takes the code of `value` without adding it to the dictionary
+  *
+  * @return
+  * Returns the code of `value` or `null_code` if it is not in the dictionary
+*/
+
+
+Dictionary::code_t Dictionary::find(std::string_view value) const {
+  auto found = codes.find(value);
+
+  if (found == codes.end()) {
+    return null_code;
+  }
+  return *found;
+}
+
+
+/**
+  * @internal
+  * The `Dictionary::decode` method is internal of the `Dictionary` class
+  *
+  * @brief Description
+  * Takes the string of the suggested code
+  *
+  * @return
+  * Returns a view of the string in the `bytes` field, it is valid until
+  * the next `Dictionary::encode`
+*/
+
+
+std::string_view Dictionary::decode(code_t code) const {
+  return std::string_view(
+    bytes.data() + offsets[code],
+    offsets[code + 1] - offsets[code]
+  );
+}
+
+
+/**
+  * @internal
+  * The `Dictionary::size` method is internal of the `Dictionary` class
+  *
+  * @return
+  * Returns the number of distinct strings of the dictionary
+*/
+
+
+size_t Dictionary::size() const {
+  return offsets.size() - 1;
+}
+
+
+/**
+  * @internal
+  * The `Dictionary::Dictionary` method is internal of the `Dictionary` class
+  *
+  * @brief Description
+  * The constructor of the `Dictionary` class, the hash and the equality of
+  * the `codes` field read the strings of this dictionary
+*/
+
+
+Dictionary::Dictionary() :
+  codes(0, CodeHash{this}, CodeEqual{this}) {}
+
+
+/**
+  * @internal
+  * The `Dictionary::Dictionary` method is internal of the `Dictionary` class
+  *
+  * @brief Description
+  * The copy constructor of the `Dictionary` class, the strings and the codes
+  * are copied and the `codes` field is hashed through the copy, not through `other`
+*/
+
+
+Dictionary::Dictionary(const Dictionary& other) :
+  bytes(other.bytes),
+  offsets(other.offsets),
+  codes(other.codes.bucket_count(), CodeHash{this}, CodeEqual{this}) {
+  codes.insert(other.codes.begin(), other.codes.end());
+}
+
+
+/**
+  * @internal
+  * The `Dictionary::~Dictionary` method is internal of the `Dictionary` class
+  *
+  * @brief Description
+  * The destructor of the `Dictionary` class, the strings held by an export
+  * are moved to its hold instead of being freed
+*/
+
+
+Dictionary::~Dictionary() noexcept {
+  export_hold.detach(false, bytes, offsets);
+}
+
+
+/**
+  * @internal
+  * The `DictionaryLayer::pushCode` method is internal of the `DictionaryLayer` class
+  *
+  * @brief Description
+  * Pushes `code` to the top of the stack, if the codes are exported and would be
+  * reallocated, the exported buffer is moved to its hold first
+  *
+  * @return
+  * This function does not return anything, since it
+  * only pushes the code
+*/
+
+
+void DictionaryLayer::pushCode(code_t code) {
+  if (codes.size() == codes.capacity()) {
+    export_hold.detach(true, codes);
+  }
+  codes.push_back(code);
+}
+
+
+/**
+  * @internal
+  * The `DictionaryLayer::filterEquals` method is internal of the `DictionaryLayer` class
+  *
+  * @brief Description
+  * Appends to `rows` the rows whose string is `value`, the string is looked up
+  * once in the dictionary and the stack is scanned comparing integer codes
+  *
+  * @return
+  * This function does not return anything, the matches are appended to `rows`
+*/
+
+
+void DictionaryLayer::filterEquals(
+  std::string_view value,
+  std::vector<uint32_t>& rows
+) const {
+  const code_t CODE = dictionary->find(value);
+
+  if (CODE == Dictionary::null_code) {
+    return;
+  }
+
+  const code_t* data = codes.data();
+  const size_t  SIZE = codes.size();
+
+  for (size_t row = 0; row < SIZE; row++) {
+    if (data[row] == CODE) {
+      rows.push_back(static_cast<uint32_t>(row));
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `DictionaryLayer::countEquals` method is internal of the `DictionaryLayer` class
+  *
+  * @brief Description
+  * Counts the rows whose string is `value` comparing integer codes,
+  * the loop has no branches so the compiler vectorizes it
+  *
+  * @return
+  * Returns the number of matching rows
+*/
+
+
+size_t DictionaryLayer::countEquals(std::string_view value) const {
+  const code_t CODE = dictionary->find(value);
+
+  if (CODE == Dictionary::null_code) {
+    return 0;
+  }
+
+  return std::count(codes.begin(), codes.end(), CODE);
+}
+
+
+/**
+  * @internal
+  * The `DictionaryLayer::DictionaryLayer` method is internal of the `DictionaryLayer` class
+  *
+  * @brief Description
+  * The constructor of the `DictionaryLayer` class, if `dictionary_v` is nullptr or NULL
+  * the layer creates and owns its own dictionary, otherwise the dictionary is
+  * shared and owned by someone else, usually the cluster
+*/
+
+
+DictionaryLayer::DictionaryLayer(Dictionary* dictionary_v) {
+  if (dictionary_v == nullptr || dictionary_v == NULL) {
+    dictionary      = new Dictionary();
+    owns_dictionary = true;
+  } else {
+    dictionary = dictionary_v;
+  }
+}
+
+
+/**
+  * @internal
+  * The `DictionaryLayer::~DictionaryLayer` method is internal of the `DictionaryLayer` class
+  *
+  * @brief Description
+  * The destructor of the `DictionaryLayer` class, deletes the dictionary
+  * only if it is owned by the layer and moves the exported codes to their hold
+*/
+
+
+DictionaryLayer::~DictionaryLayer() noexcept {
+  export_hold.detach(false, codes);
+
+  if (owns_dictionary) {
+    delete dictionary;
+  }
+  dictionary = nullptr;
+}
@@ -0,0 +1,159 @@
+/**
+  * @file dictionary.hpp
+  * This is the documentation of the `dictionary.hpp` file
+  *
+  * @brief Description
+  * Implementation of the Dictionary and DictionaryLayer classes, the dictionary encoding
+  * of the string stacks of the buckets in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+// Nativite engine imports
+#include "../Epoch/epoch.hpp"
+
+
+/**
+ * @internal
+ * The Dictionary class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * A set of distinct strings where every string has a small integer code,
+ * it can be owned by a bucket or shared by all the buckets of a cluster
+ *
+ * @details
+ * The strings are stored contiguously in the `bytes` field and delimited by the
+ * `offsets` field, code `n` is the string [offsets[n], offsets[n + 1]), the same
+ * layout as the Arrow string arrays. The `codes` field only holds the codes, it
+ * hashes and compares them through their strings in `bytes`, so a string is never
+ * stored twice.
+ *
+ * The `bytes` and `offsets` fields are exported to Arrow without a copy, while an
+ * export holds them they are moved to its hold before they are reallocated or freed.
+*/
+
+
+class Dictionary {
+  // Types
+  public:
+    // The type of the codes of the strings
+    using code_t = uint32_t;
+
+    // The code of the empty slots, also returned for the strings that are not found
+    static constexpr code_t null_code = std::numeric_limits<code_t>::max();
+
+    // The code of the null astructs, so they are not read back as empty slots
+    static constexpr code_t json_null_code = null_code - 1;
+
+    // Evaluates if a code is the code of a string, not of an empty slot or a null astruct
+    static constexpr bool isString(code_t code) {
+      return code < json_null_code;
+    }
+
+  protected:
+    // Hash and equality of the codes by their strings, they also accept a
+    // `std::string_view`, so the lookups do not allocate a string and every
+    // string is stored once, in the `bytes` field
+    struct CodeHash {
+      using is_transparent = void;
+
+      const Dictionary* dictionary;
+
+      size_t operator()(std::string_view value) const {
+        return std::hash<std::string_view>()(value);
+      }
+
+      size_t operator()(code_t code) const {
+        return std::hash<std::string_view>()(dictionary->decode(code));
+      }
+    };
+
+    struct CodeEqual {
+      using is_transparent = void;
+
+      const Dictionary* dictionary;
+
+      bool operator()(code_t left, code_t right) const {
+        return left == right;
+      }
+
+      bool operator()(std::string_view left, code_t right) const {
+        return left == dictionary->decode(right);
+      }
+
+      bool operator()(code_t left, std::string_view right) const {
+        return dictionary->decode(left) == right;
+      }
+    };
+
+    using code_set_t = std::unordered_set<code_t, CodeHash, CodeEqual>;
+
+  public:
+    std::vector<char>    bytes;        /**< The strings of the dictionary one after the other */
+    std::vector<int32_t> offsets{0};   /**< The offsets of the strings in `bytes`, one more than the strings */
+
+    code_set_t codes; /**< The codes of the strings, hashed by the string in `bytes` */
+
+    MemoryHoldSlot export_hold; /**< The hold of `bytes` and `offsets` shared with the exports */
+
+    code_t encode(std::string_view value);
+    code_t find(std::string_view value) const;
+
+    std::string_view decode(code_t code) const;
+
+    size_t size() const;
+
+    Dictionary();
+    Dictionary(const Dictionary& other);
+    Dictionary& operator=(const Dictionary& other) = delete;
+
+    ~Dictionary() noexcept;
+};
+
+
+/**
+ * @internal
+ * The DictionaryLayer class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * A dictionary encoded 3D vertical stack, the stack stores a code per slot
+ * instead of an `Astruct*` with its own heap string, the codes are exported to
+ * Arrow without a copy like the strings of the dictionary
+*/
+
+
+class DictionaryLayer {
+  // Types
+  public:
+    using code_t = Dictionary::code_t;
+
+  public:
+    Dictionary*         dictionary      = nullptr; /**< The dictionary of the codes */
+    bool                owns_dictionary = false;   /**< If the layer deletes the dictionary */
+    std::vector<code_t> codes;                     /**< The code of every slot of the stack */
+    MemoryHoldSlot      export_hold;               /**< The hold of `codes` shared with the exports */
+
+    void pushCode(code_t code);
+    void filterEquals(std::string_view value, std::vector<uint32_t>& rows) const;
+    size_t countEquals(std::string_view value) const;
+
+    DictionaryLayer(Dictionary* dictionary_v);
+    DictionaryLayer(const DictionaryLayer&) = delete;
+    DictionaryLayer& operator=(const DictionaryLayer&) = delete;
+
+    ~DictionaryLayer() noexcept;
+};
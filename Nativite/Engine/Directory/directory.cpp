@@ -0,0 +1,442 @@
+/**
+  * @file directory.cpp
+  * This is the documentation of the `directory.cpp` file
+  *
+  * @brief Description
+  * Implementation of the ClusterDirectory class methods
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+
+// Nativite engine imports
+#include "directory.hpp"
+#include "../Brain/brain.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Dictionary/dictionary.hpp"
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::size` method is internal of the `ClusterDirectory` class
+  *
+  * @return
+  * Returns the number of slots of the directory
+*/
+
+
+size_t ClusterDirectory::size() const {
+  return clusters.size();
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::resize` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Changes the number of slots of every array, the new slots are empty
+  *
+  * @return
+  * This function does not return anything, since it
+  * only resizes the arrays
+*/
+
+
+void ClusterDirectory::resize(size_t slots) {
+  clusters.resize(slots, nullptr);
+  bucket_counts.resize(slots, 0);
+  capacities.resize(slots, 0);
+  sealed_counts.resize(slots, 0);
+  row_counts.resize(slots, 0);
+  dictionaries.resize(slots, nullptr);
+  zone_firsts.resize(slots, 0);
+  zone_counts.resize(slots, 0);
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::clear` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Removes all the slots and all the zones
+  *
+  * @return
+  * This function does not return anything, since it
+  * only clears the arrays
+*/
+
+
+void ClusterDirectory::clear() {
+  resize(0);
+  zones.clear();
+  unused_zones = 0;
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::computeZones` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Appends to the `zones` field a zone per stack index of `cluster_`, merging the
+  * filters of its sealed buckets, the mutable buckets and the raw stacks make
+  * the zone not exact
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the zones
+*/
+
+
+void ClusterDirectory::computeZones(const Cluster* cluster_) {
+  const size_t FIRST = zones.size();
+
+  cluster_->forEachBucket([&](const Bucket* bucket_) {
+    if (zones.size() - FIRST < bucket_->stackCount()) {
+      zones.resize(FIRST + bucket_->stackCount());
+    }
+
+    for (size_t index = 0; index < bucket_->stackCount(); index++) {
+      stack_zone_t& zone = zones[FIRST + index];
+
+      if (bucket_->stackHeight(index) == 0) {
+        continue;
+      }
+
+      if (!bucket_->sealed) {
+        zone.has_numbers         = true;
+        zone.has_strings         = true;
+        zone.is_exact            = false;
+        zone.is_dictionary_exact = false;
+        continue;
+      }
+
+      if (bucket_->isNumericStack(index)) {
+        const Bucket::stack_filter_t& filter = bucket_->filters[index];
+
+        if (filter.has_values) {
+          zone.minimum     = zone.has_numbers ? std::min(zone.minimum, filter.minimum) : filter.minimum;
+          zone.maximum     = zone.has_numbers ? std::max(zone.maximum, filter.maximum) : filter.maximum;
+          zone.has_numbers = true;
+        }
+      } else if (bucket_->isDictionaryStack(index)) {
+        zone.has_strings = true;
+
+        if (bucket_->dictionary_layers[index]->dictionary != cluster_->dictionary) {
+          zone.is_dictionary_exact = false;
+        }
+      } else {
+        zone.has_numbers         = true;
+        zone.has_strings         = true;
+        zone.is_exact            = false;
+        zone.is_dictionary_exact = false;
+      }
+    }
+  });
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::compactZones` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Copies the zones of every slot one after the other to a new pool, dropping
+  * the unused zones
+  *
+  * @return
+  * This function does not return anything, since it
+  * only compacts the `zones` field
+*/
+
+
+void ClusterDirectory::compactZones() {
+  std::vector<stack_zone_t> compacted;
+  compacted.reserve(zones.size() - unused_zones);
+
+  for (size_t slot = 0; slot < size(); slot++) {
+    const size_t FIRST = zone_firsts[slot];
+
+    zone_firsts[slot] = compacted.size();
+    compacted.insert(
+      compacted.end(),
+      zones.begin() + FIRST,
+      zones.begin() + FIRST + zone_counts[slot]
+    );
+  }
+
+  zones.swap(compacted);
+  unused_zones = 0;
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::rebuild` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Builds the directory again from every slot of `brain_`, dropping the
+  * unused zones
+  *
+  * @return
+  * This function does not return anything, since it
+  * only rebuilds the arrays
+*/
+
+
+void ClusterDirectory::rebuild(const Brain* brain_) {
+  clear();
+  resize(brain_->brain.size());
+
+  for (size_t slot = 0; slot < brain_->brain.size(); slot++) {
+    refresh(slot, brain_->brain[slot]);
+  }
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::refresh` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Reads again the metadata of `cluster_` into the slot `slot`, the directory
+  * grows if `slot` is after the last slot. If `cluster_` is nullptr or NULL
+  * the slot is emptied. The new zones reuse the zones of the slot when they
+  * fit, else the old ones are left unused until the pool is compacted
+  *
+  * @return
+  * This function does not return anything, since it
+  * only refreshes the slot
+*/
+
+
+void ClusterDirectory::refresh(size_t slot, const Cluster* cluster_) {
+  if (slot >= size()) {
+    resize(slot + 1);
+  }
+  if (cluster_ == nullptr) {
+    remove(slot);
+    return;
+  }
+
+  uint32_t buckets = 0;
+  uint32_t sealed  = 0;
+  uint64_t rows    = 0;
+
+  cluster_->forEachBucket([&](const Bucket* bucket_) {
+    buckets++;
+    sealed += bucket_->sealed;
+    rows   += bucket_->height();
+  });
+
+  clusters[slot]      = cluster_;
+  bucket_counts[slot] = buckets;
+  capacities[slot]    = static_cast<uint32_t>(cluster_->cluster_capacity);
+  sealed_counts[slot] = sealed;
+  row_counts[slot]    = rows;
+  dictionaries[slot]  = cluster_->dictionary;
+
+  // The zones are computed at the end of the pool and moved over the old
+  // zones of the slot if they fit there
+  const size_t OLD_FIRST = zone_firsts[slot];
+  const size_t OLD_COUNT = zone_counts[slot];
+  const size_t FIRST     = zones.size();
+
+  computeZones(cluster_);
+
+  const size_t COUNT = zones.size() - FIRST;
+
+  if (COUNT <= OLD_COUNT) {
+    std::copy(zones.begin() + FIRST, zones.end(), zones.begin() + OLD_FIRST);
+    zones.resize(FIRST);
+
+    zone_firsts[slot] = OLD_FIRST;
+    unused_zones     += OLD_COUNT - COUNT;
+  } else {
+    zone_firsts[slot] = FIRST;
+    unused_zones     += OLD_COUNT;
+  }
+  zone_counts[slot] = static_cast<uint32_t>(COUNT);
+
+  if (unused_zones > zones.size() / 2) {
+    compactZones();
+  }
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::remove` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Empties the slot `slot`, an empty slot has no rows and no zones
+  *
+  * @return
+  * This function does not return anything, since it
+  * only empties the slot
+*/
+
+
+void ClusterDirectory::remove(size_t slot) {
+  if (slot >= size()) {
+    return;
+  }
+
+  clusters[slot]      = nullptr;
+  bucket_counts[slot] = 0;
+  capacities[slot]    = 0;
+  sealed_counts[slot] = 0;
+  row_counts[slot]    = 0;
+  dictionaries[slot]  = nullptr;
+  unused_zones       += zone_counts[slot];
+  zone_firsts[slot]   = 0;
+  zone_counts[slot]   = 0;
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::totalRows` method is internal of the `ClusterDirectory` class
+  *
+  * @return
+  * Returns the rows of all the clusters
+*/
+
+
+uint64_t ClusterDirectory::totalRows() const {
+  uint64_t rows = 0;
+
+  for (auto count : row_counts) {
+    rows += count;
+  }
+  return rows;
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::mayContainRange` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Evaluates with the zone of the stack `stack_index` of the slot `slot` if the
+  * cluster may have numbers between `minimum` and `maximum`
+  *
+  * @return
+  * Returns a boolean, false if the cluster surely does not have numbers in the range
+*/
+
+
+bool ClusterDirectory::mayContainRange(
+  size_t slot,
+  size_t stack_index,
+  double minimum,
+  double maximum
+) const {
+  if (slot >= size() || stack_index >= zone_counts[slot]) {
+    return false;
+  }
+
+  const stack_zone_t& zone = zones[zone_firsts[slot] + stack_index];
+
+  if (!zone.is_exact) {
+    return true;
+  }
+  return
+    zone.has_numbers &&
+    minimum <= zone.maximum &&
+    maximum >= zone.minimum;
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::mayContainString` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Evaluates with the zone of the stack `stack_index` of the slot `slot` and the
+  * dictionary of the cluster if the cluster may have the string `value`
+  *
+  * @return
+  * Returns a boolean, false if the cluster surely does not have `value`
+*/
+
+
+bool ClusterDirectory::mayContainString(
+  size_t slot,
+  size_t stack_index,
+  std::string_view value
+) const {
+  if (slot >= size() || stack_index >= zone_counts[slot]) {
+    return false;
+  }
+
+  const stack_zone_t& zone = zones[zone_firsts[slot] + stack_index];
+
+  if (!zone.has_strings) {
+    return false;
+  }
+  if (!zone.is_dictionary_exact || dictionaries[slot] == nullptr) {
+    return true;
+  }
+  return dictionaries[slot]->find(value) != Dictionary::null_code;
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::pruneRange` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Appends to `slots` the slots of the clusters that may have numbers between
+  * `minimum` and `maximum` in the stack `stack_index`
+  *
+  * @return
+  * This function does not return anything, the slots are appended to `slots`
+*/
+
+
+void ClusterDirectory::pruneRange(
+  size_t stack_index,
+  double minimum,
+  double maximum,
+  std::vector<uint32_t>& slots
+) const {
+  for (size_t slot = 0; slot < size(); slot++) {
+    if (mayContainRange(slot, stack_index, minimum, maximum)) {
+      slots.push_back(static_cast<uint32_t>(slot));
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `ClusterDirectory::pruneString` method is internal of the `ClusterDirectory` class
+  *
+  * @brief Description
+  * Appends to `slots` the slots of the clusters that may have the string `value`
+  * in the stack `stack_index`
+  *
+  * @return
+  * This function does not return anything, the slots are appended to `slots`
+*/
+
+
+void ClusterDirectory::pruneString(
+  size_t stack_index,
+  std::string_view value,
+  std::vector<uint32_t>& slots
+) const {
+  for (size_t slot = 0; slot < size(); slot++) {
+    if (mayContainString(slot, stack_index, value)) {
+      slots.push_back(static_cast<uint32_t>(slot));
+    }
+  }
+}
@@ -0,0 +1,107 @@
+/**
+  * @file directory.hpp
+  * This is the documentation of the `directory.hpp` file
+  *
+  * @brief Description
+  * Implementation of the ClusterDirectory class, the structure of arrays with the
+  * metadata of the clusters of a brain in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Forward reference to `Brain`, `Cluster` and `Dictionary`
+class Brain;
+class Cluster;
+class Dictionary;
+
+
+/**
+ * @internal
+ * The ClusterDirectory class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * The metadata of every cluster of a brain in parallel arrays indexed by the slot
+ * of the cluster, so the planning and the pruning of a query over a whole brain
+ * read contiguous memory instead of one heap object per cluster
+ *
+ * @details
+ * Every cluster has a zone per stack index, the zones of the slot `n` are
+ * `zones[zone_firsts[n]]` to `zones[zone_firsts[n] + zone_counts[n] - 1]`.
+ * Refreshing a slot writes its new zones over the old ones when they fit, else
+ * it appends them and the old ones become unused. The pool is compacted when
+ * more than half of its zones are unused, so refreshing the same slots again
+ * and again does not grow it.
+*/
+
+
+class ClusterDirectory {
+  // Types
+  public:
+    // The summary of a stack index over all the buckets of a cluster
+    struct stack_zone_t {
+      double minimum             = 0;
+      double maximum             = 0;
+      bool   has_numbers         = false; /**< Some bucket has numbers in the stack */
+      bool   has_strings         = false; /**< Some bucket has strings in the stack */
+      bool   is_exact            = true;  /**< The zone map covers every number of the stack,
+                                               false if a bucket is mutable or raw */
+      bool   is_dictionary_exact = true;  /**< Every string of the stack is encoded
+                                               with the dictionary of the cluster */
+    };
+
+  protected:
+    // Internal functions of the class
+    void computeZones(const Cluster* cluster_);
+    void compactZones();
+
+  public:
+    std::vector<const Cluster*>    clusters;      /**< The cluster of every slot */
+    std::vector<uint32_t>          bucket_counts; /**< The buckets of every cluster */
+    std::vector<uint32_t>          capacities;    /**< The capacity of every cluster */
+    std::vector<uint32_t>          sealed_counts; /**< The sealed buckets of every cluster */
+    std::vector<uint64_t>          row_counts;    /**< The rows of every cluster */
+    std::vector<const Dictionary*> dictionaries;  /**< The dictionary of every cluster */
+
+    std::vector<size_t>       zone_firsts;      /**< The first zone of every cluster */
+    std::vector<uint32_t>     zone_counts;      /**< The number of zones of every cluster */
+    std::vector<stack_zone_t> zones;            /**< The zones of all the clusters */
+    size_t                    unused_zones = 0; /**< The zones that no slot uses anymore */
+
+    size_t size() const;
+    void   resize(size_t slots);
+    void   clear();
+
+    void rebuild(const Brain* brain_);
+    void refresh(size_t slot, const Cluster* cluster_);
+    void remove(size_t slot);
+
+    uint64_t totalRows() const;
+
+    bool mayContainRange(size_t slot, size_t stack_index, double minimum, double maximum) const;
+    bool mayContainString(size_t slot, size_t stack_index, std::string_view value) const;
+
+    void pruneRange(
+      size_t stack_index,
+      double minimum,
+      double maximum,
+      std::vector<uint32_t>& slots
+    ) const;
+
+    void pruneString(
+      size_t stack_index,
+      std::string_view value,
+      std::vector<uint32_t>& slots
+    ) const;
+
+    ClusterDirectory() = default;
+};
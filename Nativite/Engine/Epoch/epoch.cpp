@@ -0,0 +1,474 @@
+/**
+  * @file epoch.cpp
+  * This is the documentation of the `epoch.cpp` file
+  *
+  * @brief Description
+  * Implementation of the EpochManager, EpochGuard and MemoryHold classes methods,
+  * the records of the reader threads, the retired objects and their collection
+  * and the references of the shared buffers
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <utility>
+
+// Nativite engine imports
+#include "epoch.hpp"
+
+
+// The record of a thread in the global manager and the number of its
+// nested guards, the record is released when the thread exits
+struct thread_epoch_t {
+  EpochManager::epoch_record_t* record = nullptr;
+  size_t                        depth  = 0;
+
+  ~thread_epoch_t() {
+    if (record != nullptr) {
+      EpochManager::global().releaseRecord(record);
+    }
+  }
+};
+
+static thread_local thread_epoch_t thread_epoch;
+
+
+/**
+  * @internal
+  * The `EpochManager::oldestEpoch` method is internal of the `EpochManager` class
+  *
+  * @brief Description
+  * Reads the epoch announced by every record
+  *
+  * @return
+  * Returns the oldest announced epoch, or `quiescent` if no reader is running
+*/
+
+
+uint64_t EpochManager::oldestEpoch() const {
+  uint64_t oldest = quiescent;
+
+  for (
+    epoch_record_t* record = records.load(std::memory_order_acquire);
+    record != nullptr;
+    record = record->next
+  ) {
+    oldest = std::min(oldest, record->epoch.load(std::memory_order_seq_cst));
+  }
+  return oldest;
+}
+
+
+/**
+  * @internal
+  * The `EpochManager::acquireRecord` method is internal of the `EpochManager` class
+  *
+  * @brief Description
+  * Takes a record released by an exited thread, or pushes a new record to the
+  * front of the `records` field if every record is used
+  *
+  * @return
+  * Returns the record, it must be released with `EpochManager::releaseRecord`
+*/
+
+
+EpochManager::epoch_record_t* EpochManager::acquireRecord() {
+  for (
+    epoch_record_t* record = records.load(std::memory_order_acquire);
+    record != nullptr;
+    record = record->next
+  ) {
+    bool used = false;
+
+    if (
+      !record->used.load(std::memory_order_relaxed) &&
+      record->used.compare_exchange_strong(used, true, std::memory_order_acq_rel)
+    ) {
+      return record;
+    }
+  }
+
+  epoch_record_t* record = new epoch_record_t();
+  record->used.store(true, std::memory_order_relaxed);
+  record->next = records.load(std::memory_order_relaxed);
+
+  while (!records.compare_exchange_weak(
+    record->next,
+    record,
+    std::memory_order_release,
+    std::memory_order_relaxed
+  )) {}
+
+  return record;
+}
+
+
+/**
+  * @internal
+  * The `EpochManager::releaseRecord` method is internal of the `EpochManager` class
+  *
+  * @brief Description
+  * Marks `record` as quiescent and unused, so another thread can take it
+  *
+  * @return
+  * This function does not return anything, since it
+  * only releases the record
+*/
+
+
+void EpochManager::releaseRecord(epoch_record_t* record) {
+  record->epoch.store(quiescent, std::memory_order_release);
+  record->used.store(false, std::memory_order_release);
+}
+
+
+/**
+  * @internal
+  * The `EpochManager::retire` method is internal of the `EpochManager` class
+  *
+  * @brief Description
+  * Tags `pointer` with the global epoch and keeps it until no reader of that
+  * epoch is running, it is freed calling `deleter(pointer)`. The caller has
+  * already unlinked `pointer`, so the new readers can not reach it. A collection
+  * runs when `collect_threshold` objects are waiting
+  *
+  * @return
+  * This function does not return anything, since it
+  * only retires the object
+*/
+
+
+void EpochManager::retire(void* pointer, void (*deleter)(void*)) {
+  if (pointer == nullptr) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(retired_mutex);
+    retired.push_back({pointer, deleter, global_epoch.load(std::memory_order_seq_cst)});
+    pending.store(retired.size(), std::memory_order_relaxed);
+  }
+
+  if (pending.load(std::memory_order_relaxed) >= collect_threshold) {
+    collect();
+  }
+}
+
+
+/**
+  * @internal
+  * The `EpochManager::collect` method is internal of the `EpochManager` class
+  *
+  * @brief Description
+  * Advances the global epoch and frees the retired objects tagged before the
+  * oldest announced epoch, the deleters run without the lock so they can retire
+  * the objects they own, which are collected in the same call if no reader is
+  * running. Only one thread collects at a time, the others return at once
+  *
+  * @return
+  * Returns the number of freed objects
+*/
+
+
+size_t EpochManager::collect() {
+  if (collecting.exchange(true, std::memory_order_acquire)) {
+    return 0;
+  }
+
+  size_t freed = 0;
+
+  global_epoch.fetch_add(1, std::memory_order_seq_cst);
+
+  while (true) {
+    const uint64_t         OLDEST = oldestEpoch();
+    std::vector<retired_t> ready;
+    {
+      std::lock_guard<std::mutex> lock(retired_mutex);
+
+      auto waiting = std::stable_partition(
+        retired.begin(),
+        retired.end(),
+        [OLDEST](const retired_t& value) { return value.epoch >= OLDEST; }
+      );
+
+      ready.assign(waiting, retired.end());
+      retired.erase(waiting, retired.end());
+      pending.store(retired.size(), std::memory_order_relaxed);
+    }
+
+    if (ready.empty()) {
+      break;
+    }
+
+    for (auto& value : ready) {
+      value.deleter(value.pointer);
+    }
+    freed += ready.size();
+  }
+
+  collecting.store(false, std::memory_order_release);
+  return freed;
+}
+
+
+/**
+  * @internal
+  * The `EpochManager::drain` method is internal of the `EpochManager` class
+  *
+  * @brief Description
+  * Frees every retired object without waiting for the readers, it is only
+  * called when no reader can be running, like in the destructor
+  *
+  * @return
+  * Returns the number of freed objects
+*/
+
+
+size_t EpochManager::drain() {
+  size_t freed = 0;
+
+  while (true) {
+    std::vector<retired_t> ready;
+    {
+      std::lock_guard<std::mutex> lock(retired_mutex);
+      ready.swap(retired);
+      pending.store(0, std::memory_order_relaxed);
+    }
+
+    if (ready.empty()) {
+      break;
+    }
+
+    for (auto& value : ready) {
+      value.deleter(value.pointer);
+    }
+    freed += ready.size();
+  }
+  return freed;
+}
+
+
+/**
+  * @internal
+  * The `EpochManager::pendingCount` method is internal of the `EpochManager` class
+  *
+  * @return
+  * Returns the number of retired objects that are not freed yet
+*/
+
+
+size_t EpochManager::pendingCount() const {
+  return pending.load(std::memory_order_relaxed);
+}
+
+
+/**
+  * @internal
+  * The `EpochManager::epoch` method is internal of the `EpochManager` class
+  *
+  * @return
+  * Returns the current global epoch
+*/
+
+
+uint64_t EpochManager::epoch() const {
+  return global_epoch.load(std::memory_order_acquire);
+}
+
+
+/**
+  * @internal
+  * The `EpochManager::global` method is internal of the `EpochManager` class
+  *
+  * @brief Description
+  * The manager shared by the whole engine, the `deleteInternalObject` methods
+  * of the brains and the clusters retire to it. It is never destroyed, so the
+  * static brains can still retire their clusters when the program exits
+  *
+  * @return
+  * Returns the global manager
+*/
+
+
+EpochManager& EpochManager::global() {
+  static EpochManager* manager = new EpochManager();
+  return *manager;
+}
+
+
+/**
+  * @internal
+  * The `EpochManager::~EpochManager` method is internal of the `EpochManager` class
+  *
+  * @brief Description
+  * The destructor of the `EpochManager` class, frees the retired objects and
+  * the records
+*/
+
+
+EpochManager::~EpochManager() noexcept {
+  drain();
+
+  epoch_record_t* record = records.load(std::memory_order_acquire);
+
+  while (record != nullptr) {
+    epoch_record_t* next = record->next;
+    delete record;
+    record = next;
+  }
+}
+
+
+/**
+  * @internal
+  * The `EpochGuard::EpochGuard` method is internal of the `EpochGuard` class
+  *
+  * @brief Description
+  * The constructor of the `EpochGuard` class, takes the record of the thread the
+  * first time and announces the global epoch if it is the outermost guard
+*/
+
+
+EpochGuard::EpochGuard() {
+  if (thread_epoch.record == nullptr) {
+    thread_epoch.record = EpochManager::global().acquireRecord();
+  }
+  record = thread_epoch.record;
+
+  if (thread_epoch.depth++ == 0) {
+    EpochManager::global().enter(record);
+  }
+}
+
+
+/**
+  * @internal
+  * The `EpochGuard::~EpochGuard` method is internal of the `EpochGuard` class
+  *
+  * @brief Description
+  * The destructor of the `EpochGuard` class, the outermost guard announces
+  * that the thread does not hold pointers anymore
+*/
+
+
+EpochGuard::~EpochGuard() noexcept {
+  if (--thread_epoch.depth == 0) {
+    EpochManager::global().exit(record);
+  }
+}
+
+
+/**
+  * @internal
+  * The `MemoryHold::acquire` method is internal of the `MemoryHold` class
+  *
+  * @brief Description
+  * Takes one more reference, the caller must already hold one or hold the
+  * lock that keeps the owner from detaching the hold
+*/
+
+
+void MemoryHold::acquire() {
+  refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+
+/**
+  * @internal
+  * The `MemoryHold::release` method is internal of the `MemoryHold` class
+  *
+  * @brief Description
+  * Drops one reference, the last one frees the kept buffers and the hold
+*/
+
+
+void MemoryHold::release() {
+  if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+    delete this;
+  }
+}
+
+
+/**
+  * @internal
+  * The `MemoryHold::keep` method is internal of the `MemoryHold` class
+  *
+  * @brief Description
+  * Takes the ownership of `pointer`, it is freed with `deleter` with the
+  * last reference, only the owner of the buffers calls it
+*/
+
+
+void MemoryHold::keep(void* pointer, void (*deleter)(void*)) {
+  kept.push_back(kept_t{pointer, deleter});
+}
+
+
+/**
+  * @internal
+  * The `MemoryHold::~MemoryHold` method is internal of the `MemoryHold` class
+  *
+  * @brief Description
+  * The destructor of the `MemoryHold` class, frees the kept buffers
+*/
+
+
+MemoryHold::~MemoryHold() noexcept {
+  for (const kept_t& buffer : kept) {
+    buffer.deleter(buffer.pointer);
+  }
+}
+
+
+/**
+  * @internal
+  * The `MemoryHoldSlot::share` method is internal of the `MemoryHoldSlot` class
+  *
+  * @brief Description
+  * Takes a reference of the hold for an export, the hold is made by the first
+  * export with the reference of the owner, the exports racing to make it keep
+  * the first one
+  *
+  * @return
+  * Returns the hold, the export releases it with `MemoryHold::release`
+*/
+
+
+MemoryHold* MemoryHoldSlot::share() const {
+  MemoryHold* current = hold.load(std::memory_order_acquire);
+
+  if (current == nullptr) {
+    MemoryHold* made = new MemoryHold();
+
+    if (hold.compare_exchange_strong(current, made, std::memory_order_acq_rel)) {
+      current = made;
+    } else {
+      made->release();
+    }
+  }
+
+  current->acquire();
+  return current;
+}
+
+
+/**
+  * @internal
+  * The `MemoryHoldSlot::~MemoryHoldSlot` method is internal of the `MemoryHoldSlot` class
+  *
+  * @brief Description
+  * The destructor of the `MemoryHoldSlot` class, drops the reference of the owner,
+  * which has already detached its buffers
+*/
+
+
+MemoryHoldSlot::~MemoryHoldSlot() noexcept {
+  MemoryHold* current = hold.exchange(nullptr, std::memory_order_acq_rel);
+
+  if (current != nullptr) {
+    current->release();
+  }
+}
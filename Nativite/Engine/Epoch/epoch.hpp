@@ -0,0 +1,286 @@
+/**
+  * @file epoch.hpp
+  * This is the documentation of the `epoch.hpp` file
+  *
+  * @brief Description
+  * Implementation of the EpochManager, EpochGuard and MemoryHold classes, the epoch
+  * based reclamation of the clusters, buckets and astructs removed by the writers and
+  * the reference counted holds of the buffers shared with the exports in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+/**
+ * @internal
+ * The EpochManager class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Defers the frees of the objects removed by the writers until no reader can
+ * still hold a pointer to them
+ *
+ * @details
+ * Every reader thread owns a record, cache line padded, where it announces the
+ * global epoch when a query begins and `quiescent` when it ends, that store is
+ * the whole cost of a read. A writer first unlinks an object, then retires it with
+ * `EpochManager::retire`, which tags it with the current global epoch. The
+ * collections advance the global epoch and free the objects tagged before the
+ * oldest announced epoch, so every reader that could see them has finished. The
+ * records are never freed while the manager lives, a thread that exits releases
+ * its record for the next thread.
+ *
+ * Only the readers that take no lock need a guard. The readers of
+ * `Brain::readCluster` hold the locks shared, which already keep the writers out.
+*/
+
+
+class EpochManager {
+  // Types
+  public:
+    // The epoch announced by a record that is not reading
+    static constexpr uint64_t quiescent = UINT64_MAX;
+
+    // The announcement of a reader thread, alone in its cache line so the
+    // readers do not invalidate the lines of each other
+    struct alignas(64) epoch_record_t {
+      std::atomic<uint64_t> epoch{quiescent};
+      std::atomic<bool>     used{false};
+      epoch_record_t*       next = nullptr;
+    };
+
+    // An object waiting for the readers of its epoch
+    struct retired_t {
+      void*    pointer;
+      void     (*deleter)(void*);
+      uint64_t epoch;
+    };
+
+  protected:
+    std::atomic<uint64_t>        global_epoch{1};   /**< The current epoch */
+    std::atomic<epoch_record_t*> records{nullptr};  /**< The list of records */
+    std::mutex                   retired_mutex;     /**< Protects the `retired` field */
+    std::vector<retired_t>       retired;           /**< The objects waiting to be freed */
+    std::atomic<size_t>          pending{0};        /**< The size of the `retired` field */
+    std::atomic<bool>            collecting{false}; /**< True during a collection */
+
+    uint64_t oldestEpoch() const;
+
+  public:
+    size_t collect_threshold = 256; /**< The retired objects that trigger a collection */
+
+    epoch_record_t* acquireRecord();
+    void            releaseRecord(epoch_record_t* record);
+
+    /**
+      * @internal
+      * The `EpochManager::enter` method is internal of the `EpochManager` class
+      *
+      * @brief Description
+      * Announces the global epoch in `record`, the store is sequentially consistent
+      * so the reads of the query can not move before it
+    */
+    void enter(epoch_record_t* record) {
+      record->epoch.store(global_epoch.load(std::memory_order_acquire), std::memory_order_seq_cst);
+    }
+
+    /**
+      * @internal
+      * The `EpochManager::exit` method is internal of the `EpochManager` class
+      *
+      * @brief Description
+      * Announces that the reader of `record` does not hold pointers anymore
+    */
+    void exit(epoch_record_t* record) {
+      record->epoch.store(quiescent, std::memory_order_release);
+    }
+
+    void retire(void* pointer, void (*deleter)(void*));
+
+    /**
+      * @internal
+      * The `EpochManager::retire` method is internal of the `EpochManager` class
+      *
+      * @brief Description
+      * Retires `pointer`, which is freed with `delete` once no reader can hold it,
+      * the manager takes its ownership
+    */
+    template <typename T>
+    void retire(T* pointer) {
+      if (pointer == nullptr) {
+        return;
+      }
+      retire(
+        static_cast<void*>(pointer),
+        [](void* value) { delete static_cast<T*>(value); }
+      );
+    }
+
+    size_t   collect();
+    size_t   drain();
+    size_t   pendingCount() const;
+    uint64_t epoch() const;
+
+    static EpochManager& global();
+
+    EpochManager() = default;
+
+    EpochManager(const EpochManager&)            = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    ~EpochManager() noexcept;
+};
+
+
+/**
+ * @internal
+ * The EpochGuard class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Keeps the objects reachable when it is created alive until it is destroyed,
+ * a query creates one on the stack before reading the brain
+ *
+ * @details
+ * The guard uses the record of its thread in the global manager, which is taken
+ * the first time and released when the thread exits. The guards can be nested,
+ * only the outermost guard announces the epoch.
+*/
+
+
+class EpochGuard {
+  protected:
+    EpochManager::epoch_record_t* record;
+
+  public:
+    EpochGuard();
+
+    EpochGuard(const EpochGuard&)            = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+
+    ~EpochGuard() noexcept;
+};
+
+
+/**
+ * @internal
+ * The MemoryHold class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * A reference counted set of buffers shared by an owner, a layer or a dictionary,
+ * and the exports that point to its memory instead of copying it
+ *
+ * @details
+ * The owner holds the first reference and every export takes one more. While the
+ * hold is shared the owner does not free nor reallocate its buffers in place, it moves
+ * them to the hold with `MemoryHold::keep` instead, which moves the heap memory of a
+ * vector without copying it, and drops its reference. The buffers are freed with the
+ * last reference, so an export can outlive its owner without stopping the epochs of
+ * the whole engine. Only the owner keeps buffers, so the kept buffers need no lock.
+*/
+
+
+class MemoryHold {
+  // Types
+  protected:
+    // A buffer moved out of its owner
+    struct kept_t {
+      void* pointer;
+      void  (*deleter)(void*);
+    };
+
+  protected:
+    std::atomic<size_t> refs{1}; /**< The owner and the exports that hold the buffers */
+    std::vector<kept_t> kept;    /**< The buffers moved out of the owner */
+
+    ~MemoryHold() noexcept;
+
+  public:
+    void acquire();
+    void release();
+
+    void keep(void* pointer, void (*deleter)(void*));
+
+    /**
+      * @internal
+      * The `MemoryHold::keep` method is internal of the `MemoryHold` class
+      *
+      * @brief Description
+      * Moves `value` to the hold, the heap memory of a vector keeps its address, if
+      * `copy` is true `value` is left with a copy so the owner can go on using it
+    */
+    template <typename T>
+    void keep(T& value, bool copy) {
+      T* moved = new T(std::move(value));
+
+      if (copy) {
+        value = *moved;
+      }
+      keep(static_cast<void*>(moved), [](void* pointer) { delete static_cast<T*>(pointer); });
+    }
+
+    MemoryHold() = default;
+
+    MemoryHold(const MemoryHold&)            = delete;
+    MemoryHold& operator=(const MemoryHold&) = delete;
+};
+
+
+/**
+ * @internal
+ * The MemoryHoldSlot class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * The hold of the buffers of an owner, it is made by the first export and
+ * detached by the owner before its buffers are freed or reallocated
+ *
+ * @details
+ * The exports share the hold under the shared lock of the cluster and the owner
+ * detaches it under the exclusive lock, so the hold never changes during an export.
+ * A copy of the owner does not share the buffers of the original, so a copy of the
+ * slot is empty.
+*/
+
+
+class MemoryHoldSlot {
+  protected:
+    mutable std::atomic<MemoryHold*> hold{nullptr}; /**< The hold, null if nothing is exported */
+
+  public:
+    MemoryHold* share() const;
+
+    /**
+      * @internal
+      * The `MemoryHoldSlot::detach` method is internal of the `MemoryHoldSlot` class
+      *
+      * @brief Description
+      * Moves `buffers` to the hold and drops the reference of the owner, if `copy`
+      * is true the owner keeps a copy of them. Nothing is moved if nothing is exported
+    */
+    template <typename... T>
+    void detach(bool copy, T&... buffers) {
+      MemoryHold* current = hold.exchange(nullptr, std::memory_order_acq_rel);
+
+      if (current == nullptr) {
+        return;
+      }
+      (current->keep(buffers, copy), ...);
+      current->release();
+    }
+
+    MemoryHoldSlot() = default;
+    MemoryHoldSlot(const MemoryHoldSlot&) {}
+    MemoryHoldSlot& operator=(const MemoryHoldSlot&) { return *this; }
+
+    ~MemoryHoldSlot() noexcept;
+};
@@ -0,0 +1,868 @@
+/**
+  * @file hash_join.cpp
+  * This is the documentation of the `hash_join.cpp` file
+  *
+  * @brief Description
+  * Implementation of the HashJoin class methods, the partitioning of both sides,
+  * the spill files and the join of every partition
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+// Nativite engine imports
+#include "hash_join.hpp"
+
+
+// The rows of a side whose encoded size is sampled by the estimate
+static constexpr size_t SAMPLE_ROWS = 256;
+
+// The bytes of the table of the build side per row, added to the estimate
+static constexpr size_t TABLE_ROW_BYTES = 48;
+
+// The largest partition bits, in memory and when a side is spilled
+static constexpr size_t MAXIMUM_RADIX_BITS = 12;
+static constexpr size_t MAXIMUM_SPILL_BITS = 14;
+
+// The spill files of all the joins of the process, to name them
+static std::atomic<size_t> spill_counter{0};
+
+
+/**
+  * @internal
+  * The `HashJoin::codec_t::writeRow` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Appends a row to the frame, its key and its viewed astructs prefixed by their
+  * length
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes to the `buffer` field
+*/
+
+
+void HashJoin::codec_t::writeRow(std::string_view key, const Cursor::view_t& row) {
+  writeVarint(key.size());
+  writeBytes(key.data(), key.size());
+
+  const size_t START = beginLengthPrefix();
+
+  writeVarint(row.size());
+  for (const auto astruct : row) {
+    writeAstruct(astruct);
+  }
+
+  endLengthPrefix(START);
+  rows++;
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::codec_t::size` and `HashJoin::codec_t::rewind` methods are
+  * internal of the `HashJoin` class
+  *
+  * @brief Description
+  * The written bytes of the frame, and the start of a new frame keeping the memory
+*/
+
+
+size_t HashJoin::codec_t::size() const {
+  return position;
+}
+
+
+void HashJoin::codec_t::rewind() {
+  position = 0;
+  rows     = 0;
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::codec_t::begin` and `HashJoin::codec_t::current` methods are
+  * internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Starts reading the rows of a frame, and the read position in the frame
+*/
+
+
+void HashJoin::codec_t::begin(const uint8_t* data, size_t size) {
+  beginRead(data, size);
+}
+
+
+const uint8_t* HashJoin::codec_t::current() const {
+  return cursor;
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::codec_t::readKey` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Reads the key of the next row of the frame, it is a view of the frame, then
+  * the row must be read or skipped
+  *
+  * @return
+  * Returns false at the end of the frame
+*/
+
+
+bool HashJoin::codec_t::readKey(std::string_view& key) {
+  uint64_t length = 0;
+
+  if (cursor >= end || !readVarint(length) || static_cast<size_t>(end - cursor) < length) {
+    return false;
+  }
+
+  key     = std::string_view(reinterpret_cast<const char*>(cursor), length);
+  cursor += length;
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::codec_t::readRow` and `HashJoin::codec_t::skipRow` methods are
+  * internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Appends the astructs of the row after the key to `row`, or skips them
+*/
+
+
+void HashJoin::codec_t::readRow(row_t& row) {
+  uint64_t length = 0;
+  uint64_t width  = 0;
+
+  readVarint(length);
+  readVarint(width);
+
+  for (uint64_t index = 0; index < width; index++) {
+    row.push_back(readAstruct(0));
+  }
+}
+
+
+void HashJoin::codec_t::skipRow() {
+  uint64_t length = 0;
+
+  readVarint(length);
+  cursor += std::min<size_t>(length, end - cursor);
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::appendKey` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Appends a key value to the key `key`, its kind and its bytes, an array or
+  * an object is written whole with its members
+  *
+  * @return
+  * Returns false if the value is empty or null, then the row has no key
+*/
+
+
+bool HashJoin::appendKey(std::string& key, const Astruct* astruct) {
+  if (astruct == nullptr || astruct->kind() == Astruct::astruct_kind_t::null) {
+    return false;
+  }
+
+  key.push_back(static_cast<char>(astruct->kind()));
+
+  switch (astruct->kind()) {
+    case Astruct::astruct_kind_t::boolean:
+      key.push_back(std::get<bool>(astruct->astruct) ? 1 : 0);
+      break;
+
+    case Astruct::astruct_kind_t::integer: {
+      const int64_t VALUE = std::get<int64_t>(astruct->astruct);
+      key.append(reinterpret_cast<const char*>(&VALUE), sizeof(VALUE));
+      break;
+    }
+
+    case Astruct::astruct_kind_t::real: {
+      // The zeros are the same key, whatever their sign
+      const double VALUE = std::get<double>(astruct->astruct) + 0.0;
+      key.append(reinterpret_cast<const char*>(&VALUE), sizeof(VALUE));
+      break;
+    }
+
+    case Astruct::astruct_kind_t::string: {
+      const auto&    value  = std::get<std::string>(astruct->astruct);
+      const uint32_t LENGTH = static_cast<uint32_t>(value.size());
+
+      key.append(reinterpret_cast<const char*>(&LENGTH), sizeof(LENGTH));
+      key.append(value);
+      break;
+    }
+
+    case Astruct::astruct_kind_t::array: {
+      const auto&    array  = std::get<Astruct::astruct_array_t>(astruct->astruct);
+      const uint32_t LENGTH = static_cast<uint32_t>(array.size());
+
+      key.append(reinterpret_cast<const char*>(&LENGTH), sizeof(LENGTH));
+      for (const auto child : array) {
+        if (!appendKey(key, child)) {
+          key.push_back(static_cast<char>(Astruct::astruct_kind_t::null));
+        }
+      }
+      break;
+    }
+
+    case Astruct::astruct_kind_t::object: {
+      const auto&    object = std::get<Astruct::astruct_object_t>(astruct->astruct);
+      const uint32_t LENGTH = static_cast<uint32_t>(object.size());
+
+      key.append(reinterpret_cast<const char*>(&LENGTH), sizeof(LENGTH));
+      for (const auto& member : object) {
+        const uint32_t NAME = static_cast<uint32_t>(member.first.size());
+
+        key.append(reinterpret_cast<const char*>(&NAME), sizeof(NAME));
+        key.append(member.first);
+
+        if (!appendKey(key, member.second)) {
+          key.push_back(static_cast<char>(Astruct::astruct_kind_t::null));
+        }
+      }
+      break;
+    }
+
+    default:
+      break;
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::estimateRows` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Counts the rows of the clusters of a side from the heights of their buckets,
+  * without reading the rows
+  *
+  * @return
+  * Returns the rows of the side
+*/
+
+
+size_t HashJoin::estimateRows(const side_t& side) const {
+  size_t rows = 0;
+
+  for (const auto cluster_index : side.clusters) {
+    side.brain->readCluster(cluster_index, [&](Cluster* cluster_) {
+      cluster_->forEachBucket([&](const Bucket* bucket_) {
+        rows += bucket_->height();
+      });
+    });
+  }
+  return rows;
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::estimateRowBytes` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Encodes the first rows of a side like the partitions do, their key and their
+  * projected astructs, to estimate the bytes of a row
+  *
+  * @return
+  * Returns the average encoded bytes of the sampled rows, 0 if the side is empty
+*/
+
+
+size_t HashJoin::estimateRowBytes(const side_t& side) const {
+  codec_t                            codec;
+  std::vector<Cursor::block_cache_t> caches;
+  std::string                        key;
+  Cursor::view_t                     row;
+
+  for (size_t index = 0; index < side.clusters.size() && codec.rows < SAMPLE_ROWS; index++) {
+    side.brain->readCluster(side.clusters[index], [&](Cluster* cluster_) {
+      cluster_->forEachBucket([&](const Bucket* bucket_) {
+        const size_t HEIGHT = bucket_->height();
+
+        for (size_t position = 0; position < HEIGHT && codec.rows < SAMPLE_ROWS; position++) {
+          key.assign(side.keys.size() * sizeof(int64_t), '\0');
+
+          Cursor::viewRow(bucket_, position, side.columns, caches, row);
+          codec.writeRow(key, row);
+        }
+      });
+    });
+  }
+
+  return codec.rows == 0 ? 0 : codec.size() / codec.rows;
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::partitionOf` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Chooses the partition of a key by the high bits of its hash, both sides
+  * choose the same partition for equal keys
+  *
+  * @return
+  * Returns the index of the partition
+*/
+
+
+size_t HashJoin::partitionOf(std::string_view key) const {
+  if (partition_bits == 0) {
+    return 0;
+  }
+  return std::hash<std::string_view>{}(key) >> (sizeof(size_t) * 8 - partition_bits);
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::flushFrame` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Appends the rows buffered by a thread to a partition as a frame prefixed by its
+  * size, to its frames in memory or to its spill file if it has one, and rewinds the
+  * buffer. The spill file is opened for the frame, so the files of a side are never
+  * all open, and a frame that can not be written is kept in memory
+  *
+  * @return
+  * This function does not return anything, since it
+  * only extends the partition
+*/
+
+
+void HashJoin::flushFrame(partition_t& partition, codec_t& codec) {
+  const uint64_t SIZE = codec.size();
+
+  if (SIZE == 0) {
+    return;
+  }
+
+  // Appends the frame to the frames in memory of the partition
+  const auto keepFrame = [&]() {
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&SIZE);
+
+    partition.frames.insert(partition.frames.end(), bytes, bytes + sizeof(SIZE));
+    partition.frames.insert(partition.frames.end(), codec.buffer.data(), codec.buffer.data() + SIZE);
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(partition.mutex);
+
+    if (partition.path.empty()) {
+      keepFrame();
+    } else {
+      std::ofstream file(partition.path, std::ios::binary | (partition.file_bytes != 0 ? std::ios::app : std::ios::trunc));
+
+      file.write(reinterpret_cast<const char*>(&SIZE), sizeof(SIZE));
+      file.write(reinterpret_cast<const char*>(codec.buffer.data()), static_cast<std::streamsize>(SIZE));
+      file.close();
+
+      if (file) {
+        partition.file_bytes += sizeof(SIZE) + SIZE;
+        spilled_bytes.fetch_add(sizeof(SIZE) + SIZE, std::memory_order_relaxed);
+      } else {
+        // The write failed, a partial frame is cut from the file and the frame is kept in memory
+        std::error_code error;
+        std::filesystem::resize_file(partition.path, partition.file_bytes, error);
+
+        keepFrame();
+      }
+    }
+    partition.rows += codec.rows;
+  }
+
+  codec.rewind();
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::scanClusters` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * The loop of a partitioning thread, it takes the next cluster of a side and
+  * writes its rows with a key to the frames of their partitions, holding the
+  * locks of the cluster shared
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `partitions`
+*/
+
+
+void HashJoin::scanClusters(const side_t& side, std::vector<partition_t>& partitions) {
+  std::vector<codec_t>               codecs(partitions.size());
+  std::vector<Cursor::block_cache_t> key_caches(side.keys.size());
+  std::vector<Cursor::block_cache_t> caches;
+  std::string                        key;
+  Cursor::view_t                     row;
+
+  for (
+    size_t index = next_task.fetch_add(1, std::memory_order_relaxed);
+    index < side.clusters.size();
+    index = next_task.fetch_add(1, std::memory_order_relaxed)
+  ) {
+    side.brain->readCluster(side.clusters[index], [&](Cluster* cluster_) {
+      cluster_->forEachBucket([&](const Bucket* bucket_) {
+        const size_t STACKS = bucket_->bucket.size();
+        const size_t HEIGHT = bucket_->height();
+
+        for (size_t position = 0; position < HEIGHT; position++) {
+          bool keyed = true;
+
+          key.clear();
+
+          for (size_t column = 0; column < side.keys.size() && keyed; column++) {
+            const size_t   STACK = side.keys[column];
+            const Astruct* value = STACK < STACKS ? Cursor::viewValue(bucket_, STACK, position, key_caches[column]) : nullptr;
+
+            keyed = appendKey(key, value);
+          }
+
+          if (!keyed) {
+            continue;
+          }
+
+          Cursor::viewRow(bucket_, position, side.columns, caches, row);
+
+          const size_t PARTITION = partitionOf(key);
+          codec_t&     codec     = codecs[PARTITION];
+
+          codec.writeRow(key, row);
+
+          if (codec.size() >= frame_bytes) {
+            flushFrame(partitions[PARTITION], codec);
+          }
+        }
+      });
+    });
+  }
+
+  for (size_t partition = 0; partition < partitions.size(); partition++) {
+    flushFrame(partitions[partition], codecs[partition]);
+  }
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::partitionSide` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Splits the rows of a side in its partitions scanning its clusters in parallel,
+  * a spilled side names a spill file per partition, created by its first frame
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `partitions`
+*/
+
+
+void HashJoin::partitionSide(const side_t& side, std::vector<partition_t>& partitions, const char* name, bool spill) {
+  partitions = std::vector<partition_t>(size_t{1} << partition_bits);
+
+  if (spill) {
+    std::error_code             error;
+    const std::filesystem::path DIRECTORY = spill_directory.empty()
+      ? std::filesystem::temp_directory_path(error)
+      : std::filesystem::path(spill_directory);
+    const size_t                JOIN      = spill_counter.fetch_add(1, std::memory_order_relaxed);
+
+    for (size_t index = 0; index < partitions.size(); index++) {
+      const auto PATH = DIRECTORY / (
+        "nativite_join_" + std::to_string(reinterpret_cast<uintptr_t>(this)) + "_" +
+        std::to_string(JOIN) + "_" + name + "_" + std::to_string(index) + ".spill"
+      );
+
+      partitions[index].path = PATH.string();
+    }
+  }
+
+  next_task.store(0, std::memory_order_relaxed);
+
+  const size_t THREADS = std::clamp<size_t>(
+    threads != 0 ? threads : std::thread::hardware_concurrency(),
+    1,
+    std::max<size_t>(1, side.clusters.size())
+  );
+
+  std::vector<std::thread> workers;
+
+  for (size_t index = 1; index < THREADS; index++) {
+    workers.emplace_back(&HashJoin::scanClusters, this, std::cref(side), std::ref(partitions));
+  }
+  scanClusters(side, partitions);
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::forEachFrame` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Visits the frames of a partition, the ones in memory and then the ones of its
+  * spill file, read back one frame at a time so only a frame of the file is in
+  * memory. The frames in memory are visited as stable, they outlive the visit
+  *
+  * @return
+  * This function does not return anything, since it
+  * only visits the frames
+*/
+
+
+void HashJoin::forEachFrame(partition_t& partition, const frame_visitor_t& visit) const {
+  uint64_t size = 0;
+
+  for (size_t position = 0; position + sizeof(size) <= partition.frames.size(); position += sizeof(size) + size) {
+    std::memcpy(&size, partition.frames.data() + position, sizeof(size));
+    visit(partition.frames.data() + position + sizeof(size), size, true);
+  }
+
+  if (partition.file_bytes == 0) {
+    return;
+  }
+
+  std::ifstream        file(partition.path, std::ios::binary);
+  std::vector<uint8_t> frame;
+
+  for (size_t position = 0; position < partition.file_bytes; position += sizeof(size) + size) {
+    if (!file.read(reinterpret_cast<char*>(&size), sizeof(size))) {
+      break;
+    }
+
+    frame.resize(size);
+
+    if (!file.read(reinterpret_cast<char*>(frame.data()), static_cast<std::streamsize>(size))) {
+      break;
+    }
+    visit(frame.data(), frame.size(), false);
+  }
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::removeSpill` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Releases the frames of a partition and deletes its spill file
+  *
+  * @return
+  * This function does not return anything, since it
+  * only empties the partition
+*/
+
+
+void HashJoin::removeSpill(partition_t& partition) const {
+  std::vector<uint8_t>().swap(partition.frames);
+
+  if (!partition.path.empty()) {
+    std::error_code error;
+    std::filesystem::remove(partition.path, error);
+    partition.path.clear();
+    partition.file_bytes = 0;
+  }
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::joinPartition` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Indexes the build rows of a partition by key, keeping them encoded, and probes
+  * the index with the probe rows of the partition frame by frame. A matching build
+  * row is decoded for every joined row, the probe row is decoded once per row
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `joined`
+*/
+
+
+void HashJoin::joinPartition(size_t partition, std::vector<row_t>& joined) {
+  partition_t& built  = build_partitions[partition];
+  partition_t& probed = probe_partitions[partition];
+
+  if (built.rows == 0 || probed.rows == 0) {
+    removeSpill(built);
+    removeSpill(probed);
+    return;
+  }
+
+  // The frames read back from the spill file are kept, the index points into them
+  std::vector<std::vector<uint8_t>>                                    frames;
+  std::unordered_map<std::string_view, std::vector<std::string_view>> index;
+  codec_t                                                              codec;
+  std::string_view                                                     key;
+
+  index.reserve(built.rows);
+
+  forEachFrame(built, [&](const uint8_t* data, size_t size, bool stable) {
+    if (!stable) {
+      frames.emplace_back(data, data + size);
+      data = frames.back().data();
+    }
+
+    codec.begin(data, size);
+
+    while (codec.readKey(key)) {
+      const uint8_t* START = codec.current();
+
+      codec.skipRow();
+      index[key].emplace_back(reinterpret_cast<const char*>(START), codec.current() - START);
+    }
+  });
+
+  codec_t decoder;
+  row_t   probe_row;
+
+  forEachFrame(probed, [&](const uint8_t* data, size_t size, bool) {
+    codec.begin(data, size);
+
+    while (codec.readKey(key)) {
+      const auto found = index.find(key);
+
+      if (found == index.end()) {
+        codec.skipRow();
+        continue;
+      }
+
+      probe_row.clear();
+      codec.readRow(probe_row);
+
+      const auto& matches = found->second;
+
+      for (size_t match = 0; match < matches.size(); match++) {
+        row_t build_row;
+        row_t row;
+
+        decoder.begin(reinterpret_cast<const uint8_t*>(matches[match].data()), matches[match].size());
+        decoder.readRow(build_row);
+
+        // The last match takes the probe astructs, the others copy them
+        row_t probe_values;
+
+        if (match + 1 == matches.size()) {
+          probe_values = std::move(probe_row);
+          probe_row.clear();
+        } else {
+          for (const auto astruct : probe_row) {
+            probe_values.push_back(astruct != nullptr ? astruct->clone() : nullptr);
+          }
+        }
+
+        row_t& first  = build_left ? build_row : probe_values;
+        row_t& second = build_left ? probe_values : build_row;
+
+        row.reserve(first.size() + second.size());
+        row.insert(row.end(), first.begin(), first.end());
+        row.insert(row.end(), second.begin(), second.end());
+
+        joined.push_back(std::move(row));
+      }
+    }
+  });
+
+  removeSpill(built);
+  removeSpill(probed);
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::joinPartitions` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * The loop of a join thread, it takes the next partition and joins it, no other
+  * thread reads the partition
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `joined`
+*/
+
+
+void HashJoin::joinPartitions(std::vector<std::vector<row_t>>& joined) {
+  for (
+    size_t partition = next_task.fetch_add(1, std::memory_order_relaxed);
+    partition < joined.size();
+    partition = next_task.fetch_add(1, std::memory_order_relaxed)
+  ) {
+    joinPartition(partition, joined[partition]);
+  }
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::join` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Joins the `left` and the `right` sides into the `results` field. The sizes of
+  * both sides are estimated first, they choose the build side and which sides are
+  * spilled, then both sides are partitioned and the partitions are joined in
+  * parallel. The rows of the last join are deleted first
+  *
+  * @return
+  * Returns the `results` field, the rows are not ordered
+*/
+
+
+std::vector<HashJoin::row_t>& HashJoin::join() {
+  clear();
+
+  estimated_build_bytes = 0;
+  estimated_probe_bytes = 0;
+  build_rows.store(0, std::memory_order_relaxed);
+  probe_rows.store(0, std::memory_order_relaxed);
+  spilled_bytes.store(0, std::memory_order_relaxed);
+
+  if (
+    left.brain == nullptr || right.brain == nullptr ||
+    left.keys.empty() || left.keys.size() != right.keys.size()
+  ) {
+    return results;
+  }
+
+  // The sides without clusters join all the clusters of their brain
+  side_t left_side  = left;
+  side_t right_side = right;
+
+  for (side_t* side : {&left_side, &right_side}) {
+    auto structure = side->brain->lockStructureShared();
+
+    if (side->clusters.empty()) {
+      for (size_t index = 0; index < side->brain->brain.size(); index++) {
+        side->clusters.push_back(index);
+      }
+    }
+  }
+
+  const size_t LEFT_BYTES  = estimateRows(left_side) * (estimateRowBytes(left_side) + TABLE_ROW_BYTES);
+  const size_t RIGHT_BYTES = estimateRows(right_side) * (estimateRowBytes(right_side) + TABLE_ROW_BYTES);
+
+  build_left = build_side == build_side_t::automatic
+    ? LEFT_BYTES <= RIGHT_BYTES
+    : build_side == build_side_t::left;
+
+  estimated_build_bytes = build_left ? LEFT_BYTES : RIGHT_BYTES;
+  estimated_probe_bytes = build_left ? RIGHT_BYTES : LEFT_BYTES;
+
+  const bool SPILL_BUILD = estimated_build_bytes > memory_limit;
+  const bool SPILL_PROBE = estimated_probe_bytes > memory_limit;
+
+  // A spilled build side has enough partitions that one fits in half the limit
+  partition_bits = std::min(radix_bits, MAXIMUM_RADIX_BITS);
+
+  while (
+    SPILL_BUILD &&
+    partition_bits < MAXIMUM_SPILL_BITS &&
+    (estimated_build_bytes >> partition_bits) > memory_limit / 2
+  ) {
+    partition_bits++;
+  }
+
+  partitionSide(build_left ? left_side : right_side, build_partitions, "build", SPILL_BUILD);
+  partitionSide(build_left ? right_side : left_side, probe_partitions, "probe", SPILL_PROBE);
+
+  for (const auto& partition : build_partitions) {
+    build_rows.fetch_add(partition.rows, std::memory_order_relaxed);
+  }
+  for (const auto& partition : probe_partitions) {
+    probe_rows.fetch_add(partition.rows, std::memory_order_relaxed);
+  }
+
+  std::vector<std::vector<row_t>> joined(build_partitions.size());
+  std::vector<std::thread>        workers;
+
+  const size_t THREADS = std::clamp<size_t>(
+    threads != 0 ? threads : std::thread::hardware_concurrency(),
+    1,
+    joined.size()
+  );
+
+  next_task.store(0, std::memory_order_relaxed);
+
+  for (size_t index = 1; index < THREADS; index++) {
+    workers.emplace_back(&HashJoin::joinPartitions, this, std::ref(joined));
+  }
+  joinPartitions(joined);
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (auto& rows : joined) {
+    std::move(rows.begin(), rows.end(), std::back_inserter(results));
+  }
+
+  build_partitions.clear();
+  probe_partitions.clear();
+  return results;
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::clear` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * Deletes the rows of the last join
+  *
+  * @return
+  * This function does not return anything, since it
+  * only empties the `results` field
+*/
+
+
+void HashJoin::clear() {
+  for (auto& row : results) {
+    for (auto astruct : row) {
+      delete astruct;
+    }
+  }
+  results.clear();
+}
+
+
+/**
+  * @internal
+  * The `HashJoin::~HashJoin` method is internal of the `HashJoin` class
+  *
+  * @brief Description
+  * The destructor of the `HashJoin` class, it deletes the rows of the results
+*/
+
+
+HashJoin::~HashJoin() noexcept {
+  clear();
+}
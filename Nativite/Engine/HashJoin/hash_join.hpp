@@ -0,0 +1,168 @@
+/**
+  * @file hash_join.hpp
+  * This is the documentation of the `hash_join.hpp` file
+  *
+  * @brief Description
+  * Implementation of the HashJoin class, the parallel radix partitioned hash join
+  * of the clusters of two brains in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Nativite engine imports
+#include "../Brain/brain.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Astruct/astruct.hpp"
+#include "../Cursor/cursor.hpp"
+#include "../Serializer/serializer.hpp"
+
+
+/**
+ * @internal
+ * The HashJoin class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Joins the rows of two brains, or of two sets of clusters of the same brain, whose
+ * key stacks have equal values, the INNER JOIN of the `left` and `right` sides
+ *
+ * @details
+ * The clusters of a side are scanned in parallel and every row is written with its
+ * key to one of the `2^radix_bits` partitions of the side, chosen by the high bits
+ * of the hash of the key. The rows are encoded with the astruct format of the
+ * Serializer class and every thread appends them to its partitions in frames, so
+ * a partition is only locked once per frame. Then every partition is joined by a
+ * single thread, it indexes the build rows of the partition by key and probes them
+ * with the rows of the other side, the build rows are only decoded when they match.
+ *
+ * The build side is the side with the smallest estimated size, the rows of its
+ * clusters times the encoded size of a sample of its rows. A side whose estimate
+ * exceeds `memory_limit` spills its partitions to files in `spill_directory`, a
+ * spilled build side has enough partitions that one fits in half the limit, and
+ * the probe partitions are read back a frame at a time. A spill file is only opened
+ * to append a frame, and a frame that can not be written stays in memory.
+ *
+ * A key is typed, the integer 1 and the real 1.0 do not match, and the rows with an
+ * empty or a null key never match, like in SQL.
+*/
+
+
+class HashJoin {
+  // Types
+  public:
+    using row_t = Cursor::row_t;
+
+    // The side of a join that is built, the smallest by default
+    enum class build_side_t : uint8_t {
+      automatic = 0,
+      left      = 1,
+      right     = 2
+    };
+
+    // A side of a join, the clusters of a brain and the stacks of its rows
+    struct side_t {
+      Brain*              brain = nullptr;
+      std::vector<size_t> clusters; /**< The joined clusters, empty to join all of them */
+      std::vector<size_t> keys;     /**< The stacks of the key, one per key of the other side */
+      std::vector<size_t> columns;  /**< The projected stacks, empty to read all of them */
+    };
+
+  protected:
+    // The encoding of the rows of a partition, every row is its key and its
+    // projected astructs prefixed by their length, so a row can be skipped
+    class codec_t : protected Serializer {
+      public:
+        using Serializer::buffer;
+
+        size_t rows = 0; /**< The rows written since the last rewind */
+
+        void   writeRow(std::string_view key, const Cursor::view_t& row);
+        size_t size() const;
+        void   rewind();
+
+        void           begin(const uint8_t* data, size_t size);
+        const uint8_t* current() const;
+        bool           readKey(std::string_view& key);
+        void           readRow(row_t& row);
+        void           skipRow();
+
+        codec_t() = default;
+    };
+
+    // A partition of a side, its frames are in memory or in its spill file
+    struct partition_t {
+      std::mutex           mutex;
+      std::vector<uint8_t> frames;         /**< The frames in memory, every frame prefixed by its size */
+      std::string          path;           /**< The spill file of a spilled side, empty in memory */
+      size_t               file_bytes = 0; /**< The bytes of the frames written to the spill file */
+      size_t               rows       = 0;
+    };
+
+    // The visitor of the frames of a partition, its data, its size and if it stays in memory
+    using frame_visitor_t = std::function<void(const uint8_t*, size_t, bool)>;
+
+    // Internal functions of the class
+    static bool appendKey(std::string& key, const Astruct* astruct);
+
+    size_t estimateRows(const side_t& side) const;
+    size_t estimateRowBytes(const side_t& side) const;
+    size_t partitionOf(std::string_view key) const;
+
+    void flushFrame(partition_t& partition, codec_t& codec);
+    void scanClusters(const side_t& side, std::vector<partition_t>& partitions);
+    void partitionSide(const side_t& side, std::vector<partition_t>& partitions, const char* name, bool spill);
+
+
+    void forEachFrame(partition_t& partition, const frame_visitor_t& visit) const;
+    void removeSpill(partition_t& partition) const;
+    void joinPartition(size_t partition, std::vector<row_t>& joined);
+    void joinPartitions(std::vector<std::vector<row_t>>& joined);
+
+    std::vector<partition_t> build_partitions;
+    std::vector<partition_t> probe_partitions;
+    bool                     build_left     = true; /**< If the left side is the build side */
+    size_t                   partition_bits = 0;    /**< The partitions of both sides are `2^partition_bits` */
+    std::atomic<size_t>      next_task{0};          /**< The next cluster to scan or partition to join */
+
+  public:
+    side_t       left;                                  /**< The left side, its columns come first */
+    side_t       right;                                 /**< The right side */
+    build_side_t build_side   = build_side_t::automatic;
+    size_t       threads      = 0;                      /**< The join threads, 0 is one per hardware thread */
+    size_t       radix_bits   = 6;                      /**< The partitions in memory are `2^radix_bits` */
+    size_t       memory_limit = size_t{256} << 20;      /**< The estimated bytes of a side kept in memory */
+    size_t       frame_bytes  = size_t{64} << 10;       /**< The bytes a thread buffers per partition */
+    std::string  spill_directory;                       /**< The directory of the spill files, empty for the temporary one */
+
+    std::vector<row_t> results; /**< The rows of the last join, the left columns then the right ones */
+
+    size_t              estimated_build_bytes = 0; /**< The estimated size of the build side */
+    size_t              estimated_probe_bytes = 0; /**< The estimated size of the probe side */
+    std::atomic<size_t> build_rows{0};             /**< The rows of the build side with a key */
+    std::atomic<size_t> probe_rows{0};             /**< The rows of the probe side with a key */
+    std::atomic<size_t> spilled_bytes{0};          /**< The bytes written to the spill files */
+
+    std::vector<row_t>& join();
+    void                clear();
+
+    HashJoin() = default;
+
+    HashJoin(const HashJoin&)            = delete;
+    HashJoin& operator=(const HashJoin&) = delete;
+
+    ~HashJoin() noexcept;
+};
@@ -0,0 +1,419 @@
+/**
+  * @file ingestor.cpp
+  * This is the documentation of the `ingestor.cpp` file
+  *
+  * @brief Description
+  * Implementation of the Ingestor class methods, the stages of the pipeline,
+  * their threads and the submission of the batches
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <unordered_map>
+#include <utility>
+
+// Nativite engine imports
+#include "ingestor.hpp"
+#include "../Astruct/astruct.hpp"
+#include "../AppendBuffer/append_buffer.hpp"
+#include "../Epoch/epoch.hpp"
+
+
+/**
+  * @internal
+  * The `Ingestor::rejectRows` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * Deletes the astructs of `rows` and counts them in `rejected_rows`
+  *
+  * @return
+  * This function does not return anything, since it
+  * only deletes the rows
+*/
+
+
+void Ingestor::rejectRows(rows_t& rows) {
+  for (auto& row : rows) {
+    for (Astruct* astruct : row) {
+      delete astruct;
+    }
+  }
+
+  rejected_rows.fetch_add(rows.size(), std::memory_order_relaxed);
+  rows.clear();
+}
+
+
+/**
+  * @internal
+  * The `Ingestor::parseStage` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * The loop of a parse thread, parses the batches of records to batches of rows
+  * until the records queue is closed and empty
+  *
+  * @return
+  * This function does not return anything, since it
+  * only feeds the route stage
+*/
+
+
+void Ingestor::parseStage() {
+  records_t records;
+
+  while (records_queue->pop(records)) {
+    rows_t rows;
+    rows_t malformed;
+
+    rows.reserve(records.size());
+
+    for (const auto& record : records) {
+      row_t row;
+
+      if (parse(record, row)) {
+        rows.push_back(std::move(row));
+      } else {
+        malformed.push_back(std::move(row));
+      }
+    }
+
+    rejectRows(malformed);
+    parsed_rows.fetch_add(rows.size(), std::memory_order_relaxed);
+
+    if (!rows.empty() && !rows_queue->push(std::move(rows))) {
+      rejectRows(rows);
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Ingestor::routeStage` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * The loop of a route thread, splits every batch of rows by cluster and sends
+  * the rows of a cluster to the append thread of the cluster
+  *
+  * @return
+  * This function does not return anything, since it
+  * only feeds the append stage
+*/
+
+
+void Ingestor::routeStage() {
+  rows_t rows;
+
+  while (rows_queue->pop(rows)) {
+    std::unordered_map<size_t, rows_t> clusters;
+
+    for (auto& row : rows) {
+      clusters[route(row)].push_back(std::move(row));
+    }
+
+    for (auto& [cluster_index, cluster_rows] : clusters) {
+      routed_t routed{cluster_index, std::move(cluster_rows)};
+
+      if (!routed_queues[cluster_index % routed_queues.size()]->push(std::move(routed))) {
+        rejectRows(routed.rows);
+      }
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Ingestor::appendStage` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * The loop of an append thread, appends the routed rows of its clusters until
+  * its queue is closed and empty, then flushes the append buffers of the clusters
+  * it appended to, so their rows are in buckets when the ingestion finishes
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the rows
+*/
+
+
+void Ingestor::appendStage(size_t queue_index) {
+  std::vector<size_t> touched;
+  routed_t            routed;
+
+  while (routed_queues[queue_index]->pop(routed)) {
+    if (std::find(touched.begin(), touched.end(), routed.cluster_index) == touched.end()) {
+      touched.push_back(routed.cluster_index);
+    }
+    appendRows(routed);
+  }
+
+  for (size_t cluster_index : touched) {
+    auto structure = brain->lockStructureShared();
+
+    if (cluster_index < brain->brain.size() && brain->brain[cluster_index] != nullptr) {
+      brain->brain[cluster_index]->flushAppends();
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Ingestor::appendRows` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * Appends the rows of `routed` to its cluster without locking the cluster, the
+  * structure lock is held shared so the cluster is not removed meanwhile. The rows
+  * of a missing cluster and the rows wider than its append buffer are rejected
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the rows
+*/
+
+
+void Ingestor::appendRows(routed_t& routed) {
+  EpochGuard guard;
+  auto       structure = brain->lockStructureShared();
+
+  if (routed.cluster_index >= brain->brain.size() || brain->brain[routed.cluster_index] == nullptr) {
+    rejectRows(routed.rows);
+    return;
+  }
+
+  Cluster* cluster_ = brain->brain[routed.cluster_index];
+
+  if (cluster_->append_buffer.load(std::memory_order_acquire) == nullptr) {
+    cluster_->enableAppends(width != 0 ? width : routed.rows.front().size());
+  }
+
+  rows_t wide;
+  size_t appended = 0;
+
+  for (auto& row : routed.rows) {
+    if (cluster_->appendRow(row)) {
+      appended++;
+    } else {
+      wide.push_back(std::move(row));
+    }
+  }
+
+  appended_rows.fetch_add(appended, std::memory_order_relaxed);
+  rejectRows(wide);
+}
+
+
+/**
+  * @internal
+  * The `Ingestor::start` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * Creates the queues and starts the threads of every stage, it does nothing if
+  * the pipeline is already running
+  *
+  * @return
+  * This function does not return anything, since it
+  * only starts the pipeline
+*/
+
+
+void Ingestor::start() {
+  if (running) {
+    return;
+  }
+
+  running       = true;
+  records_queue = new BoundedQueue<records_t>(queue_capacity);
+  rows_queue    = new BoundedQueue<rows_t>(queue_capacity);
+
+  for (size_t index = 0; index < std::max<size_t>(1, append_threads); index++) {
+    routed_queues.push_back(new BoundedQueue<routed_t>(queue_capacity));
+  }
+
+  for (size_t index = 0; index < std::max<size_t>(1, parse_threads); index++) {
+    parse_workers.emplace_back(&Ingestor::parseStage, this);
+  }
+
+  for (size_t index = 0; index < std::max<size_t>(1, route_threads); index++) {
+    route_workers.emplace_back(&Ingestor::routeStage, this);
+  }
+
+  for (size_t index = 0; index < routed_queues.size(); index++) {
+    append_workers.emplace_back(&Ingestor::appendStage, this, index);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Ingestor::submit` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * Sends a batch of records to the parse stage, waiting while the stage is busy
+  *
+  * @return
+  * Returns false if the pipeline is not running
+*/
+
+
+bool Ingestor::submit(records_t&& records) {
+  return running && records_queue->push(std::move(records));
+}
+
+
+/**
+  * @internal
+  * The `Ingestor::submitRows` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * Sends a batch of parsed rows to the route stage, skipping the parse stage,
+  * waiting while the stage is busy. The ingestor always takes the ownership of
+  * the astructs, the rows that can not be sent are deleted and counted in
+  * `rejected_rows`
+  *
+  * @return
+  * Returns false if the pipeline is not running or was closed
+*/
+
+
+bool Ingestor::submitRows(rows_t&& rows) {
+  if (!running) {
+    rejectRows(rows);
+    return false;
+  }
+
+  const size_t ROWS = rows.size();
+
+  // A closed queue does not move the rows
+  if (!rows_queue->push(std::move(rows))) {
+    rejectRows(rows);
+    return false;
+  }
+
+  parsed_rows.fetch_add(ROWS, std::memory_order_relaxed);
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Ingestor::finish` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * Closes the stages one after the other, so every submitted batch goes through
+  * the whole pipeline, joins their threads and deletes the queues
+  *
+  * @return
+  * Returns the number of appended rows
+*/
+
+
+size_t Ingestor::finish() {
+  if (!running) {
+    return appended_rows.load(std::memory_order_relaxed);
+  }
+
+  records_queue->close();
+
+  for (auto& worker : parse_workers) {
+    worker.join();
+  }
+
+  rows_queue->close();
+
+  for (auto& worker : route_workers) {
+    worker.join();
+  }
+
+  for (auto queue : routed_queues) {
+    queue->close();
+  }
+
+  for (auto& worker : append_workers) {
+    worker.join();
+  }
+
+  parse_workers.clear();
+  route_workers.clear();
+  append_workers.clear();
+
+  delete records_queue;
+  delete rows_queue;
+
+  for (auto queue : routed_queues) {
+    delete queue;
+  }
+
+  records_queue = nullptr;
+  rows_queue    = nullptr;
+  running       = false;
+
+  routed_queues.clear();
+
+  return appended_rows.load(std::memory_order_relaxed);
+}
+
+
+/**
+  * @internal
+  * The `Ingestor::ingest` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * Inserts all the `records` at once, they are split in batches of `batch_rows`
+  * records and sent through the pipeline, which is started if it is not running
+  *
+  * @return
+  * Returns the number of appended rows
+*/
+
+
+size_t Ingestor::ingest(records_t&& records) {
+  const size_t BATCH_ROWS = std::max<size_t>(1, batch_rows);
+
+  start();
+
+  for (size_t first = 0; first < records.size(); first += BATCH_ROWS) {
+    const size_t LAST = std::min(first + BATCH_ROWS, records.size());
+
+    submit(records_t(
+      std::make_move_iterator(records.begin() + first),
+      std::make_move_iterator(records.begin() + LAST)
+    ));
+  }
+
+  records.clear();
+  return finish();
+}
+
+
+/**
+  * @internal
+  * The `Ingestor::Ingestor` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * The constructor of the `Ingestor` class, the threads are not started until
+  * `Ingestor::start` is called
+*/
+
+
+Ingestor::Ingestor(Brain* brain_v, parse_t parse_v, route_t route_v)
+  : brain(brain_v), parse(std::move(parse_v)), route(std::move(route_v)) {}
+
+
+/**
+  * @internal
+  * The `Ingestor::~Ingestor` method is internal of the `Ingestor` class
+  *
+  * @brief Description
+  * The destructor of the `Ingestor` class, finishes the pipeline
+*/
+
+
+Ingestor::~Ingestor() noexcept {
+  finish();
+}
@@ -0,0 +1,130 @@
+/**
+  * @file ingestor.hpp
+  * This is the documentation of the `ingestor.hpp` file
+  *
+  * @brief Description
+  * Implementation of the Ingestor class, the bulk insertion of records in a brain
+  * through a pipeline of parse, route and append stages in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+// Nativite engine imports
+#include "../Brain/brain.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../BoundedQueue/bounded_queue.hpp"
+
+// Forward reference to `Astruct`
+class Astruct;
+
+
+/**
+ * @internal
+ * The Ingestor class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Inserts big batches of records in a brain, every record is parsed to a row of
+ * astructs, routed to a cluster by `route` and appended to the open bucket of
+ * the cluster with `Cluster::appendRow`
+ *
+ * @details
+ * Every stage has its own threads and the stages are joined by bounded queues of
+ * batches, so a slow stage makes the stages before it wait and the memory of a
+ * big ingestion does not grow. The route stage splits every batch by cluster and
+ * the batches of a cluster always go to the same append thread, which enables the
+ * appends of the cluster with `width` stacks the first time and flushes its append
+ * buffer to a bucket when the ingestion finishes.
+ *
+ * The batches are submitted by one thread with `Ingestor::submit`, or as parsed rows
+ * with `Ingestor::submitRows` by the loaders that parse by themselves, and
+ * `Ingestor::finish` waits for the stages. The rows that can not be parsed, routed or
+ * appended are deleted and counted in `rejected_rows`.
+*/
+
+
+class Ingestor {
+  // Types
+  public:
+    // A parsed record, the stacks of a row of a bucket
+    using row_t = std::vector<Astruct*>;
+
+    // The batches of every stage
+    using records_t = std::vector<std::string>;
+    using rows_t    = std::vector<row_t>;
+
+    // Parses `record` into `row`, it returns false if the record is malformed
+    using parse_t = std::function<bool(std::string_view record, row_t& row)>;
+
+    // The index of the cluster of `row` in the `brain` field of the brain
+    using route_t = std::function<size_t(const row_t& row)>;
+
+    // The rows of a batch that go to the same cluster
+    struct routed_t {
+      size_t cluster_index = 0;
+      rows_t rows;
+    };
+
+  protected:
+    // Internal functions of the class
+    void rejectRows(rows_t& rows);
+
+    void parseStage();
+    void routeStage();
+    void appendStage(size_t queue_index);
+
+    void appendRows(routed_t& routed);
+
+    BoundedQueue<records_t>*             records_queue = nullptr; /**< Parse stage input */
+    BoundedQueue<rows_t>*                rows_queue    = nullptr; /**< Route stage input */
+    std::vector<BoundedQueue<routed_t>*> routed_queues;           /**< Append stage inputs */
+
+    std::vector<std::thread> parse_workers;
+    std::vector<std::thread> route_workers;
+    std::vector<std::thread> append_workers;
+
+    bool running = false;
+
+  public:
+    Brain*  brain = nullptr; /**< The brain that receives the rows */
+    parse_t parse;           /**< The parser of the records */
+    route_t route;           /**< The partitioning function of the rows */
+
+    size_t parse_threads  = 2;    /**< The threads of the parse stage */
+    size_t route_threads  = 1;    /**< The threads of the route stage */
+    size_t append_threads = 2;    /**< The threads of the append stage */
+    size_t queue_capacity = 8;    /**< The batches waiting between two stages */
+    size_t batch_rows     = 4096; /**< The records of a batch of `Ingestor::ingest` */
+    size_t width          = 0;    /**< The stacks of the append buffers, 0 is the
+                                       width of the first row of the cluster */
+
+    std::atomic<size_t> parsed_rows{0};   /**< The rows that were parsed */
+    std::atomic<size_t> appended_rows{0}; /**< The rows that were appended */
+    std::atomic<size_t> rejected_rows{0}; /**< The rows that were deleted */
+
+    void start();
+    bool submit(records_t&& records);
+    bool submitRows(rows_t&& rows);
+    size_t finish();
+
+    size_t ingest(records_t&& records);
+
+    Ingestor(Brain* brain_v, parse_t parse_v, route_t route_v);
+
+    Ingestor(const Ingestor&)            = delete;
+    Ingestor& operator=(const Ingestor&) = delete;
+
+    ~Ingestor() noexcept;
+};
@@ -0,0 +1,938 @@
+/**
+  * @file json_loader.cpp
+  * This is the documentation of the `json_loader.cpp` file
+  *
+  * @brief Description
+  * Implementation of the JsonLoader class methods, the structural index of the
+  * first stage, the astructs of the second stage and the parallel chunks
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <thread>
+#include <utility>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+  #include <emmintrin.h>
+#endif
+
+// Nativite engine imports
+#include "json_loader.hpp"
+#include "../Astruct/astruct.hpp"
+#include "../MappedFile/mapped_file.hpp"
+
+
+// Reads the four hexadecimal digits of a `\u` escape at `position`
+static bool readHex(const char* data, size_t size, size_t position, uint32_t& code) {
+  if (position + 4 > size) {
+    return false;
+  }
+
+  const auto [END, ERROR] = std::from_chars(data + position, data + position + 4, code, 16);
+  return ERROR == std::errc() && END == data + position + 4;
+}
+
+
+// Appends the code point `code` to `value` encoded in UTF-8
+static void appendUtf8(std::string& value, uint32_t code) {
+  if (code < 0x80) {
+    value += static_cast<char>(code);
+  } else if (code < 0x800) {
+    value += static_cast<char>(0xC0 | (code >> 6));
+    value += static_cast<char>(0x80 | (code & 0x3F));
+  } else if (code < 0x10000) {
+    value += static_cast<char>(0xE0 | (code >> 12));
+    value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    value += static_cast<char>(0x80 | (code & 0x3F));
+  } else {
+    value += static_cast<char>(0xF0 | (code >> 18));
+    value += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+    value += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+    value += static_cast<char>(0x80 | (code & 0x3F));
+  }
+}
+
+
+// The bytes that end a scalar
+static bool isDelimiter(char character) {
+  switch (character) {
+    case ' ': case '\t': case '\n': case '\r':
+    case ',': case ':': case '[': case ']': case '{': case '}': case '"':
+      return true;
+    default:
+      return false;
+  }
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::classifyBlock` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Compares the 64 bytes of `block` with the quote, the backslash, the operators
+  * and the whitespaces at once with SSE2 or AVX2, one byte at a time without them.
+  * The brackets and the braces only differ in the bit 0x20, so they are compared
+  * with that bit set
+  *
+  * @return
+  * Returns the bitmasks of the block
+*/
+
+
+JsonLoader::block_masks_t JsonLoader::classifyBlock(const char* block) {
+  block_masks_t masks;
+
+#if defined(__AVX2__)
+  for (size_t offset = 0; offset < block_size; offset += 32) {
+    const __m256i BYTES  = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block + offset));
+    const __m256i FOLDED = _mm256_or_si256(BYTES, _mm256_set1_epi8(0x20));
+
+    auto is   = [](__m256i bytes, char value) { return _mm256_cmpeq_epi8(bytes, _mm256_set1_epi8(value)); };
+    auto bits = [&](__m256i equal) {
+      return uint64_t(uint32_t(_mm256_movemask_epi8(equal))) << offset;
+    };
+
+    const __m256i NEWLINES = is(BYTES, '\n');
+
+    masks.quotes      |= bits(is(BYTES, '"'));
+    masks.backslashes |= bits(is(BYTES, '\\'));
+    masks.newlines    |= bits(NEWLINES);
+    masks.operators   |= bits(_mm256_or_si256(
+      _mm256_or_si256(is(FOLDED, '{'), is(FOLDED, '}')),
+      _mm256_or_si256(is(BYTES, ':'), is(BYTES, ','))
+    ));
+    masks.whitespaces |= bits(_mm256_or_si256(
+      _mm256_or_si256(is(BYTES, ' '), is(BYTES, '\t')),
+      _mm256_or_si256(NEWLINES, is(BYTES, '\r'))
+    ));
+  }
+#elif defined(__SSE2__) || defined(_M_X64)
+  for (size_t offset = 0; offset < block_size; offset += 16) {
+    const __m128i BYTES  = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block + offset));
+    const __m128i FOLDED = _mm_or_si128(BYTES, _mm_set1_epi8(0x20));
+
+    auto is   = [](__m128i bytes, char value) { return _mm_cmpeq_epi8(bytes, _mm_set1_epi8(value)); };
+    auto bits = [&](__m128i equal) {
+      return uint64_t(uint16_t(_mm_movemask_epi8(equal))) << offset;
+    };
+
+    const __m128i NEWLINES = is(BYTES, '\n');
+
+    masks.quotes      |= bits(is(BYTES, '"'));
+    masks.backslashes |= bits(is(BYTES, '\\'));
+    masks.newlines    |= bits(NEWLINES);
+    masks.operators   |= bits(_mm_or_si128(
+      _mm_or_si128(is(FOLDED, '{'), is(FOLDED, '}')),
+      _mm_or_si128(is(BYTES, ':'), is(BYTES, ','))
+    ));
+    masks.whitespaces |= bits(_mm_or_si128(
+      _mm_or_si128(is(BYTES, ' '), is(BYTES, '\t')),
+      _mm_or_si128(NEWLINES, is(BYTES, '\r'))
+    ));
+  }
+#else
+  for (size_t index = 0; index < block_size; index++) {
+    const uint64_t BIT = uint64_t(1) << index;
+
+    switch (block[index]) {
+      case '"':  masks.quotes      |= BIT; break;
+      case '\\': masks.backslashes |= BIT; break;
+      case '\n': masks.newlines    |= BIT; masks.whitespaces |= BIT; break;
+      case ' ': case '\t': case '\r':
+        masks.whitespaces |= BIT;
+        break;
+      case '{': case '}': case '[': case ']': case ':': case ',':
+        masks.operators |= BIT;
+        break;
+      default:
+        break;
+    }
+  }
+#endif
+
+  return masks;
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::findEscaped` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Finds the bytes escaped by a backslash, every backslash that is not escaped
+  * escapes the next byte. The backslashes are rare, so they are walked one at a time,
+  * `escaped` carries the escape of the first byte of the next block
+  *
+  * @return
+  * Returns the bitmask of the escaped bytes
+*/
+
+
+uint64_t JsonLoader::findEscaped(uint64_t backslashes, uint64_t& escaped) {
+  uint64_t result = escaped;
+
+  backslashes &= ~escaped;
+  escaped      = 0;
+
+  while (backslashes != 0) {
+    const int BACKSLASH = std::countr_zero(backslashes);
+
+    if (BACKSLASH == 63) {
+      escaped = 1;
+      break;
+    }
+
+    const uint64_t NEXT = uint64_t(1) << (BACKSLASH + 1);
+
+    result      |= NEXT;
+    backslashes &= ~(NEXT | (NEXT >> 1));
+  }
+  return result;
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::prefixXor` method is internal of the `JsonLoader` class
+  *
+  * @return
+  * Returns a bitmask where the bit `i` is the xor of the bits `0` to `i` of `bits`,
+  * for the quotes it is set from an opening quote to the byte before its closing quote
+*/
+
+
+uint64_t JsonLoader::prefixXor(uint64_t bits) {
+  bits ^= bits << 1;
+  bits ^= bits << 2;
+  bits ^= bits << 4;
+  bits ^= bits << 8;
+  bits ^= bits << 16;
+  bits ^= bits << 32;
+
+  return bits;
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::buildIndex` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * The first stage, writes to `index` the positions of the structural bytes of
+  * `data` a block at a time, the operators and the newlines outside the strings,
+  * the opening quotes and the first byte of every scalar. The last block is padded
+  * with spaces
+  *
+  * @return
+  * Returns false if a newline is inside a string, so the lines can not be split
+  * with the index, the lines must then be indexed one by one
+*/
+
+
+bool JsonLoader::buildIndex(const char* data, size_t size, index_t& index) {
+  index_state_t state;
+  char          padded[block_size];
+
+  index.clear();
+  index.reserve(size / 4);
+
+  for (size_t base = 0; base < size; base += block_size) {
+    const char* block = data + base;
+
+    if (size - base < block_size) {
+      std::memset(padded, ' ', block_size);
+      std::memcpy(padded, block, size - base);
+      block = padded;
+    }
+
+    const block_masks_t MASKS     = classifyBlock(block);
+    const uint64_t      ESCAPED   = findEscaped(MASKS.backslashes, state.escaped);
+    const uint64_t      QUOTES    = MASKS.quotes & ~ESCAPED;
+    const uint64_t      IN_STRING = prefixXor(QUOTES) ^ state.in_string;
+
+    if ((MASKS.newlines & IN_STRING) != 0) {
+      return false;
+    }
+
+    // The bytes of a scalar are the bytes outside the strings that are not structural
+    // or whitespaces, a scalar starts where the previous byte is not one of them
+    const uint64_t SCALARS = ~(MASKS.operators | MASKS.whitespaces | QUOTES | IN_STRING);
+    const uint64_t STARTS  = SCALARS & ~((SCALARS << 1) | state.scalar);
+
+    state.in_string = uint64_t(int64_t(IN_STRING) >> 63);
+    state.scalar    = SCALARS >> 63;
+
+    uint64_t structurals =
+      ((MASKS.operators | MASKS.newlines) & ~IN_STRING) |
+      (QUOTES & IN_STRING) |
+      STARTS;
+
+    while (structurals != 0) {
+      index.push_back(static_cast<uint32_t>(base + std::countr_zero(structurals)));
+      structurals &= structurals - 1;
+    }
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::buildString` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Decodes the string of the opening quote at `position` to `value`, the runs
+  * without escapes are copied at once and the `\u` escapes are encoded in UTF-8
+  *
+  * @return
+  * Returns false if the string is malformed or has no closing quote
+*/
+
+
+bool JsonLoader::buildString(const char* data, size_t size, size_t position, std::string& value) {
+  size_t index = position + 1;
+
+  value.clear();
+
+  while (index < size) {
+    const unsigned char CHARACTER = static_cast<unsigned char>(data[index]);
+
+    if (CHARACTER == '"') {
+      return true;
+    }
+
+    if (CHARACTER < 0x20) {
+      return false;
+    }
+
+    if (CHARACTER != '\\') {
+      size_t run = index + 1;
+
+      while (
+        run < size &&
+        data[run] != '"' &&
+        data[run] != '\\' &&
+        static_cast<unsigned char>(data[run]) >= 0x20
+      ) {
+        run++;
+      }
+
+      value.append(data + index, run - index);
+      index = run;
+      continue;
+    }
+
+    if (index + 1 >= size) {
+      return false;
+    }
+
+    switch (data[index + 1]) {
+      case '"':  value += '"';  break;
+      case '\\': value += '\\'; break;
+      case '/':  value += '/';  break;
+      case 'b':  value += '\b'; break;
+      case 'f':  value += '\f'; break;
+      case 'n':  value += '\n'; break;
+      case 'r':  value += '\r'; break;
+      case 't':  value += '\t'; break;
+      case 'u': {
+        uint32_t code = 0;
+
+        if (!readHex(data, size, index + 2, code)) {
+          return false;
+        }
+        index += 6;
+
+        // A high surrogate must be followed by the escape of a low surrogate
+        if (code >= 0xD800 && code < 0xDC00) {
+          uint32_t low = 0;
+
+          if (
+            index + 1 >= size ||
+            data[index] != '\\' ||
+            data[index + 1] != 'u' ||
+            !readHex(data, size, index + 2, low) ||
+            low < 0xDC00 ||
+            low >= 0xE000
+          ) {
+            return false;
+          }
+
+          code   = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+          index += 6;
+        } else if (code >= 0xDC00 && code < 0xE000) {
+          return false;
+        }
+
+        appendUtf8(value, code);
+        continue;
+      }
+      default:
+        return false;
+    }
+    index += 2;
+  }
+  return false;
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::buildScalar` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Creates the astruct of the scalar starting at `position`, the literals are
+  * booleans and nulls and the numbers without fraction or exponent are integers,
+  * unless they do not fit in 64 bits
+  *
+  * @return
+  * Returns the astruct, or nullptr if the scalar is malformed
+*/
+
+
+Astruct* JsonLoader::buildScalar(const char* data, size_t size, size_t position) {
+  size_t end = position;
+
+  while (end < size && !isDelimiter(data[end])) {
+    end++;
+  }
+
+  const std::string_view TOKEN(data + position, end - position);
+
+  if (TOKEN == "true") {
+    return new Astruct(true);
+  }
+
+  if (TOKEN == "false") {
+    return new Astruct(false);
+  }
+
+  if (TOKEN == "null") {
+    return new Astruct(nullptr);
+  }
+
+  if (TOKEN.empty() || (TOKEN.front() != '-' && (TOKEN.front() < '0' || TOKEN.front() > '9'))) {
+    return nullptr;
+  }
+
+  const char* FIRST = TOKEN.data();
+  const char* LAST  = TOKEN.data() + TOKEN.size();
+
+  if (TOKEN.find_first_of(".eE") == std::string_view::npos) {
+    int64_t integer = 0;
+
+    const auto [END, ERROR] = std::from_chars(FIRST, LAST, integer);
+
+    if (ERROR == std::errc() && END == LAST) {
+      return new Astruct(integer);
+    }
+
+    if (ERROR != std::errc::result_out_of_range) {
+      return nullptr;
+    }
+  }
+
+  double real = 0;
+
+  const auto [END, ERROR] = std::from_chars(FIRST, LAST, real);
+
+  if (ERROR != std::errc() || END != LAST) {
+    return nullptr;
+  }
+  return new Astruct(real);
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::buildValue` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * The second stage, creates the astruct of the value at the cursor and moves the
+  * cursor after it. A newline is never consumed here, so a malformed line does not
+  * take the next one with it
+  *
+  * @return
+  * Returns the astruct, or nullptr if the value is malformed or nested deeper than
+  * `max_depth`
+*/
+
+
+Astruct* JsonLoader::buildValue(cursor_t& cursor, size_t depth) const {
+  if (cursor.position == cursor.end || depth > max_depth) {
+    return nullptr;
+  }
+
+  const uint32_t POSITION = *cursor.position;
+
+  switch (cursor.data[POSITION]) {
+    case '{':
+      cursor.position++;
+      return buildObject(cursor, depth + 1);
+    case '[':
+      cursor.position++;
+      return buildArray(cursor, depth + 1);
+    case '"': {
+      std::string value;
+
+      cursor.position++;
+
+      if (!buildString(cursor.data, cursor.size, POSITION, value)) {
+        return nullptr;
+      }
+      return new Astruct(std::move(value));
+    }
+    case '}': case ']': case ':': case ',': case '\n':
+      return nullptr;
+    default:
+      cursor.position++;
+      return buildScalar(cursor.data, cursor.size, POSITION);
+  }
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::buildArray` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Creates the astruct of the array whose opening bracket was consumed, the
+  * children that were created are deleted if the array is malformed
+  *
+  * @return
+  * Returns the astruct, or nullptr if the array is malformed
+*/
+
+
+Astruct* JsonLoader::buildArray(cursor_t& cursor, size_t depth) const {
+  Astruct::astruct_array_t array;
+
+  if (cursor.position != cursor.end && cursor.data[*cursor.position] == ']') {
+    cursor.position++;
+    return new Astruct(std::move(array));
+  }
+
+  while (true) {
+    Astruct* child = buildValue(cursor, depth);
+
+    if (child == nullptr) {
+      break;
+    }
+    array.push_back(child);
+
+    if (cursor.position == cursor.end) {
+      break;
+    }
+
+    const char SEPARATOR = cursor.data[*cursor.position];
+
+    if (SEPARATOR == ']') {
+      cursor.position++;
+      return new Astruct(std::move(array));
+    }
+
+    if (SEPARATOR != ',') {
+      break;
+    }
+    cursor.position++;
+  }
+
+  for (auto child : array) {
+    delete child;
+  }
+  return nullptr;
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::buildObject` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Creates the astruct of the object whose opening brace was consumed, the
+  * members that were created are deleted if the object is malformed
+  *
+  * @return
+  * Returns the astruct, or nullptr if the object is malformed
+*/
+
+
+Astruct* JsonLoader::buildObject(cursor_t& cursor, size_t depth) const {
+  Astruct::astruct_object_t object;
+
+  if (cursor.position != cursor.end && cursor.data[*cursor.position] == '}') {
+    cursor.position++;
+    return new Astruct(std::move(object));
+  }
+
+  while (cursor.position != cursor.end && cursor.data[*cursor.position] == '"') {
+    std::string key;
+
+    if (!buildString(cursor.data, cursor.size, *cursor.position, key)) {
+      break;
+    }
+    cursor.position++;
+
+    if (cursor.position == cursor.end || cursor.data[*cursor.position] != ':') {
+      break;
+    }
+    cursor.position++;
+
+    Astruct* child = buildValue(cursor, depth);
+
+    if (child == nullptr) {
+      break;
+    }
+    object.emplace_back(std::move(key), child);
+
+    if (cursor.position == cursor.end) {
+      break;
+    }
+
+    const char SEPARATOR = cursor.data[*cursor.position];
+
+    if (SEPARATOR == '}') {
+      cursor.position++;
+      return new Astruct(std::move(object));
+    }
+
+    if (SEPARATOR != ',') {
+      break;
+    }
+    cursor.position++;
+  }
+
+  for (auto& member : object) {
+    delete member.second;
+  }
+  return nullptr;
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::buildRow` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Turns the value of a line into `row`, the whole value if `columns` is empty,
+  * otherwise the members of the columns are moved out of the object and the
+  * object is deleted
+  *
+  * @return
+  * Returns false if `columns` is set and the value is not an object, the value
+  * is deleted in that case
+*/
+
+
+bool JsonLoader::buildRow(Astruct* value, Ingestor::row_t& row) const {
+  if (columns.empty()) {
+    row.push_back(value);
+    return true;
+  }
+
+  auto* object = std::get_if<Astruct::astruct_object_t>(&value->astruct);
+
+  if (object == nullptr) {
+    delete value;
+    return false;
+  }
+
+  row.assign(columns.size(), nullptr);
+
+  for (auto& member : *object) {
+    const auto COLUMN = column_indexes.find(member.first);
+
+    if (COLUMN != column_indexes.end() && row[COLUMN->second] == nullptr) {
+      row[COLUMN->second] = member.second;
+      member.second       = nullptr;
+    }
+  }
+
+  delete value;
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::submitRows` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Sends `rows` to the route stage of the ingestor and leaves `rows` empty,
+  * the ingestor deletes the rows if it is not running
+  *
+  * @return
+  * This function does not return anything, since it
+  * only sends the rows
+*/
+
+
+void JsonLoader::submitRows(Ingestor::rows_t& rows) {
+  const size_t ROWS = rows.size();
+
+  if (ingestor->submitRows(std::move(rows))) {
+    loaded_rows.fetch_add(ROWS, std::memory_order_relaxed);
+  }
+
+  rows = Ingestor::rows_t();
+  rows.reserve(batch_rows);
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::loadLines` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Walks the `index` of `data`, every line is one value that is turned into a row,
+  * the empty lines are skipped and the malformed lines are skipped until their newline
+  *
+  * @return
+  * This function does not return anything, since it
+  * only adds the rows to `rows`
+*/
+
+
+void JsonLoader::loadLines(const char* data, size_t size, const index_t& index, Ingestor::rows_t& rows) {
+  cursor_t cursor{data, size, index.data(), index.data() + index.size()};
+
+  while (cursor.position != cursor.end) {
+    if (data[*cursor.position] == '\n') {
+      cursor.position++;
+      continue;
+    }
+
+    Astruct*   value      = buildValue(cursor, 0);
+    const bool WHOLE_LINE = cursor.position == cursor.end || data[*cursor.position] == '\n';
+
+    if (value == nullptr || !WHOLE_LINE) {
+      delete value;
+      malformed_rows.fetch_add(1, std::memory_order_relaxed);
+
+      while (cursor.position != cursor.end && data[*cursor.position] != '\n') {
+        cursor.position++;
+      }
+      continue;
+    }
+
+    Ingestor::row_t row;
+
+    if (!buildRow(value, row)) {
+      malformed_rows.fetch_add(1, std::memory_order_relaxed);
+      continue;
+    }
+
+    rows.push_back(std::move(row));
+
+    if (rows.size() >= batch_rows) {
+      submitRows(rows);
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::loadWindow` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Runs the two stages on a window of whole lines. If a newline is inside a string
+  * the state of the first stage is wrong after it, so the lines of the window are
+  * indexed one by one and only the broken line is lost
+  *
+  * @return
+  * This function does not return anything, since it
+  * only adds the rows to `rows`
+*/
+
+
+void JsonLoader::loadWindow(const char* data, size_t size, index_t& index, Ingestor::rows_t& rows) {
+  if (buildIndex(data, size, index)) {
+    loadLines(data, size, index, rows);
+    return;
+  }
+
+  for (size_t begin = 0; begin < size;) {
+    const void*  NEWLINE = std::memchr(data + begin, '\n', size - begin);
+    const size_t END     = NEWLINE != nullptr ? static_cast<const char*>(NEWLINE) - data : size;
+
+    buildIndex(data + begin, END - begin, index);
+    loadLines(data + begin, END - begin, index, rows);
+
+    begin = END + 1;
+  }
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::loadChunk` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * The loop of a loading thread, loads the chunk a window at a time, every window
+  * ends after a newline. The positions of the index are 32 bits, so a line longer
+  * than 4 GB is skipped as malformed
+  *
+  * @return
+  * This function does not return anything, since it
+  * only sends the rows to the ingestor
+*/
+
+
+void JsonLoader::loadChunk(const char* data, size_t size) {
+  Ingestor::rows_t rows;
+  index_t          index;
+
+  rows.reserve(batch_rows);
+
+  for (size_t begin = 0; begin < size;) {
+    size_t end = std::min(size, begin + window_size);
+
+    if (end < size) {
+      const void* NEWLINE = std::memchr(data + end, '\n', size - end);
+      end = NEWLINE != nullptr ? static_cast<const char*>(NEWLINE) - data + 1 : size;
+    }
+
+    if (end - begin > UINT32_MAX) {
+      malformed_rows.fetch_add(1, std::memory_order_relaxed);
+    } else {
+      loadWindow(data + begin, end - begin, index, rows);
+    }
+    begin = end;
+  }
+
+  if (!rows.empty()) {
+    submitRows(rows);
+  }
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::load` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Loads the NDJSON `input`, it is split in one chunk of whole lines per thread and
+  * the chunks are loaded at once. The ingestor is started if it is not running and
+  * it is not finished, so many inputs can be loaded before `Ingestor::finish`
+  *
+  * @return
+  * Returns the number of rows sent to the ingestor
+*/
+
+
+size_t JsonLoader::load(std::string_view input) {
+  const size_t BEFORE  = loaded_rows.load(std::memory_order_relaxed);
+  const size_t THREADS = threads != 0
+    ? threads
+    : std::max<size_t>(1, std::thread::hardware_concurrency());
+
+  column_indexes.clear();
+
+  for (size_t index = 0; index < columns.size(); index++) {
+    column_indexes.emplace(columns[index], index);
+  }
+
+  ingestor->start();
+
+  std::vector<std::thread> workers;
+  size_t                   begin = 0;
+
+  for (size_t chunk = 0; chunk < THREADS && begin < input.size(); chunk++) {
+    size_t end = chunk + 1 == THREADS
+      ? input.size()
+      : std::max(begin, input.size() / THREADS * (chunk + 1));
+
+    if (end < input.size()) {
+      const size_t NEWLINE = input.find('\n', end);
+      end = NEWLINE != std::string_view::npos ? NEWLINE + 1 : input.size();
+    }
+
+    workers.emplace_back(&JsonLoader::loadChunk, this, input.data() + begin, end - begin);
+    begin = end;
+  }
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  return loaded_rows.load(std::memory_order_relaxed) - BEFORE;
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::loadFile` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Maps the NDJSON file `path` and loads it with `JsonLoader::load`, the file
+  * is never copied
+  *
+  * @return
+  * Returns the number of rows sent to the ingestor, 0 if the file can not be opened
+*/
+
+
+size_t JsonLoader::loadFile(const std::string& path) {
+  MappedFile file(path);
+
+  if (!file.isOpen()) {
+    return 0;
+  }
+  return load(file.view());
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::parse` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * Parses a single JSON document with the same two stages, the newlines are
+  * whitespaces inside a document, so they are removed from the index
+  *
+  * @return
+  * Returns the astruct of the document, or nullptr if it is malformed
+*/
+
+
+Astruct* JsonLoader::parse(std::string_view json) const {
+  index_t index;
+
+  if (json.size() > UINT32_MAX || !buildIndex(json.data(), json.size(), index)) {
+    return nullptr;
+  }
+
+  std::erase_if(index, [&](uint32_t position) { return json[position] == '\n'; });
+
+  cursor_t cursor{json.data(), json.size(), index.data(), index.data() + index.size()};
+  Astruct* value = buildValue(cursor, 0);
+
+  if (value != nullptr && cursor.position != cursor.end) {
+    delete value;
+    return nullptr;
+  }
+  return value;
+}
+
+
+/**
+  * @internal
+  * The `JsonLoader::JsonLoader` method is internal of the `JsonLoader` class
+  *
+  * @brief Description
+  * The constructor of the `JsonLoader` class, the rows are sent to `ingestor_v`
+*/
+
+
+JsonLoader::JsonLoader(Ingestor* ingestor_v) : ingestor(ingestor_v) {}
@@ -0,0 +1,139 @@
+/**
+  * @file json_loader.hpp
+  * This is the documentation of the `json_loader.hpp` file
+  *
+  * @brief Description
+  * Implementation of the JsonLoader class, the bulk loading of NDJSON files into
+  * astructs with a structural index built a block of bytes at a time in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Nativite engine imports
+#include "../Ingestor/ingestor.hpp"
+
+// Forward reference to `Astruct`
+class Astruct;
+
+
+/**
+ * @internal
+ * The JsonLoader class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Loads NDJSON, one JSON value per line, into rows of astructs that are sent to
+ * the append stage of an Ingestor, the file is mapped and split in chunks of whole
+ * lines that are loaded by `threads` threads
+ *
+ * @details
+ * Every chunk is read in windows of about `window_size` bytes in two stages, like the
+ * simdjson parser. The first stage classifies 64 bytes at a time with SIMD compares
+ * (SSE2 or AVX2, with a scalar fallback) into bitmasks of quotes, backslashes,
+ * operators and whitespaces, removes the escaped quotes, finds the bytes inside the
+ * strings with a prefix xor of the quotes and writes the positions of the structural
+ * bytes, the operators, the opening quotes, the first byte of every scalar and the
+ * newlines outside the strings, to the index. The second stage walks the index and
+ * creates the astructs of a line straight away, no tree is built before them.
+ *
+ * Every line is a row, the whole value is the only stack of the row unless `columns`
+ * is set, then the line must be an object and the member named `columns[i]` is the
+ * stack `i` of the row, the missing members are empty slots and the other members
+ * are dropped. The malformed lines are skipped and counted in `malformed_rows`.
+*/
+
+
+class JsonLoader {
+  // Types
+  public:
+    // The bytes classified at once by the first stage
+    static constexpr size_t block_size = 64;
+
+    // The bytes indexed before they are turned into astructs, so the index
+    // of a window stays in the cache
+    static constexpr size_t window_size = size_t(1) << 20;
+
+    // The positions of the structural bytes of a window
+    using index_t = std::vector<uint32_t>;
+
+    // The bitmasks of a block, bit `i` is the byte `i` of the block
+    struct block_masks_t {
+      uint64_t quotes      = 0;
+      uint64_t backslashes = 0;
+      uint64_t operators   = 0;
+      uint64_t whitespaces = 0;
+      uint64_t newlines    = 0;
+    };
+
+    // The state of the first stage carried from a block to the next one
+    struct index_state_t {
+      uint64_t escaped   = 0; /**< The first byte of the block is escaped */
+      uint64_t in_string = 0; /**< All ones if the block starts inside a string */
+      uint64_t scalar    = 0; /**< The last byte of the previous block is a scalar */
+    };
+
+    // The second stage reading position in the index of a window
+    struct cursor_t {
+      const char*     data;
+      size_t          size;
+      const uint32_t* position;
+      const uint32_t* end;
+    };
+
+  protected:
+    // First stage functions
+    static block_masks_t classifyBlock(const char* block);
+    static uint64_t      findEscaped(uint64_t backslashes, uint64_t& escaped);
+    static uint64_t      prefixXor(uint64_t bits);
+    static bool          buildIndex(const char* data, size_t size, index_t& index);
+
+    // Second stage functions
+    static bool     buildString(const char* data, size_t size, size_t position, std::string& value);
+    static Astruct* buildScalar(const char* data, size_t size, size_t position);
+
+    Astruct* buildValue(cursor_t& cursor, size_t depth) const;
+    Astruct* buildArray(cursor_t& cursor, size_t depth) const;
+    Astruct* buildObject(cursor_t& cursor, size_t depth) const;
+
+    bool buildRow(Astruct* value, Ingestor::row_t& row) const;
+
+    void submitRows(Ingestor::rows_t& rows);
+
+    void loadLines(const char* data, size_t size, const index_t& index, Ingestor::rows_t& rows);
+    void loadWindow(const char* data, size_t size, index_t& index, Ingestor::rows_t& rows);
+    void loadChunk(const char* data, size_t size);
+
+    std::unordered_map<std::string, size_t> column_indexes; /**< The stack of every column */
+
+  public:
+    Ingestor* ingestor = nullptr; /**< The ingestor that routes and appends the rows */
+
+    std::vector<std::string> columns; /**< The members that are the stacks of a row,
+                                           empty to keep the whole value */
+
+    size_t threads    = 0;    /**< The loading threads, 0 is one per hardware thread */
+    size_t batch_rows = 4096; /**< The rows sent to the ingestor at once */
+    size_t max_depth  = 512;  /**< The maximum nesting of arrays and objects */
+
+    std::atomic<size_t> loaded_rows{0};    /**< The rows sent to the ingestor */
+    std::atomic<size_t> malformed_rows{0}; /**< The lines that were skipped */
+
+    size_t load(std::string_view input);
+    size_t loadFile(const std::string& path);
+
+    Astruct* parse(std::string_view json) const;
+
+    JsonLoader(Ingestor* ingestor_v);
+};
@@ -0,0 +1,568 @@
+/**
+  * @file lean_cluster.cpp
+  * This is the documentation of the `lean_cluster.cpp` file
+  *
+  * @brief Description
+  * Implementation of the LeanCluster class methods, its allocation and its
+  * conversions from and to the Cluster class
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+// Nativite engine imports
+#include "lean_cluster.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Astruct/astruct.hpp"
+#include "../Dictionary/dictionary.hpp"
+
+// The slots follow the object, so it must keep them aligned
+static_assert(sizeof(LeanCluster) % alignof(Bucket*) == 0);
+
+
+/**
+  * @internal
+  * The `LeanCluster::allocationSize` method is internal of the `LeanCluster` class
+  *
+  * @return
+  * Returns the bytes of a lean cluster with the suggested capacities
+*/
+
+
+size_t LeanCluster::allocationSize(size_t bucket_capacity_v, size_t terminal_capacity_v) {
+  return
+    sizeof(LeanCluster) +
+    bucket_capacity_v * sizeof(Bucket*) +
+    terminal_capacity_v * sizeof(Astruct*);
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::terminal` method is internal of the `LeanCluster` class
+  *
+  * @return
+  * Returns the terminal slots, they are right after the bucket slots
+*/
+
+
+Astruct** LeanCluster::terminal() {
+  return reinterpret_cast<Astruct**>(buckets() + bucket_capacity);
+}
+
+
+Astruct* const* LeanCluster::terminal() const {
+  return reinterpret_cast<Astruct* const*>(buckets() + bucket_capacity);
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::pushBucket` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * Appends `bucket_` after the last bucket, the cluster takes its ownership
+  *
+  * @return
+  * Returns false if `bucket_` is nullptr or NULL or there is no bucket slot left,
+  * `LeanCluster::reserve` makes room for more buckets
+*/
+
+
+bool LeanCluster::pushBucket(Bucket* bucket_) {
+  if (bucket_ == nullptr || bucket_count == bucket_capacity) {
+    return false;
+  }
+
+  buckets()[bucket_count++] = bucket_;
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::pushTerminal` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * Appends `astruct` to the terminal, if the terminal is full its oldest
+  * astruct is deleted and its slot is reused
+  *
+  * @return
+  * This function does not return anything, since it
+  * only pushes the astruct to the terminal
+*/
+
+
+void LeanCluster::pushTerminal(Astruct* astruct) {
+  if (terminal_capacity == 0) {
+    delete astruct;
+    return;
+  }
+
+  Astruct** slots = terminal();
+
+  if (terminal_count == terminal_capacity) {
+    delete slots[terminal_head];
+    slots[terminal_head] = astruct;
+    terminal_head        = (terminal_head + 1) % terminal_capacity;
+    return;
+  }
+
+  slots[(terminal_head + terminal_count) % terminal_capacity] = astruct;
+  terminal_count++;
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::terminalAt` method is internal of the `LeanCluster` class
+  *
+  * @return
+  * Returns the astruct `index` of the terminal, 0 is the oldest one,
+  * or nullptr if `index` is not in the terminal
+*/
+
+
+Astruct* LeanCluster::terminalAt(size_t index) const {
+  if (index >= terminal_count) {
+    return nullptr;
+  }
+  return terminal()[(terminal_head + index) % terminal_capacity];
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::memoryUsage` method is internal of the `LeanCluster` class
+  *
+  * @return
+  * Returns the bytes of the allocation of the cluster, the buckets are not counted
+*/
+
+
+size_t LeanCluster::memoryUsage() const {
+  return allocationSize(bucket_capacity, terminal_capacity);
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::create` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * Allocates a lean cluster and its slots in a single block
+  *
+  * @return
+  * Returns the new lean cluster, it is freed with `LeanCluster::release`
+*/
+
+
+LeanCluster* LeanCluster::create(size_t bucket_capacity_v, size_t terminal_capacity_v) {
+  void* memory = ::operator new(allocationSize(bucket_capacity_v, terminal_capacity_v));
+
+  return new (memory) LeanCluster(
+    static_cast<uint32_t>(bucket_capacity_v),
+    static_cast<uint32_t>(terminal_capacity_v)
+  );
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::reserve` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * Makes room for `bucket_capacity_v` buckets, if the allocation is too small
+  * the cluster is moved to a new allocation and `lean_` is freed
+  *
+  * @return
+  * Returns the lean cluster, which is not `lean_` if it was moved
+*/
+
+
+LeanCluster* LeanCluster::reserve(LeanCluster* lean_, size_t bucket_capacity_v) {
+  if (bucket_capacity_v <= lean_->bucket_capacity) {
+    return lean_;
+  }
+
+  LeanCluster* moved = create(bucket_capacity_v, lean_->terminal_capacity);
+
+  std::memcpy(moved->buckets(), lean_->buckets(), lean_->bucket_count * sizeof(Bucket*));
+  std::memcpy(moved->terminal(), lean_->terminal(), lean_->terminal_capacity * sizeof(Astruct*));
+
+  moved->dictionary                 = lean_->dictionary;
+  moved->bucket_count               = lean_->bucket_count;
+  moved->terminal_count             = lean_->terminal_count;
+  moved->terminal_head              = lean_->terminal_head;
+  moved->automaticTerminalManagment = lean_->automaticTerminalManagment;
+
+  // The old cluster does not own anything anymore
+  lean_->dictionary     = nullptr;
+  lean_->bucket_count   = 0;
+  lean_->terminal_count = 0;
+  release(lean_);
+
+  return moved;
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::resizeTerminal` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * Moves the cluster to a new allocation with `terminal_capacity_v` terminal slots,
+  * the newest astructs of the terminal are kept and the rest are deleted, `lean_`
+  * is freed
+  *
+  * @return
+  * Returns the lean cluster, which is `lean_` if the capacity did not change
+*/
+
+
+LeanCluster* LeanCluster::resizeTerminal(LeanCluster* lean_, size_t terminal_capacity_v) {
+  if (terminal_capacity_v == lean_->terminal_capacity) {
+    return lean_;
+  }
+
+  LeanCluster* moved = create(lean_->bucket_capacity, terminal_capacity_v);
+
+  std::memcpy(moved->buckets(), lean_->buckets(), lean_->bucket_count * sizeof(Bucket*));
+
+  const size_t DROPPED = lean_->terminal_count > terminal_capacity_v
+    ? lean_->terminal_count - terminal_capacity_v
+    : 0;
+
+  for (uint32_t index = 0; index < lean_->terminal_count; index++) {
+    if (index < DROPPED) {
+      delete lean_->terminalAt(index);
+    } else {
+      moved->pushTerminal(lean_->terminalAt(index));
+    }
+  }
+
+  moved->dictionary                 = lean_->dictionary;
+  moved->bucket_count               = lean_->bucket_count;
+  moved->automaticTerminalManagment = lean_->automaticTerminalManagment;
+
+  // The old cluster does not own anything anymore
+  lean_->dictionary     = nullptr;
+  lean_->bucket_count   = 0;
+  lean_->terminal_count = 0;
+  release(lean_);
+
+  return moved;
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::release` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * Deletes the buckets, the terminal and the dictionary of `lean_` and frees
+  * its allocation, `lean_` can be nullptr or NULL
+  *
+  * @return
+  * This function does not return anything, since it
+  * only frees the lean cluster
+*/
+
+
+void LeanCluster::release(LeanCluster* lean_) {
+  if (lean_ == nullptr) {
+    return;
+  }
+
+  lean_->~LeanCluster();
+  ::operator delete(lean_);
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::fromCluster` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * Takes the allocation of `cluster_` with its buckets, its terminal and its
+  * dictionary, the empty slots are dropped. `cluster_` is left with an empty
+  * allocation and the caller still has to delete it
+  *
+  * @return
+  * Returns the lean cluster of `cluster_`
+*/
+
+
+LeanCluster* LeanCluster::fromCluster(Cluster* cluster_) {
+  LeanSlots& slots = cluster_->cluster;
+  size_t     kept  = 0;
+
+  for (size_t index = 0; index < slots.size(); index++) {
+    if (slots[index] != nullptr) {
+      slots[kept++] = slots[index];
+    }
+  }
+  slots.resize(kept);
+
+  LeanCluster* lean_ = slots.release();
+
+  lean_->dictionary    = cluster_->dictionary;
+  cluster_->dictionary = nullptr;
+  cluster_->rebuildBucketSlots();
+
+  return lean_;
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::toCluster` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * Creates a `Cluster` that owns `lean_`, its buckets, its terminal and its
+  * dictionary, nothing is copied
+  *
+  * @return
+  * Returns the new cluster
+*/
+
+
+Cluster* LeanCluster::toCluster(LeanCluster* lean_) {
+  Cluster* cluster_ = new Cluster();
+
+  cluster_->dictionary = lean_->dictionary;
+  lean_->dictionary    = nullptr;
+
+  cluster_->cluster.adopt(lean_);
+  cluster_->cluster_capacity = lean_->bucket_capacity;
+  cluster_->rebuildBucketSlots();
+
+  return cluster_;
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::destroy` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * Deletes the buckets, the astructs of the terminal and the dictionary
+  *
+  * @return
+  * This function does not return anything, since it
+  * only destroys the contents of the cluster
+*/
+
+
+void LeanCluster::destroy() {
+  Bucket** slots = buckets();
+
+  for (uint32_t index = 0; index < bucket_count; index++) {
+    delete slots[index];
+  }
+  for (uint32_t index = 0; index < terminal_count; index++) {
+    delete terminalAt(index);
+  }
+
+  // The buckets only borrow the dictionary, so it is deleted after them
+  delete dictionary;
+
+  dictionary     = nullptr;
+  bucket_count   = 0;
+  terminal_count = 0;
+  terminal_head  = 0;
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::LeanCluster` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * The constructor of the `LeanCluster` class, it is only called by
+  * `LeanCluster::create` on an allocation with room for the slots,
+  * which are filled with nullptr
+*/
+
+
+LeanCluster::LeanCluster(uint32_t bucket_capacity_v, uint32_t terminal_capacity_v) :
+  bucket_capacity(bucket_capacity_v),
+  terminal_capacity(terminal_capacity_v) {
+  std::fill(buckets(), buckets() + bucket_capacity, nullptr);
+  std::fill(terminal(), terminal() + terminal_capacity, nullptr);
+}
+
+
+/**
+  * @internal
+  * The `LeanCluster::~LeanCluster` method is internal of the `LeanCluster` class
+  *
+  * @brief Description
+  * The destructor of the `LeanCluster` class, it is only called by `LeanCluster::release`
+*/
+
+
+LeanCluster::~LeanCluster() noexcept {
+  destroy();
+}
+
+
+/**
+  * @internal
+  * The `LeanSlots::push_back` method is internal of the `LeanSlots` class
+  *
+  * @brief Description
+  * Appends `value` after the last slot, the allocation doubles when it is full.
+  * `value` can be nullptr or NULL
+  *
+  * @return
+  * This function does not return anything, since it
+  * only appends the slot
+*/
+
+
+void LeanSlots::push_back(Bucket* value) {
+  if (lean->bucket_count == lean->bucket_capacity) {
+    reserve(std::max<size_t>(4, size_t(lean->bucket_capacity) * 2));
+  }
+  lean->buckets()[lean->bucket_count++] = value;
+}
+
+
+/**
+  * @internal
+  * The `LeanSlots::reserve` method is internal of the `LeanSlots` class
+  *
+  * @brief Description
+  * Makes room for `capacity_v` slots, see `LeanCluster::reserve`
+  *
+  * @return
+  * This function does not return anything, since it
+  * only reserves the slots
+*/
+
+
+void LeanSlots::reserve(size_t capacity_v) {
+  lean = LeanCluster::reserve(lean, capacity_v);
+}
+
+
+/**
+  * @internal
+  * The `LeanSlots::resize` method is internal of the `LeanSlots` class
+  *
+  * @brief Description
+  * Sets the number of slots to `size_v`, the new slots are nullptr and the
+  * buckets of the removed slots are not deleted
+  *
+  * @return
+  * This function does not return anything, since it
+  * only resizes the slots
+*/
+
+
+void LeanSlots::resize(size_t size_v) {
+  reserve(size_v);
+
+  if (size_v > lean->bucket_count) {
+    std::fill(lean->buckets() + lean->bucket_count, lean->buckets() + size_v, nullptr);
+  }
+  lean->bucket_count = static_cast<uint32_t>(size_v);
+}
+
+
+/**
+  * @internal
+  * The `LeanSlots::clear` method is internal of the `LeanSlots` class
+  *
+  * @brief Description
+  * Removes every slot, the buckets are not deleted and the allocation is kept
+  *
+  * @return
+  * This function does not return anything, since it
+  * only clears the slots
+*/
+
+
+void LeanSlots::clear() {
+  lean->bucket_count = 0;
+}
+
+
+/**
+  * @internal
+  * The `LeanSlots::release` method is internal of the `LeanSlots` class
+  *
+  * @brief Description
+  * Hands the lean cluster to the caller and starts an empty one with the
+  * same terminal capacity
+  *
+  * @return
+  * Returns the lean cluster, the caller takes its ownership
+*/
+
+
+LeanCluster* LeanSlots::release() {
+  LeanCluster* released = lean;
+
+  lean = LeanCluster::create(0, released->terminal_capacity);
+  lean->automaticTerminalManagment = released->automaticTerminalManagment;
+
+  return released;
+}
+
+
+/**
+  * @internal
+  * The `LeanSlots::adopt` method is internal of the `LeanSlots` class
+  *
+  * @brief Description
+  * Takes the ownership of `lean_` instead of the current lean cluster, which is
+  * released with its buckets and its terminal
+  *
+  * @return
+  * This function does not return anything, since it
+  * only adopts the lean cluster
+*/
+
+
+void LeanSlots::adopt(LeanCluster* lean_) {
+  LeanCluster::release(lean);
+  lean = lean_;
+}
+
+
+/**
+  * @internal
+  * The `LeanSlots::LeanSlots` method is internal of the `LeanSlots` class
+  *
+  * @brief Description
+  * The constructor of the `LeanSlots` class, it allocates a lean cluster
+  * without bucket slots and with `terminal_capacity_v` terminal slots
+*/
+
+
+LeanSlots::LeanSlots(size_t terminal_capacity_v) :
+  lean(LeanCluster::create(0, terminal_capacity_v)) {}
+
+
+/**
+  * @internal
+  * The `LeanSlots::~LeanSlots` method is internal of the `LeanSlots` class
+  *
+  * @brief Description
+  * The destructor of the `LeanSlots` class, it releases the lean cluster with
+  * the buckets that are still in its slots and its terminal
+*/
+
+
+LeanSlots::~LeanSlots() noexcept {
+  LeanCluster::release(lean);
+}
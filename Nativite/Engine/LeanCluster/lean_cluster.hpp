@@ -0,0 +1,188 @@
+/**
+  * @file lean_cluster.hpp
+  * This is the documentation of the `lean_cluster.hpp` file
+  *
+  * @brief Description
+  * Implementation of the LeanCluster class, a cluster with only its buckets and one
+  * terminal laid out in a single allocation in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <cstdint>
+
+// Forward reference to `Astruct`, `Bucket`, `Cluster` and `Dictionary`
+class Astruct;
+class Bucket;
+class Cluster;
+class Dictionary;
+
+
+/**
+ * @internal
+ * The LeanCluster class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * The buckets and the one terminal of a cluster without the locks, the bitmap and
+ * the append buffer of the `Cluster` class, which keeps its slots in one of them
+ *
+ * @details
+ * The object is followed in the same allocation by `bucket_capacity` bucket slots and
+ * `terminal_capacity` terminal slots, so a cluster is one heap block instead of the
+ * object plus three vectors. The lean clusters built by `LeanCluster::fromCluster`
+ * are dense, the one owned by a `Cluster` through the LeanSlots class can have empty
+ * slots. The terminal is a ring buffer, pushing to a full terminal deletes its
+ * oldest astruct.
+ *
+ * The lean clusters are created with `LeanCluster::create` and freed with
+ * `LeanCluster::release`, `LeanCluster::reserve` and `LeanCluster::resizeTerminal`
+ * can move the cluster to a new allocation. `LeanCluster::fromCluster` and
+ * `LeanCluster::toCluster` hand the allocation from and to the `Cluster` class,
+ * the buckets and the terminal are not copied.
+*/
+
+
+class LeanCluster {
+  protected:
+    // Internal functions of the class
+    static size_t allocationSize(size_t bucket_capacity_v, size_t terminal_capacity_v);
+
+    void destroy();
+
+    LeanCluster(uint32_t bucket_capacity_v, uint32_t terminal_capacity_v);
+    ~LeanCluster() noexcept;
+
+  public:
+    static constexpr size_t max_terminal_capacity = 1 << 20; /**< The terminal slots allowed
+                                                                  by the readers of the files */
+
+    Dictionary* dictionary = nullptr; /**< The dictionary shared by the string stacks
+                                           of all the buckets of the cluster */
+
+    uint32_t bucket_count      = 0; /**< The number of buckets */
+    uint32_t bucket_capacity   = 0; /**< The bucket slots of the allocation */
+    uint32_t terminal_count    = 0; /**< The number of astructs of the terminal */
+    uint32_t terminal_capacity = 0; /**< The terminal slots of the allocation */
+    uint32_t terminal_head     = 0; /**< The slot of the oldest astruct of the terminal */
+
+    bool automaticTerminalManagment = true; /**< Indicates if the terminal It is handled automatically */
+
+    /**
+      * @internal
+      * The `LeanCluster::buckets` method is internal of the `LeanCluster` class
+      *
+      * @brief Description
+      * Returns the bucket slots, they are right after the object. It is in the
+      * header because the `Cluster` readers index the slots through it
+    */
+    Bucket** buckets() {
+      return reinterpret_cast<Bucket**>(this + 1);
+    }
+
+    Bucket* const* buckets() const {
+      return reinterpret_cast<Bucket* const*>(this + 1);
+    }
+
+    Astruct**       terminal();
+    Astruct* const* terminal() const;
+
+    bool     pushBucket(Bucket* bucket_);
+    void     pushTerminal(Astruct* astruct);
+    Astruct* terminalAt(size_t index) const;
+
+    size_t memoryUsage() const;
+
+    static LeanCluster* create(size_t bucket_capacity_v, size_t terminal_capacity_v = 17);
+    static LeanCluster* reserve(LeanCluster* lean_, size_t bucket_capacity_v);
+    static LeanCluster* resizeTerminal(LeanCluster* lean_, size_t terminal_capacity_v);
+    static void         release(LeanCluster* lean_);
+
+    static LeanCluster* fromCluster(Cluster* cluster_);
+    static Cluster*     toCluster(LeanCluster* lean_);
+
+    /**
+      * @internal
+      * The `LeanCluster::forEachBucket` method is internal of the `LeanCluster` class
+      *
+      * @brief Description
+      * Calls `function(bucket)` for every bucket in order, the empty slots are skipped
+    */
+    template <typename Function>
+    void forEachBucket(Function&& function) const {
+      Bucket* const* slots = buckets();
+
+      for (uint32_t index = 0; index < bucket_count; index++) {
+        if (slots[index] != nullptr) {
+          function(slots[index]);
+        }
+      }
+    }
+
+    LeanCluster(const LeanCluster&) = delete;
+    LeanCluster& operator=(const LeanCluster&) = delete;
+};
+
+
+
+/**
+ * @internal
+ * The LeanSlots class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * The bucket slots of a lean cluster seen as a vector of `Bucket*`, it is the
+ * `cluster` field of the `Cluster` class, so the buckets and the terminal of a
+ * cluster are one allocation
+ *
+ * @details
+ * It owns its lean cluster, which is never nullptr or NULL, and moves it when it
+ * grows like a vector. A slot can be nullptr or NULL. `LeanSlots::clear` and
+ * `LeanSlots::resize` only forget the slots, the owner deletes the buckets.
+*/
+
+
+class LeanSlots {
+  // Types
+  public:
+    using value_type     = Bucket*;
+    using iterator       = Bucket**;
+    using const_iterator = Bucket* const*;
+
+  public:
+    LeanCluster* lean; /**< The allocation of the slots and the terminal */
+
+    // The accessors of a vector, they are in the header because they are in
+    // the loops of every reader of the buckets
+    size_t size() const     { return lean->bucket_count; }
+    size_t capacity() const { return lean->bucket_capacity; }
+    bool   empty() const    { return lean->bucket_count == 0; }
+
+    Bucket*& operator[](size_t index)       { return lean->buckets()[index]; }
+    Bucket*  operator[](size_t index) const { return lean->buckets()[index]; }
+
+    iterator       begin()       { return lean->buckets(); }
+    iterator       end()         { return lean->buckets() + lean->bucket_count; }
+    const_iterator begin() const { return lean->buckets(); }
+    const_iterator end() const   { return lean->buckets() + lean->bucket_count; }
+
+    Bucket*& back() { return lean->buckets()[lean->bucket_count - 1]; }
+
+    void push_back(Bucket* value);
+    void reserve(size_t capacity_v);
+    void resize(size_t size_v);
+    void clear();
+
+    LeanCluster* release();
+    void         adopt(LeanCluster* lean_);
+
+    LeanSlots(size_t terminal_capacity_v = 17);
+    ~LeanSlots() noexcept;
+
+    LeanSlots(const LeanSlots&) = delete;
+    LeanSlots& operator=(const LeanSlots&) = delete;
+};
@@ -0,0 +1,217 @@
+/**
+  * @file mapped_file.cpp
+  * This is the documentation of the `mapped_file.cpp` file
+  *
+  * @brief Description
+  * Implementation of the MappedFile class methods, the mapping of the files
+  * with the calls of every system
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#ifdef _WIN32
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+// Nativite engine imports
+#include "mapped_file.hpp"
+
+
+/**
+  * @internal
+  * The `MappedFile::open` method is internal of the `MappedFile` class
+  *
+  * @brief Description
+  * Maps the file `path` read only, the previous file is closed first. The system
+  * is told that the file is read sequentially, so it reads ahead
+  *
+  * @return
+  * Returns false if the file can not be opened or mapped
+*/
+
+
+bool MappedFile::open(const std::string& path) {
+  close();
+
+#ifdef _WIN32
+  file_handle = CreateFileA(
+    path.c_str(),
+    GENERIC_READ,
+    FILE_SHARE_READ,
+    nullptr,
+    OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+    nullptr
+  );
+
+  if (file_handle == INVALID_HANDLE_VALUE) {
+    file_handle = nullptr;
+    return false;
+  }
+
+  LARGE_INTEGER file_size;
+
+  if (!GetFileSizeEx(file_handle, &file_size)) {
+    close();
+    return false;
+  }
+
+  size = static_cast<size_t>(file_size.QuadPart);
+  data = "";
+
+  if (size == 0) {
+    return true;
+  }
+
+  mapping_handle = CreateFileMappingA(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  mapping        = mapping_handle != nullptr
+    ? MapViewOfFile(mapping_handle, FILE_MAP_READ, 0, 0, 0)
+    : nullptr;
+#else
+  const int DESCRIPTOR = ::open(path.c_str(), O_RDONLY);
+
+  if (DESCRIPTOR < 0) {
+    return false;
+  }
+
+  struct stat status;
+
+  if (fstat(DESCRIPTOR, &status) != 0) {
+    ::close(DESCRIPTOR);
+    return false;
+  }
+
+  size = static_cast<size_t>(status.st_size);
+  data = "";
+
+  if (size == 0) {
+    ::close(DESCRIPTOR);
+    return true;
+  }
+
+  mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, DESCRIPTOR, 0);
+
+  // The mapping keeps the file alive, so the descriptor is not needed anymore
+  ::close(DESCRIPTOR);
+
+  if (mapping == MAP_FAILED) {
+    mapping = nullptr;
+  } else {
+    madvise(mapping, size, MADV_SEQUENTIAL);
+  }
+#endif
+
+  if (mapping == nullptr) {
+    close();
+    return false;
+  }
+
+  data = static_cast<const char*>(mapping);
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `MappedFile::close` method is internal of the `MappedFile` class
+  *
+  * @brief Description
+  * Releases the mapping and the handles of the file, it does nothing if no file is open
+  *
+  * @return
+  * This function does not return anything, since it
+  * only releases the mapping
+*/
+
+
+void MappedFile::close() {
+#ifdef _WIN32
+  if (mapping != nullptr) {
+    UnmapViewOfFile(mapping);
+  }
+
+  if (mapping_handle != nullptr) {
+    CloseHandle(mapping_handle);
+  }
+
+  if (file_handle != nullptr) {
+    CloseHandle(file_handle);
+  }
+
+  file_handle    = nullptr;
+  mapping_handle = nullptr;
+#else
+  if (mapping != nullptr) {
+    munmap(mapping, size);
+  }
+#endif
+
+  mapping = nullptr;
+  data    = nullptr;
+  size    = 0;
+}
+
+
+/**
+  * @internal
+  * The `MappedFile::isOpen` method is internal of the `MappedFile` class
+  *
+  * @return
+  * Returns a boolean, true if a file is open
+*/
+
+
+bool MappedFile::isOpen() const {
+  return data != nullptr;
+}
+
+
+/**
+  * @internal
+  * The `MappedFile::view` method is internal of the `MappedFile` class
+  *
+  * @return
+  * Returns the bytes of the file, empty if no file is open
+*/
+
+
+std::string_view MappedFile::view() const {
+  return data != nullptr ? std::string_view(data, size) : std::string_view();
+}
+
+
+/**
+  * @internal
+  * The `MappedFile::MappedFile` method is internal of the `MappedFile` class
+  *
+  * @brief Description
+  * The constructor of the `MappedFile` class, maps the file `path`, the result
+  * is checked with `MappedFile::isOpen`
+*/
+
+
+MappedFile::MappedFile(const std::string& path) {
+  open(path);
+}
+
+
+/**
+  * @internal
+  * The `MappedFile::~MappedFile` method is internal of the `MappedFile` class
+  *
+  * @brief Description
+  * The destructor of the `MappedFile` class, releases the mapping
+*/
+
+
+MappedFile::~MappedFile() noexcept {
+  close();
+}
@@ -0,0 +1,64 @@
+/**
+  * @file mapped_file.hpp
+  * This is the documentation of the `mapped_file.hpp` file
+  *
+  * @brief Description
+  * Implementation of the MappedFile class, a read only file mapped in memory
+  * for the bulk loaders in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+
+/**
+ * @internal
+ * The MappedFile class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Maps a whole file read only, so the loaders read it without copying it and the
+ * pages are loaded by the system as they are read
+ *
+ * @details
+ * The file is mapped with `mmap` or with `MapViewOfFile` on Windows, and the
+ * mapping is released when the object is destroyed or `MappedFile::close` is called,
+ * so the views returned by `MappedFile::view` must not outlive it. An empty file
+ * is opened without a mapping.
+*/
+
+
+class MappedFile {
+  protected:
+    void* mapping = nullptr; /**< The base of the mapping, nullptr if nothing is mapped */
+
+#ifdef _WIN32
+    void* file_handle    = nullptr; /**< The handle of the file */
+    void* mapping_handle = nullptr; /**< The handle of the file mapping */
+#endif
+
+  public:
+    const char* data = nullptr; /**< The first byte of the file */
+    size_t      size = 0;       /**< The size of the file in bytes */
+
+    bool open(const std::string& path);
+    void close();
+    bool isOpen() const;
+
+    std::string_view view() const;
+
+    MappedFile() = default;
+    MappedFile(const std::string& path);
+
+    MappedFile(const MappedFile&)            = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() noexcept;
+};
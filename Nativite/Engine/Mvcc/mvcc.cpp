@@ -0,0 +1,659 @@
+/**
+  * @file mvcc.cpp
+  * This is the documentation of the `mvcc.cpp` file
+  *
+  * @brief Description
+  * Implementation of the Mvcc, Snapshot and Transaction classes methods, the
+  * visibility of the versions, the commits and the collection of the versions
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <set>
+
+// Nativite engine imports
+#include "mvcc.hpp"
+
+
+/**
+  * @internal
+  * The `Mvcc::visibleVersion` method is internal of the `Mvcc` class
+  *
+  * @brief Description
+  * Walks the versions of `bucket_` from the newest to the oldest until the one
+  * published at or before `timestamp`
+  *
+  * @return
+  * Returns the visible version, or nullptr if the bucket did not exist or was
+  * already removed at `timestamp`
+*/
+
+
+const Bucket* Mvcc::visibleVersion(const Bucket* bucket_, timestamp_t timestamp) {
+  while (bucket_ != nullptr && bucket_->version_begin > timestamp) {
+    bucket_ = bucket_->older_version;
+  }
+
+  if (bucket_ == nullptr || timestamp >= bucket_->version_end) {
+    return nullptr;
+  }
+  return bucket_;
+}
+
+
+/**
+  * @internal
+  * The `Mvcc::horizon` method is internal of the `Mvcc` class
+  *
+  * @brief Description
+  * The oldest timestamp that a snapshot can read now or later, the versions
+  * that ended at or before it are not visible anymore
+  *
+  * @return
+  * Returns the oldest pinned timestamp, or the clock if nothing is pinned
+*/
+
+
+Mvcc::timestamp_t Mvcc::horizon() const {
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+
+  if (snapshots.empty()) {
+    return clock.load(std::memory_order_acquire);
+  }
+  return *snapshots.begin();
+}
+
+
+/**
+  * @internal
+  * The `Mvcc::collectCluster` method is internal of the `Mvcc` class
+  *
+  * @brief Description
+  * Cuts the versions of the buckets of `cluster_` that ended at or before
+  * `horizon_v` and empties the slots of the removed buckets that no snapshot
+  * sees, the versions are retired to the global `EpochManager`. The caller
+  * holds the lock of the cluster exclusively
+  *
+  * @return
+  * Returns the number of retired versions
+*/
+
+
+size_t Mvcc::collectCluster(Cluster* cluster_, timestamp_t horizon_v) {
+  size_t retired = 0;
+
+  for (size_t index = 0; index < cluster_->cluster.size(); index++) {
+    Bucket* bucket_ = cluster_->cluster[index];
+
+    if (bucket_ == nullptr) {
+      continue;
+    }
+
+    // The bucket and all of its versions are not visible anymore
+    if (bucket_->version_end <= horizon_v) {
+      for (Bucket* version = bucket_; version != nullptr; version = version->older_version) {
+        retired++;
+      }
+
+      cluster_->cluster[index] = nullptr;
+
+      if (cluster_->bucket_slots.size == cluster_->cluster.size()) {
+        cluster_->bucket_slots.reset(index);
+      }
+      EpochManager::global().retire(bucket_);
+      continue;
+    }
+
+    Bucket* newer = bucket_;
+
+    while (newer->older_version != nullptr && newer->older_version->version_end > horizon_v) {
+      newer = newer->older_version;
+    }
+
+    Bucket* cut = newer->older_version;
+
+    if (cut == nullptr) {
+      continue;
+    }
+
+    for (Bucket* version = cut; version != nullptr; version = version->older_version) {
+      retired++;
+    }
+
+    newer->older_version = nullptr;
+    EpochManager::global().retire(cut);
+  }
+  return retired;
+}
+
+
+/**
+  * @internal
+  * The `Mvcc::pin` method is internal of the `Mvcc` class
+  *
+  * @brief Description
+  * Pins the timestamp of the last commit, its versions are kept until it is
+  * unpinned with `Mvcc::unpin`
+  *
+  * @return
+  * Returns the pinned timestamp
+*/
+
+
+Mvcc::timestamp_t Mvcc::pin() {
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+
+  const timestamp_t TIMESTAMP = clock.load(std::memory_order_acquire);
+
+  snapshots.insert(TIMESTAMP);
+  return TIMESTAMP;
+}
+
+
+/**
+  * @internal
+  * The `Mvcc::unpin` method is internal of the `Mvcc` class
+  *
+  * @brief Description
+  * Releases a timestamp pinned by `Mvcc::pin`
+  *
+  * @return
+  * This function does not return anything, since it
+  * only releases the timestamp
+*/
+
+
+void Mvcc::unpin(timestamp_t timestamp) {
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+
+  auto found = snapshots.find(timestamp);
+
+  if (found != snapshots.end()) {
+    snapshots.erase(found);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Mvcc::pinnedCount` method is internal of the `Mvcc` class
+  *
+  * @return
+  * Returns the number of pinned snapshots
+*/
+
+
+size_t Mvcc::pinnedCount() const {
+  std::lock_guard<std::mutex> lock(snapshot_mutex);
+  return snapshots.size();
+}
+
+
+/**
+  * @internal
+  * The `Mvcc::now` method is internal of the `Mvcc` class
+  *
+  * @return
+  * Returns the timestamp of the last commit
+*/
+
+
+Mvcc::timestamp_t Mvcc::now() const {
+  return clock.load(std::memory_order_acquire);
+}
+
+
+/**
+  * @internal
+  * The `Mvcc::collectVisible` method is internal of the `Mvcc` class
+  *
+  * @brief Description
+  * Appends to `visible` the version of every bucket of the brain that is visible
+  * at `timestamp`, every cluster is locked shared only while its slots are read.
+  * The caller holds an epoch guard while it reads the buckets
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `visible`
+*/
+
+
+void Mvcc::collectVisible(timestamp_t timestamp, std::vector<visible_t>& visible) const {
+  auto structure = brain->lockStructureShared();
+
+  for (size_t cluster_index = 0; cluster_index < brain->brain.size(); cluster_index++) {
+    Cluster* cluster_ = brain->brain[cluster_index];
+
+    if (cluster_ == nullptr) {
+      continue;
+    }
+
+    auto lock = cluster_->lockBucketsShared();
+
+    for (size_t bucket_index = 0; bucket_index < cluster_->cluster.size(); bucket_index++) {
+      const Bucket* bucket_ = visibleVersion(cluster_->cluster[bucket_index], timestamp);
+
+      if (bucket_ != nullptr) {
+        visible.push_back({cluster_index, bucket_index, bucket_});
+      }
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Mvcc::collect` method is internal of the `Mvcc` class
+  *
+  * @brief Description
+  * Retires the versions that no pinned snapshot, and no snapshot pinned later,
+  * can see. Only one cluster is locked at a time
+  *
+  * @return
+  * Returns the number of retired versions
+*/
+
+
+size_t Mvcc::collect() {
+  const timestamp_t HORIZON = horizon();
+  size_t            retired = 0;
+
+  for (size_t index = 0; ; index++) {
+    auto structure = brain->lockStructureShared();
+
+    if (index >= brain->brain.size()) {
+      break;
+    }
+
+    Cluster* cluster_ = brain->brain[index];
+
+    if (cluster_ == nullptr) {
+      continue;
+    }
+
+    auto lock = cluster_->lockBuckets();
+    retired += collectCluster(cluster_, HORIZON);
+  }
+
+  EpochManager::global().collect();
+
+  return retired;
+}
+
+
+/**
+  * @internal
+  * The `Mvcc::attachAppends` method is internal of the `Mvcc` class
+  *
+  * @brief Description
+  * Attaches the Mvcc to every cluster of the brain, the buckets flushed from their
+  * append buffers are committed with `Mvcc::commitWith` from now on. The clusters
+  * inserted later are attached by calling it again, the Mvcc must outlive them
+  *
+  * @return
+  * Returns the number of attached clusters
+*/
+
+
+size_t Mvcc::attachAppends() {
+  auto   structure = brain->lockStructureShared();
+  size_t attached  = 0;
+
+  brain->forEachCluster([&](Cluster* cluster_) {
+    cluster_->mvcc.store(this, std::memory_order_release);
+    attached++;
+  });
+  return attached;
+}
+
+
+/**
+  * @internal
+  * The `Mvcc::Mvcc` method is internal of the `Mvcc` class
+  *
+  * @brief Description
+  * The constructor of the `Mvcc` class, the buckets already in `brain_v` are
+  * the versions of the timestamp 0
+*/
+
+
+Mvcc::Mvcc(Brain* brain_v) {
+  brain = brain_v;
+}
+
+
+/**
+  * @internal
+  * The `Snapshot::time` method is internal of the `Snapshot` class
+  *
+  * @return
+  * Returns the timestamp read by the snapshot
+*/
+
+
+Mvcc::timestamp_t Snapshot::time() const {
+  return timestamp;
+}
+
+
+/**
+  * @internal
+  * The `Snapshot::Snapshot` method is internal of the `Snapshot` class
+  *
+  * @brief Description
+  * The constructor of the `Snapshot` class, pins the last commit of `mvcc_v`
+*/
+
+
+Snapshot::Snapshot(Mvcc* mvcc_v) {
+  mvcc      = mvcc_v;
+  timestamp = mvcc->pin();
+}
+
+
+/**
+  * @internal
+  * The `Snapshot::~Snapshot` method is internal of the `Snapshot` class
+  *
+  * @brief Description
+  * The destructor of the `Snapshot` class, unpins its timestamp
+*/
+
+
+Snapshot::~Snapshot() noexcept {
+  mvcc->unpin(timestamp);
+}
+
+
+/**
+  * @internal
+  * The `Transaction::isCurrent` method is internal of the `Transaction` class
+  *
+  * @brief Description
+  * Evaluates if the bucket that `value` replaces or removes is still the current
+  * version of its slot, and if the cluster of an insertion still exists
+  *
+  * @return
+  * Returns a boolean, true if value if the previous expresion is right
+*/
+
+
+bool Transaction::isCurrent(const write_t& value) const {
+  bool current = false;
+
+  mvcc->brain->readCluster(value.cluster_index, [&](auto* cluster_) {
+    if (value.kind == write_kind_t::insert) {
+      current = true;
+      return;
+    }
+
+    current =
+      value.bucket_index < cluster_->cluster.size() &&
+      cluster_->cluster[value.bucket_index] == value.base &&
+      value.base->version_end == Bucket::live_version;
+  });
+  return current;
+}
+
+
+/**
+  * @internal
+  * The `Transaction::write` method is internal of the `Transaction` class
+  *
+  * @brief Description
+  * Copies the current bucket of the slot `bucket_index` of the cluster `cluster_index`
+  * unsealed, the copy is private to the transaction until the commit. Writing the
+  * same slot again returns the same copy
+  *
+  * @return
+  * Returns the copy to write, or nullptr if the slot is empty or was removed
+*/
+
+
+Bucket* Transaction::write(size_t cluster_index, size_t bucket_index) {
+  for (auto& value : writes) {
+    if (
+      value.kind != write_kind_t::insert &&
+      value.cluster_index == cluster_index &&
+      value.bucket_index == bucket_index
+    ) {
+      return value.bucket;
+    }
+  }
+
+  Bucket* base = nullptr;
+  Bucket* copy = nullptr;
+
+  mvcc->brain->readCluster(cluster_index, [&](auto* cluster_) {
+    if (bucket_index >= cluster_->cluster.size()) {
+      return;
+    }
+
+    base = cluster_->cluster[bucket_index];
+
+    if (base != nullptr && base->version_end == Bucket::live_version) {
+      copy = base->clone();
+    }
+  });
+
+  if (copy == nullptr) {
+    return nullptr;
+  }
+
+  copy->unseal();
+  writes.push_back({write_kind_t::update, cluster_index, bucket_index, base, copy});
+
+  return copy;
+}
+
+
+/**
+  * @internal
+  * The `Transaction::insert` method is internal of the `Transaction` class
+  *
+  * @brief Description
+  * Adds `bucket_` to the cluster `cluster_index` at the commit, the transaction
+  * takes its ownership
+  *
+  * @return
+  * This function does not return anything, since it
+  * only stages the insertion
+*/
+
+
+void Transaction::insert(size_t cluster_index, Bucket* bucket_) {
+  if (bucket_ == nullptr) {
+    return;
+  }
+  writes.push_back({write_kind_t::insert, cluster_index, 0, nullptr, bucket_});
+}
+
+
+/**
+  * @internal
+  * The `Transaction::remove` method is internal of the `Transaction` class
+  *
+  * @brief Description
+  * Removes the current bucket of the slot `bucket_index` of the cluster
+  * `cluster_index` at the commit, a previous write of the slot is dropped
+  *
+  * @return
+  * Returns false if the slot is empty or was already removed
+*/
+
+
+bool Transaction::remove(size_t cluster_index, size_t bucket_index) {
+  for (auto& value : writes) {
+    if (
+      value.kind != write_kind_t::insert &&
+      value.cluster_index == cluster_index &&
+      value.bucket_index == bucket_index
+    ) {
+      if (value.kind == write_kind_t::remove) {
+        return false;
+      }
+      delete value.bucket;
+      value.bucket = nullptr;
+      value.kind   = write_kind_t::remove;
+      return true;
+    }
+  }
+
+  Bucket* base = nullptr;
+
+  mvcc->brain->readCluster(cluster_index, [&](auto* cluster_) {
+    if (bucket_index < cluster_->cluster.size()) {
+      base = cluster_->cluster[bucket_index];
+    }
+  });
+
+  if (base == nullptr || base->version_end != Bucket::live_version) {
+    return false;
+  }
+
+  writes.push_back({write_kind_t::remove, cluster_index, bucket_index, base, nullptr});
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Transaction::commit` method is internal of the `Transaction` class
+  *
+  * @brief Description
+  * Publishes every write of the transaction with the next timestamp. The commits
+  * are serialized, the writes are validated first and the transaction is aborted
+  * if another commit changed one of its slots. The directory of the brain is
+  * refreshed for the written clusters before the clock moves
+  *
+  * @return
+  * Returns the timestamp of the commit, or `Mvcc::aborted` if the transaction was
+  * aborted. A transaction without writes returns the timestamp of the last commit
+*/
+
+
+Mvcc::timestamp_t Transaction::commit() {
+  if (writes.empty()) {
+    return mvcc->now();
+  }
+
+  std::lock_guard<std::mutex> commit_lock(mvcc->commit_mutex);
+
+  for (const auto& value : writes) {
+    if (!isCurrent(value)) {
+      abort();
+      return Mvcc::aborted;
+    }
+  }
+
+  Brain*                  brain_    = mvcc->brain;
+  const Mvcc::timestamp_t TIMESTAMP = mvcc->clock.load(std::memory_order_relaxed) + 1;
+  std::set<size_t>        written;
+
+  for (auto& value : writes) {
+    written.insert(value.cluster_index);
+
+    if (value.kind == write_kind_t::insert) {
+      auto structure = brain_->lockStructureShared();
+
+      // The cluster was removed without a transaction after the validation
+      if (value.cluster_index >= brain_->brain.size() || brain_->brain[value.cluster_index] == nullptr) {
+        continue;
+      }
+
+      value.bucket->version_begin = TIMESTAMP;
+      brain_->brain[value.cluster_index]->insertBucket(value.bucket);
+      value.bucket = nullptr;
+      continue;
+    }
+
+    brain_->writeCluster(value.cluster_index, [&](auto* cluster_) {
+      Bucket* current = cluster_->cluster[value.bucket_index];
+
+      current->version_end = TIMESTAMP;
+
+      if (value.kind == write_kind_t::update) {
+        value.bucket->version_begin = TIMESTAMP;
+        value.bucket->older_version = current;
+
+        cluster_->cluster[value.bucket_index] = value.bucket;
+      }
+    });
+    value.bucket = nullptr;
+  }
+
+  // The zones must contain the new versions before a snapshot can read them
+  {
+    auto structure = brain_->lockStructure();
+
+    for (size_t index : written) {
+      if (brain_->directory == nullptr) {
+        break;
+      }
+
+      if (index < brain_->brain.size() && brain_->brain[index] != nullptr) {
+        auto lock = brain_->brain[index]->lockBucketsShared();
+        brain_->refreshDirectory(index);
+      }
+    }
+  }
+
+  // The inserts whose cluster was removed are deleted here
+  abort();
+  mvcc->clock.store(TIMESTAMP, std::memory_order_release);
+
+  return TIMESTAMP;
+}
+
+
+/**
+  * @internal
+  * The `Transaction::abort` method is internal of the `Transaction` class
+  *
+  * @brief Description
+  * Drops every write of the transaction, deleting the private copies and the
+  * buckets that were not inserted
+  *
+  * @return
+  * This function does not return anything, since it
+  * only drops the writes
+*/
+
+
+void Transaction::abort() {
+  for (auto& value : writes) {
+    delete value.bucket;
+  }
+  writes.clear();
+}
+
+
+/**
+  * @internal
+  * The `Transaction::Transaction` method is internal of the `Transaction` class
+  *
+  * @brief Description
+  * The constructor of the `Transaction` class
+*/
+
+
+Transaction::Transaction(Mvcc* mvcc_v) {
+  mvcc = mvcc_v;
+}
+
+
+/**
+  * @internal
+  * The `Transaction::~Transaction` method is internal of the `Transaction` class
+  *
+  * @brief Description
+  * The destructor of the `Transaction` class, aborts the writes that were not committed
+*/
+
+
+Transaction::~Transaction() noexcept {
+  abort();
+}
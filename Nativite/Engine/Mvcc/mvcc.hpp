@@ -0,0 +1,236 @@
+/**
+  * @file mvcc.hpp
+  * This is the documentation of the `mvcc.hpp` file
+  *
+  * @brief Description
+  * Implementation of the Mvcc, Snapshot and Transaction classes, the multi version
+  * concurrency control of the buckets of a brain in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <set>
+#include <vector>
+
+// Nativite engine imports
+#include "../Brain/brain.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Epoch/epoch.hpp"
+
+
+/**
+ * @internal
+ * The Mvcc class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * The versions of the buckets of a brain, the writers publish new buckets with
+ * a Transaction and the readers scan the brain as it was at a Snapshot
+ *
+ * @details
+ * Every commit takes the next timestamp of the `clock` field, which starts at 1 so the
+ * buckets that were in the brain before the Mvcc, with `Bucket::version_begin` 0, are
+ * seen by every snapshot. A transaction copies
+ * the buckets it writes, so the published buckets are never changed, and its commit
+ * puts the copies in the slots linking the replaced buckets in `Bucket::older_version`.
+ * A removed bucket stays in its slot with `Bucket::version_end` set until no snapshot
+ * sees it. The `clock` field only moves after the whole commit is in place, so a
+ * snapshot sees all the buckets of a commit or none of them.
+ *
+ * A snapshot pins the clock, the versions it can see are kept until it is destroyed
+ * and `Mvcc::collect` frees the others. The scans only lock a cluster to find the
+ * visible versions, then they read them without locks, so the ingestion does not wait
+ * for a long scan. While a snapshot is pinned the buckets must only be written through
+ * transactions, the Compactor skips its passes if it knows the Mvcc of the brain.
+ * The clusters attached with `Mvcc::attachAppends` commit the buckets flushed from
+ * their append buffers, so the snapshots do not see the rows appended after them.
+*/
+
+
+class Mvcc {
+  // Types
+  public:
+    using timestamp_t = uint64_t;
+
+    // The result of a commit that was aborted, the clock starts after it so
+    // no commit, not even the first empty one, has this timestamp
+    static constexpr timestamp_t aborted = 0;
+
+    // A bucket visible to a snapshot
+    struct visible_t {
+      size_t        cluster_index;
+      size_t        bucket_index;
+      const Bucket* bucket;
+    };
+
+  protected:
+    std::atomic<timestamp_t>   clock{1};        /**< The timestamp of the last commit, 1 before
+                                                     any commit */
+    std::mutex                 commit_mutex;    /**< Serializes the commits */
+    mutable std::mutex         snapshot_mutex;  /**< Protects the `snapshots` field */
+    std::multiset<timestamp_t> snapshots;       /**< The pinned timestamps */
+
+    static const Bucket* visibleVersion(const Bucket* bucket_, timestamp_t timestamp);
+
+    timestamp_t horizon() const;
+
+    size_t collectCluster(Cluster* cluster_, timestamp_t horizon_v);
+
+    friend class Snapshot;
+    friend class Transaction;
+
+  public:
+    Brain* brain = nullptr; /**< The brain whose buckets are versioned */
+
+    timestamp_t pin();
+    void        unpin(timestamp_t timestamp);
+    size_t      pinnedCount() const;
+    timestamp_t now() const;
+
+    void collectVisible(timestamp_t timestamp, std::vector<visible_t>& visible) const;
+
+    size_t collect();
+
+    size_t attachAppends();
+
+    /**
+      * @internal
+      * The `Mvcc::commitWith` method is internal of the `Mvcc` class
+      *
+      * @brief Description
+      * Calls `function(timestamp)` with the next timestamp holding the commit lock,
+      * the function publishes its buckets with that timestamp and the clock only
+      * moves if it returns true, like the end of `Transaction::commit`. It is the
+      * commit of the buckets flushed from the append buffers
+      *
+      * @return
+      * Returns the timestamp of the commit, or `Mvcc::aborted` if the function
+      * returned false
+    */
+    template <typename Function>
+    timestamp_t commitWith(Function&& function) {
+      std::lock_guard<std::mutex> commit_lock(commit_mutex);
+
+      const timestamp_t TIMESTAMP = clock.load(std::memory_order_relaxed) + 1;
+
+      if (!function(TIMESTAMP)) {
+        return aborted;
+      }
+      clock.store(TIMESTAMP, std::memory_order_release);
+      return TIMESTAMP;
+    }
+
+    Mvcc(Brain* brain_v);
+};
+
+
+/**
+ * @internal
+ * The Snapshot class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Pins the last commit of a Mvcc while it lives, the scans of the snapshot see
+ * the brain as it was at that commit
+*/
+
+
+class Snapshot {
+  protected:
+    Mvcc*             mvcc;
+    Mvcc::timestamp_t timestamp;
+
+  public:
+    Mvcc::timestamp_t time() const;
+
+    /**
+      * @internal
+      * The `Snapshot::forEachBucket` method is internal of the `Snapshot` class
+      *
+      * @brief Description
+      * Calls `function(cluster_index, bucket)` for every bucket visible to the
+      * snapshot, the clusters are only locked to find the buckets and the epoch
+      * guard keeps them alive until the scan ends
+    */
+    template <typename Function>
+    void forEachBucket(Function&& function) const {
+      EpochGuard                   guard;
+      std::vector<Mvcc::visible_t> visible;
+
+      mvcc->collectVisible(timestamp, visible);
+
+      for (const auto& value : visible) {
+        function(value.cluster_index, value.bucket);
+      }
+    }
+
+    Snapshot(Mvcc* mvcc_v);
+
+    Snapshot(const Snapshot&)            = delete;
+    Snapshot& operator=(const Snapshot&) = delete;
+
+    ~Snapshot() noexcept;
+};
+
+
+/**
+ * @internal
+ * The Transaction class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * A group of bucket writes that is published at once by `Transaction::commit`,
+ * the writes are private copies until then
+ *
+ * @details
+ * `Transaction::write` copies the current bucket of a slot unsealed, so it can be
+ * appended to. The commit fails if another transaction replaced or removed one of
+ * the written buckets after it was copied, the first commit wins. A transaction
+ * that is not committed is aborted by its destructor.
+*/
+
+
+class Transaction {
+  // Types
+  protected:
+    enum class write_kind_t : uint8_t {
+      update = 0,
+      insert = 1,
+      remove = 2
+    };
+
+    struct write_t {
+      write_kind_t kind;
+      size_t       cluster_index;
+      size_t       bucket_index;
+      Bucket*      base;   /**< The bucket that was current when it was written */
+      Bucket*      bucket; /**< The new version, owned by the transaction */
+    };
+
+    Mvcc*                mvcc;
+    std::vector<write_t> writes;
+
+    bool isCurrent(const write_t& value) const;
+
+  public:
+    Bucket* write(size_t cluster_index, size_t bucket_index);
+    void    insert(size_t cluster_index, Bucket* bucket_);
+    bool    remove(size_t cluster_index, size_t bucket_index);
+
+    Mvcc::timestamp_t commit();
+    void              abort();
+
+    Transaction(Mvcc* mvcc_v);
+
+    Transaction(const Transaction&)            = delete;
+    Transaction& operator=(const Transaction&) = delete;
+
+    ~Transaction() noexcept;
+};
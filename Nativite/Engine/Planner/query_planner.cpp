@@ -0,0 +1,1324 @@
+/**
+  * @file query_planner.cpp
+  * This is the documentation of the `query_planner.cpp` file
+  *
+  * @brief Description
+  * Implementation of the QueryPlanner class methods, the analysis of the clusters,
+  * the cost model of the strategies and the execution of the plans
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <thread>
+
+// Nativite engine imports
+#include "query_planner.hpp"
+#include "../Dictionary/dictionary.hpp"
+#include "../Compression/compression.hpp"
+#include "../ShardedTerminal/sharded_terminal.hpp"
+
+
+// The registers of the distinct values sketch of a stack are `2^SKETCH_BITS`
+static constexpr size_t SKETCH_BITS      = 10;
+static constexpr size_t SKETCH_REGISTERS = size_t{1} << SKETCH_BITS;
+
+
+// The rows of an array cached by `QueryPlanner::fillTerminal` after its stamp, if it
+// was stamped with `version`, or nullptr if it is stale
+static const Astruct::astruct_array_t* freshRows(const Astruct* astruct, uint64_t version) {
+  if (astruct == nullptr || astruct->kind() != Astruct::astruct_kind_t::array) {
+    return nullptr;
+  }
+
+  const auto& cached = std::get<Astruct::astruct_array_t>(astruct->astruct);
+
+  if (
+    cached.empty() ||
+    cached[0] == nullptr ||
+    cached[0]->kind() != Astruct::astruct_kind_t::integer ||
+    static_cast<uint64_t>(std::get<int64_t>(cached[0]->astruct)) != version
+  ) {
+    return nullptr;
+  }
+  return &cached;
+}
+
+
+// Mixes the bits of a hash, so the sketch registers are chosen uniformly
+static uint64_t mixHash(uint64_t value) {
+  value ^= value >> 30;
+  value *= 0xBF58476D1CE4E5B9ULL;
+  value ^= value >> 27;
+  value *= 0x94D049BB133111EBULL;
+  value ^= value >> 31;
+  return value;
+}
+
+
+// Adds a hash to a HyperLogLog sketch, the register keeps its longest run of zeros
+static void addToSketch(std::vector<uint8_t>& sketch, uint64_t hash) {
+  const size_t  REGISTER = hash >> (64 - SKETCH_BITS);
+  const uint8_t RANK     = static_cast<uint8_t>(std::countl_zero((hash << SKETCH_BITS) | (uint64_t{1} << (SKETCH_BITS - 1))) + 1);
+
+  sketch[REGISTER] = std::max(sketch[REGISTER], RANK);
+}
+
+
+// Estimates the distinct hashes added to a HyperLogLog sketch
+static uint64_t estimateSketch(const std::vector<uint8_t>& sketch) {
+  const double REGISTERS = static_cast<double>(SKETCH_REGISTERS);
+  const double ALPHA     = 0.7213 / (1 + 1.079 / REGISTERS);
+
+  double sum   = 0;
+  size_t zeros = 0;
+
+  for (const auto rank : sketch) {
+    sum += std::ldexp(1.0, -rank);
+    zeros += rank == 0 ? 1 : 0;
+  }
+
+  double estimate = ALPHA * REGISTERS * REGISTERS / sum;
+
+  // The small cardinalities are counted by the empty registers
+  if (estimate <= 2.5 * REGISTERS && zeros != 0) {
+    estimate = REGISTERS * std::log(REGISTERS / static_cast<double>(zeros));
+  }
+  return static_cast<uint64_t>(std::llround(estimate));
+}
+
+
+// Calls `function(kind, integer, number, text)` for every value of the stack `stack_index`
+// of a bucket whatever its layer is, the empty slots are skipped
+template <typename Function>
+static void visitStack(const Bucket* bucket_, size_t stack_index, Function&& function) {
+  if (stack_index >= bucket_->bucket.size()) {
+    return;
+  }
+
+  if (bucket_->isNumericStack(stack_index)) {
+    const NumericLayer*  layer   = bucket_->numeric_layers[stack_index];
+    const bool           INTEGER = layer->kind == NumericLayer::numeric_kind_t::integer;
+    std::vector<int64_t> integers(NumericLayer::block_size);
+    std::vector<double>  reals(NumericLayer::block_size);
+
+    for (size_t block_index = 0; block_index < layer->blockCount(); block_index++) {
+      const size_t COUNT = INTEGER
+        ? layer->decodeBlock(block_index, integers.data())
+        : layer->decodeBlock(block_index, reals.data());
+      const size_t FIRST = block_index * NumericLayer::block_size;
+
+      for (size_t offset = 0; offset < COUNT; offset++) {
+        if (!layer->isValid(FIRST + offset)) {
+          continue;
+        }
+
+        if (INTEGER) {
+          function(Astruct::astruct_kind_t::integer, integers[offset], static_cast<double>(integers[offset]), std::string_view());
+        } else {
+          function(Astruct::astruct_kind_t::real, int64_t{0}, reals[offset], std::string_view());
+        }
+      }
+    }
+    return;
+  }
+
+  if (bucket_->isDictionaryStack(stack_index)) {
+    const DictionaryLayer* layer = bucket_->dictionary_layers[stack_index];
+
+    for (const auto code : layer->codes) {
+      if (Dictionary::isString(code)) {
+        function(Astruct::astruct_kind_t::string, int64_t{0}, 0.0, layer->dictionary->decode(code));
+      }
+    }
+    return;
+  }
+
+  for (const Astruct* astruct : bucket_->bucket[stack_index]) {
+    if (astruct == nullptr) {
+      continue;
+    }
+
+    switch (astruct->kind()) {
+      case Astruct::astruct_kind_t::boolean:
+        function(astruct->kind(), int64_t{std::get<bool>(astruct->astruct) ? 1 : 0}, 0.0, std::string_view());
+        break;
+
+      case Astruct::astruct_kind_t::integer: {
+        const int64_t VALUE = std::get<int64_t>(astruct->astruct);
+        function(astruct->kind(), VALUE, static_cast<double>(VALUE), std::string_view());
+        break;
+      }
+
+      case Astruct::astruct_kind_t::real:
+        function(astruct->kind(), int64_t{0}, std::get<double>(astruct->astruct), std::string_view());
+        break;
+
+      case Astruct::astruct_kind_t::string:
+        function(astruct->kind(), int64_t{0}, 0.0, std::string_view(std::get<std::string>(astruct->astruct)));
+        break;
+
+      default:
+        function(astruct->kind(), int64_t{0}, 0.0, std::string_view());
+        break;
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::analyzeCluster` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Collects the statistics of a cluster, the caller holds its locks shared. The
+  * minimum and the maximum of the numbers of a stack are read first, from the
+  * statistics of the compressed blocks when they are finite, then the values are
+  * counted, added to the distinct values sketch and to the histogram. The numbers
+  * that are not finite are counted as values but not as numbers, so they are not
+  * in the bounds of the histogram
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `statistics`
+*/
+
+
+void QueryPlanner::analyzeCluster(const Cluster* cluster_, cluster_statistics_t& statistics) const {
+  size_t stacks = 0;
+
+  statistics         = cluster_statistics_t();
+  statistics.cluster = cluster_;
+
+  if (cluster_->sharded_terminal != nullptr) {
+    statistics.has_terminal  = true;
+    statistics.terminal_fill = static_cast<double>(cluster_->sharded_terminal->size()) /
+      static_cast<double>(std::max<size_t>(1, cluster_->sharded_terminal->capacity()));
+  }
+
+  cluster_->forEachBucket([&](const Bucket* bucket_) {
+    statistics.rows += bucket_->height();
+    statistics.buckets++;
+    stacks = std::max(stacks, bucket_->bucket.size());
+  });
+
+  statistics.stacks.resize(stacks);
+
+  const size_t         BINS = std::max<size_t>(1, histogram_bins);
+  std::vector<uint8_t> sketch(SKETCH_REGISTERS);
+
+  for (size_t stack_index = 0; stack_index < stacks; stack_index++) {
+    stack_statistics_t& stack = statistics.stacks[stack_index];
+    double              minimum = std::numeric_limits<double>::infinity();
+    double              maximum = -std::numeric_limits<double>::infinity();
+
+    cluster_->forEachBucket([&](const Bucket* bucket_) {
+      if (bucket_->isNumericStack(stack_index)) {
+        const auto& blocks = bucket_->numeric_layers[stack_index]->blocks;
+
+        // A block with a NaN or an infinity has statistics that are not bounds, its values are read
+        const bool FINITE = std::all_of(blocks.begin(), blocks.end(), [](const NumericLayer::numeric_block_t& block) {
+          return !block.has_values || (std::isfinite(block.real_minimum) && std::isfinite(block.real_maximum));
+        });
+
+        if (FINITE) {
+          for (const auto& block : blocks) {
+            if (block.has_values) {
+              minimum = std::min(minimum, block.real_minimum);
+              maximum = std::max(maximum, block.real_maximum);
+            }
+          }
+          return;
+        }
+      }
+
+      if (bucket_->isDictionaryStack(stack_index)) {
+        return;
+      }
+
+      visitStack(bucket_, stack_index, [&](Astruct::astruct_kind_t kind, int64_t, double number, std::string_view) {
+        if ((kind == Astruct::astruct_kind_t::integer || kind == Astruct::astruct_kind_t::real) && std::isfinite(number)) {
+          minimum = std::min(minimum, number);
+          maximum = std::max(maximum, number);
+        }
+      });
+    });
+
+    if (minimum <= maximum) {
+      stack.minimum = minimum;
+      stack.maximum = maximum;
+      stack.histogram.assign(BINS, 0);
+    }
+
+    std::fill(sketch.begin(), sketch.end(), 0);
+
+    cluster_->forEachBucket([&](const Bucket* bucket_) {
+      visitStack(bucket_, stack_index, [&](Astruct::astruct_kind_t kind, int64_t integer, double number, std::string_view text) {
+        uint64_t hash = static_cast<uint64_t>(kind);
+
+        switch (kind) {
+          case Astruct::astruct_kind_t::null:
+            return;
+
+          case Astruct::astruct_kind_t::integer:
+          case Astruct::astruct_kind_t::real: {
+            if (std::isfinite(number)) {
+              const double WIDTH = stack.maximum - stack.minimum;
+              const size_t BIN   = WIDTH > 0
+                ? std::min(BINS - 1, static_cast<size_t>((number - stack.minimum) / WIDTH * static_cast<double>(BINS)))
+                : 0;
+
+              stack.numbers++;
+              stack.histogram[BIN]++;
+            }
+
+            if (kind == Astruct::astruct_kind_t::integer) {
+              hash ^= static_cast<uint64_t>(integer);
+            } else {
+              uint64_t bits;
+              std::memcpy(&bits, &number, sizeof(bits));
+              hash ^= bits;
+            }
+            break;
+          }
+
+          case Astruct::astruct_kind_t::string:
+            stack.strings++;
+            hash ^= std::hash<std::string_view>{}(text);
+            break;
+
+          default:
+            hash ^= static_cast<uint64_t>(integer);
+            break;
+        }
+
+        stack.values++;
+        addToSketch(sketch, mixHash(hash));
+      });
+    });
+
+    stack.distinct = std::min<uint64_t>(stack.values, std::max<uint64_t>(stack.values != 0 ? 1 : 0, estimateSketch(sketch)));
+  }
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::analyzeClusters` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * The loop of an analysis thread, it takes the next slot and analyzes its cluster
+  * holding the locks of the cluster shared
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the `statistics` field
+*/
+
+
+void QueryPlanner::analyzeClusters() {
+  for (
+    size_t slot = next_cluster.fetch_add(1, std::memory_order_relaxed);
+    slot < statistics.size();
+    slot = next_cluster.fetch_add(1, std::memory_order_relaxed)
+  ) {
+    brain->readCluster(slot, [&](Cluster* cluster_) {
+      analyzeCluster(cluster_, statistics[slot]);
+    });
+  }
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::analyze` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Collects the statistics of every cluster of the brain in parallel, replacing
+  * the ones of the last analysis. The empty slots have no statistics
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the `statistics` field
+*/
+
+
+void QueryPlanner::analyze() {
+  {
+    auto structure = brain->lockStructureShared();
+    statistics.assign(brain->brain.size(), cluster_statistics_t());
+  }
+
+  next_cluster.store(0, std::memory_order_relaxed);
+
+  const size_t THREADS = std::clamp<size_t>(
+    threads != 0 ? threads : std::thread::hardware_concurrency(),
+    1,
+    std::max<size_t>(1, statistics.size())
+  );
+
+  std::vector<std::thread> workers;
+
+  for (size_t index = 1; index < THREADS; index++) {
+    workers.emplace_back(&QueryPlanner::analyzeClusters, this);
+  }
+  analyzeClusters();
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::selectivity` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Estimates the part of the rows of a cluster that match the conditions of a query,
+  * a range counts the parts of the histogram it covers and an equality, or a range of
+  * a single number, is one of the distinct values of the stack
+  *
+  * @return
+  * Returns the estimated part of the rows, between 0 and 1
+*/
+
+
+double QueryPlanner::selectivity(const cluster_statistics_t& statistics, const query_t& query) const {
+  const double ROWS   = static_cast<double>(std::max<uint64_t>(1, statistics.rows));
+  double       result = 1;
+
+  for (const auto& range : query.ranges) {
+    if (range.stack_index >= statistics.stacks.size()) {
+      return 0;
+    }
+
+    const stack_statistics_t& stack = statistics.stacks[range.stack_index];
+
+    if (stack.numbers == 0 || range.maximum < stack.minimum || range.minimum > stack.maximum) {
+      return 0;
+    }
+
+    double inside = 0;
+
+    if (range.minimum == range.maximum) {
+      inside = static_cast<double>(stack.numbers) / static_cast<double>(std::max<uint64_t>(1, stack.distinct));
+    } else if (stack.maximum == stack.minimum) {
+      inside = static_cast<double>(stack.numbers);
+    } else {
+      const double WIDTH = (stack.maximum - stack.minimum) / static_cast<double>(stack.histogram.size());
+
+      for (size_t bin = 0; bin < stack.histogram.size(); bin++) {
+        const double LOW     = stack.minimum + WIDTH * static_cast<double>(bin);
+        const double OVERLAP = std::min(LOW + WIDTH, range.maximum) - std::max(LOW, range.minimum);
+
+        if (OVERLAP > 0) {
+          inside += static_cast<double>(stack.histogram[bin]) * std::min(1.0, OVERLAP / WIDTH);
+        }
+      }
+    }
+
+    result *= inside / ROWS;
+  }
+
+  for (const auto& match : query.matches) {
+    if (match.stack_index >= statistics.stacks.size()) {
+      return 0;
+    }
+
+    const stack_statistics_t& stack = statistics.stacks[match.stack_index];
+
+    if (stack.strings == 0) {
+      return 0;
+    }
+
+    result *= static_cast<double>(stack.strings) / ROWS / static_cast<double>(std::max<uint64_t>(1, stack.distinct));
+  }
+
+  return std::clamp(result, 0.0, 1.0);
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::orderedCost` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Estimates the cost of scanning the clusters one by one in the order of `estimates`,
+  * with a limit the scan stops in the cluster where enough rows matched
+  *
+  * @return
+  * Returns the estimated cost in scanned rows
+*/
+
+
+double QueryPlanner::orderedCost(const std::vector<estimate_t>& estimates, size_t limit) const {
+  const double LIMIT = static_cast<double>(limit);
+
+  double scanned = 0;
+  double matched = 0;
+  double visited = 0;
+
+  for (const auto& estimate : estimates) {
+    visited++;
+
+    if (limit != 0 && estimate.matches > 0 && matched + estimate.matches >= LIMIT) {
+      scanned += estimate.rows * (LIMIT - matched) / estimate.matches;
+      break;
+    }
+
+    scanned += estimate.rows;
+    matched += estimate.matches;
+  }
+
+  return scanned * row_cost + visited * cluster_cost;
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::breadthCost` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Estimates the cost of scanning a bucket of every cluster per round, every round
+  * opens all the clusters and scans an equal part of every cluster, so with a limit
+  * the scan stops after the rows of the average selectivity
+  *
+  * @return
+  * Returns the estimated cost in scanned rows
+*/
+
+
+double QueryPlanner::breadthCost(const std::vector<estimate_t>& estimates, size_t limit) const {
+  double rows    = 0;
+  double matches = 0;
+  double buckets = 0;
+
+  for (const auto& estimate : estimates) {
+    rows    += estimate.rows;
+    matches += estimate.matches;
+    buckets  = std::max(buckets, estimate.buckets);
+  }
+
+  if (rows == 0) {
+    return static_cast<double>(estimates.size()) * cluster_cost;
+  }
+
+  const double SCANNED = limit != 0 && matches > 0
+    ? std::min(rows, rows * static_cast<double>(limit) / matches)
+    : rows;
+  const double ROUNDS  = std::max(1.0, std::ceil(SCANNED / rows * buckets));
+
+  return SCANNED * row_cost + ROUNDS * static_cast<double>(estimates.size()) * cluster_cost;
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::parallelCost` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Estimates the cost of scanning all the clusters at once with `threads_` threads,
+  * the rows and the clusters are split between the threads, which cost their start
+  *
+  * @return
+  * Returns the estimated cost in scanned rows
+*/
+
+
+double QueryPlanner::parallelCost(const std::vector<estimate_t>& estimates, size_t limit, size_t threads_) const {
+  double rows    = 0;
+  double matches = 0;
+
+  for (const auto& estimate : estimates) {
+    rows    += estimate.rows;
+    matches += estimate.matches;
+  }
+
+  const double THREADS = static_cast<double>(std::max<size_t>(1, threads_));
+  const double SCANNED = limit != 0 && matches > 0
+    ? std::min(rows, rows * static_cast<double>(limit) / matches)
+    : rows;
+
+  return
+    SCANNED * row_cost / THREADS +
+    static_cast<double>(estimates.size()) * cluster_cost / THREADS +
+    (THREADS - 1) * thread_cost;
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::plan` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Estimates the rows and the matches of every cluster, with its statistics if they
+  * are of the cluster in the slot now, and chooses the cheapest strategy. With a
+  * `cache_key` and some sharded terminal, probing the terminals first is chosen if
+  * fresh rows are cached and its cost is cheaper than the scan
+  *
+  * @return
+  * Returns the plan of the query
+*/
+
+
+QueryPlanner::plan_t QueryPlanner::plan(const query_t& query) const {
+  plan_t                  plan;
+  std::vector<estimate_t> estimates;
+  size_t                  slots = 0;
+
+  {
+    auto structure = brain->lockStructureShared();
+
+    slots                  = brain->brain.size();
+    plan.structure_version = brain->structure_version.load(std::memory_order_acquire);
+  }
+
+  const double CONDITIONS = static_cast<double>(query.ranges.size() + query.matches.size());
+
+  for (size_t slot = 0; slot < slots; slot++) {
+    brain->readCluster(slot, [&](Cluster* cluster_) {
+      estimate_t estimate;
+      estimate.slot = slot;
+
+      if (slot < statistics.size() && statistics[slot].cluster == cluster_) {
+        estimate.rows    = static_cast<double>(statistics[slot].rows);
+        estimate.buckets = static_cast<double>(statistics[slot].buckets);
+        estimate.matches = estimate.rows * selectivity(statistics[slot], query);
+      } else {
+        cluster_->forEachBucket([&](const Bucket* bucket_) {
+          estimate.rows += static_cast<double>(bucket_->height());
+          estimate.buckets++;
+        });
+        estimate.matches = estimate.rows * std::pow(default_selectivity, CONDITIONS);
+      }
+
+      plan.estimated_rows += estimate.matches;
+      estimates.push_back(estimate);
+    });
+  }
+
+  if (query.limit != 0) {
+    plan.estimated_rows = std::min(plan.estimated_rows, static_cast<double>(query.limit));
+  }
+
+  const size_t THREADS = std::clamp<size_t>(
+    threads != 0 ? threads : std::thread::hardware_concurrency(),
+    1,
+    std::max<size_t>(1, estimates.size())
+  );
+
+  // Flow_M reads the clusters with the most matches per row first
+  std::vector<estimate_t> best_first = estimates;
+
+  std::stable_sort(best_first.begin(), best_first.end(), [](const estimate_t& left, const estimate_t& right) {
+    return left.matches * std::max(1.0, right.rows) > right.matches * std::max(1.0, left.rows);
+  });
+
+  plan.alternatives = {
+    {access_path_t::ordered_scan,  strategy_t::dfs,    orderedCost(estimates, query.limit)},
+    {access_path_t::ordered_scan,  strategy_t::bfs,    breadthCost(estimates, query.limit)},
+    {access_path_t::ordered_scan,  strategy_t::flow_m, orderedCost(best_first, query.limit)},
+    {access_path_t::parallel_scan, strategy_t::tps,    parallelCost(estimates, query.limit, THREADS)}
+  };
+
+  alternative_t best = *std::min_element(
+    plan.alternatives.begin(),
+    plan.alternatives.end(),
+    [](const alternative_t& left, const alternative_t& right) { return left.cost < right.cost; }
+  );
+
+  plan.strategy       = best.strategy;
+  plan.access_path    = best.access_path;
+  plan.estimated_cost = best.cost;
+  plan.threads        = best.strategy == strategy_t::tps ? THREADS : 1;
+
+  for (const auto& estimate : best.strategy == strategy_t::flow_m ? best_first : estimates) {
+    plan.clusters.push_back(estimate.slot);
+  }
+
+  if (query.cache_key.empty()) {
+    return plan;
+  }
+
+  // The terminals are probed in the order of the plan until fresh rows are found
+  const std::string KEY     = cacheKey(query);
+  const uint64_t    VERSION = writeVersion(plan);
+
+  size_t probes = 0;
+  size_t cached = 0;
+  bool   hit    = false;
+
+  for (size_t index = 0; index < plan.clusters.size() && !hit; index++) {
+    brain->readCluster(plan.clusters[index], [&](Cluster* cluster_) {
+      if (cluster_->sharded_terminal == nullptr) {
+        return;
+      }
+
+      if (plan.cache_slot == Bucket::no_key) {
+        plan.cache_slot = plan.clusters[index];
+      }
+
+      probes++;
+      cluster_->sharded_terminal->find(KEY, [&](const Astruct* astruct) {
+        if (const auto* rows = freshRows(astruct, VERSION)) {
+          hit    = true;
+          cached = rows->size() - 1;
+        }
+      });
+    });
+  }
+
+  if (probes != 0) {
+    const double ROWS = static_cast<double>(query.limit != 0 ? std::min(cached, query.limit) : cached);
+    const double COST = static_cast<double>(probes) * terminal_cost + (hit ? ROWS * row_cost : best.cost);
+
+    plan.alternatives.push_back({access_path_t::terminal, best.strategy, COST});
+
+    if (hit && COST < best.cost) {
+      plan.access_path    = access_path_t::terminal;
+      plan.estimated_cost = COST;
+    }
+  }
+
+  return plan;
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::matchesRow` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Evaluates the conditions of a query on the row `row` of a bucket, the values are
+  * viewed through `caches`, one per condition, so a compressed block is decoded once
+  * and no value is copied
+  *
+  * @return
+  * Returns a boolean, true if the row matches all the conditions
+*/
+
+
+bool QueryPlanner::matchesRow(const Bucket* bucket_, size_t row, const query_t& query, std::vector<Cursor::block_cache_t>& caches) const {
+  const size_t STACKS = bucket_->bucket.size();
+
+  for (size_t index = 0; index < query.ranges.size(); index++) {
+    const range_t& range = query.ranges[index];
+    const Astruct* value = range.stack_index < STACKS ? Cursor::viewValue(bucket_, range.stack_index, row, caches[index]) : nullptr;
+    double         number;
+
+    if (value != nullptr && value->kind() == Astruct::astruct_kind_t::integer) {
+      number = static_cast<double>(std::get<int64_t>(value->astruct));
+    } else if (value != nullptr && value->kind() == Astruct::astruct_kind_t::real) {
+      number = std::get<double>(value->astruct);
+    } else {
+      return false;
+    }
+
+    // A NaN is never between the bounds
+    if (!(number >= range.minimum && number <= range.maximum)) {
+      return false;
+    }
+  }
+
+  for (const auto& match : query.matches) {
+    if (match.stack_index >= STACKS) {
+      return false;
+    }
+
+    if (bucket_->isDictionaryStack(match.stack_index)) {
+      const DictionaryLayer* layer = bucket_->dictionary_layers[match.stack_index];
+
+      if (row >= layer->codes.size() || !Dictionary::isString(layer->codes[row]) || layer->dictionary->decode(layer->codes[row]) != match.value) {
+        return false;
+      }
+      continue;
+    }
+
+    if (bucket_->isNumericStack(match.stack_index)) {
+      return false;
+    }
+
+    const Bucket::stack_t& stack = bucket_->bucket[match.stack_index];
+
+    if (
+      row >= stack.size() ||
+      stack[row] == nullptr ||
+      stack[row]->kind() != Astruct::astruct_kind_t::string ||
+      std::get<std::string>(stack[row]->astruct) != match.value
+    ) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::mayMatchBucket` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Evaluates the conditions of a query with the zone maps of a sealed bucket and
+  * with the stacks that the bucket has
+  *
+  * @return
+  * Returns a boolean, false if no row of the bucket can match
+*/
+
+
+bool QueryPlanner::mayMatchBucket(const Bucket* bucket_, const query_t& query) const {
+  for (const auto& range : query.ranges) {
+    if (range.stack_index >= bucket_->bucket.size() || !bucket_->mayContainRange(range.stack_index, range.minimum, range.maximum)) {
+      return false;
+    }
+  }
+
+  for (const auto& match : query.matches) {
+    if (match.stack_index >= bucket_->bucket.size() || bucket_->isNumericStack(match.stack_index)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::scanBucket` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Appends the projected rows of a bucket that match a query to `rows`, every row
+  * takes a place of the limit from `taken`, which is shared by the scans of a query
+  *
+  * @return
+  * Returns false once the limit is reached
+*/
+
+
+bool QueryPlanner::scanBucket(const Bucket* bucket_, const query_t& query, std::vector<row_t>& rows, std::atomic<size_t>& taken) const {
+  if (!mayMatchBucket(bucket_, query)) {
+    return true;
+  }
+
+  const size_t STACKS = bucket_->bucket.size();
+  const size_t WIDTH  = query.columns.empty() ? STACKS : query.columns.size();
+  const size_t HEIGHT = bucket_->height();
+
+  std::vector<Cursor::block_cache_t> conditions(query.ranges.size());
+  std::vector<Cursor::block_cache_t> caches(WIDTH);
+
+  for (size_t row = 0; row < HEIGHT; row++) {
+    if (query.limit != 0 && taken.load(std::memory_order_relaxed) >= query.limit) {
+      return false;
+    }
+
+    if (!matchesRow(bucket_, row, query, conditions)) {
+      continue;
+    }
+
+    if (taken.fetch_add(1, std::memory_order_relaxed) >= query.limit && query.limit != 0) {
+      return false;
+    }
+
+    row_t values(WIDTH, nullptr);
+
+    for (size_t column = 0; column < WIDTH; column++) {
+      const size_t STACK = query.columns.empty() ? column : query.columns[column];
+
+      if (STACK < STACKS) {
+        values[column] = Cursor::readValue(bucket_, STACK, row, caches[column]);
+      }
+    }
+    rows.push_back(std::move(values));
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::projectRow` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Copies the projected stacks `columns` of a whole row to `values` like a scan
+  * does, every stack if `columns` is empty, a stack that the row does not have is
+  * an empty slot
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `values`
+*/
+
+
+void QueryPlanner::projectRow(const Cursor::view_t& stacks, const std::vector<size_t>& columns, row_t& values) {
+  const size_t WIDTH = columns.empty() ? stacks.size() : columns.size();
+
+  values.assign(WIDTH, nullptr);
+
+  for (size_t column = 0; column < WIDTH; column++) {
+    const size_t STACK = columns.empty() ? column : columns[column];
+
+    if (STACK < stacks.size() && stacks[STACK] != nullptr) {
+      values[column] = stacks[STACK]->clone();
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::cacheKey` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Makes the key of the rows of a query in the sharded terminals, the `cache_key`
+  * followed by the bytes of its ranges and matches, so the queries with the same
+  * `cache_key` and other conditions do not share their rows. The columns and the
+  * limit are not in the key, since the whole rows of the query are cached
+  *
+  * @return
+  * Returns the key of the query
+*/
+
+
+std::string QueryPlanner::cacheKey(const query_t& query) {
+  std::string key = query.cache_key;
+
+  auto append = [&key](const auto& value) {
+    key.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  };
+
+  for (const auto& range : query.ranges) {
+    key.push_back('r');
+    append(range.stack_index);
+    append(range.minimum + 0.0);
+    append(range.maximum + 0.0);
+  }
+
+  for (const auto& match : query.matches) {
+    key.push_back('m');
+    append(match.stack_index);
+    append(match.value.size());
+    key.append(match.value);
+  }
+  return key;
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::writeVersion` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Reads the write version of the clusters of a plan, the latest `Cluster::write_version`
+  * of its clusters and `Brain::structure_version`. Every write under the locks of a
+  * cluster or of the structure moves it, so the rows cached with an older version
+  * are stale. It is read before the scan, a write during the scan makes its rows stale
+  *
+  * @return
+  * Returns the write version of the plan
+*/
+
+
+uint64_t QueryPlanner::writeVersion(const plan_t& plan) const {
+  auto     structure = brain->lockStructureShared();
+  uint64_t version   = brain->structure_version.load(std::memory_order_acquire);
+
+  for (const auto slot : plan.clusters) {
+    if (slot < brain->brain.size() && brain->brain[slot] != nullptr) {
+      version = std::max(version, brain->brain[slot]->write_version.load(std::memory_order_acquire));
+    }
+  }
+  return version;
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::probeTerminals` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Looks for the key of a query in the sharded terminals of the clusters of the plan,
+  * in the order of the plan. The cached astruct is the array of the write version of
+  * the rows followed by the whole rows of the query, every row the array of its stacks,
+  * they are projected on the columns of the query and cut at its limit. The rows of
+  * another write version than `version` are a miss
+  *
+  * @return
+  * Returns true on a hit, then `rows` has the cached rows
+*/
+
+
+bool QueryPlanner::probeTerminals(const query_t& query, const plan_t& plan, uint64_t version, std::vector<row_t>& rows) const {
+  const std::string KEY = cacheKey(query);
+
+  for (const auto slot : plan.clusters) {
+    bool found = false;
+
+    brain->readCluster(slot, [&](Cluster* cluster_) {
+      if (cluster_->sharded_terminal == nullptr) {
+        return;
+      }
+
+      cluster_->sharded_terminal->find(KEY, [&](const Astruct* astruct) {
+        const auto* cached_rows = freshRows(astruct, version);
+
+        if (cached_rows == nullptr) {
+          return;
+        }
+
+        Cursor::view_t stacks;
+
+        for (size_t index = 1; index < cached_rows->size(); index++) {
+          const Astruct* cached = (*cached_rows)[index];
+
+          if (query.limit != 0 && rows.size() >= query.limit) {
+            break;
+          }
+
+          stacks.clear();
+
+          if (cached != nullptr && cached->kind() == Astruct::astruct_kind_t::array) {
+            const auto& array = std::get<Astruct::astruct_array_t>(cached->astruct);
+            stacks.assign(array.begin(), array.end());
+          }
+
+          projectRow(stacks, query.columns, rows.emplace_back());
+        }
+        found = true;
+      });
+    });
+
+    if (found) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::fillTerminal` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Caches the whole rows of a query in the sharded terminal of the `cache_slot` of
+  * its plan, as an array of the write version `version` read before the scan and of
+  * the rows, the stale rows of the key are replaced. The rows cut by the limit are
+  * not cached, since they are not all the rows of the query, nor the rows of a plan
+  * made before the last change of the structure, which can miss a cluster
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the terminal
+*/
+
+
+void QueryPlanner::fillTerminal(const query_t& query, const plan_t& plan, uint64_t version, const std::vector<row_t>& rows) const {
+  if (
+    plan.cache_slot == Bucket::no_key ||
+    (query.limit != 0 && rows.size() >= query.limit) ||
+    plan.structure_version != brain->structure_version.load(std::memory_order_acquire)
+  ) {
+    return;
+  }
+
+  brain->readCluster(plan.cache_slot, [&](Cluster* cluster_) {
+    if (cluster_->sharded_terminal == nullptr) {
+      return;
+    }
+
+    Astruct::astruct_array_t cached;
+    cached.reserve(rows.size() + 1);
+    cached.push_back(new Astruct(static_cast<int64_t>(version)));
+
+    for (const auto& row : rows) {
+      Astruct::astruct_array_t stacks;
+      stacks.reserve(row.size());
+
+      for (const Astruct* astruct : row) {
+        stacks.push_back(astruct != nullptr ? astruct->clone() : nullptr);
+      }
+      cached.push_back(new Astruct(std::move(stacks)));
+    }
+
+    cluster_->sharded_terminal->insert(cacheKey(query), new Astruct(std::move(cached)));
+  });
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::scanOrdered` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Scans the clusters of the plan one by one in its order, DFS and Flow_M, and
+  * stops at the limit
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `rows`
+*/
+
+
+void QueryPlanner::scanOrdered(const scanner_t& scanner, const plan_t& plan, std::vector<row_t>& rows) const {
+  std::atomic<size_t> taken{0};
+  bool                running = true;
+
+  for (size_t index = 0; index < plan.clusters.size() && running; index++) {
+    brain->readCluster(plan.clusters[index], [&](Cluster* cluster_) {
+      cluster_->forEachBucket([&](const Bucket* bucket_) {
+        running = running && scanner(bucket_, rows, taken);
+      });
+    });
+  }
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::scanBreadth` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Scans the bucket of the slot `n` of every cluster of the plan in round `n`, BFS,
+  * until no cluster has more buckets or the limit is reached
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `rows`
+*/
+
+
+void QueryPlanner::scanBreadth(const scanner_t& scanner, const plan_t& plan, std::vector<row_t>& rows) const {
+  std::atomic<size_t> taken{0};
+  bool                running = true;
+
+  for (size_t round = 0; running; round++) {
+    bool more = false;
+
+    for (size_t index = 0; index < plan.clusters.size() && running; index++) {
+      brain->readCluster(plan.clusters[index], [&](Cluster* cluster_) {
+        if (round >= cluster_->cluster.size()) {
+          return;
+        }
+
+        more = true;
+
+        if (cluster_->cluster[round] != nullptr && cluster_->cluster[round]->isLive()) {
+          running = scanner(cluster_->cluster[round], rows, taken);
+        }
+      });
+    }
+
+    running = running && more;
+  }
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::scanClusters` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * The loop of a TPS thread, it takes the next cluster of the plan and scans it
+  * into its own rows until the limit shared by the threads is reached
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `rows`
+*/
+
+
+void QueryPlanner::scanClusters(
+  const scanner_t& scanner,
+  const plan_t& plan,
+  std::vector<row_t>& rows,
+  std::atomic<size_t>& next,
+  std::atomic<size_t>& taken
+) const {
+  bool running = true;
+
+  for (
+    size_t index = next.fetch_add(1, std::memory_order_relaxed);
+    index < plan.clusters.size() && running;
+    index = next.fetch_add(1, std::memory_order_relaxed)
+  ) {
+    brain->readCluster(plan.clusters[index], [&](Cluster* cluster_) {
+      cluster_->forEachBucket([&](const Bucket* bucket_) {
+        running = running && scanner(bucket_, rows, taken);
+      });
+    });
+  }
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::scanParallel` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Scans all the clusters of the plan at once with the threads of the plan, TPS
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `rows`
+*/
+
+
+void QueryPlanner::scanParallel(const scanner_t& scanner, const plan_t& plan, std::vector<row_t>& rows) const {
+  const size_t THREADS = std::clamp<size_t>(plan.threads, 1, std::max<size_t>(1, plan.clusters.size()));
+
+  std::atomic<size_t>             next{0};
+  std::atomic<size_t>             taken{0};
+  std::vector<std::vector<row_t>> partials(THREADS);
+  std::vector<std::thread>        workers;
+
+  for (size_t index = 1; index < THREADS; index++) {
+    workers.emplace_back(
+      &QueryPlanner::scanClusters,
+      this,
+      std::cref(scanner),
+      std::cref(plan),
+      std::ref(partials[index]),
+      std::ref(next),
+      std::ref(taken)
+    );
+  }
+  scanClusters(scanner, plan, partials[0], next, taken);
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (auto& partial : partials) {
+    std::move(partial.begin(), partial.end(), std::back_inserter(rows));
+  }
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::scanPlan` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Scans the clusters of a plan with its strategy, every bucket with `scanner`
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `rows`
+*/
+
+
+void QueryPlanner::scanPlan(const scanner_t& scanner, const plan_t& plan, std::vector<row_t>& rows) const {
+  switch (plan.strategy) {
+    case strategy_t::bfs:
+      scanBreadth(scanner, plan, rows);
+      break;
+
+    case strategy_t::tps:
+      scanParallel(scanner, plan, rows);
+      break;
+
+    default:
+      scanOrdered(scanner, plan, rows);
+      break;
+  }
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::execute` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * Runs a query with a plan, a terminal plan probes the terminals first and scans
+  * with its strategy on a miss. Every bucket is scanned by `scanner`, so a caller
+  * can replace the evaluation of the conditions and keep the strategies, only the
+  * scans of the planner cache their rows in a terminal. A plan can be reused while
+  * the clusters of its slots are the same, the query without a plan is planned first
+  *
+  * @return
+  * Returns the rows of the query, owned by the caller, a TPS scan does not keep
+  * the order of the clusters
+*/
+
+
+std::vector<QueryPlanner::row_t> QueryPlanner::execute(const query_t& query, const plan_t& plan, const scanner_t& scanner) const {
+  std::vector<row_t> rows;
+
+  if (plan.access_path == access_path_t::terminal && probeTerminals(query, plan, writeVersion(plan), rows)) {
+    return rows;
+  }
+
+  scanPlan(scanner, plan, rows);
+  return rows;
+}
+
+
+std::vector<QueryPlanner::row_t> QueryPlanner::execute(const query_t& query, const plan_t& plan) const {
+  if (query.cache_key.empty() || plan.cache_slot == Bucket::no_key) {
+    return execute(query, plan, [&](const Bucket* bucket_, std::vector<row_t>& rows, std::atomic<size_t>& taken) {
+      return scanBucket(bucket_, query, rows, taken);
+    });
+  }
+
+  std::vector<row_t> rows;
+  const uint64_t     VERSION = writeVersion(plan);
+
+  if (plan.access_path == access_path_t::terminal && probeTerminals(query, plan, VERSION, rows)) {
+    return rows;
+  }
+
+  // A miss reads the whole rows, so the terminal can serve every projection of the query
+  query_t whole = query;
+  whole.columns.clear();
+
+  scanPlan([&](const Bucket* bucket_, std::vector<row_t>& scanned, std::atomic<size_t>& taken) {
+    return scanBucket(bucket_, whole, scanned, taken);
+  }, plan, rows);
+
+  fillTerminal(query, plan, VERSION, rows);
+
+  if (!query.columns.empty()) {
+    for (auto& row : rows) {
+      row_t values;
+
+      projectRow(Cursor::view_t(row.begin(), row.end()), query.columns, values);
+
+      for (auto astruct : row) {
+        delete astruct;
+      }
+      row = std::move(values);
+    }
+  }
+  return rows;
+}
+
+
+std::vector<QueryPlanner::row_t> QueryPlanner::execute(const query_t& query) const {
+  return execute(query, plan(query));
+}
+
+
+/**
+  * @internal
+  * The `QueryPlanner::QueryPlanner` method is internal of the `QueryPlanner` class
+  *
+  * @brief Description
+  * The constructor of the `QueryPlanner` class, the clusters have no statistics
+  * until `QueryPlanner::analyze`
+*/
+
+
+QueryPlanner::QueryPlanner(Brain* brain_v) {
+  brain = brain_v;
+}
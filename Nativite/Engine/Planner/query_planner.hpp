@@ -0,0 +1,231 @@
+/**
+  * @file query_planner.hpp
+  * This is the documentation of the `query_planner.hpp` file
+  *
+  * @brief Description
+  * Implementation of the QueryPlanner class, the statistics of the clusters of a
+  * brain and the cost based choice of the access path and the search strategy in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "../Brain/brain.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Astruct/astruct.hpp"
+#include "../Cursor/cursor.hpp"
+
+
+/**
+ * @internal
+ * The QueryPlanner class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Collects the statistics of the clusters of a brain and chooses for every query the
+ * cheapest access path and search strategy, then it runs the query with that plan
+ *
+ * @details
+ * `QueryPlanner::analyze` reads every cluster in parallel and keeps per stack the
+ * values, the numbers and the strings it has, an estimate of its distinct values
+ * and an equi-width histogram of its numbers. `QueryPlanner::plan` estimates with
+ * them the matching rows of every cluster, assuming that the conditions are
+ * independent, and the cost of every strategy in scanned rows:
+ *
+ * - DFS scans the clusters one by one in their order, bucket by bucket
+ * - BFS scans the first bucket of every cluster, then the second one and so on
+ * - Flow_M scans the clusters one by one, the ones with the most matches first
+ * - TPS scans all the clusters at once, every thread takes the next cluster
+ *
+ * The first three are ordered scans, with a LIMIT they stop when enough rows matched.
+ * TPS is the parallel scan, it pays the start of its threads. If the query has a
+ * `cache_key` and a cluster has a sharded terminal, the rows of the query are cached
+ * in the first terminal of the plan as an array of whole rows, so they are projected
+ * like a scan does. The rows are cached under `QueryPlanner::cacheKey`, the `cache_key`
+ * followed by the conditions of the query, so two queries with the same `cache_key`
+ * never share their rows. They are stamped with the write version of the plan taken
+ * before the scan, the latest `Cluster::write_version` of its clusters and the
+ * `Brain::structure_version`, and a cached array with another stamp is a miss. The
+ * terminals are probed first if fresh rows are cached when the query is planned,
+ * and the chosen scan only runs on a miss, which caches its rows if it read all of
+ * them. Only the writes made under the locks of the clusters move the versions.
+ *
+ * The statistics are only estimates, a cluster that changed since the analysis keeps
+ * its old statistics and a cluster without them uses `default_selectivity`, so no
+ * cluster is skipped because of them. The numbers that are not finite are not in the
+ * histograms and never match a range. The sealed buckets whose zone maps do not match
+ * the ranges are skipped while scanning.
+*/
+
+
+class QueryPlanner {
+  // Types
+  public:
+    using row_t = Cursor::row_t;
+
+    // The ways to read the rows of a query
+    enum class access_path_t : uint8_t {
+      terminal      = 0,
+      ordered_scan  = 1,
+      parallel_scan = 2
+    };
+
+    // The search strategies
+    enum class strategy_t : uint8_t {
+      dfs    = 0,
+      bfs    = 1,
+      flow_m = 2,
+      tps    = 3
+    };
+
+    // A condition of the rows, the number in the stack `stack_index` must be
+    // between `minimum` and `maximum`
+    struct range_t {
+      size_t stack_index;
+      double minimum;
+      double maximum;
+    };
+
+    // A condition of the rows, the stack `stack_index` must have the string `value`
+    struct match_t {
+      size_t      stack_index;
+      std::string value;
+    };
+
+    // A query, the rows that match all its conditions
+    struct query_t {
+      std::vector<range_t> ranges;
+      std::vector<match_t> matches;
+      std::vector<size_t>  columns;   /**< The projected stacks, empty to read all of them */
+      size_t               limit = 0; /**< The maximum rows of the result, 0 for all of them */
+      std::string          cache_key; /**< The key of the result in the sharded terminals, empty if it has none */
+    };
+
+    // The statistics of a stack of a cluster
+    struct stack_statistics_t {
+      uint64_t              values   = 0; /**< The slots that are not empty */
+      uint64_t              numbers  = 0;
+      uint64_t              strings  = 0;
+      uint64_t              distinct = 0; /**< The estimated distinct values */
+      double                minimum  = 0; /**< The smallest number */
+      double                maximum  = 0; /**< The largest number */
+      std::vector<uint64_t> histogram;    /**< The numbers in every equal part of the minimum to the maximum */
+    };
+
+    // The statistics of a cluster
+    struct cluster_statistics_t {
+      const Cluster*                  cluster       = nullptr; /**< The analyzed cluster, nullptr if it was not */
+      uint64_t                        rows          = 0;
+      uint64_t                        buckets       = 0;
+      double                          terminal_fill = 0;       /**< The used part of the sharded terminal */
+      bool                            has_terminal  = false;
+      std::vector<stack_statistics_t> stacks;
+    };
+
+    // The estimated cost of a strategy for a query
+    struct alternative_t {
+      access_path_t access_path;
+      strategy_t    strategy;
+      double        cost;
+    };
+
+    // The scan of the rows of a bucket that match a query, it appends them to the
+    // rows and takes their places of the limit from the counter, false once it is reached
+    using scanner_t = std::function<bool(const Bucket*, std::vector<row_t>&, std::atomic<size_t>&)>;
+
+    // The plan of a query, the clusters are in the order they are read
+    struct plan_t {
+      access_path_t              access_path       = access_path_t::ordered_scan;
+      strategy_t                 strategy          = strategy_t::dfs; /**< The scan, also on a terminal miss */
+      std::vector<size_t>        clusters;
+      size_t                     cache_slot        = Bucket::no_key; /**< The slot whose terminal caches the rows, no_key if none */
+      double                     estimated_rows    = 0; /**< The estimated matching rows */
+      double                     estimated_cost    = 0; /**< The estimated cost in scanned rows */
+      uint64_t                   structure_version = 0; /**< The `Brain::structure_version` when it was planned */
+      size_t                     threads           = 1;
+      std::vector<alternative_t> alternatives;          /**< The cost of every strategy that was considered */
+    };
+
+  protected:
+    // The estimates of a cluster for a query
+    struct estimate_t {
+      size_t slot    = 0;
+      double rows    = 0;
+      double matches = 0;
+      double buckets = 0;
+    };
+
+    // Internal functions of the class
+    void analyzeCluster(const Cluster* cluster_, cluster_statistics_t& statistics) const;
+    void analyzeClusters();
+
+    double selectivity(const cluster_statistics_t& statistics, const query_t& query) const;
+
+    double orderedCost(const std::vector<estimate_t>& estimates, size_t limit) const;
+    double breadthCost(const std::vector<estimate_t>& estimates, size_t limit) const;
+    double parallelCost(const std::vector<estimate_t>& estimates, size_t limit, size_t threads_) const;
+
+    bool matchesRow(const Bucket* bucket_, size_t row, const query_t& query, std::vector<Cursor::block_cache_t>& caches) const;
+    bool mayMatchBucket(const Bucket* bucket_, const query_t& query) const;
+    bool scanBucket(const Bucket* bucket_, const query_t& query, std::vector<row_t>& rows, std::atomic<size_t>& taken) const;
+
+    static void projectRow(const Cursor::view_t& stacks, const std::vector<size_t>& columns, row_t& values);
+
+    uint64_t writeVersion(const plan_t& plan) const;
+
+    bool probeTerminals(const query_t& query, const plan_t& plan, uint64_t version, std::vector<row_t>& rows) const;
+    void fillTerminal(const query_t& query, const plan_t& plan, uint64_t version, const std::vector<row_t>& rows) const;
+    void scanPlan(const scanner_t& scanner, const plan_t& plan, std::vector<row_t>& rows) const;
+    void scanOrdered(const scanner_t& scanner, const plan_t& plan, std::vector<row_t>& rows) const;
+    void scanBreadth(const scanner_t& scanner, const plan_t& plan, std::vector<row_t>& rows) const;
+    void scanParallel(const scanner_t& scanner, const plan_t& plan, std::vector<row_t>& rows) const;
+
+    void scanClusters(
+      const scanner_t& scanner,
+      const plan_t& plan,
+      std::vector<row_t>& rows,
+      std::atomic<size_t>& next,
+      std::atomic<size_t>& taken
+    ) const;
+
+    std::atomic<size_t> next_cluster{0}; /**< The next cluster to analyze */
+
+  public:
+    Brain* brain;       /**< The planned brain */
+    size_t threads = 0; /**< The threads of the analysis and of TPS, 0 is one per hardware thread */
+
+    size_t histogram_bins      = 32;   /**< The parts of the histograms of the numbers */
+    double default_selectivity = 0.1;  /**< The matching part of a condition without statistics */
+    double row_cost            = 1;    /**< The cost of scanning a row */
+    double cluster_cost        = 64;   /**< The cost of locking and opening a cluster */
+    double thread_cost         = 4096; /**< The cost of starting a scan thread */
+    double terminal_cost       = 8;    /**< The cost of probing a sharded terminal */
+
+    std::vector<cluster_statistics_t> statistics; /**< The statistics of every slot of the brain */
+
+    void   analyze();
+    plan_t plan(const query_t& query) const;
+
+    static std::string cacheKey(const query_t& query);
+
+    std::vector<row_t> execute(const query_t& query, const plan_t& plan, const scanner_t& scanner) const;
+    std::vector<row_t> execute(const query_t& query, const plan_t& plan) const;
+    std::vector<row_t> execute(const query_t& query) const;
+
+    QueryPlanner(Brain* brain_v);
+
+    QueryPlanner(const QueryPlanner&)            = delete;
+    QueryPlanner& operator=(const QueryPlanner&) = delete;
+};
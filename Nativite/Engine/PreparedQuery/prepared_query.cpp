@@ -0,0 +1,605 @@
+/**
+  * @file prepared_query.cpp
+  * This is the documentation of the `prepared_query.cpp` file
+  *
+  * @brief Description
+  * Implementation of the PreparedQuery class methods, the compiled filters of the
+  * layers and the execution of the prepared plan
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+// Nativite engine imports
+#include "prepared_query.hpp"
+#include "../Dictionary/dictionary.hpp"
+#include "../Compression/compression.hpp"
+
+
+// The doubles from which the integers of a layer are out of range, 2^63
+static constexpr double INTEGER_LIMIT = 9223372036854775808.0;
+
+
+/**
+  * @internal
+  * The `PreparedQuery::filterIntegerRange` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * The filter of a range on a compressed integer layer, the block statistics skip the
+  * blocks out of the range and keep the blocks inside it without decoding them, else
+  * the block is decoded once and its integers are compared to the rounded bounds
+  *
+  * @return
+  * Returns the selected rows that match the range
+*/
+
+
+size_t PreparedQuery::filterIntegerRange(stage_t& stage, size_t first, uint16_t* selection, size_t selected) {
+  const NumericLayer* layer = static_cast<const NumericLayer*>(stage.layer);
+  const size_t        BLOCK = first / NumericLayer::block_size;
+
+  if (BLOCK >= layer->blockCount()) {
+    return 0;
+  }
+
+  const NumericLayer::numeric_block_t& block = layer->blocks[BLOCK];
+
+  if (!block.has_values || block.maximum < stage.lower || block.minimum > stage.upper) {
+    return 0;
+  }
+
+  const bool INSIDE = block.minimum >= stage.lower && block.maximum <= stage.upper;
+  const size_t COUNT = INSIDE ? block.count : layer->decodeBlock(BLOCK, stage.integers.data());
+  size_t       kept  = 0;
+
+  for (size_t index = 0; index < selected; index++) {
+    const uint16_t OFFSET = selection[index];
+
+    if (OFFSET >= COUNT || !layer->isValid(first + OFFSET)) {
+      continue;
+    }
+
+    selection[kept] = OFFSET;
+    kept += INSIDE || (stage.integers[OFFSET] >= stage.lower && stage.integers[OFFSET] <= stage.upper) ? 1 : 0;
+  }
+  return kept;
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::filterRealRange` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * The filter of a range on a compressed real layer, like the integer one with the
+  * real statistics of the blocks. A block with a NaN is never kept without decoding
+  * it, its statistics do not count the NaNs and a NaN is in no range
+  *
+  * @return
+  * Returns the selected rows that match the range
+*/
+
+
+size_t PreparedQuery::filterRealRange(stage_t& stage, size_t first, uint16_t* selection, size_t selected) {
+  const NumericLayer* layer = static_cast<const NumericLayer*>(stage.layer);
+  const size_t        BLOCK = first / NumericLayer::block_size;
+
+  if (BLOCK >= layer->blockCount()) {
+    return 0;
+  }
+
+  const NumericLayer::numeric_block_t& block = layer->blocks[BLOCK];
+
+  if (!block.has_values || block.real_maximum < stage.minimum || block.real_minimum > stage.maximum) {
+    return 0;
+  }
+
+  const bool INSIDE = !block.has_nan && block.real_minimum >= stage.minimum && block.real_maximum <= stage.maximum;
+  const size_t COUNT = INSIDE ? block.count : layer->decodeBlock(BLOCK, stage.reals.data());
+  size_t       kept  = 0;
+
+  for (size_t index = 0; index < selected; index++) {
+    const uint16_t OFFSET = selection[index];
+
+    if (OFFSET >= COUNT || !layer->isValid(first + OFFSET)) {
+      continue;
+    }
+
+    selection[kept] = OFFSET;
+    kept += INSIDE || (stage.reals[OFFSET] >= stage.minimum && stage.reals[OFFSET] <= stage.maximum) ? 1 : 0;
+  }
+  return kept;
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::filterPlainRange` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * The filter of a range on a plain stack, the integer and the real astructs are
+  * compared in place
+  *
+  * @return
+  * Returns the selected rows that match the range
+*/
+
+
+size_t PreparedQuery::filterPlainRange(stage_t& stage, size_t first, uint16_t* selection, size_t selected) {
+  const Bucket::stack_t& stack = *static_cast<const Bucket::stack_t*>(stage.layer);
+  size_t                 kept  = 0;
+
+  for (size_t index = 0; index < selected; index++) {
+    const size_t ROW = first + selection[index];
+
+    if (ROW >= stack.size() || stack[ROW] == nullptr) {
+      continue;
+    }
+
+    double number;
+
+    if (const int64_t* integer = std::get_if<int64_t>(&stack[ROW]->astruct)) {
+      number = static_cast<double>(*integer);
+    } else if (const double* real = std::get_if<double>(&stack[ROW]->astruct)) {
+      number = *real;
+    } else {
+      continue;
+    }
+
+    selection[kept] = selection[index];
+    kept += number >= stage.minimum && number <= stage.maximum ? 1 : 0;
+  }
+  return kept;
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::filterDictionaryMatch` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * The filter of an equality on a dictionary layer, the string was replaced by its
+  * code when the bucket was compiled, so only the codes are compared
+  *
+  * @return
+  * Returns the selected rows that match the string
+*/
+
+
+size_t PreparedQuery::filterDictionaryMatch(stage_t& stage, size_t first, uint16_t* selection, size_t selected) {
+  const std::vector<Dictionary::code_t>& codes = static_cast<const DictionaryLayer*>(stage.layer)->codes;
+  size_t                                 kept  = 0;
+
+  if (first + NumericLayer::block_size <= codes.size()) {
+    const Dictionary::code_t* block = codes.data() + first;
+
+    for (size_t index = 0; index < selected; index++) {
+      selection[kept] = selection[index];
+      kept += block[selection[index]] == stage.code ? 1 : 0;
+    }
+    return kept;
+  }
+
+  for (size_t index = 0; index < selected; index++) {
+    const size_t ROW = first + selection[index];
+
+    selection[kept] = selection[index];
+    kept += ROW < codes.size() && codes[ROW] == stage.code ? 1 : 0;
+  }
+  return kept;
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::filterPlainMatch` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * The filter of an equality on a plain stack, the string astructs are compared in place
+  *
+  * @return
+  * Returns the selected rows that match the string
+*/
+
+
+size_t PreparedQuery::filterPlainMatch(stage_t& stage, size_t first, uint16_t* selection, size_t selected) {
+  const Bucket::stack_t& stack = *static_cast<const Bucket::stack_t*>(stage.layer);
+  size_t                 kept  = 0;
+
+  for (size_t index = 0; index < selected; index++) {
+    const size_t ROW = first + selection[index];
+
+    if (ROW >= stack.size() || stack[ROW] == nullptr) {
+      continue;
+    }
+
+    const std::string* text = std::get_if<std::string>(&stack[ROW]->astruct);
+
+    selection[kept] = selection[index];
+    kept += text != nullptr && *text == *stage.value ? 1 : 0;
+  }
+  return kept;
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::compileRange` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * Compiles a range for the layer of its stack in a bucket, the bounds of a range on
+  * an integer layer are rounded to the integers inside them
+  *
+  * @return
+  * Returns false if no row of the bucket can match the range
+*/
+
+
+bool PreparedQuery::compileRange(const Bucket* bucket_, const QueryPlanner::range_t& range, stage_t& stage) const {
+  if (
+    range.stack_index >= bucket_->bucket.size() ||
+    !(range.minimum <= range.maximum) ||
+    !bucket_->mayContainRange(range.stack_index, range.minimum, range.maximum)
+  ) {
+    return false;
+  }
+
+  stage.minimum = range.minimum;
+  stage.maximum = range.maximum;
+
+  if (bucket_->isDictionaryStack(range.stack_index)) {
+    return false;
+  }
+
+  if (!bucket_->isNumericStack(range.stack_index)) {
+    stage.filter = &PreparedQuery::filterPlainRange;
+    stage.layer  = &bucket_->bucket[range.stack_index];
+    return true;
+  }
+
+  const NumericLayer* layer = bucket_->numeric_layers[range.stack_index];
+
+  stage.layer = layer;
+
+  if (layer->kind == NumericLayer::numeric_kind_t::real) {
+    stage.filter = &PreparedQuery::filterRealRange;
+    stage.reals.resize(NumericLayer::block_size);
+    return true;
+  }
+
+  if (range.maximum < -INTEGER_LIMIT || range.minimum >= INTEGER_LIMIT) {
+    return false;
+  }
+
+  stage.lower = range.minimum <= -INTEGER_LIMIT ? std::numeric_limits<int64_t>::min() : static_cast<int64_t>(std::ceil(range.minimum));
+  stage.upper = range.maximum >= INTEGER_LIMIT ? std::numeric_limits<int64_t>::max() : static_cast<int64_t>(std::floor(range.maximum));
+
+  if (stage.lower > stage.upper) {
+    return false;
+  }
+
+  stage.filter = &PreparedQuery::filterIntegerRange;
+  stage.integers.resize(NumericLayer::block_size);
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::compileMatch` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * Compiles an equality for the layer of its stack in a bucket, the string is looked
+  * up once in the dictionary of a dictionary layer
+  *
+  * @return
+  * Returns false if no row of the bucket can match the string
+*/
+
+
+bool PreparedQuery::compileMatch(const Bucket* bucket_, const QueryPlanner::match_t& match, stage_t& stage) const {
+  if (match.stack_index >= bucket_->bucket.size() || bucket_->isNumericStack(match.stack_index)) {
+    return false;
+  }
+
+  if (bucket_->isDictionaryStack(match.stack_index)) {
+    const DictionaryLayer* layer = bucket_->dictionary_layers[match.stack_index];
+
+    stage.filter = &PreparedQuery::filterDictionaryMatch;
+    stage.layer  = layer;
+    stage.code   = layer->dictionary->find(match.value);
+    return stage.code != Dictionary::null_code;
+  }
+
+  stage.filter = &PreparedQuery::filterPlainMatch;
+  stage.layer  = &bucket_->bucket[match.stack_index];
+  stage.value  = &match.value;
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::compileBucket` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * Compiles the conditions of the query for the layers of a bucket, in the order
+  * of `conditions_`
+  *
+  * @return
+  * Returns false if no row of the bucket can match
+*/
+
+
+bool PreparedQuery::compileBucket(const Bucket* bucket_, const std::vector<condition_t>& conditions_, std::vector<stage_t>& stages) const {
+  stages.resize(conditions_.size());
+
+  for (size_t index = 0; index < conditions_.size(); index++) {
+    const condition_t& condition = conditions_[index];
+
+    const bool COMPILED = condition.range
+      ? compileRange(bucket_, query.ranges[condition.index], stages[index])
+      : compileMatch(bucket_, query.matches[condition.index], stages[index]);
+
+    if (!COMPILED) {
+      return false;
+    }
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::scanBucket` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * Runs the pipeline of a bucket block by block, every filter keeps the rows of the
+  * block that match its condition and the rows left are projected like the scans of
+  * the QueryPlanner class, taking their places of the limit from `taken`
+  *
+  * @return
+  * Returns false once the limit is reached
+*/
+
+
+bool PreparedQuery::scanBucket(
+  const Bucket* bucket_,
+  const std::vector<condition_t>& conditions_,
+  std::vector<row_t>& rows,
+  std::atomic<size_t>& taken
+) const {
+  std::vector<stage_t> stages;
+
+  if (!compileBucket(bucket_, conditions_, stages)) {
+    return true;
+  }
+
+  const size_t STACKS = bucket_->bucket.size();
+  const size_t WIDTH  = query.columns.empty() ? STACKS : query.columns.size();
+  const size_t HEIGHT = bucket_->height();
+
+  std::array<uint16_t, NumericLayer::block_size> selection;
+  std::vector<Cursor::block_cache_t>              caches(WIDTH);
+
+  for (size_t first = 0; first < HEIGHT; first += NumericLayer::block_size) {
+    if (query.limit != 0 && taken.load(std::memory_order_relaxed) >= query.limit) {
+      return false;
+    }
+
+    size_t selected = std::min(NumericLayer::block_size, HEIGHT - first);
+
+    std::iota(selection.begin(), selection.begin() + selected, uint16_t{0});
+
+    for (size_t index = 0; index < stages.size() && selected != 0; index++) {
+      selected = stages[index].filter(stages[index], first, selection.data(), selected);
+    }
+
+    for (size_t index = 0; index < selected; index++) {
+      if (taken.fetch_add(1, std::memory_order_relaxed) >= query.limit && query.limit != 0) {
+        return false;
+      }
+
+      row_t values(WIDTH, nullptr);
+
+      for (size_t column = 0; column < WIDTH; column++) {
+        const size_t STACK = query.columns.empty() ? column : query.columns[column];
+
+        if (STACK < STACKS) {
+          values[column] = Cursor::readValue(bucket_, STACK, first + selection[index], caches[column]);
+        }
+      }
+      rows.push_back(std::move(values));
+    }
+  }
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::bindRange` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * Replaces the bounds of the range `index` of the query, the plan and the order
+  * of the conditions are kept
+  *
+  * @return
+  * This function does not return anything, since it
+  * only updates the query
+*/
+
+
+void PreparedQuery::bindRange(size_t index, double minimum, double maximum) {
+  QueryPlanner::range_t& range = query.ranges.at(index);
+
+  range.minimum = minimum;
+  range.maximum = maximum;
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::bindMatch` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * Replaces the string of the equality `index` of the query, the plan and the order
+  * of the conditions are kept
+  *
+  * @return
+  * This function does not return anything, since it
+  * only updates the query
+*/
+
+
+void PreparedQuery::bindMatch(size_t index, std::string value) {
+  query.matches.at(index).value = std::move(value);
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::isStale` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * Checks if a slot of the brain has another cluster than when the query was planned,
+  * which also finds a cluster removed and another one inserted in its slot. The
+  * caller holds `plan_mutex`
+  *
+  * @return
+  * Returns true if the query must be planned again
+*/
+
+
+bool PreparedQuery::isStale() const {
+  auto structure = planner->brain->lockStructureShared();
+
+  const auto& slots = planner->brain->brain;
+  return !std::equal(planned_clusters.begin(), planned_clusters.end(), slots.begin(), slots.end());
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::planQuery` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * Plans the query with the statistics of the planner and orders its conditions by
+  * the rows that every condition alone is estimated to match, the fewest first. The
+  * caller holds `plan_mutex`
+  *
+  * @return
+  * This function does not return anything, since it
+  * only updates the plan, the conditions and the planned clusters
+*/
+
+
+void PreparedQuery::planQuery() const {
+  {
+    auto structure = planner->brain->lockStructureShared();
+    planned_clusters.assign(planner->brain->brain.begin(), planner->brain->brain.end());
+  }
+
+  plan = planner->plan(query);
+  conditions.clear();
+
+  for (size_t index = 0; index < query.ranges.size(); index++) {
+    query_t single;
+    single.ranges = {query.ranges[index]};
+    conditions.push_back({true, index, planner->plan(single).estimated_rows});
+  }
+
+  for (size_t index = 0; index < query.matches.size(); index++) {
+    query_t single;
+    single.matches = {query.matches[index]};
+    conditions.push_back({false, index, planner->plan(single).estimated_rows});
+  }
+
+  std::stable_sort(conditions.begin(), conditions.end(), [](const condition_t& left, const condition_t& right) {
+    return left.selectivity < right.selectivity;
+  });
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::replan` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * Plans the query again, after the statistics of the planner were refreshed
+  *
+  * @return
+  * This function does not return anything, since it
+  * only updates the plan and the conditions
+*/
+
+
+void PreparedQuery::replan() {
+  std::lock_guard<std::mutex> lock(plan_mutex);
+  planQuery();
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::execute` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * Runs the prepared query with its plan and its compiled pipelines. If the slots of
+  * the brain changed since the plan, the query is planned again and the new plan is
+  * kept, so the clusters are all scanned and the next executions do not plan again.
+  * The execution runs with a copy of the plan and of the conditions
+  *
+  * @return
+  * Returns the rows of the query, owned by the caller
+*/
+
+
+std::vector<PreparedQuery::row_t> PreparedQuery::execute() const {
+  plan_t                   plan_;
+  std::vector<condition_t> conditions_;
+
+  {
+    std::lock_guard<std::mutex> lock(plan_mutex);
+
+    if (isStale()) {
+      planQuery();
+    }
+
+    plan_       = plan;
+    conditions_ = conditions;
+  }
+
+  const QueryPlanner::scanner_t SCANNER = [this, &conditions_](const Bucket* bucket_, std::vector<row_t>& rows, std::atomic<size_t>& taken) {
+    return scanBucket(bucket_, conditions_, rows, taken);
+  };
+
+  return planner->execute(query, plan_, SCANNER);
+}
+
+
+/**
+  * @internal
+  * The `PreparedQuery::PreparedQuery` method is internal of the `PreparedQuery` class
+  *
+  * @brief Description
+  * The constructor of the `PreparedQuery` class, it plans the query with the
+  * statistics that the planner has now
+*/
+
+
+PreparedQuery::PreparedQuery(QueryPlanner* planner_v, query_t query_v) {
+  planner = planner_v;
+  query   = std::move(query_v);
+
+  replan();
+}
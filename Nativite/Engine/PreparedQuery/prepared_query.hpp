@@ -0,0 +1,135 @@
+/**
+  * @file prepared_query.hpp
+  * This is the documentation of the `prepared_query.hpp` file
+  *
+  * @brief Description
+  * Implementation of the PreparedQuery class, a query that is planned once and whose
+  * conditions are compiled to the layers of every bucket it scans in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "../Planner/query_planner.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Cursor/cursor.hpp"
+
+
+/**
+ * @internal
+ * The PreparedQuery class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * A query that is executed many times, it is planned once and its conditions run
+ * as filters compiled to the layers of the buckets instead of being evaluated row
+ * by row
+ *
+ * @details
+ * Preparing a query plans it with a QueryPlanner and orders its conditions by their
+ * estimated selectivity, so the most selective condition runs first. On every bucket
+ * the conditions are compiled to a pipeline of filters, one per condition, chosen by
+ * the layer of its stack: a range on a compressed integer layer compares integers
+ * against the rounded bounds, an equality on a dictionary layer compares the code of
+ * the string, and the plain stacks compare the astructs in place. A filter keeps the
+ * selected rows of a block of `NumericLayer::block_size` rows, so it is called once
+ * per block, decodes a compressed block at most once and skips the blocks whose
+ * statistics do not match. A bucket where a condition can not match is not scanned.
+ * A block with a NaN is always decoded, since its statistics do not count the NaNs
+ * and a NaN matches no range.
+ *
+ * The values of the conditions are parameters, `PreparedQuery::bindRange` and
+ * `PreparedQuery::bindMatch` replace them without planning the query again. The
+ * query is planned again on `PreparedQuery::replan` and by the first execution that
+ * finds a slot of the brain with another cluster than when it was planned, a cluster
+ * added, removed or moved, which keeps the new plan for the next executions. The
+ * plan and the conditions are replaced under `plan_mutex` and every execution runs
+ * with its own copy of them. `PreparedQuery::execute` can run on many threads at
+ * once, but not while the parameters are bound.
+*/
+
+
+class PreparedQuery {
+  // Types
+  public:
+    using row_t   = Cursor::row_t;
+    using query_t = QueryPlanner::query_t;
+    using plan_t  = QueryPlanner::plan_t;
+
+  protected:
+    // A condition compiled for the layer of its stack in a bucket, `filter` keeps the
+    // `selected` rows of the block from the row `first` that match it and returns them
+    struct stage_t {
+      using filter_t = size_t (*)(stage_t& stage, size_t first, uint16_t* selection, size_t selected);
+
+      filter_t             filter  = nullptr;
+      const void*          layer   = nullptr; /**< The NumericLayer, DictionaryLayer or plain stack of the condition */
+      int64_t              lower   = 0;       /**< The bounds of a range of an integer layer */
+      int64_t              upper   = 0;
+      double               minimum = 0;       /**< The bounds of any other range */
+      double               maximum = 0;
+      uint32_t             code    = 0;       /**< The code of the string of a dictionary layer */
+      const std::string*   value   = nullptr; /**< The string of a plain stack */
+      std::vector<int64_t> integers;          /**< The decoded block of a numeric layer */
+      std::vector<double>  reals;
+    };
+
+    // A condition of the query, in the order the conditions run
+    struct condition_t {
+      bool   range       = true; /**< If it is a range, else a match */
+      size_t index       = 0;    /**< The index in the ranges or in the matches of the query */
+      double selectivity = 1;    /**< The estimated matching rows */
+    };
+
+    // Internal functions of the class
+    static size_t filterIntegerRange(stage_t& stage, size_t first, uint16_t* selection, size_t selected);
+    static size_t filterRealRange(stage_t& stage, size_t first, uint16_t* selection, size_t selected);
+    static size_t filterPlainRange(stage_t& stage, size_t first, uint16_t* selection, size_t selected);
+    static size_t filterDictionaryMatch(stage_t& stage, size_t first, uint16_t* selection, size_t selected);
+    static size_t filterPlainMatch(stage_t& stage, size_t first, uint16_t* selection, size_t selected);
+
+    bool compileRange(const Bucket* bucket_, const QueryPlanner::range_t& range, stage_t& stage) const;
+    bool compileMatch(const Bucket* bucket_, const QueryPlanner::match_t& match, stage_t& stage) const;
+    bool compileBucket(const Bucket* bucket_, const std::vector<condition_t>& conditions_, std::vector<stage_t>& stages) const;
+
+    bool scanBucket(
+      const Bucket* bucket_,
+      const std::vector<condition_t>& conditions_,
+      std::vector<row_t>& rows,
+      std::atomic<size_t>& taken
+    ) const;
+
+    bool isStale() const;
+    void planQuery() const;
+
+    mutable std::vector<condition_t>    conditions;       /**< The conditions, the most selective first */
+    mutable std::vector<const Cluster*> planned_clusters; /**< The cluster of every slot of the brain when the query was planned */
+    mutable std::mutex                  plan_mutex;       /**< Guards the plan, the conditions and the planned clusters */
+
+  public:
+    QueryPlanner*  planner; /**< The planner of the query, its statistics order the conditions */
+    query_t        query;   /**< The prepared query, with the bound parameters */
+    mutable plan_t plan;    /**< The plan of the query, replaced by the executions that find it stale */
+
+    void bindRange(size_t index, double minimum, double maximum);
+    void bindMatch(size_t index, std::string value);
+    void replan();
+
+    std::vector<row_t> execute() const;
+
+    PreparedQuery(QueryPlanner* planner_v, query_t query_v);
+
+    PreparedQuery(const PreparedQuery&)            = delete;
+    PreparedQuery& operator=(const PreparedQuery&) = delete;
+};
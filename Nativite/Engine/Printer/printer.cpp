@@ -0,0 +1,507 @@
+/**
+  * @file printer.cpp
+  * This is the documentation of the `printer.cpp` file
+  *
+  * @brief Description
+  * Implementation of the Printer class methods, the buffered writing and
+  * the square layout of brains, clusters and buckets.
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <string>
+#include <variant>
+
+// Nativite engine imports
+#include "printer.hpp"
+
+
+/**
+  * @internal
+  * The `Printer::flush` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Writes the used bytes of the `buffer` field to the ostream with a single call
+  *
+  * @return
+  * This function does not return anything, since it
+  * only flushes the buffer
+*/
+
+
+void Printer::flush() {
+  if (used > 0) {
+    ostream->write(buffer.data(), used);
+    used = 0;
+  }
+}
+
+
+/**
+  * @internal
+  * The `Printer::writeText` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Copies `text` to the `buffer` field, flushing it when it is full, a text
+  * larger than the buffer is written directly to the ostream
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes to the buffer
+*/
+
+
+void Printer::writeText(std::string_view text) {
+  if (text.size() > buffer.size() - used) {
+    flush();
+
+    if (text.size() > buffer.size()) {
+      ostream->write(text.data(), text.size());
+      return;
+    }
+  }
+
+  std::memcpy(buffer.data() + used, text.data(), text.size());
+  used += text.size();
+}
+
+
+/**
+  * @internal
+  * The `Printer::writeUnsigned`, `Printer::writeInteger` and `Printer::writeReal` methods
+  * are internal of the `Printer` class
+  *
+  * @brief Description
+  * Formats a number with `std::to_chars` in a stack buffer, without locales
+  * or allocations, and writes it
+*/
+
+
+void Printer::writeUnsigned(uint64_t value) {
+  char text[24];
+  auto result = std::to_chars(text, text + sizeof(text), value);
+  writeText(std::string_view(text, result.ptr - text));
+}
+
+
+void Printer::writeInteger(int64_t value) {
+  char text[24];
+  auto result = std::to_chars(text, text + sizeof(text), value);
+  writeText(std::string_view(text, result.ptr - text));
+}
+
+
+void Printer::writeReal(double value) {
+  char text[32];
+  auto result = std::to_chars(text, text + sizeof(text), value);
+  writeText(std::string_view(text, result.ptr - text));
+}
+
+
+/**
+  * @internal
+  * The `Printer::writeAstruct` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Writes an astruct in a JSON like way, printing 'empty' for nullptr slots
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the astruct to the buffer
+*/
+
+
+void Printer::writeAstruct(const Astruct* astruct) {
+  if (astruct == nullptr) {
+    writeText("empty");
+    return;
+  }
+
+  switch (astruct->kind()) {
+    case Astruct::astruct_kind_t::null:
+      writeText("null");
+      break;
+    case Astruct::astruct_kind_t::boolean:
+      writeText(std::get<bool>(astruct->astruct) ? "true" : "false");
+      break;
+    case Astruct::astruct_kind_t::integer:
+      writeInteger(std::get<int64_t>(astruct->astruct));
+      break;
+    case Astruct::astruct_kind_t::real:
+      writeReal(std::get<double>(astruct->astruct));
+      break;
+    case Astruct::astruct_kind_t::string:
+      writeText("\"");
+      writeText(std::get<std::string>(astruct->astruct));
+      writeText("\"");
+      break;
+    case Astruct::astruct_kind_t::array: {
+      auto& array = std::get<Astruct::astruct_array_t>(astruct->astruct);
+
+      writeText("[");
+      for (size_t index = 0; index < array.size(); index++) {
+        if (index > 0) {
+          writeText(", ");
+        }
+        writeAstruct(array[index]);
+      }
+      writeText("]");
+      break;
+    }
+    case Astruct::astruct_kind_t::object: {
+      auto& object = std::get<Astruct::astruct_object_t>(astruct->astruct);
+
+      writeText("{");
+      for (size_t index = 0; index < object.size(); index++) {
+        if (index > 0) {
+          writeText(", ");
+        }
+        writeText("\"");
+        writeText(object[index].first);
+        writeText("\": ");
+        writeAstruct(object[index].second);
+      }
+      writeText("}");
+      break;
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Printer::takeSquareRootOfSize` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Takes the square root of `size` rounded up, it is the number of slots
+  * per row so the output looks like a square and not a flat array
+  *
+  * @return
+  * Returns the number of slots per row
+*/
+
+
+size_t Printer::takeSquareRootOfSize(size_t size) {
+  return std::ceil(
+    std::sqrt(
+      static_cast<double>(size)
+    )
+  );
+}
+
+
+/**
+  * @internal
+  * The `Printer::writeSquare` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Writes the slots of `container` that are inside the page selected by
+  * `slot_offset` and `slot_limit` in a square, the container is read by
+  * reference and never copied
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the square to the buffer
+*/
+
+
+template <typename Container, typename PrintSlot>
+void Printer::writeSquare(
+  std::string_view name,
+  const Container& container,
+  PrintSlot printSlot
+) {
+  const size_t SIZE  = container.size();
+  const size_t FIRST = std::min(slot_offset, SIZE);
+  const size_t LAST  = FIRST + std::min(slot_limit, SIZE - FIRST);
+  const size_t SQUARE_ROOT_OF_SIZE = takeSquareRootOfSize(LAST - FIRST);
+
+  size_t square_counter = 0;
+
+  writeText(name);
+  writeText("([");
+
+  if (LAST > FIRST) {
+    writeText("\n");
+  }
+
+  for (size_t index = FIRST; index < LAST; index++) {
+    if (index == FIRST) {
+      writeText("  ");
+    }
+
+    if (square_counter == SQUARE_ROOT_OF_SIZE) {
+      writeText("\n  ");
+      square_counter = 0;
+    }
+
+    printSlot(container[index]);
+
+    if (index + 1 < LAST) {
+      writeText(", ");
+    }
+
+    square_counter++;
+  }
+
+  if (LAST > FIRST) {
+    writeText("\n");
+  }
+
+  writeHiddenSlots(FIRST, SIZE - LAST);
+  writeText("])");
+}
+
+
+/**
+  * @internal
+  * The `Printer::writeHiddenSlots` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Writes how many slots were left out of the page before and after it,
+  * nothing is written if every slot was printed
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes to the buffer
+*/
+
+
+void Printer::writeHiddenSlots(size_t before, size_t after) {
+  if (before == 0 && after == 0) {
+    return;
+  }
+
+  writeText("  ... ");
+  writeUnsigned(before);
+  writeText(" slots before, ");
+  writeUnsigned(after);
+  writeText(" slots after\n");
+}
+
+
+/**
+  * @internal
+  * The `Printer::print` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Prints a brain, its clusters and its empty slots in a square
+  *
+  * @return
+  * This function does not return anything, the output is flushed to the ostream
+*/
+
+
+void Printer::print(const Brain* brain_) {
+  writeSquare(
+    "Brain",
+    brain_->brain,
+    [this](const Brain::brain_subv_t cluster_) {
+      writeText(cluster_ == nullptr ? "empty" : "item");
+    }
+  );
+  flush();
+}
+
+
+/**
+  * @internal
+  * The `Printer::print` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Prints a cluster, its buckets and its empty slots in a square
+  *
+  * @return
+  * This function does not return anything, the output is flushed to the ostream
+*/
+
+
+void Printer::print(const Cluster* cluster_) {
+  writeSquare(
+    "Cluster",
+    cluster_->cluster,
+    [this](const Cluster::cluster_subv_t bucket_) {
+      writeText(bucket_ == nullptr ? "empty" : "item");
+    }
+  );
+  flush();
+}
+
+
+/**
+  * @internal
+  * The `Printer::print` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Prints a bucket, one 3D vertical stack per row, the page selected by
+  * `slot_offset` and `slot_limit` is applied to the astructs of every stack
+  *
+  * @return
+  * This function does not return anything, the output is flushed to the ostream
+*/
+
+
+void Printer::print(const Bucket* bucket_) {
+  writeText("Bucket([");
+
+  if (!bucket_->bucket.empty()) {
+    writeText("\n");
+  }
+
+  for (size_t stack_index = 0; stack_index < bucket_->bucket.size(); stack_index++) {
+    // The dictionary encoded stacks are printed from their codes and the
+    // compressed stacks from their blocks, decoding only the visible blocks
+    const auto&            stack   = bucket_->bucket[stack_index];
+    const DictionaryLayer* layer   = bucket_->isDictionaryStack(stack_index)
+      ? bucket_->dictionary_layers[stack_index]
+      : nullptr;
+    const NumericLayer*    numeric = bucket_->isNumericStack(stack_index)
+      ? bucket_->numeric_layers[stack_index]
+      : nullptr;
+    const size_t           HEIGHT  = bucket_->stackHeight(stack_index);
+    const size_t           FIRST   = std::min(slot_offset, HEIGHT);
+    const size_t           LAST    = FIRST + std::min(slot_limit, HEIGHT - FIRST);
+
+    int64_t integers[NumericLayer::block_size];
+    double  reals[NumericLayer::block_size];
+    size_t  decoded_block = SIZE_MAX;
+
+    writeText("  [");
+
+    if (FIRST > 0) {
+      writeText("... ");
+      writeUnsigned(FIRST);
+      writeText(" hidden");
+    }
+
+    for (size_t index = FIRST; index < LAST; index++) {
+      if (index > 0) {
+        writeText(", ");
+      }
+
+      if (numeric != nullptr) {
+        const size_t BLOCK = index / NumericLayer::block_size;
+
+        if (BLOCK != decoded_block) {
+          if (numeric->kind == NumericLayer::numeric_kind_t::integer) {
+            numeric->decodeBlock(BLOCK, integers);
+          } else {
+            numeric->decodeBlock(BLOCK, reals);
+          }
+          decoded_block = BLOCK;
+        }
+
+        if (!numeric->isValid(index)) {
+          writeText("empty");
+        } else if (numeric->kind == NumericLayer::numeric_kind_t::integer) {
+          writeInteger(integers[index % NumericLayer::block_size]);
+        } else {
+          writeReal(reals[index % NumericLayer::block_size]);
+        }
+      } else if (layer == nullptr) {
+        writeAstruct(stack[index]);
+      } else if (layer->codes[index] == Dictionary::null_code) {
+        writeText("empty");
+      } else if (layer->codes[index] == Dictionary::json_null_code) {
+        writeText("null");
+      } else {
+        writeText("\"");
+        writeText(layer->dictionary->decode(layer->codes[index]));
+        writeText("\"");
+      }
+    }
+
+    if (LAST < HEIGHT) {
+      writeText(LAST > 0 ? ", ... " : "... ");
+      writeUnsigned(HEIGHT - LAST);
+      writeText(" hidden");
+    }
+
+    writeText(stack_index + 1 < bucket_->bucket.size() ? "],\n" : "]\n");
+  }
+
+  writeText("])");
+  flush();
+}
+
+
+/**
+  * @internal
+  * The `Printer::page` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Selects the page `page_index` of `page_size` slots for the next prints
+  *
+  * @return
+  * This function does not return anything, since it
+  * only assigns the `slot_offset` and `slot_limit` fields
+*/
+
+
+void Printer::page(size_t page_index, size_t page_size) {
+  slot_offset = page_index * page_size;
+  slot_limit  = page_size;
+}
+
+
+/**
+  * @internal
+  * The `Printer::threadPrinter` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * Gives the printer of the calling thread, pointed to `ostream_` and without
+  * a page, its buffer is allocated on the first call of the thread and reused
+  *
+  * @return
+  * Returns the printer of the calling thread
+*/
+
+
+Printer& Printer::threadPrinter(std::ostream& ostream_) {
+  thread_local Printer printer(ostream_);
+
+  // The previous print flushed the buffer, only the output and the page change
+  printer.ostream     = &ostream_;
+  printer.slot_offset = 0;
+  printer.slot_limit  = no_limit;
+  return printer;
+}
+
+
+/**
+  * @internal
+  * The `Printer::Printer` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * The constructor of the `Printer` class, it allocates the buffer once,
+  * the same printer can be used for many prints
+*/
+
+
+Printer::Printer(
+  std::ostream& ostream_,
+  size_t buffer_size
+) :
+  ostream(&ostream_),
+  buffer(std::max<size_t>(buffer_size, 64)) {}
+
+
+/**
+  * @internal
+  * The `Printer::~Printer` method is internal of the `Printer` class
+  *
+  * @brief Description
+  * The destructor of the `Printer` class, flushes what is left in the buffer
+*/
+
+
+Printer::~Printer() noexcept {
+  flush();
+}
@@ -0,0 +1,105 @@
+/**
+  * @file printer.hpp
+  * This is the documentation of the `printer.hpp` file
+  *
+  * @brief Description
+  * Implementation of the Printer class, a streaming pretty printer for brains,
+  * clusters and buckets that writes through a reusable buffer in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <string_view>
+#include <vector>
+
+// Nativite engine imports
+#include "../Brain/brain.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Astruct/astruct.hpp"
+
+
+/**
+ * @internal
+ * The Printer class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Prints brains, clusters and buckets with the same square layout of `operator<<`,
+ * without copying the containers and with a bounded memory use
+ *
+ * @details
+ * Everything is written to the `buffer` field, which is flushed to the ostream
+ * when it is full, so printing a brain of 10M slots only uses the buffer.
+ * Numbers are formatted with `std::to_chars`. The output can be paged or truncated
+ * with the `slot_offset` and `slot_limit` fields, the hidden slots are reported
+ * at the end of the output. `Printer::threadPrinter` gives the printer of the calling
+ * thread, the `operator<<` functions print through it so the buffer is allocated
+ * once per thread and not on every print.
+*/
+
+
+class Printer {
+  // Types
+  public:
+    // The default size of the `buffer` field
+    static constexpr size_t default_buffer_size = 64 * 1024;
+
+    // The value of `slot_limit` that prints every slot
+    static constexpr size_t no_limit = std::numeric_limits<size_t>::max();
+
+  protected:
+    // Internal functions of the class
+    void flush();
+
+    void writeText(std::string_view text);
+    void writeUnsigned(uint64_t value);
+    void writeInteger(int64_t value);
+    void writeReal(double value);
+    void writeAstruct(const Astruct* astruct);
+
+    size_t takeSquareRootOfSize(size_t size);
+
+    // Writes the slots [first, last) of a container in a square,
+    // `printSlot` writes one slot
+    template <typename Container, typename PrintSlot>
+    void writeSquare(
+      std::string_view name,
+      const Container& container,
+      PrintSlot printSlot
+    );
+
+    void writeHiddenSlots(size_t before, size_t after);
+
+    std::ostream* ostream; /**< The output where the buffer is flushed */
+    size_t        used = 0; /**< The used bytes of the `buffer` field */
+
+  public:
+    std::vector<char> buffer; /**< The reusable buffer of the printer */
+
+    size_t slot_offset = 0;        /**< The first slot that is printed */
+    size_t slot_limit  = no_limit; /**< The maximum number of slots that are printed */
+
+    void print(const Brain* brain_);
+    void print(const Cluster* cluster_);
+    void print(const Bucket* bucket_);
+
+    void page(size_t page_index, size_t page_size);
+
+    static Printer& threadPrinter(std::ostream& ostream_);
+
+    Printer(
+      std::ostream& ostream_,
+      size_t buffer_size = default_buffer_size
+    );
+
+    ~Printer() noexcept;
+};
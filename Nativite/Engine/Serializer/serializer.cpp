@@ -0,0 +1,1236 @@
+/**
+  * @file serializer.cpp
+  * This is the documentation of the `serializer.cpp` file
+  *
+  * @brief Description
+  * Implementation of the Serializer class methods, the writing of the binary
+  * format and the reading of it.
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <variant>
+
+// Nativite engine imports
+#include "serializer.hpp"
+
+// The maximum depth of nested arrays and objects that the reader accepts,
+// it avoids a stack overflow with malicious inputs
+static constexpr size_t MAX_ASTRUCT_DEPTH = 512;
+
+// The maximum size of a varint of 64 bits
+static constexpr size_t MAX_VARINT_SIZE = 10;
+
+//////////////////////////////////
+// ////////// WRITING ////////////
+//////////////////////////////////
+
+
+/**
+  * @internal
+  * The `Serializer::reserveBytes` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Makes sure that `size` bytes can be written at `position`, the `buffer` field
+  * grows geometrically so the writes are amortized
+  *
+  * @return
+  * This function does not return anything, since it
+  * only grows the `buffer` field
+*/
+
+
+void Serializer::reserveBytes(size_t size) {
+  if (position + size > buffer.size()) {
+    buffer.resize(std::max(buffer.size() * 2, position + size + 64));
+  }
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeByte` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes a single byte at `position`
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes to the `buffer` field
+*/
+
+
+void Serializer::writeByte(uint8_t value) {
+  reserveBytes(1);
+  buffer[position++] = value;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeVarint` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes `value` as a LEB128 varint, 7 bits per byte with the high bit
+  * indicating that more bytes follow
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes to the `buffer` field
+*/
+
+
+void Serializer::writeVarint(uint64_t value) {
+  reserveBytes(MAX_VARINT_SIZE);
+  uint8_t* output = buffer.data() + position;
+
+  while (value >= 0x80) {
+    *output++ = static_cast<uint8_t>(value) | 0x80;
+    value >>= 7;
+  }
+  *output++ = static_cast<uint8_t>(value);
+
+  position = output - buffer.data();
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeZigzag` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes a signed integer as a zigzag varint, so small negative numbers
+  * also take a few bytes
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes to the `buffer` field
+*/
+
+
+void Serializer::writeZigzag(int64_t value) {
+  writeVarint(
+    (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63)
+  );
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeBytes` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Copies `size` raw bytes to the `buffer` field
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes to the `buffer` field
+*/
+
+
+void Serializer::writeBytes(const void* data, size_t size) {
+  if (size == 0) {
+    return;
+  }
+  reserveBytes(size);
+  std::memcpy(buffer.data() + position, data, size);
+  position += size;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeMagic` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes the 4 magic bytes and the format version
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes to the `buffer` field
+*/
+
+
+void Serializer::writeMagic(const char* magic) {
+  writeBytes(magic, 4);
+  writeVarint(format_version);
+}
+
+
+/**
+  * @internal
+  * The `Serializer::beginLengthPrefix` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Leaves room for the varint length of the section that is going to be written,
+  * the length is unknown until `Serializer::endLengthPrefix` is called
+  *
+  * @return
+  * Returns the position where the section starts
+*/
+
+
+size_t Serializer::beginLengthPrefix() {
+  reserveBytes(MAX_VARINT_SIZE);
+  size_t start = position;
+  position += MAX_VARINT_SIZE;
+  return start;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::endLengthPrefix` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes the length of the section started at `start` and moves the section
+  * just after its varint, it is a single memmove per cluster or bucket,
+  * not per astruct
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the length of the section
+*/
+
+
+void Serializer::endLengthPrefix(size_t start) {
+  const size_t BODY_START = start + MAX_VARINT_SIZE;
+  const size_t BODY_SIZE  = position - BODY_START;
+
+  position = start;
+  writeVarint(BODY_SIZE);
+
+  std::memmove(
+    buffer.data() + position,
+    buffer.data() + BODY_START,
+    BODY_SIZE
+  );
+  position += BODY_SIZE;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeAstruct` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes the tag of the astruct followed by its payload, arrays and objects
+  * write their children recursively
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the astruct to the `buffer` field
+*/
+
+
+void Serializer::writeAstruct(const Astruct* astruct) {
+  // The tag and the scalar payloads are written with a single capacity check
+  reserveBytes(1 + MAX_VARINT_SIZE);
+  uint8_t* output = buffer.data() + position;
+
+  if (astruct == nullptr) {
+    *output = 0x00;
+    position++;
+    return;
+  }
+
+  *output++ = 1 + static_cast<uint8_t>(astruct->kind());
+  position++;
+
+  switch (astruct->kind()) {
+    case Astruct::astruct_kind_t::null:
+      break;
+    case Astruct::astruct_kind_t::boolean:
+      *output = std::get<bool>(astruct->astruct) ? 1 : 0;
+      position++;
+      break;
+    case Astruct::astruct_kind_t::integer:
+      writeZigzag(std::get<int64_t>(astruct->astruct));
+      break;
+    case Astruct::astruct_kind_t::real: {
+      double real = std::get<double>(astruct->astruct);
+      std::memcpy(output, &real, sizeof(real));
+      position += sizeof(real);
+      break;
+    }
+    case Astruct::astruct_kind_t::string: {
+      const std::string& string = std::get<std::string>(astruct->astruct);
+      writeVarint(string.size());
+      writeBytes(string.data(), string.size());
+      break;
+    }
+    case Astruct::astruct_kind_t::array: {
+      auto& array = std::get<Astruct::astruct_array_t>(astruct->astruct);
+      writeVarint(array.size());
+      for (auto child : array) {
+        writeAstruct(child);
+      }
+      break;
+    }
+    case Astruct::astruct_kind_t::object: {
+      auto& object = std::get<Astruct::astruct_object_t>(astruct->astruct);
+      writeVarint(object.size());
+      for (auto& member : object) {
+        writeVarint(member.first.size());
+        writeBytes(member.first.data(), member.first.size());
+        writeAstruct(member.second);
+      }
+      break;
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeStack` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes the 3D vertical stack `stack_index` of a bucket with its encoding byte,
+  * a dictionary encoded stack writes its dictionary unless it is `shared`
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the stack to the `buffer` field
+*/
+
+
+void Serializer::writeStack(const Bucket* bucket_, size_t stack_index, const Dictionary* shared) {
+  if (bucket_->isDictionaryStack(stack_index)) {
+    const DictionaryLayer* layer = bucket_->dictionary_layers[stack_index];
+
+    if (layer->dictionary == shared) {
+      writeByte(0x02);
+    } else {
+      writeByte(0x01);
+      writeDictionary(layer->dictionary);
+    }
+
+    // The codes are shifted by two so the null code is written as 0
+    // and the JSON null code as 1
+    writeVarint(layer->codes.size());
+    for (auto code : layer->codes) {
+      writeVarint(
+        code == Dictionary::null_code      ? 0 :
+        code == Dictionary::json_null_code ? 1 :
+        uint64_t{code} + 2
+      );
+    }
+    return;
+  }
+
+  if (bucket_->isNumericStack(stack_index)) {
+    writeByte(0x03);
+    writeNumericLayer(bucket_->numeric_layers[stack_index]);
+    return;
+  }
+
+  const Bucket::stack_t& stack = bucket_->bucket[stack_index];
+
+  writeByte(0x00);
+  writeVarint(stack.size());
+  for (auto astruct : stack) {
+    writeAstruct(astruct);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeBucket` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes the capacity of the bucket, its seal state and all of its 3D vertical stacks,
+  * the filters of a sealed bucket are not written, they are built again by the reader
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the bucket to the `buffer` field
+*/
+
+
+void Serializer::writeBucket(const Bucket* bucket_, const Dictionary* shared) {
+  writeVarint(bucket_->bucket_capacity);
+  writeByte(bucket_->sealed);
+  writeVarint(bucket_->sort_key == Bucket::no_key ? 0 : bucket_->sort_key + 1);
+  writeVarint(bucket_->bucket.size());
+
+  for (size_t index = 0; index < bucket_->bucket.size(); index++) {
+    writeStack(bucket_, index, shared);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeNumericLayer` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes the validity bitmap, the metadata of the blocks and the encoded
+  * words of a numeric layer as they are in memory
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the layer to the `buffer` field
+*/
+
+
+void Serializer::writeNumericLayer(const NumericLayer* layer) {
+  writeByte(static_cast<uint8_t>(layer->kind));
+  writeVarint(layer->size);
+
+  writeVarint(layer->validity.size());
+  writeBytes(layer->validity.data(), layer->validity.size() * sizeof(uint64_t));
+
+  writeVarint(layer->blocks.size());
+  for (const auto& block : layer->blocks) {
+    writeByte(static_cast<uint8_t>(block.encoding));
+    writeByte(block.bit_width);
+    writeVarint(block.count);
+    writeVarint(block.runs);
+    writeVarint(block.offset);
+    writeZigzag(block.base);
+    writeZigzag(block.reference);
+    writeZigzag(block.minimum);
+    writeZigzag(block.maximum);
+    writeBytes(&block.real_minimum, sizeof(double));
+    writeBytes(&block.real_maximum, sizeof(double));
+    writeByte(block.has_values);
+    writeByte(block.has_nan);
+  }
+
+  writeVarint(layer->data.size());
+  writeBytes(layer->data.data(), layer->data.size() * sizeof(uint64_t));
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeDictionary` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes the strings of a dictionary in the order of their codes
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the dictionary to the `buffer` field
+*/
+
+
+void Serializer::writeDictionary(const Dictionary* dictionary) {
+  writeVarint(dictionary->size());
+
+  for (size_t code = 0; code < dictionary->size(); code++) {
+    std::string_view string = dictionary->decode(static_cast<Dictionary::code_t>(code));
+    writeVarint(string.size());
+    writeBytes(string.data(), string.size());
+  }
+}
+
+
+/**
+  * @internal
+  * The `Serializer::writeCluster` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Writes the capacity of the cluster, the configuration of its terminal and
+  * all of its bucket slots, every bucket is length prefixed. The rows of the
+  * append buffer are flushed to a bucket first, then the lock of the cluster is
+  * held shared, so the queries keep running
+  *
+  * @return
+  * This function does not return anything, since it
+  * only writes the cluster to the `buffer` field
+*/
+
+
+void Serializer::writeCluster(Cluster* cluster_) {
+  cluster_->flushAppends();
+
+  auto lock = cluster_->lockBucketsShared();
+
+  writeVarint(cluster_->cluster_capacity);
+  writeVarint(cluster_->terminalCapacity());
+  writeByte(cluster_->automaticTerminal() ? 1 : 0);
+
+  if (cluster_->dictionary == nullptr) {
+    writeByte(0x00);
+  } else {
+    writeByte(0x01);
+    writeDictionary(cluster_->dictionary);
+  }
+
+  writeVarint(cluster_->cluster.size());
+
+  // The buckets removed by a transaction are written as empty slots, the
+  // versions are not part of the format
+  for (auto bucket_ : cluster_->cluster) {
+    if (bucket_ == nullptr || !bucket_->isLive()) {
+      writeByte(0x00);
+      continue;
+    }
+
+    writeByte(0x01);
+    size_t start = beginLengthPrefix();
+    writeBucket(bucket_, cluster_->dictionary);
+    endLengthPrefix(start);
+  }
+}
+
+
+/**
+  * @internal
+  * The `Serializer::beginWrite` and `Serializer::endWrite` methods are internal
+  * of the `Serializer` class
+  *
+  * @brief Description
+  * Rewinds the `buffer` field keeping its memory, and after the writing
+  * shrinks its size to the written bytes
+*/
+
+
+void Serializer::beginWrite() {
+  position = 0;
+  buffer.resize(buffer.capacity());
+}
+
+
+void Serializer::endWrite() {
+  buffer.resize(position);
+}
+
+
+/**
+  * @internal
+  * The `Serializer::serialize` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Serializes the whole brain, its clusters, buckets and astructs to the
+  * `buffer` field holding the structure lock shared
+  *
+  * @return
+  * This function does not return anything, the output is in the `buffer` field
+*/
+
+
+void Serializer::serialize(Brain* brain_) {
+  auto structure = brain_->lockStructureShared();
+
+  beginWrite();
+  writeMagic("NTVB");
+
+  writeVarint(brain_->brain_capacity);
+  writeVarint(brain_->brain.size());
+
+  for (auto cluster_ : brain_->brain) {
+    if (cluster_ == nullptr) {
+      writeByte(0x00);
+      continue;
+    }
+
+    writeByte(0x01);
+    size_t start = beginLengthPrefix();
+    writeCluster(cluster_);
+    endLengthPrefix(start);
+  }
+
+  endWrite();
+}
+
+
+/**
+  * @internal
+  * The `Serializer::serialize` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Serializes a single cluster, its buckets and astructs to the `buffer` field,
+  * useful for shipping a cluster to another process
+  *
+  * @return
+  * This function does not return anything, the output is in the `buffer` field
+*/
+
+
+void Serializer::serialize(Cluster* cluster_) {
+  beginWrite();
+  writeMagic("NTVC");
+  writeCluster(cluster_);
+  endWrite();
+}
+
+//////////////////////////////////
+// ////////// READING ////////////
+//////////////////////////////////
+
+
+/**
+  * @internal
+  * The `Serializer::readByte` method is internal of the `Serializer` class
+  *
+  * @return
+  * Returns false if there are no more bytes to read
+*/
+
+
+bool Serializer::readByte(uint8_t& value) {
+  if (cursor >= end) {
+    return false;
+  }
+  value = *cursor++;
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::readVarint` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Reads a LEB128 varint of up to 64 bits
+  *
+  * @return
+  * Returns false if the varint is truncated or longer than 10 bytes
+*/
+
+
+bool Serializer::readVarint(uint64_t& value) {
+  value = 0;
+
+  for (unsigned shift = 0; shift < 64; shift += 7) {
+    if (cursor >= end) {
+      return false;
+    }
+
+    uint8_t byte = *cursor++;
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+
+    if ((byte & 0x80) == 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::readZigzag` method is internal of the `Serializer` class
+  *
+  * @return
+  * Returns false if the varint is malformed
+*/
+
+
+bool Serializer::readZigzag(int64_t& value) {
+  uint64_t raw = 0;
+
+  if (!readVarint(raw)) {
+    return false;
+  }
+  value = static_cast<int64_t>((raw >> 1) ^ (~(raw & 1) + 1));
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::readBytes` method is internal of the `Serializer` class
+  *
+  * @return
+  * Returns false if there are less than `size` bytes to read
+*/
+
+
+bool Serializer::readBytes(void* data, size_t size) {
+  if (static_cast<size_t>(end - cursor) < size) {
+    return false;
+  }
+  if (size != 0) {
+    std::memcpy(data, cursor, size);
+  }
+  cursor += size;
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::readMagic` method is internal of the `Serializer` class
+  *
+  * @return
+  * Returns true if the input starts with `magic` and a supported version
+*/
+
+
+bool Serializer::readMagic(const char* magic) {
+  char     read_magic[4];
+  uint64_t version = 0;
+
+  return
+    readBytes(read_magic, 4) &&
+    std::memcmp(read_magic, magic, 4) == 0 &&
+    readVarint(version) &&
+    version == format_version;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::readAstruct` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Reads an astruct written by `Serializer::writeAstruct`
+  *
+  * @return
+  * Returns the new astruct or nullptr if it was an empty slot, throws
+  * if the input is malformed
+*/
+
+
+Astruct* Serializer::readAstruct(size_t depth) {
+  uint8_t tag = 0;
+
+  if (depth > MAX_ASTRUCT_DEPTH || !readByte(tag) || tag > 7) {
+    throw std::runtime_error("malformed astruct");
+  }
+
+  switch (tag) {
+    case 0:
+      return nullptr;
+    case 1 + static_cast<uint8_t>(Astruct::astruct_kind_t::null):
+      return new Astruct(nullptr);
+    case 1 + static_cast<uint8_t>(Astruct::astruct_kind_t::boolean): {
+      uint8_t boolean = 0;
+      if (!readByte(boolean)) {
+        break;
+      }
+      return new Astruct(boolean != 0);
+    }
+    case 1 + static_cast<uint8_t>(Astruct::astruct_kind_t::integer): {
+      int64_t integer = 0;
+      if (!readZigzag(integer)) {
+        break;
+      }
+      return new Astruct(integer);
+    }
+    case 1 + static_cast<uint8_t>(Astruct::astruct_kind_t::real): {
+      double real = 0;
+      if (!readBytes(&real, sizeof(real))) {
+        break;
+      }
+      return new Astruct(real);
+    }
+    case 1 + static_cast<uint8_t>(Astruct::astruct_kind_t::string): {
+      uint64_t size = 0;
+      if (!readVarint(size) || size > static_cast<uint64_t>(end - cursor)) {
+        break;
+      }
+      std::string string(reinterpret_cast<const char*>(cursor), size);
+      cursor += size;
+      return new Astruct(std::move(string));
+    }
+    case 1 + static_cast<uint8_t>(Astruct::astruct_kind_t::array): {
+      uint64_t size = 0;
+      if (!readVarint(size) || size > static_cast<uint64_t>(end - cursor)) {
+        break;
+      }
+
+      Astruct* array = new Astruct(Astruct::astruct_array_t());
+      auto&    children = std::get<Astruct::astruct_array_t>(array->astruct);
+      children.reserve(size);
+
+      try {
+        for (uint64_t index = 0; index < size; index++) {
+          children.push_back(readAstruct(depth + 1));
+        }
+      } catch (...) {
+        delete array;
+        throw;
+      }
+      return array;
+    }
+    case 1 + static_cast<uint8_t>(Astruct::astruct_kind_t::object): {
+      uint64_t size = 0;
+      if (!readVarint(size) || size > static_cast<uint64_t>(end - cursor)) {
+        break;
+      }
+
+      Astruct* object  = new Astruct(Astruct::astruct_object_t());
+      auto&    members = std::get<Astruct::astruct_object_t>(object->astruct);
+      members.reserve(size);
+
+      try {
+        for (uint64_t index = 0; index < size; index++) {
+          uint64_t key_size = 0;
+          if (!readVarint(key_size) || key_size > static_cast<uint64_t>(end - cursor)) {
+            throw std::runtime_error("malformed object key");
+          }
+
+          std::string key(reinterpret_cast<const char*>(cursor), key_size);
+          cursor += key_size;
+          members.emplace_back(std::move(key), nullptr);
+          members.back().second = readAstruct(depth + 1);
+        }
+      } catch (...) {
+        delete object;
+        throw;
+      }
+      return object;
+    }
+  }
+
+  throw std::runtime_error("truncated astruct");
+}
+
+
+/**
+  * @internal
+  * The `Serializer::readStack` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Reads a 3D vertical stack written by `Serializer::writeStack` into the stack
+  * `stack_index` of `bucket_`, which must have its stacks already
+  *
+  * @return
+  * This function does not return anything, throws if the input is malformed
+*/
+
+
+void Serializer::readStack(Bucket* bucket_, size_t stack_index, Dictionary* shared) {
+  const size_t STACKS   = bucket_->bucket.size();
+  uint8_t      encoding = 0;
+  uint64_t     height   = 0;
+
+  if (!readByte(encoding) || encoding > 3 || (encoding == 2 && shared == nullptr)) {
+    throw std::runtime_error("malformed stack encoding");
+  }
+
+  if (encoding == 0) {
+    if (!readVarint(height) || height > static_cast<uint64_t>(end - cursor)) {
+      throw std::runtime_error("malformed stack");
+    }
+
+    Bucket::stack_t& stack = bucket_->bucket[stack_index];
+    stack.reserve(height);
+    for (uint64_t index = 0; index < height; index++) {
+      stack.push_back(readAstruct(0));
+    }
+    return;
+  }
+
+  if (encoding == 3) {
+    NumericLayer* layer = new NumericLayer();
+
+    bucket_->numeric_layers.resize(STACKS, nullptr);
+    bucket_->numeric_layers[stack_index] = layer;
+
+    readNumericLayer(layer);
+    return;
+  }
+
+  DictionaryLayer* layer = new DictionaryLayer(encoding == 2 ? shared : nullptr);
+
+  bucket_->dictionary_layers.resize(STACKS, nullptr);
+  bucket_->dictionary_layers[stack_index] = layer;
+
+  if (encoding == 1) {
+    readDictionary(layer->dictionary);
+  }
+  if (!readVarint(height) || height > static_cast<uint64_t>(end - cursor)) {
+    throw std::runtime_error("malformed dictionary stack");
+  }
+
+  layer->codes.reserve(height);
+  for (uint64_t index = 0; index < height; index++) {
+    uint64_t code = 0;
+    if (!readVarint(code) || code > layer->dictionary->size() + 1) {
+      throw std::runtime_error("malformed dictionary code");
+    }
+    layer->codes.push_back(
+      code == 0 ? Dictionary::null_code :
+      code == 1 ? Dictionary::json_null_code :
+      static_cast<Dictionary::code_t>(code - 2)
+    );
+  }
+}
+
+
+/**
+  * @internal
+  * The `Serializer::readBucket` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Reads a bucket written by `Serializer::writeBucket`
+  *
+  * @return
+  * Returns the new bucket, throws if the input is malformed
+*/
+
+
+Bucket* Serializer::readBucket(Dictionary* shared) {
+  uint64_t capacity = 0;
+  uint8_t  sealed   = 0;
+  uint64_t sort_key = 0;
+  uint64_t stacks   = 0;
+
+  if (
+    !readVarint(capacity) ||
+    !readByte(sealed) ||
+    !readVarint(sort_key) ||
+    !readVarint(stacks) ||
+    sealed > 1 ||
+    sort_key > stacks ||
+    stacks > static_cast<uint64_t>(end - cursor)
+  ) {
+    throw std::runtime_error("malformed bucket");
+  }
+
+  Bucket* bucket_ = new Bucket();
+  bucket_->bucket_capacity = capacity;
+  bucket_->bucket.resize(stacks);
+
+  try {
+    for (size_t stack_index = 0; stack_index < stacks; stack_index++) {
+      readStack(bucket_, stack_index, shared);
+    }
+  } catch (...) {
+    delete bucket_;
+    throw;
+  }
+
+  if (sealed == 1) {
+    bucket_->sort_key = sort_key == 0 ? Bucket::no_key : sort_key - 1;
+    bucket_->sealed   = true;
+    bucket_->buildFilters();
+  }
+  return bucket_;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::readNumericLayer` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Reads a numeric layer written by `Serializer::writeNumericLayer` into `layer`,
+  * the blocks are checked so a malformed layer can not be decoded out of bounds
+  *
+  * @return
+  * This function does not return anything, throws if the input is malformed
+*/
+
+
+void Serializer::readNumericLayer(NumericLayer* layer) {
+  uint8_t  kind   = 0;
+  uint64_t size   = 0;
+  uint64_t words  = 0;
+  uint64_t blocks = 0;
+
+  if (
+    !readByte(kind) ||
+    kind > static_cast<uint8_t>(NumericLayer::numeric_kind_t::real) ||
+    !readVarint(size) ||
+    !readVarint(words) ||
+    words > static_cast<uint64_t>(end - cursor) / sizeof(uint64_t)
+  ) {
+    throw std::runtime_error("malformed numeric layer");
+  }
+
+  layer->kind = static_cast<NumericLayer::numeric_kind_t>(kind);
+  layer->size = size;
+  layer->validity.resize(words);
+  readBytes(layer->validity.data(), words * sizeof(uint64_t));
+
+  if (!readVarint(blocks) || blocks > static_cast<uint64_t>(end - cursor)) {
+    throw std::runtime_error("malformed numeric layer");
+  }
+
+  layer->blocks.resize(blocks);
+  for (auto& block : layer->blocks) {
+    uint8_t  encoding   = 0;
+    uint8_t  has_values = 0;
+    uint8_t  has_nan    = 0;
+    uint64_t count      = 0;
+    uint64_t runs       = 0;
+    uint64_t offset     = 0;
+
+    if (
+      !readByte(encoding) ||
+      !readByte(block.bit_width) ||
+      !readVarint(count) ||
+      !readVarint(runs) ||
+      !readVarint(offset) ||
+      !readZigzag(block.base) ||
+      !readZigzag(block.reference) ||
+      !readZigzag(block.minimum) ||
+      !readZigzag(block.maximum) ||
+      !readBytes(&block.real_minimum, sizeof(double)) ||
+      !readBytes(&block.real_maximum, sizeof(double)) ||
+      !readByte(has_values) ||
+      !readByte(has_nan) ||
+      count > NumericLayer::block_size ||
+      runs > NumericLayer::block_size
+    ) {
+      throw std::runtime_error("malformed numeric block");
+    }
+
+    block.encoding   = static_cast<NumericLayer::numeric_encoding_t>(encoding);
+    block.count      = static_cast<uint32_t>(count);
+    block.runs       = static_cast<uint32_t>(runs);
+    block.offset     = offset;
+    block.has_values = has_values != 0;
+    block.has_nan    = has_nan != 0;
+  }
+
+  if (
+    !readVarint(words) ||
+    words > static_cast<uint64_t>(end - cursor) / sizeof(uint64_t)
+  ) {
+    throw std::runtime_error("malformed numeric layer");
+  }
+
+  layer->data.resize(words);
+  readBytes(layer->data.data(), words * sizeof(uint64_t));
+
+  if (!layer->isWellFormed()) {
+    throw std::runtime_error("malformed numeric layer");
+  }
+}
+
+
+/**
+  * @internal
+  * The `Serializer::readDictionary` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Reads the strings written by `Serializer::writeDictionary` into `dictionary`,
+  * the strings must be distinct so they keep their codes
+  *
+  * @return
+  * This function does not return anything, throws if the input is malformed
+*/
+
+
+void Serializer::readDictionary(Dictionary* dictionary) {
+  uint64_t strings = 0;
+
+  if (!readVarint(strings) || strings > static_cast<uint64_t>(end - cursor)) {
+    throw std::runtime_error("malformed dictionary");
+  }
+
+  for (uint64_t code = 0; code < strings; code++) {
+    uint64_t size = 0;
+
+    if (!readVarint(size) || size > static_cast<uint64_t>(end - cursor)) {
+      throw std::runtime_error("malformed dictionary string");
+    }
+
+    std::string_view string(reinterpret_cast<const char*>(cursor), size);
+    cursor += size;
+
+    if (dictionary->encode(string) != code) {
+      throw std::runtime_error("duplicated dictionary string");
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `Serializer::readCluster` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Reads a cluster written by `Serializer::writeCluster`, every bucket must
+  * consume exactly the bytes of its length prefix
+  *
+  * @return
+  * Returns the new cluster, throws if the input is malformed
+*/
+
+
+Cluster* Serializer::readCluster() {
+  uint64_t capacity          = 0;
+  uint64_t terminal_capacity = 0;
+  uint8_t  automatic         = 0;
+  uint8_t  has_dictionary    = 0;
+  uint64_t slots             = 0;
+
+  if (
+    !readVarint(capacity) ||
+    !readVarint(terminal_capacity) ||
+    !readByte(automatic) ||
+    !readByte(has_dictionary) ||
+    has_dictionary > 1 ||
+    terminal_capacity > LeanCluster::max_terminal_capacity
+  ) {
+    throw std::runtime_error("malformed cluster");
+  }
+
+  Cluster* cluster_ = new Cluster();
+  cluster_->cluster_capacity = capacity;
+  cluster_->configureTerminal(terminal_capacity, automatic != 0);
+
+  try {
+    if (has_dictionary == 1) {
+      cluster_->dictionary = new Dictionary();
+      readDictionary(cluster_->dictionary);
+    }
+
+    if (!readVarint(slots) || slots > static_cast<uint64_t>(end - cursor)) {
+      throw std::runtime_error("malformed cluster slots");
+    }
+    cluster_->cluster.reserve(slots);
+
+    for (uint64_t index = 0; index < slots; index++) {
+      uint8_t  present = 0;
+      uint64_t length  = 0;
+
+      if (!readByte(present) || present > 1) {
+        throw std::runtime_error("malformed bucket slot");
+      }
+      if (present == 0) {
+        cluster_->cluster.push_back(nullptr);
+        continue;
+      }
+      if (!readVarint(length) || length > static_cast<uint64_t>(end - cursor)) {
+        throw std::runtime_error("malformed bucket length");
+      }
+
+      const uint8_t* section_end = cursor + length;
+      const uint8_t* outer_end   = end;
+
+      end = section_end;
+      cluster_->cluster.push_back(readBucket(cluster_->dictionary));
+      end = outer_end;
+
+      if (cursor != section_end) {
+        throw std::runtime_error("bucket length mismatch");
+      }
+    }
+  } catch (...) {
+    delete cluster_;
+    throw;
+  }
+
+  cluster_->rebuildBucketSlots();
+  return cluster_;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::beginRead` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Points the reader to the suggested input
+*/
+
+
+void Serializer::beginRead(const uint8_t* data, size_t size) {
+  cursor = data;
+  end    = data + size;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::deserializeBrain` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Reads a brain written by `Serializer::serialize(Brain*)`
+  *
+  * @return
+  * Returns a new `Brain*` owned by the caller, or nullptr if the input is
+  * malformed or truncated, in that case nothing is leaked
+*/
+
+
+Brain* Serializer::deserializeBrain(const uint8_t* data, size_t size) {
+  beginRead(data, size);
+
+  uint64_t capacity = 0;
+  uint64_t slots    = 0;
+
+  if (
+    !readMagic("NTVB") ||
+    !readVarint(capacity) ||
+    !readVarint(slots) ||
+    slots > static_cast<uint64_t>(end - cursor)
+  ) {
+    return nullptr;
+  }
+
+  Brain* brain_ = new Brain();
+  brain_->brain_capacity = capacity;
+  brain_->brain.reserve(slots);
+
+  try {
+    for (uint64_t index = 0; index < slots; index++) {
+      uint8_t  present = 0;
+      uint64_t length  = 0;
+
+      if (!readByte(present) || present > 1) {
+        throw std::runtime_error("malformed cluster slot");
+      }
+      if (present == 0) {
+        brain_->brain.push_back(nullptr);
+        continue;
+      }
+      if (!readVarint(length) || length > static_cast<uint64_t>(end - cursor)) {
+        throw std::runtime_error("malformed cluster length");
+      }
+
+      const uint8_t* section_end = cursor + length;
+
+      end = section_end;
+      brain_->brain.push_back(readCluster());
+      end = data + size;
+
+      if (cursor != section_end) {
+        throw std::runtime_error("cluster length mismatch");
+      }
+    }
+  } catch (...) {
+    delete brain_;
+    return nullptr;
+  }
+
+  brain_->rebuildClusterSlots();
+  return brain_;
+}
+
+
+/**
+  * @internal
+  * The `Serializer::deserializeCluster` method is internal of the `Serializer` class
+  *
+  * @brief Description
+  * Reads a cluster written by `Serializer::serialize(Cluster*)`
+  *
+  * @return
+  * Returns a new `Cluster*` owned by the caller, or nullptr if the input is
+  * malformed or truncated
+*/
+
+
+Cluster* Serializer::deserializeCluster(const uint8_t* data, size_t size) {
+  beginRead(data, size);
+
+  if (!readMagic("NTVC")) {
+    return nullptr;
+  }
+
+  try {
+    return readCluster();
+  } catch (...) {
+    return nullptr;
+  }
+}
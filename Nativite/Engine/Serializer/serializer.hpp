@@ -0,0 +1,137 @@
+/**
+  * @file serializer.hpp
+  * This is the documentation of the `serializer.hpp` file
+  *
+  * @brief Description
+  * Implementation of the Serializer class, a compact binary serializer and deserializer
+  * of the whole hierarchy Brain -> Cluster -> Bucket -> Astruct in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Nativite engine imports
+#include "../Brain/brain.hpp"
+#include "../Cluster/cluster.hpp"
+#include "../Bucket/bucket.hpp"
+#include "../Astruct/astruct.hpp"
+#include "../Dictionary/dictionary.hpp"
+#include "../Compression/compression.hpp"
+
+
+/**
+ * @internal
+ * The Serializer class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Writes brains and clusters to a compact binary format and reads them back,
+ * it is used for backups and for shipping clusters between processes
+ *
+ * @details
+ * The format is little endian, every integer is a LEB128 varint (signed integers
+ * are zigzag encoded) and every cluster and bucket is length prefixed, so a reader can
+ * skip them without decoding them. The layout is:
+ *
+ * <pre>
+ *   brain_file   := "NTVB" varint(version) brain
+ *   cluster_file := "NTVC" varint(version) cluster
+ *
+ *   brain    := varint(capacity) varint(slots) { 0x00 | 0x01 varint(length) cluster }
+ *   cluster  := varint(capacity) varint(terminal_capacity) byte(automatic_managment)
+ *               (0x00 | 0x01 dictionary) varint(slots) { 0x00 | 0x01 varint(length) bucket }
+ *   bucket   := varint(capacity) byte(sealed) varint(sort_key + 1) varint(stacks) { stack }
+ *   stack    := 0x00 varint(height) { astruct }
+ *             | 0x01 dictionary varint(height) { varint(code + 1) }
+ *             | 0x02 varint(height) { varint(code + 1) }
+ *             | 0x03 numeric
+ *   astruct  := byte(0x00 empty slot | 0x01 + kind) payload
+ *   dictionary := varint(strings) { varint(size) bytes }
+ *   numeric  := byte(kind) varint(size) varint(validity_words) { u64 }
+ *               varint(blocks) { block } varint(data_words) { u64 }
+ *   block    := byte(encoding) byte(bit_width) varint(count) varint(runs) varint(offset)
+ *               zigzag(base) zigzag(reference) zigzag(minimum) zigzag(maximum)
+ *               f64(real_minimum) f64(real_maximum) byte(has_values) byte(has_nan)
+ * </pre>
+ *
+ * A dictionary encoded stack either has its own dictionary (0x01) or uses the
+ * dictionary of its cluster (0x02), which is written once per cluster. A compressed
+ * numeric stack (0x03) is written as its blocks, so it is not decompressed.
+ *
+ * The terminals are caches, so only their configuration is written and they are
+ * filled again by the queries after a deserialization.
+*/
+
+
+class Serializer {
+  // Types
+  public:
+    // The type of the `buffer` field
+    using buffer_t = std::vector<uint8_t>;
+
+    // The version written after the magic bytes
+    static constexpr uint64_t format_version = 1;
+
+  protected:
+    // Writing functions, they write at `position` growing the `buffer` field
+    void reserveBytes(size_t size);
+
+    void writeByte(uint8_t value);
+    void writeVarint(uint64_t value);
+    void writeZigzag(int64_t value);
+    void writeBytes(const void* data, size_t size);
+    void writeMagic(const char* magic);
+
+    size_t beginLengthPrefix();
+    void endLengthPrefix(size_t start);
+
+    void writeAstruct(const Astruct* astruct);
+    void writeDictionary(const Dictionary* dictionary);
+    void writeNumericLayer(const NumericLayer* layer);
+    void writeStack(const Bucket* bucket_, size_t stack_index, const Dictionary* shared);
+    void writeBucket(const Bucket* bucket_, const Dictionary* shared);
+    void writeCluster(Cluster* cluster_);
+
+    void beginWrite();
+    void endWrite();
+
+    // Reading functions, they read from `cursor` and return false or nullptr
+    // if the input is malformed or truncated
+    bool readByte(uint8_t& value);
+    bool readVarint(uint64_t& value);
+    bool readZigzag(int64_t& value);
+    bool readBytes(void* data, size_t size);
+    bool readMagic(const char* magic);
+
+    Astruct* readAstruct(size_t depth);
+    void     readDictionary(Dictionary* dictionary);
+    void     readNumericLayer(NumericLayer* layer);
+    void     readStack(Bucket* bucket_, size_t stack_index, Dictionary* shared);
+    Bucket*  readBucket(Dictionary* shared);
+    Cluster* readCluster();
+
+    void beginRead(const uint8_t* data, size_t size);
+
+    size_t         position = 0;       /**< The write position in the `buffer` field */
+    const uint8_t* cursor   = nullptr; /**< The read position of the input */
+    const uint8_t* end      = nullptr; /**< The end of the input */
+
+  public:
+    buffer_t buffer; /**< The output of the last serialization, it is reused
+                          between serializations to avoid allocations */
+
+    void serialize(Brain* brain_);
+    void serialize(Cluster* cluster_);
+
+    Brain*   deserializeBrain(const uint8_t* data, size_t size);
+    Cluster* deserializeCluster(const uint8_t* data, size_t size);
+
+    Serializer() = default;
+};
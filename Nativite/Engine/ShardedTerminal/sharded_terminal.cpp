@@ -0,0 +1,410 @@
+/**
+  * @file sharded_terminal.cpp
+  * This is the documentation of the `sharded_terminal.cpp` file
+  *
+  * @brief Description
+  * Implementation of the ShardedTerminal class methods, the lock free lookups,
+  * the insertions and the evictions of every shard
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <bit>
+#include <functional>
+#include <thread>
+
+// Nativite engine imports
+#include "sharded_terminal.hpp"
+#include "../Astruct/astruct.hpp"
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::entry_t::~entry_t` method is internal of the `ShardedTerminal` class
+  *
+  * @brief Description
+  * The destructor of an entry, deletes its astruct
+*/
+
+
+ShardedTerminal::entry_t::~entry_t() noexcept {
+  delete value;
+  value = nullptr;
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::hashKey` method is internal of the `ShardedTerminal` class
+  *
+  * @brief Description
+  * Hashes `key` and mixes the bits, so the low bits that select the shard
+  * depend on the whole key
+  *
+  * @return
+  * Returns the hash of `key`
+*/
+
+
+uint64_t ShardedTerminal::hashKey(std::string_view key) {
+  uint64_t hash = std::hash<std::string_view>()(key);
+
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+
+  return hash;
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::shardOf` method is internal of the `ShardedTerminal` class
+  *
+  * @return
+  * Returns the shard of the keys with the hash `hash`
+*/
+
+
+ShardedTerminal::shard_t& ShardedTerminal::shardOf(uint64_t hash) const {
+  return shards[hash & (shard_count - 1)];
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::homeSlot` method is internal of the `ShardedTerminal` class
+  *
+  * @brief Description
+  * Maps the high 32 bits of `hash` to a slot with a multiply and a shift, the low
+  * bits already selected the shard
+  *
+  * @return
+  * Returns the first slot where the keys with the hash `hash` are probed
+*/
+
+
+size_t ShardedTerminal::homeSlot(uint64_t hash) const {
+  return static_cast<size_t>(((hash >> 32) * shard_capacity) >> 32);
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::probeLength` method is internal of the `ShardedTerminal` class
+  *
+  * @return
+  * Returns the number of slots probed for a key, `probe_limit` or the slots of a
+  * shard if they are less
+*/
+
+
+size_t ShardedTerminal::probeLength() const {
+  return std::min(probe_limit, shard_capacity);
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::lookup` method is internal of the `ShardedTerminal` class
+  *
+  * @brief Description
+  * Finds the entry of `key` without locks in the probe slots of its hash, the hash
+  * of a slot is only a hint and the entry is compared again after it is loaded. The recency of the slot is only
+  * written if the clock of the shard moved since the last hit. The caller holds an
+  * epoch guard while it reads the entry
+  *
+  * @return
+  * Returns the entry, or nullptr if `key` is not cached
+*/
+
+
+const ShardedTerminal::entry_t* ShardedTerminal::lookup(std::string_view key) const {
+  const uint64_t HASH  = hashKey(key);
+  shard_t&       shard = shardOf(HASH);
+  const uint32_t NOW   = shard.clock.load(std::memory_order_relaxed);
+  const size_t   PROBE = probeLength();
+  size_t         index = homeSlot(HASH);
+
+  for (size_t step = 0; step < PROBE; step++, index++) {
+    if (index == shard_capacity) {
+      index = 0;
+    }
+
+    slot_t& slot = shard.slots[index];
+
+    if (slot.hash.load(std::memory_order_relaxed) != HASH) {
+      continue;
+    }
+
+    const entry_t* entry = slot.entry.load(std::memory_order_acquire);
+
+    if (entry != nullptr && entry->hash == HASH && entry->key == key) {
+      if (slot.recency.load(std::memory_order_relaxed) != NOW) {
+        slot.recency.store(NOW, std::memory_order_relaxed);
+      }
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::contains` method is internal of the `ShardedTerminal` class
+  *
+  * @return
+  * Returns a boolean, true if `key` is cached
+*/
+
+
+bool ShardedTerminal::contains(std::string_view key) const {
+  EpochGuard guard;
+  return lookup(key) != nullptr;
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::insert` method is internal of the `ShardedTerminal` class
+  *
+  * @brief Description
+  * Caches `value` for `key`, the terminal takes its ownership. Among the probe slots
+  * of its hash, the slot of the same key is replaced, otherwise an empty slot is
+  * used, otherwise the least recently read slot is evicted. The replaced entry is retired, so the readers
+  * that hold it can finish
+  *
+  * @return
+  * This function does not return anything, since it
+  * only caches the astruct
+*/
+
+
+void ShardedTerminal::insert(std::string_view key, Astruct* value) {
+  const uint64_t HASH  = hashKey(key);
+  shard_t&       shard = shardOf(HASH);
+  entry_t*       entry = new entry_t{HASH, std::string(key), value};
+  entry_t*       old   = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const uint32_t NOW = shard.clock.fetch_add(1, std::memory_order_relaxed) + 1;
+
+    slot_t* same   = nullptr;
+    slot_t* empty  = nullptr;
+    slot_t* victim = nullptr;
+
+    const size_t PROBE = probeLength();
+    size_t       index = homeSlot(HASH);
+
+    for (size_t step = 0; step < PROBE; step++, index++) {
+      if (index == shard_capacity) {
+        index = 0;
+      }
+
+      slot_t&        slot    = shard.slots[index];
+      const entry_t* current = slot.entry.load(std::memory_order_relaxed);
+
+      if (current == nullptr) {
+        empty = empty == nullptr ? &slot : empty;
+        continue;
+      }
+
+      if (current->hash == HASH && current->key == key) {
+        same = &slot;
+        break;
+      }
+
+      // The ages are compared, so the clock can wrap around
+      if (
+        victim == nullptr ||
+        NOW - slot.recency.load(std::memory_order_relaxed) >
+        NOW - victim->recency.load(std::memory_order_relaxed)
+      ) {
+        victim = &slot;
+      }
+    }
+
+    slot_t* target = same != nullptr ? same : (empty != nullptr ? empty : victim);
+
+    old = target->entry.load(std::memory_order_relaxed);
+
+    target->hash.store(HASH, std::memory_order_relaxed);
+    target->recency.store(NOW, std::memory_order_relaxed);
+    target->entry.store(entry, std::memory_order_release);
+
+    if (old == nullptr) {
+      shard.count.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+
+  EpochManager::global().retire(old);
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::erase` method is internal of the `ShardedTerminal` class
+  *
+  * @brief Description
+  * Removes the astruct cached for `key`, its entry is retired
+  *
+  * @return
+  * Returns false if `key` was not cached
+*/
+
+
+bool ShardedTerminal::erase(std::string_view key) {
+  const uint64_t HASH  = hashKey(key);
+  shard_t&       shard = shardOf(HASH);
+  entry_t*       old   = nullptr;
+  {
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    const size_t PROBE = probeLength();
+    size_t       index = homeSlot(HASH);
+
+    for (size_t step = 0; step < PROBE; step++, index++) {
+      if (index == shard_capacity) {
+        index = 0;
+      }
+
+      slot_t&  slot    = shard.slots[index];
+      entry_t* current = slot.entry.load(std::memory_order_relaxed);
+
+      if (current != nullptr && current->hash == HASH && current->key == key) {
+        old = current;
+
+        slot.entry.store(nullptr, std::memory_order_release);
+        slot.hash.store(0, std::memory_order_relaxed);
+        shard.count.fetch_sub(1, std::memory_order_relaxed);
+        break;
+      }
+    }
+  }
+
+  if (old == nullptr) {
+    return false;
+  }
+
+  EpochManager::global().retire(old);
+  return true;
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::clear` method is internal of the `ShardedTerminal` class
+  *
+  * @brief Description
+  * Removes every cached astruct, one shard at a time
+  *
+  * @return
+  * This function does not return anything, since it
+  * only empties the shards
+*/
+
+
+void ShardedTerminal::clear() {
+  for (size_t shard_index = 0; shard_index < shard_count; shard_index++) {
+    shard_t&                    shard = shards[shard_index];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+
+    for (size_t index = 0; index < shard_capacity; index++) {
+      slot_t&  slot = shard.slots[index];
+      entry_t* old  = slot.entry.exchange(nullptr, std::memory_order_acq_rel);
+
+      slot.hash.store(0, std::memory_order_relaxed);
+      EpochManager::global().retire(old);
+    }
+    shard.count.store(0, std::memory_order_relaxed);
+  }
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::size` method is internal of the `ShardedTerminal` class
+  *
+  * @return
+  * Returns the number of cached astructs, it can be stale if there are writers
+*/
+
+
+size_t ShardedTerminal::size() const {
+  size_t total = 0;
+
+  for (size_t index = 0; index < shard_count; index++) {
+    total += shards[index].count.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::capacity` method is internal of the `ShardedTerminal` class
+  *
+  * @return
+  * Returns the number of slots of all the shards
+*/
+
+
+size_t ShardedTerminal::capacity() const {
+  return shard_count * shard_capacity;
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::ShardedTerminal` method is internal of the `ShardedTerminal` class
+  *
+  * @brief Description
+  * The constructor of the `ShardedTerminal` class, `capacity_v` slots are split
+  * between the shards. If `shard_count_v` is 0 there is one shard per hardware
+  * thread, the count is rounded up to a power of two
+*/
+
+
+ShardedTerminal::ShardedTerminal(size_t capacity_v, size_t shard_count_v) {
+  if (shard_count_v == 0) {
+    shard_count_v = std::max<size_t>(1, std::thread::hardware_concurrency());
+  }
+
+  shard_count    = std::bit_ceil(shard_count_v);
+  shard_capacity = std::max<size_t>(1, (capacity_v + shard_count - 1) / shard_count);
+
+  shards = new shard_t[shard_count];
+
+  for (size_t index = 0; index < shard_count; index++) {
+    shards[index].slots = new slot_t[shard_capacity];
+  }
+}
+
+
+/**
+  * @internal
+  * The `ShardedTerminal::~ShardedTerminal` method is internal of the `ShardedTerminal` class
+  *
+  * @brief Description
+  * The destructor of the `ShardedTerminal` class, no reader can be running, so
+  * the entries are deleted at once
+*/
+
+
+ShardedTerminal::~ShardedTerminal() noexcept {
+  for (size_t shard_index = 0; shard_index < shard_count; shard_index++) {
+    for (size_t index = 0; index < shard_capacity; index++) {
+      delete shards[shard_index].slots[index].entry.load(std::memory_order_relaxed);
+    }
+    delete[] shards[shard_index].slots;
+  }
+  delete[] shards;
+}
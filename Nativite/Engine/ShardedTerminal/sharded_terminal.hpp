@@ -0,0 +1,137 @@
+/**
+  * @file sharded_terminal.hpp
+  * This is the documentation of the `sharded_terminal.hpp` file
+  *
+  * @brief Description
+  * Implementation of the ShardedTerminal class, a terminal split in independent
+  * shards for the hot clusters read by many threads in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Nativite engine imports
+#include "../Epoch/epoch.hpp"
+
+// Forward reference to `Astruct`
+class Astruct;
+
+
+/**
+ * @internal
+ * The ShardedTerminal class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * The terminal or cache of a hot cluster, the astructs are cached by key and the
+ * key hash selects one of `shard_count` independent shards
+ *
+ * @details
+ * Every shard is alone in its cache lines, every shard has its own writer lock and
+ * the readers do not lock. A key lives in the `probe_limit` slots that follow its
+ * home slot, which is picked by the high bits of its hash, so a lookup reads a few
+ * adjacent slots instead of the whole shard. A slot holds an immutable entry with the key and the astruct, the
+ * writers publish a new entry and retire the replaced one to the global `EpochManager`,
+ * so a reader sees a whole entry or none, this is the versioned slot of the reader.
+ * The recency of a slot is the clock of its shard when it was last read, the readers
+ * only store it when the clock moved, so the hot slots are not written on every hit.
+ * A key whose probe slots are full evicts the least recently read of them, an
+ * approximate LRU.
+*/
+
+
+class ShardedTerminal {
+  // Types
+  public:
+    // An immutable cached astruct, it owns `value`
+    struct entry_t {
+      uint64_t    hash;
+      std::string key;
+      Astruct*    value;
+
+      ~entry_t() noexcept;
+    };
+
+    // A slot of a shard, `hash` is a hint, the entry is the truth. Two slots share
+    // a cache line, the readers only write `recency` when the clock of the shard moved
+    struct alignas(32) slot_t {
+      std::atomic<uint64_t> hash{0};
+      std::atomic<entry_t*> entry{nullptr};
+      std::atomic<uint32_t> recency{0};
+    };
+
+    // A shard, alone in its cache lines so the shards do not share them
+    struct alignas(64) shard_t {
+      std::mutex            mutex;      /**< Held by the writers of the shard */
+      std::atomic<uint32_t> clock{0};   /**< Moves on every insertion */
+      std::atomic<size_t>   count{0};   /**< The used slots */
+      slot_t*               slots = nullptr;
+    };
+
+  protected:
+    // Internal functions of the class
+    static uint64_t hashKey(std::string_view key);
+
+    shard_t& shardOf(uint64_t hash) const;
+    size_t   homeSlot(uint64_t hash) const;
+    size_t   probeLength() const;
+
+    const entry_t* lookup(std::string_view key) const;
+
+    shard_t* shards; /**< The shards, `shard_count` of them */
+
+  public:
+    size_t shard_count;    /**< The number of shards, a power of two */
+    size_t shard_capacity; /**< The slots of every shard */
+
+    static constexpr size_t probe_limit = 8; /**< The slots where a key can live, from its home slot */
+
+    /**
+      * @internal
+      * The `ShardedTerminal::find` method is internal of the `ShardedTerminal` class
+      *
+      * @brief Description
+      * Calls `function(astruct)` with the astruct cached for `key`, the astruct is
+      * alive until `function` returns, so it must be cloned to keep it
+      *
+      * @return
+      * Returns false if `key` is not cached
+    */
+    template <typename Function>
+    bool find(std::string_view key, Function&& function) const {
+      EpochGuard     guard;
+      const entry_t* entry = lookup(key);
+
+      if (entry == nullptr) {
+        return false;
+      }
+      function(static_cast<const Astruct*>(entry->value));
+      return true;
+    }
+
+    bool contains(std::string_view key) const;
+
+    void insert(std::string_view key, Astruct* value);
+    bool erase(std::string_view key);
+    void clear();
+
+    size_t size() const;
+    size_t capacity() const;
+
+    ShardedTerminal(size_t capacity_v, size_t shard_count_v = 0);
+
+    ShardedTerminal(const ShardedTerminal&)            = delete;
+    ShardedTerminal& operator=(const ShardedTerminal&) = delete;
+
+    ~ShardedTerminal() noexcept;
+};
@@ -12,10 +12,13 @@
 */
 
 // C++ libraries imports
-#include "terminal.hpp"
 #include <iostream>
 #include <vector>
 
+// Nativite engine imports
+#include "terminal.hpp"
+#include "../Astruct/astruct.hpp"
+
 
 /**
   * @internal
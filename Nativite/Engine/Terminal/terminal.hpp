@@ -14,6 +14,7 @@
 #pragma once
 
 // C++ libraries imports
+#include <cstddef>
 #include <vector>
 
 // Forward reference to Astruct
@@ -0,0 +1,519 @@
+/**
+  * @file top_k.cpp
+  * This is the documentation of the `top_k.cpp` file
+  *
+  * @brief Description
+  * Implementation of the TopK class methods, the bounded heaps of the clusters,
+  * the shared threshold and the merge of the partial results
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <limits>
+#include <thread>
+#include <utility>
+
+// Nativite engine imports
+#include "top_k.hpp"
+#include "../Compression/compression.hpp"
+
+
+/**
+  * @internal
+  * The `TopK::compareScores` method is internal of the `TopK` class
+  *
+  * @brief Description
+  * Compares two scores exactly, an integer and a real number are compared without
+  * rounding the integer to a double
+  *
+  * @return
+  * Returns a negative number if `left` is smaller, 0 if they are equal, else a
+  * positive number
+*/
+
+
+int TopK::compareScores(const score_t& left, const score_t& right) {
+  if (left.is_integer && right.is_integer) {
+    return (left.integer > right.integer) - (left.integer < right.integer);
+  }
+
+  if (!left.is_integer && !right.is_integer) {
+    return (left.real > right.real) - (left.real < right.real);
+  }
+
+  if (!left.is_integer) {
+    return -compareScores(right, left);
+  }
+
+  // 2^63, every int64_t is below it and every double below it and over -2^63
+  // has an integer part that fits an int64_t
+  constexpr double LIMIT = 9223372036854775808.0;
+
+  const double REAL = right.real;
+
+  if (REAL != REAL) {
+    return 0;
+  }
+  if (REAL >= LIMIT) {
+    return -1;
+  }
+  if (REAL < -LIMIT) {
+    return 1;
+  }
+
+  const double  FLOOR = std::floor(REAL);
+  const int64_t WHOLE = static_cast<int64_t>(FLOOR);
+
+  if (left.integer != WHOLE) {
+    return left.integer < WHOLE ? -1 : 1;
+  }
+  return REAL > FLOOR ? -1 : 0;
+}
+
+
+/**
+  * @internal
+  * The `TopK::isBetter` and `TopK::isBetterScore` methods are internal of the
+  * `TopK` class
+  *
+  * @return
+  * Returns a boolean, true if the score `left` ranks before the score `right`
+*/
+
+
+bool TopK::isBetter(double left, double right) const {
+  return descending ? left > right : left < right;
+}
+
+
+bool TopK::isBetterScore(const score_t& left, const score_t& right) const {
+  const int ORDER = compareScores(left, right);
+  return descending ? ORDER > 0 : ORDER < 0;
+}
+
+
+/**
+  * @internal
+  * The `TopK::isBetterEntry` method is internal of the `TopK` class
+  *
+  * @return
+  * Returns a boolean, true if the entry `left` ranks before the entry `right`,
+  * the ties are broken by the cluster index
+*/
+
+
+bool TopK::isBetterEntry(const entry_t& left, const entry_t& right) const {
+  const int ORDER = compareScores(left.score, right.score);
+
+  if (ORDER != 0) {
+    return descending ? ORDER > 0 : ORDER < 0;
+  }
+  return left.cluster_index < right.cluster_index;
+}
+
+
+/**
+  * @internal
+  * The `TopK::mayQualify` and `TopK::mayQualifyRange` methods are internal of the
+  * `TopK` class
+  *
+  * @return
+  * Returns a boolean, false if the score, or every score between `minimum` and
+  * `maximum`, is surely worse than the threshold
+*/
+
+
+bool TopK::mayQualify(double score) const {
+  const double THRESHOLD = threshold.load(std::memory_order_relaxed);
+  return descending ? score >= THRESHOLD : score <= THRESHOLD;
+}
+
+
+bool TopK::mayQualifyRange(double minimum, double maximum) const {
+  return mayQualify(descending ? maximum : minimum);
+}
+
+
+/**
+  * @internal
+  * The `TopK::raiseThreshold` method is internal of the `TopK` class
+  *
+  * @brief Description
+  * Moves the threshold to `score` if it is better, `score` is the worst score of a
+  * full heap, so the global top K can not be worse than it
+  *
+  * @return
+  * This function does not return anything, since it
+  * only moves the threshold
+*/
+
+
+void TopK::raiseThreshold(double score) {
+  double current = threshold.load(std::memory_order_relaxed);
+
+  while (isBetter(score, current) && !threshold.compare_exchange_weak(current, score, std::memory_order_relaxed)) {}
+}
+
+
+/**
+  * @internal
+  * The `TopK::offerRow` method is internal of the `TopK` class
+  *
+  * @brief Description
+  * Adds the row `row` with its score to the heap of a cluster, the row is only
+  * viewed if its score can still be in the top K and only copied if it matches the
+  * predicate, and a full heap replaces its worst row and raises the threshold. A
+  * LIMIT search takes the rows until `k` rows are taken by all the clusters
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the heap
+*/
+
+
+void TopK::offerRow(
+  const Bucket* bucket_,
+  size_t row,
+  score_t score,
+  size_t cluster_index,
+  std::vector<Cursor::block_cache_t>& caches,
+  Cursor::view_t& view,
+  std::vector<entry_t>& heap
+) {
+  const bool RANKED = score_stack != Bucket::no_key;
+
+  // The heap has its worst entry at the front
+  auto worse = [&](const entry_t& left, const entry_t& right) { return isBetterEntry(left, right); };
+
+  if (
+    RANKED &&
+    (!mayQualify(score.toDouble()) || (heap.size() >= k && !isBetterScore(score, heap.front().score)))
+  ) {
+    return;
+  }
+
+  Cursor::viewRow(bucket_, row, columns, caches, view);
+
+  if (
+    (predicate && !predicate(view)) ||
+    (!RANKED && taken_rows.fetch_add(1, std::memory_order_relaxed) >= k)
+  ) {
+    return;
+  }
+
+  entry_t entry{score, cluster_index, {}};
+  Cursor::copyRow(view, entry.row);
+
+  if (!RANKED) {
+    heap.push_back(std::move(entry));
+    return;
+  }
+
+  if (heap.size() >= k) {
+    std::pop_heap(heap.begin(), heap.end(), worse);
+
+    for (auto astruct : heap.back().row) {
+      delete astruct;
+    }
+    heap.pop_back();
+  }
+
+  heap.push_back(std::move(entry));
+  std::push_heap(heap.begin(), heap.end(), worse);
+
+  if (heap.size() >= k) {
+    raiseThreshold(heap.front().score.toDouble());
+  }
+}
+
+
+/**
+  * @internal
+  * The `TopK::searchBucket` method is internal of the `TopK` class
+  *
+  * @brief Description
+  * Offers the rows of a bucket to the heap of its cluster. A compressed score stack
+  * is skipped whole by the zone map of a sealed bucket and block by block by the
+  * statistics of the blocks, and a block is only decoded if it can beat the threshold
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills the heap
+*/
+
+
+void TopK::searchBucket(const Bucket* bucket_, size_t cluster_index, std::vector<entry_t>& heap) {
+  std::vector<Cursor::block_cache_t> caches;
+  Cursor::view_t                     view;
+
+  if (score_stack == Bucket::no_key) {
+    const size_t HEIGHT = bucket_->height();
+
+    for (size_t row = 0; row < HEIGHT && taken_rows.load(std::memory_order_relaxed) < k; row++) {
+      scanned_rows.fetch_add(1, std::memory_order_relaxed);
+      offerRow(bucket_, row, score_t(), cluster_index, caches, view, heap);
+    }
+    return;
+  }
+
+  if (score_stack >= bucket_->bucket.size() || bucket_->isDictionaryStack(score_stack)) {
+    return;
+  }
+
+  if (bucket_->isNumericStack(score_stack)) {
+    const NumericLayer* layer = bucket_->numeric_layers[score_stack];
+
+    if (bucket_->sealed && score_stack < bucket_->filters.size()) {
+      const Bucket::stack_filter_t& filter = bucket_->filters[score_stack];
+
+      if (!filter.has_values || !mayQualifyRange(filter.minimum, filter.maximum)) {
+        pruned_buckets.fetch_add(1, std::memory_order_relaxed);
+        return;
+      }
+    }
+
+    std::vector<int64_t> integers(NumericLayer::block_size);
+    std::vector<double>  reals(NumericLayer::block_size);
+
+    for (size_t block_index = 0; block_index < layer->blockCount(); block_index++) {
+      const NumericLayer::numeric_block_t& block = layer->blocks[block_index];
+
+      // The threshold can move while the block is read, so it is checked again per row
+      if (!block.has_values || !mayQualifyRange(block.real_minimum, block.real_maximum)) {
+        pruned_blocks.fetch_add(1, std::memory_order_relaxed);
+        continue;
+      }
+
+      const bool   INTEGER = layer->kind == NumericLayer::numeric_kind_t::integer;
+      const size_t COUNT   = INTEGER
+        ? layer->decodeBlock(block_index, integers.data())
+        : layer->decodeBlock(block_index, reals.data());
+      const size_t FIRST   = block_index * NumericLayer::block_size;
+
+      for (size_t offset = 0; offset < COUNT; offset++) {
+        if (!layer->isValid(FIRST + offset)) {
+          continue;
+        }
+
+        scanned_rows.fetch_add(1, std::memory_order_relaxed);
+        offerRow(
+          bucket_,
+          FIRST + offset,
+          INTEGER ? score_t{true, integers[offset], 0} : score_t{false, 0, reals[offset]},
+          cluster_index,
+          caches,
+          view,
+          heap
+        );
+      }
+    }
+    return;
+  }
+
+  const Bucket::stack_t& stack = bucket_->bucket[score_stack];
+
+  for (size_t row = 0; row < stack.size(); row++) {
+    const Astruct* astruct = stack[row];
+
+    if (astruct == nullptr) {
+      continue;
+    }
+
+    if (astruct->kind() == Astruct::astruct_kind_t::integer) {
+      scanned_rows.fetch_add(1, std::memory_order_relaxed);
+      offerRow(bucket_, row, score_t{true, std::get<int64_t>(astruct->astruct), 0}, cluster_index, caches, view, heap);
+    } else if (astruct->kind() == Astruct::astruct_kind_t::real) {
+      scanned_rows.fetch_add(1, std::memory_order_relaxed);
+      offerRow(bucket_, row, score_t{false, 0, std::get<double>(astruct->astruct)}, cluster_index, caches, view, heap);
+    }
+  }
+}
+
+
+/**
+  * @internal
+  * The `TopK::searchClusters` method is internal of the `TopK` class
+  *
+  * @brief Description
+  * The loop of a search thread, it takes the next cluster and searches it with
+  * its own heap holding the locks of the cluster shared, then it moves the heap
+  * to the partial results of the thread
+  *
+  * @return
+  * This function does not return anything, since it
+  * only fills `partial`
+*/
+
+
+void TopK::searchClusters(std::vector<entry_t>& partial) {
+  for (
+    size_t cluster_index = next_cluster.fetch_add(1, std::memory_order_relaxed);
+    cluster_index < cluster_count;
+    cluster_index = next_cluster.fetch_add(1, std::memory_order_relaxed)
+  ) {
+    if (score_stack == Bucket::no_key && taken_rows.load(std::memory_order_relaxed) >= k) {
+      break;
+    }
+
+    std::vector<entry_t> heap;
+
+    brain->readCluster(cluster_index, [&](Cluster* cluster_) {
+      cluster_->forEachBucket([&](const Bucket* bucket_) {
+        searchBucket(bucket_, cluster_index, heap);
+      });
+    });
+
+    std::move(heap.begin(), heap.end(), std::back_inserter(partial));
+  }
+}
+
+
+/**
+  * @internal
+  * The `TopK::deleteEntries` method is internal of the `TopK` class
+  *
+  * @brief Description
+  * Deletes the astructs of the rows of `entries` and empties it
+  *
+  * @return
+  * This function does not return anything, since it
+  * only empties `entries`
+*/
+
+
+void TopK::deleteEntries(std::vector<entry_t>& entries) {
+  for (auto& entry : entries) {
+    for (auto astruct : entry.row) {
+      delete astruct;
+    }
+  }
+  entries.clear();
+}
+
+
+/**
+  * @internal
+  * The `TopK::search` method is internal of the `TopK` class
+  *
+  * @brief Description
+  * Searches the clusters in parallel and merges the partial results of the clusters,
+  * at most `k` rows each, into the `results` field. The rows of the last search
+  * are deleted first
+  *
+  * @return
+  * Returns the `results` field, the best rows first
+*/
+
+
+std::vector<TopK::entry_t>& TopK::search() {
+  clear();
+
+  if (k == 0) {
+    return results;
+  }
+
+  {
+    auto structure = brain->lockStructureShared();
+    cluster_count  = brain->brain.size();
+  }
+
+  threshold.store(
+    descending ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity(),
+    std::memory_order_relaxed
+  );
+  taken_rows.store(0, std::memory_order_relaxed);
+  next_cluster.store(0, std::memory_order_relaxed);
+  scanned_rows.store(0, std::memory_order_relaxed);
+  pruned_blocks.store(0, std::memory_order_relaxed);
+  pruned_buckets.store(0, std::memory_order_relaxed);
+
+  const size_t THREADS = std::clamp<size_t>(
+    threads != 0 ? threads : std::thread::hardware_concurrency(),
+    1,
+    std::max<size_t>(1, cluster_count)
+  );
+
+  std::vector<std::vector<entry_t>> partials(THREADS);
+  std::vector<std::thread>          workers;
+
+  for (size_t index = 1; index < THREADS; index++) {
+    workers.emplace_back(&TopK::searchClusters, this, std::ref(partials[index]));
+  }
+  searchClusters(partials[0]);
+
+  for (auto& worker : workers) {
+    worker.join();
+  }
+
+  for (auto& partial : partials) {
+    std::move(partial.begin(), partial.end(), std::back_inserter(results));
+  }
+
+  std::sort(results.begin(), results.end(), [&](const entry_t& left, const entry_t& right) {
+    return isBetterEntry(left, right);
+  });
+
+  if (results.size() > k) {
+    std::vector<entry_t> rest(
+      std::make_move_iterator(results.begin() + k),
+      std::make_move_iterator(results.end())
+    );
+
+    results.resize(k);
+    deleteEntries(rest);
+  }
+  return results;
+}
+
+
+/**
+  * @internal
+  * The `TopK::clear` method is internal of the `TopK` class
+  *
+  * @brief Description
+  * Deletes the rows of the last search that were not moved out
+  *
+  * @return
+  * This function does not return anything, since it
+  * only empties the `results` field
+*/
+
+
+void TopK::clear() {
+  deleteEntries(results);
+}
+
+
+/**
+  * @internal
+  * The `TopK::TopK` method is internal of the `TopK` class
+  *
+  * @brief Description
+  * The constructor of the `TopK` class
+*/
+
+
+TopK::TopK(Brain* brain_v) : threshold(0) {
+  brain = brain_v;
+}
+
+
+/**
+  * @internal
+  * The `TopK::~TopK` method is internal of the `TopK` class
+  *
+  * @brief Description
+  * The destructor of the `TopK` class, it deletes the rows of the last search
+*/
+
+
+TopK::~TopK() noexcept {
+  clear();
+}
@@ -0,0 +1,130 @@
+/**
+  * @file top_k.hpp
+  * This is the documentation of the `top_k.hpp` file
+  *
+  * @brief Description
+  * Implementation of the TopK class, the top K and LIMIT searches pushed down
+  * into the scan of every cluster in C++
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Nativite engine imports
+#include "../Cursor/cursor.hpp"
+
+
+/**
+ * @internal
+ * The TopK class is internal and is not part of the public API.
+ *
+ * @brief Description
+ * Finds the `k` rows of a brain with the best score in the stack `score_stack`, or
+ * any `k` rows that match the predicate if there is no score stack, the LIMIT
+ *
+ * @details
+ * The clusters are searched in parallel and every search keeps its own bounded heap
+ * of `k` rows, so only `k` rows per cluster are copied and merged at the end. When a
+ * heap is full its worst score is a bound, the global top K can not be worse than it,
+ * so it raises the shared `threshold` and every search drops the rows, the compressed
+ * blocks and the buckets whose scores are surely worse than the threshold without
+ * copying or decoding them. A LIMIT search stops every cluster once `k` rows are taken.
+ *
+ * The rows are filtered by the predicate on a view of the bucket and only the rows that
+ * match it are copied. The rows without a number in the score stack are not ranked.
+ * The integer scores are compared exactly, the threshold is their nearest double, which
+ * keeps the order of the scores, so it never drops a row that is better. The ties
+ * between equal scores are broken by the cluster index.
+*/
+
+
+class TopK {
+  // Types
+  public:
+    using row_t       = Cursor::row_t;
+    using predicate_t = Cursor::predicate_t;
+
+    // The score of a row, an integer score is kept exact since a double only has
+    // 53 bits of mantissa
+    struct score_t {
+      bool    is_integer = false;
+      int64_t integer    = 0;
+      double  real       = 0;
+
+      double toDouble() const {
+        return is_integer ? static_cast<double>(integer) : real;
+      }
+    };
+
+    // A row of the result, it owns the astructs of its row
+    struct entry_t {
+      score_t score;
+      size_t  cluster_index = 0;
+      row_t   row;
+    };
+
+  protected:
+    // Internal functions of the class
+    static int compareScores(const score_t& left, const score_t& right);
+
+    bool isBetter(double left, double right) const;
+    bool isBetterScore(const score_t& left, const score_t& right) const;
+    bool isBetterEntry(const entry_t& left, const entry_t& right) const;
+    bool mayQualify(double score) const;
+    bool mayQualifyRange(double minimum, double maximum) const;
+    void raiseThreshold(double score);
+
+    void offerRow(
+      const Bucket* bucket_,
+      size_t row,
+      score_t score,
+      size_t cluster_index,
+      std::vector<Cursor::block_cache_t>& caches,
+      Cursor::view_t& view,
+      std::vector<entry_t>& heap
+    );
+
+    void searchBucket(const Bucket* bucket_, size_t cluster_index, std::vector<entry_t>& heap);
+    void searchClusters(std::vector<entry_t>& partial);
+
+    static void deleteEntries(std::vector<entry_t>& entries);
+
+    std::atomic<double> threshold;       /**< The worst score that can still be in the top K */
+    std::atomic<size_t> taken_rows{0};   /**< The rows taken by a LIMIT search */
+    std::atomic<size_t> next_cluster{0}; /**< The next cluster to search */
+    size_t              cluster_count = 0;
+
+  public:
+    Brain*              brain;                        /**< The searched brain */
+    size_t              k           = 10;             /**< The rows of the result */
+    size_t              score_stack = Bucket::no_key; /**< The stack of the scores, no_key for a LIMIT */
+    bool                descending  = true;           /**< If the best scores are the largest */
+    std::vector<size_t> columns;                      /**< The projected stacks, empty to read all of them */
+    predicate_t         predicate;                    /**< The filter of the rows, empty to keep all of them */
+    size_t              threads     = 0;              /**< The search threads, 0 is one per hardware thread */
+
+    std::vector<entry_t> results; /**< The rows of the last search, the best first */
+
+    std::atomic<size_t> scanned_rows{0};   /**< The rows whose score was read */
+    std::atomic<size_t> pruned_blocks{0};  /**< The compressed blocks skipped by the threshold */
+    std::atomic<size_t> pruned_buckets{0}; /**< The buckets skipped by the threshold */
+
+    std::vector<entry_t>& search();
+    void                  clear();
+
+    TopK(Brain* brain_v);
+
+    TopK(const TopK&)            = delete;
+    TopK& operator=(const TopK&) = delete;
+
+    ~TopK() noexcept;
+};
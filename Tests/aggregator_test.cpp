@@ -0,0 +1,247 @@
+/**
+  * @file aggregator_test.cpp
+  * This is the documentation of the `aggregator_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the Aggregator class, the aggregates of the plain stacks and of the
+  * layers, the groups of the dictionary stacks, the chunks skipped by the ranges
+  * and the typed group keys
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Aggregator/aggregator.hpp"
+
+
+using function_t = Aggregator::function_t;
+
+
+// The buckets have three group names and reals with empty slots
+static const test_columns_t columns{"g", 3, [](int64_t id, int64_t) -> Astruct* {
+  return id % 5 == 0 ? nullptr : new Astruct(id * 0.5);
+}};
+
+
+// A brain with a plain cluster, an empty slot and a cluster of sealed encoded buckets
+static Brain* makeBrain() {
+  Brain* brain = new Brain();
+
+  Cluster* plain = new Cluster();
+  plain->insertBucket(makeBucket(columns, 0, 1000));
+
+  Cluster* sealed = new Cluster();
+  sealed->insertBucket(makeBucket(columns, 1000, 1000));
+  sealed->insertBucket(makeBucket(columns, 2000, 1000));
+  sealed->encodeStringStacks();
+  sealed->cluster[0]->seal();
+  sealed->cluster[1]->seal();
+
+  brain->brain = {plain, nullptr, sealed};
+  brain->rebuildClusterSlots();
+  return brain;
+}
+
+
+// The aggregates of every row, the integers stay integers and the empty slots are skipped
+static void testTotals() {
+  Brain*     brain = makeBrain();
+  Aggregator aggregator(brain);
+
+  aggregator.threads    = 2;
+  aggregator.aggregates = {
+    {function_t::count},
+    {function_t::count, 2},
+    {function_t::sum, 0},
+    {function_t::minimum, 0},
+    {function_t::maximum, 0},
+    {function_t::average, 0},
+    {function_t::sum, 2},
+    {function_t::sum, 9}
+  };
+
+  auto& results = aggregator.compute();
+
+  CHECK(results.size() == 1);
+
+  if (results.size() == 1) {
+    const auto& row = results[0];
+
+    CHECK(row.size() == 8);
+    CHECK(std::get<int64_t>(row[0]->astruct) == 3000);
+    CHECK(std::get<int64_t>(row[1]->astruct) == 2400);
+    CHECK(std::get<int64_t>(row[2]->astruct) == 2999 * 3000 / 2);
+    CHECK(std::get<int64_t>(row[3]->astruct) == 0);
+    CHECK(std::get<int64_t>(row[4]->astruct) == 2999);
+    CHECK(std::get<double>(row[5]->astruct) == 1499.5);
+    CHECK(std::get<double>(row[6]->astruct) == 1800000.0);
+    CHECK(row[7]->kind() == Astruct::astruct_kind_t::null);
+  }
+
+  CHECK(aggregator.aggregated_rows.load() == 3000);
+
+  delete brain;
+}
+
+
+// The groups of a dictionary stack are the same in the plain and the sealed buckets
+static void testGroups() {
+  Brain*     brain = makeBrain();
+  Aggregator aggregator(brain);
+
+  aggregator.threads      = 3;
+  aggregator.radix_bits   = 2;
+  aggregator.group_stacks = {1};
+  aggregator.aggregates   = {{function_t::count}, {function_t::sum, 0}};
+
+  auto& results = aggregator.compute();
+
+  CHECK(results.size() == 3);
+
+  for (const auto& row : results) {
+    CHECK(row.size() == 3);
+
+    const std::string& name  = std::get<std::string>(row[0]->astruct);
+    const int64_t      GROUP = name.back() - '0';
+
+    CHECK(std::get<int64_t>(row[1]->astruct) == 1000);
+    CHECK(std::get<int64_t>(row[2]->astruct) == 1498500 + GROUP * 1000);
+  }
+
+  delete brain;
+}
+
+
+// The rows out of the ranges are not aggregated, the sealed buckets out of them are skipped
+static void testRanges() {
+  Brain*     brain = makeBrain();
+  Aggregator aggregator(brain);
+
+  aggregator.ranges     = {{0, 1500, 1599}, {2, 0, 10000}};
+  aggregator.aggregates = {{function_t::count}, {function_t::minimum, 0}, {function_t::maximum, 0}};
+
+  auto& results = aggregator.compute();
+
+  CHECK(results.size() == 1);
+
+  if (results.size() == 1) {
+    CHECK(std::get<int64_t>(results[0][0]->astruct) == 80);
+    CHECK(std::get<int64_t>(results[0][1]->astruct) == 1501);
+    CHECK(std::get<int64_t>(results[0][2]->astruct) == 1599);
+  }
+
+  CHECK(aggregator.aggregated_rows.load() == 80);
+  CHECK(aggregator.pruned_chunks.load() > 0);
+
+  delete brain;
+}
+
+
+// The integer 1 and the real 1.0 are different groups, the empty slots and the nulls
+// are the same group, and an overflowing integer sum is a real
+static void testTypedKeys() {
+  Brain*   brain    = new Brain();
+  Cluster* cluster_ = new Cluster();
+  Bucket*  bucket_  = new Bucket();
+
+  const int64_t LARGEST = std::numeric_limits<int64_t>::max();
+
+  bucket_->pushAstruct(0, new Astruct(int64_t{1}));
+  bucket_->pushAstruct(0, new Astruct(1.0));
+  bucket_->pushAstruct(0, nullptr);
+  bucket_->pushAstruct(0, new Astruct(nullptr));
+  bucket_->pushAstruct(0, new Astruct(int64_t{1}));
+
+  bucket_->pushAstruct(1, new Astruct(LARGEST));
+  bucket_->pushAstruct(1, new Astruct(int64_t{2}));
+  bucket_->pushAstruct(1, new Astruct(int64_t{3}));
+  bucket_->pushAstruct(1, new Astruct(int64_t{4}));
+  bucket_->pushAstruct(1, new Astruct(int64_t{1}));
+
+  cluster_->insertBucket(bucket_);
+  brain->insertCluster(cluster_);
+
+  Aggregator aggregator(brain);
+
+  aggregator.group_stacks = {0};
+  aggregator.aggregates   = {{function_t::count}, {function_t::sum, 1}};
+
+  auto& results = aggregator.compute();
+
+  CHECK(results.size() == 3);
+
+  for (const auto& row : results) {
+    switch (row[0]->kind()) {
+      case Astruct::astruct_kind_t::integer:
+        CHECK(std::get<int64_t>(row[1]->astruct) == 2);
+        CHECK(std::get<double>(row[2]->astruct) == static_cast<double>(LARGEST) + 1.0);
+        break;
+
+      case Astruct::astruct_kind_t::real:
+        CHECK(std::get<int64_t>(row[1]->astruct) == 1);
+        CHECK(std::get<int64_t>(row[2]->astruct) == 2);
+        break;
+
+      default:
+        CHECK(row[0]->kind() == Astruct::astruct_kind_t::null);
+        CHECK(std::get<int64_t>(row[1]->astruct) == 2);
+        CHECK(std::get<int64_t>(row[2]->astruct) == 7);
+        break;
+    }
+  }
+
+  delete brain;
+}
+
+
+// The zeros of both signs are one group
+static void testSignedZeros() {
+  Brain*   brain    = new Brain();
+  Cluster* cluster_ = new Cluster();
+  Bucket*  bucket_  = new Bucket();
+
+  bucket_->pushAstruct(0, new Astruct(0.0));
+  bucket_->pushAstruct(0, new Astruct(-0.0));
+  bucket_->pushAstruct(0, new Astruct(0.0));
+  bucket_->pushAstruct(0, new Astruct(-1.0));
+
+  cluster_->insertBucket(bucket_);
+  brain->insertCluster(cluster_);
+
+  Aggregator aggregator(brain);
+
+  aggregator.group_stacks = {0};
+  aggregator.aggregates   = {{function_t::count}};
+
+  auto& results = aggregator.compute();
+
+  CHECK(results.size() == 2);
+
+  for (const auto& row : results) {
+    const double VALUE = std::get<double>(row[0]->astruct);
+
+    CHECK(std::get<int64_t>(row[1]->astruct) == (VALUE == 0.0 ? 3 : 1));
+  }
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testTotals);
+  RUN_TEST(testGroups);
+  RUN_TEST(testRanges);
+  RUN_TEST(testTypedKeys);
+  RUN_TEST(testSignedZeros);
+
+  return finishTests();
+}
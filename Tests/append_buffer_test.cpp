@@ -0,0 +1,345 @@
+/**
+  * @file append_buffer_test.cpp
+  * This is the documentation of the `append_buffer_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the AppendBuffer class and the appends of a cluster, the published
+  * rows, the full and closed buffers, the reads of the rows that are not flushed,
+  * the flushes committed to the snapshots, the serialization and the destruction,
+  * and the producers that run with the readers
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/AppendBuffer/append_buffer.hpp"
+#include "../Nativite/Engine/Serializer/serializer.hpp"
+#include "../Nativite/Engine/Brain/brain.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+#include "../Nativite/Engine/Mvcc/mvcc.hpp"
+
+
+// Appends the row `{value, value * 2}` to the cluster
+static bool appendPair(Cluster* cluster_, int64_t value) {
+  Astruct* row[] = {new Astruct(value), new Astruct(value * 2)};
+
+  if (cluster_->appendRow(row)) {
+    return true;
+  }
+  delete row[0];
+  delete row[1];
+  return false;
+}
+
+
+// The rows of the live buckets of the cluster, the lock must be held
+static size_t bucketRows(const Cluster* cluster_) {
+  size_t rows = 0;
+
+  cluster_->forEachBucket([&](const Bucket* bucket_) {
+    rows += bucket_->height();
+  });
+  return rows;
+}
+
+
+// The rows of the buckets and the appended rows that are not flushed, the lock must be held
+static size_t visibleRows(const Cluster* cluster_) {
+  return bucketRows(cluster_) + cluster_->forEachAppendedRow([](size_t, Astruct* const*) {});
+}
+
+
+// The rows seen by a snapshot
+static size_t snapshotRows(const Snapshot& snapshot) {
+  size_t rows = 0;
+
+  snapshot.forEachBucket([&](size_t, const Bucket* bucket_) { rows += bucket_->height(); });
+  return rows;
+}
+
+
+// The published rows are read in order, a closed buffer refuses the rows and
+// becomes a bucket once
+static void testPublishedRows() {
+  AppendBuffer buffer(2);
+
+  for (int64_t value = 0; value < 10; value++) {
+    Astruct* row[] = {new Astruct(value), new Astruct(value * 2)};
+    CHECK(buffer.appendRow(row));
+  }
+
+  CHECK(buffer.size() == 10);
+  CHECK(std::get<int64_t>(buffer.at(3, 1)->astruct) == 6);
+
+  int64_t expected = 0;
+
+  buffer.forEachRow([&](size_t row, Astruct* const* values) {
+    CHECK(row == static_cast<size_t>(expected));
+    CHECK(std::get<int64_t>(values[0]->astruct) == expected);
+    expected++;
+  });
+  CHECK(expected == 10);
+
+  CHECK(buffer.close() == 10);
+  CHECK(buffer.isClosed());
+
+  Astruct* refused[] = {new Astruct(int64_t{99})};
+  CHECK(!buffer.appendRow(refused));
+  delete refused[0];
+
+  Bucket* bucket_ = buffer.toBucket();
+
+  CHECK(bucket_ != nullptr);
+  CHECK(bucket_->height() == 10);
+  CHECK(buffer.toBucket() == nullptr);
+
+  delete bucket_;
+}
+
+
+// A full buffer refuses the rows, the cluster flushes it and opens a new one
+static void testFullBuffer() {
+  AppendBuffer buffer(1, 4);
+
+  for (int64_t value = 0; value < 4; value++) {
+    Astruct* row[] = {new Astruct(value)};
+    CHECK(buffer.appendRow(row));
+  }
+
+  Astruct* row[] = {new Astruct(int64_t{4})};
+  CHECK(!buffer.appendRow(row));
+  delete row[0];
+
+  // The unmoved rows are deleted with the buffer
+  CHECK(buffer.size() == 4);
+
+  Cluster* cluster_ = new Cluster();
+  CHECK(!appendPair(cluster_, 0));
+
+  cluster_->enableAppends(2);
+
+  for (int64_t value = 0; value < 3 * 16 * 4096 / 2; value++) {
+    CHECK(appendPair(cluster_, value));
+  }
+
+  // The buffers that were full are already buckets
+  CHECK(cluster_->bucket_slots.used == 1);
+  CHECK(cluster_->flushAppends() == 3 * 16 * 4096 / 2 - 16 * 4096);
+  CHECK(cluster_->flushAppends() == 0);
+  CHECK(bucketRows(cluster_) == 3 * 16 * 4096 / 2);
+
+  delete cluster_;
+}
+
+
+// The reads of the brain see the published rows without flushing them
+static void testReadsSeeAppends() {
+  Brain*   brain    = new Brain();
+  Cluster* cluster_ = new Cluster();
+  size_t   index    = brain->insertCluster(cluster_);
+
+  cluster_->enableAppends(2);
+
+  for (int64_t value = 0; value < 100; value++) {
+    CHECK(appendPair(cluster_, value));
+  }
+
+  size_t rows = 0;
+
+  CHECK(brain->readCluster(index, [&](Cluster* read) {
+    rows = visibleRows(read);
+  }));
+  CHECK(rows == 100);
+  CHECK(cluster_->bucket_slots.used == 0);
+
+  for (int64_t value = 100; value < 150; value++) {
+    CHECK(appendPair(cluster_, value));
+  }
+
+  rows = 0;
+  brain->readClusters([&](Cluster* read) {
+    rows += visibleRows(read);
+  });
+  CHECK(rows == 150);
+  CHECK(cluster_->bucket_slots.used == 0);
+
+  // A writer flushes, the rows are seen once
+  CHECK(cluster_->flushAppends() == 150);
+
+  rows = 0;
+  brain->readClusters([&](Cluster* read) {
+    rows += visibleRows(read);
+  });
+  CHECK(rows == 150);
+  CHECK(cluster_->bucket_slots.used == 1);
+
+  delete brain;
+}
+
+
+// The serialization writes the rows that were not flushed, the destruction of
+// a cluster deletes them once
+static void testSerializeAndDestroy() {
+  Cluster* cluster_ = new Cluster();
+
+  cluster_->enableAppends(2);
+
+  for (int64_t value = 0; value < 20; value++) {
+    CHECK(appendPair(cluster_, value));
+  }
+
+  Serializer writer;
+  writer.serialize(cluster_);
+
+  Serializer reader;
+  Cluster*   copy = reader.deserializeCluster(writer.buffer.data(), writer.buffer.size());
+
+  CHECK(copy != nullptr);
+
+  if (copy != nullptr) {
+    CHECK(bucketRows(copy) == 20);
+  }
+
+  for (int64_t value = 20; value < 30; value++) {
+    CHECK(appendPair(cluster_, value));
+  }
+
+  // The leak checker finds the rows of the buffer if they are dropped
+  delete copy;
+  delete cluster_;
+}
+
+
+// The producers append and flush while a reader reads, every row is seen once
+static void testConcurrentAppends() {
+  constexpr int64_t PRODUCERS = 4;
+  constexpr int64_t ROWS      = 5000;
+
+  Brain*   brain    = new Brain();
+  Cluster* cluster_ = new Cluster();
+  size_t   index    = brain->insertCluster(cluster_);
+
+  cluster_->enableAppends(2);
+
+  std::atomic<bool>        done{false};
+  std::vector<std::thread> producers;
+
+  for (int64_t producer = 0; producer < PRODUCERS; producer++) {
+    producers.emplace_back([&, producer] {
+      for (int64_t value = 0; value < ROWS; value++) {
+        CHECK(appendPair(cluster_, producer * ROWS + value));
+
+        if (value % 1000 == 999) {
+          cluster_->flushAppends();
+        }
+      }
+    });
+  }
+
+  std::thread reader([&] {
+    size_t last = 0;
+
+    while (!done.load()) {
+      brain->readCluster(index, [&](Cluster* read) {
+        const size_t ROWS_READ = visibleRows(read);
+
+        CHECK(ROWS_READ >= last);
+        last = ROWS_READ;
+      });
+      std::this_thread::yield();
+    }
+  });
+
+  for (auto& producer : producers) {
+    producer.join();
+  }
+  done.store(true);
+  reader.join();
+
+  int64_t sum  = 0;
+  size_t  rows = 0;
+
+  brain->readCluster(index, [&](Cluster* read) {
+    read->forEachBucket([&](const Bucket* bucket_) {
+      rows += bucket_->height();
+
+      for (size_t row = 0; row < bucket_->height(); row++) {
+        sum += std::get<int64_t>(bucket_->bucket[0][row]->astruct);
+      }
+    });
+    read->forEachAppendedRow([&](size_t, Astruct* const* values) {
+      rows++;
+      sum += std::get<int64_t>(values[0]->astruct);
+    });
+  });
+
+  CHECK(rows == PRODUCERS * ROWS);
+  CHECK(sum == PRODUCERS * ROWS * (PRODUCERS * ROWS - 1) / 2);
+
+  delete brain;
+}
+
+
+// A flush of an attached cluster is a commit, the snapshots pinned before it
+// do not see its rows, and neither the reads nor the snapshots flush
+static void testSnapshotsDoNotSeeLaterAppends() {
+  Brain*   brain    = new Brain();
+  Cluster* cluster_ = new Cluster();
+  Mvcc     mvcc(brain);
+
+  brain->insertCluster(cluster_);
+  CHECK(mvcc.attachAppends() == 1);
+
+  cluster_->enableAppends(2);
+
+  for (int64_t value = 0; value < 10; value++) {
+    CHECK(appendPair(cluster_, value));
+  }
+  CHECK(cluster_->flushAppends() == 10);
+
+  {
+    Snapshot before(&mvcc);
+
+    CHECK(snapshotRows(before) == 10);
+
+    for (int64_t value = 10; value < 15; value++) {
+      CHECK(appendPair(cluster_, value));
+    }
+
+    size_t rows = 0;
+
+    brain->readCluster(0, [&](Cluster* read) { rows = visibleRows(read); });
+    CHECK(rows == 15);
+    CHECK(snapshotRows(before) == 10);
+
+    CHECK(cluster_->flushAppends() == 5);
+    CHECK(snapshotRows(before) == 10);
+
+    Snapshot after(&mvcc);
+    CHECK(snapshotRows(after) == 15);
+  }
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testPublishedRows);
+  RUN_TEST(testFullBuffer);
+  RUN_TEST(testReadsSeeAppends);
+  RUN_TEST(testSerializeAndDestroy);
+  RUN_TEST(testSnapshotsDoNotSeeLaterAppends);
+  RUN_TEST(testConcurrentAppends);
+
+  return finishTests();
+}
@@ -0,0 +1,254 @@
+/**
+  * @file arrow_exporter_test.cpp
+  * This is the documentation of the `arrow_exporter_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the ArrowExporter class, the arrays of the plain stacks, of the stacks
+  * of mixed kinds and of the dictionary and numeric layers, the buffers shared with
+  * the layers and the exports that outlive their cluster
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/ArrowExporter/arrow_exporter.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+#include "../Nativite/Engine/Dictionary/dictionary.hpp"
+#include "../Nativite/Engine/Compression/compression.hpp"
+
+
+// Checks the validity bit of the row `row` of an array
+static bool isValid(const ArrowArray* array, size_t row) {
+  const auto* validity = static_cast<const uint64_t*>(array->buffers[0]);
+  return validity == nullptr || ((validity[row >> 6] >> (row & 63)) & 1) != 0;
+}
+
+
+// The string of the row `row` of an Arrow string array
+static std::string stringAt(const ArrowArray* array, size_t row) {
+  const auto* offsets = static_cast<const int32_t*>(array->buffers[1]);
+  const auto* bytes   = static_cast<const char*>(array->buffers[2]);
+
+  return std::string(bytes + offsets[row], offsets[row + 1] - offsets[row]);
+}
+
+
+// A bucket with an integer, a real, a boolean, a string, a mixed and an empty stack
+static Bucket* makeBucket() {
+  Bucket* bucket_ = new Bucket();
+
+  for (int64_t row = 0; row < 5; row++) {
+    bucket_->pushAstruct(0, row == 2 ? nullptr : new Astruct(row * 10));
+    bucket_->pushAstruct(1, new Astruct(row + 0.5));
+    bucket_->pushAstruct(2, new Astruct(row % 2 == 0));
+    bucket_->pushAstruct(3, new Astruct("s" + std::to_string(row)));
+    bucket_->pushAstruct(5, nullptr);
+  }
+
+  bucket_->pushAstruct(4, new Astruct(int64_t{7}));
+  bucket_->pushAstruct(4, new Astruct("a \"quoted\"\n"));
+  bucket_->pushAstruct(4, new Astruct(Astruct::astruct_array_t{new Astruct(true), new Astruct(nullptr)}));
+  bucket_->pushAstruct(4, new Astruct(Astruct::astruct_object_t{{"k", new Astruct(1.5)}}));
+  bucket_->pushAstruct(4, new Astruct(nullptr));
+  return bucket_;
+}
+
+
+// The plain stacks are typed arrays, a stack of mixed kinds is the JSON text of its values
+static void testPlainStacks() {
+  Cluster*      cluster_ = new Cluster();
+  ArrowExporter exporter(cluster_);
+
+  cluster_->insertBucket(makeBucket());
+  exporter.names = {"id", "", "flag"};
+
+  ArrowArray  array;
+  ArrowSchema schema;
+
+  CHECK(exporter.exportBucket(0, &array, &schema));
+  CHECK(std::strcmp(schema.format, "+s") == 0);
+  CHECK(array.n_children == 6 && schema.n_children == 6);
+  CHECK(array.length == 5);
+
+  const ArrowArray* integers = array.children[0];
+  CHECK(std::strcmp(schema.children[0]->format, "l") == 0);
+  CHECK(std::strcmp(schema.children[0]->name, "id") == 0);
+  CHECK(std::strcmp(schema.children[1]->name, "1") == 0);
+  CHECK(integers->null_count == 1);
+  CHECK(!isValid(integers, 2));
+  CHECK(static_cast<const int64_t*>(integers->buffers[1])[4] == 40);
+
+  CHECK(std::strcmp(schema.children[1]->format, "g") == 0);
+  CHECK(static_cast<const double*>(array.children[1]->buffers[1])[3] == 3.5);
+
+  CHECK(std::strcmp(schema.children[2]->format, "b") == 0);
+  CHECK((static_cast<const uint64_t*>(array.children[2]->buffers[1])[0] & 0x1f) == 0x15);
+
+  CHECK(std::strcmp(schema.children[3]->format, "u") == 0);
+  CHECK(stringAt(array.children[3], 4) == "s4");
+
+  const ArrowArray* mixed = array.children[4];
+  CHECK(std::strcmp(schema.children[4]->format, "u") == 0);
+  CHECK(mixed->null_count == 1);
+  CHECK(stringAt(mixed, 0) == "7");
+  CHECK(stringAt(mixed, 1) == "\"a \\\"quoted\\\"\\u000a\"");
+  CHECK(stringAt(mixed, 2) == "[true,null]");
+  CHECK(stringAt(mixed, 3) == "{\"k\":1.5}");
+  CHECK(!isValid(mixed, 4));
+
+  CHECK(std::strcmp(schema.children[5]->format, "n") == 0);
+  CHECK(array.children[5]->null_count == 5);
+
+  array.release(&array);
+  schema.release(&schema);
+
+  CHECK(!exporter.exportBucket(1, &array, &schema));
+  CHECK(!exporter.exportStack(0, 6, &array, &schema));
+
+  delete cluster_;
+}
+
+
+// The layers of a sealed bucket are exported as dictionary and numeric arrays
+static void testLayers() {
+  Cluster*      cluster_ = new Cluster();
+  ArrowExporter exporter(cluster_);
+
+  cluster_->insertBucket(makeBucket());
+  cluster_->insertBucket(makeBucket());
+  cluster_->encodeStringStacks();
+  cluster_->cluster[1]->seal();
+
+  std::vector<ArrowArray>  arrays;
+  std::vector<ArrowSchema> schemas;
+
+  CHECK(exporter.exportCluster(arrays, schemas) == 2);
+
+  for (size_t index = 0; index < arrays.size(); index++) {
+    const ArrowSchema* strings = schemas[index].children[3];
+    const ArrowArray*  codes   = arrays[index].children[3];
+
+    CHECK(std::strcmp(strings->format, "I") == 0);
+    CHECK(strings->dictionary != nullptr && std::strcmp(strings->dictionary->format, "u") == 0);
+
+    for (size_t row = 0; row < 5; row++) {
+      const uint32_t CODE = static_cast<const uint32_t*>(codes->buffers[1])[row];
+      CHECK(stringAt(codes->dictionary, CODE) == "s" + std::to_string(row));
+    }
+  }
+
+  // The sealed bucket has a compressed integer layer with a null
+  const ArrowArray* integers = arrays[1].children[0];
+  CHECK(std::strcmp(schemas[1].children[0]->format, "l") == 0);
+  CHECK(integers->null_count == 1);
+  CHECK(static_cast<const int64_t*>(integers->buffers[1])[1] == 10);
+
+  for (size_t index = 0; index < arrays.size(); index++) {
+    arrays[index].release(&arrays[index]);
+    schemas[index].release(&schemas[index]);
+  }
+
+  delete cluster_;
+}
+
+
+// The codes, the strings and the validity bitmaps are shared with the layers, the
+// export keeps them when the layers grow
+static void testExportsShareBuffers() {
+  Cluster*      cluster_ = new Cluster();
+  ArrowExporter exporter(cluster_);
+
+  cluster_->insertBucket(makeBucket());
+  cluster_->insertBucket(makeBucket());
+  cluster_->encodeStringStacks();
+  cluster_->cluster[1]->seal();
+
+  Bucket*                bucket_    = cluster_->cluster[0];
+  const DictionaryLayer* layer      = bucket_->dictionary_layers[3];
+  const NumericLayer*    numeric    = cluster_->cluster[1]->numeric_layers[0];
+  ArrowArray             strings;
+  ArrowSchema            strings_schema;
+  ArrowArray             integers;
+  ArrowSchema            integers_schema;
+
+  CHECK(bucket_->isDictionaryStack(3));
+  CHECK(exporter.exportStack(0, 3, &strings, &strings_schema));
+  CHECK(exporter.exportStack(1, 0, &integers, &integers_schema));
+
+  CHECK(strings.buffers[1] == layer->codes.data());
+  CHECK(strings.dictionary->buffers[1] == layer->dictionary->offsets.data());
+  CHECK(strings.dictionary->buffers[2] == layer->dictionary->bytes.data());
+  CHECK(integers.buffers[0] == numeric->validity.data());
+
+  // The codes and the strings are reallocated, the export keeps the old buffers
+  const void* CODES = layer->codes.data();
+
+  for (int64_t row = 0; row < 1000; row++) {
+    bucket_->pushAstruct(3, new Astruct("n" + std::to_string(row)));
+  }
+  CHECK(layer->codes.data() != CODES);
+  CHECK(strings.buffers[1] == CODES);
+
+  for (size_t row = 0; row < 5; row++) {
+    const uint32_t CODE = static_cast<const uint32_t*>(strings.buffers[1])[row];
+    CHECK(stringAt(strings.dictionary, CODE) == "s" + std::to_string(row));
+  }
+  CHECK(layer->dictionary->decode(layer->codes[1004]) == "n999");
+
+  delete cluster_;
+
+  CHECK(integers.null_count == 1);
+  CHECK(!isValid(&integers, 2) && isValid(&integers, 3));
+
+  strings.release(&strings);
+  strings_schema.release(&strings_schema);
+  integers.release(&integers);
+  integers_schema.release(&integers_schema);
+}
+
+
+// An export holds its memory, the cluster and its dictionary can be deleted first
+static void testExportOutlivesCluster() {
+  Cluster*      cluster_ = new Cluster();
+  ArrowExporter exporter(cluster_);
+
+  cluster_->insertBucket(makeBucket());
+  cluster_->encodeStringStacks();
+  cluster_->cluster[0]->seal();
+
+  ArrowArray  array;
+  ArrowSchema schema;
+
+  CHECK(exporter.exportStack(0, 3, &array, &schema));
+
+  delete cluster_;
+  EpochManager::global().collect();
+  EpochManager::global().collect();
+
+  const uint32_t CODE = static_cast<const uint32_t*>(array.buffers[1])[2];
+  CHECK(stringAt(array.dictionary, CODE) == "s2");
+
+  array.release(&array);
+  schema.release(&schema);
+  CHECK(array.release == nullptr);
+}
+
+
+int main() {
+  RUN_TEST(testPlainStacks);
+  RUN_TEST(testLayers);
+  RUN_TEST(testExportsShareBuffers);
+  RUN_TEST(testExportOutlivesCluster);
+
+  return finishTests();
+}
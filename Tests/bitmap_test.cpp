@@ -0,0 +1,125 @@
+/**
+  * @file bitmap_test.cpp
+  * This is the documentation of the `bitmap_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the SlotBitmap class and of the reuse and compaction of the empty
+  * slots of brains and clusters
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Bitmap/bitmap.hpp"
+#include "../Nativite/Engine/Brain/brain.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+
+
+// The slots are set, reset and found free across the words
+static void testSlots() {
+  SlotBitmap bitmap;
+  bitmap.resize(200);
+
+  bitmap.setRange(0, 130);
+  CHECK(bitmap.used == 130);
+  CHECK(bitmap.findFirstFree() == 130);
+
+  bitmap.reset(70);
+  CHECK(!bitmap.test(70));
+  CHECK(bitmap.findFirstFree() == 70);
+
+  bitmap.set(70);
+  bitmap.set(130);
+  CHECK(bitmap.findFirstFree() == 131);
+
+  std::vector<size_t> used;
+  bitmap.forEachUsed([&](size_t slot) { used.push_back(slot); });
+  CHECK(used.size() == 131);
+  CHECK(used.back() == 130);
+
+  bitmap.setRange(0, 200);
+  CHECK(bitmap.used == 200);
+  CHECK(bitmap.findFirstFree() == 200);
+}
+
+
+// The bitmap of a vector written directly is rebuilt from its slots
+static void testRebuild() {
+  int               value = 0;
+  std::vector<int*> slots = {&value, nullptr, nullptr, &value};
+  SlotBitmap        bitmap;
+
+  bitmap.rebuild(slots);
+  CHECK(bitmap.size == 4);
+  CHECK(bitmap.used == 2);
+  CHECK(bitmap.findFirstFree() == 1);
+}
+
+
+// A removed cluster leaves a hole that the next insertion reuses
+static void testBrainHoles() {
+  Brain*   brain  = new Brain();
+  Cluster* first  = new Cluster();
+  Cluster* second = new Cluster();
+  Cluster* third  = new Cluster();
+
+  brain->insertCluster(first);
+  const size_t SLOT = brain->insertCluster(second);
+  brain->insertCluster(third);
+
+  CHECK(brain->removeCluster(SLOT) == second);
+  CHECK(brain->brain[SLOT] == nullptr);
+  CHECK(brain->insertCluster(second) == SLOT);
+
+  brain->removeCluster(0);
+  delete first;
+
+  const size_t SIZE = brain->brain.size();
+  CHECK(brain->compactClusters() == SIZE - 2);
+  CHECK(brain->brain.size() == 2);
+  CHECK(brain->brain[0] == second);
+  CHECK(brain->brain[1] == third);
+  CHECK(brain->cluster_slots.used == 2);
+
+  delete brain;
+}
+
+
+// A removed bucket leaves a hole that the next insertion reuses
+static void testClusterHoles() {
+  Cluster* cluster = new Cluster();
+  Bucket*  first   = new Bucket();
+  Bucket*  second  = new Bucket();
+
+  cluster->insertBucket(first);
+  cluster->insertBucket(second);
+
+  CHECK(cluster->removeBucket(0) == first);
+  CHECK(cluster->insertBucket(first) == 0);
+
+  delete cluster->removeBucket(0);
+  cluster->compactBuckets();
+
+  CHECK(cluster->cluster.size() == 1);
+  CHECK(cluster->cluster[0] == second);
+  CHECK(cluster->bucket_slots.used == 1);
+
+  delete cluster;
+}
+
+
+int main() {
+  RUN_TEST(testSlots);
+  RUN_TEST(testRebuild);
+  RUN_TEST(testBrainHoles);
+  RUN_TEST(testClusterHoles);
+
+  return finishTests();
+}
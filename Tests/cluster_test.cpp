@@ -0,0 +1,140 @@
+/**
+  * @file cluster_test.cpp
+  * This is the documentation of the `cluster_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the Cluster class, its constructors, its destructor and the ownership
+  * of its buckets, the moving and the span constructors and appends of brains
+  * and clusters
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <span>
+#include <utility>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Brain/brain.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+
+
+// A bucket with a single stack of `rows` integers
+static Bucket* makeBucket(int64_t rows) {
+  Bucket* bucket = new Bucket();
+
+  for (int64_t row = 0; row < rows; row++) {
+    bucket->pushAstruct(0, new Astruct(row));
+  }
+  return bucket;
+}
+
+
+// A cluster built from a nullptr vector is deleted once, it is not in its own brain part
+static void testDeleteEmptyCluster() {
+  Cluster* cluster = new Cluster(nullptr, 0);
+
+  CHECK(cluster->cluster.size() == 15);
+  CHECK(cluster->bucket_slots.used == 0);
+
+  delete cluster;
+}
+
+
+// A cluster built from a vector of buckets owns and deletes them once
+static void testDeleteClusterWithBuckets() {
+  Cluster::cluster_t buckets = {makeBucket(3), nullptr, makeBucket(5)};
+  Cluster*           cluster = new Cluster(&buckets, 0);
+
+  CHECK(cluster->bucket_slots.used == 2);
+  CHECK(cluster->cluster[0]->height() == 3);
+  CHECK(cluster->cluster[1]->height() == 5);
+
+  delete cluster;
+}
+
+
+// A cluster in a brain is deleted by the brain only
+static void testDeleteClusterInBrain() {
+  Brain* brain = new Brain();
+
+  brain->insertCluster(new Cluster(nullptr, 0));
+  brain->insertCluster(new Cluster());
+
+  CHECK(brain->cluster_slots.used == 2);
+
+  delete brain;
+}
+
+
+// A moved vector gives its storage to the cluster, the empty slots are dropped
+static void testMoveConstructor() {
+  Cluster::cluster_t buckets = {makeBucket(1), nullptr, makeBucket(2), nullptr, makeBucket(3)};
+  Bucket*            first   = buckets[0];
+  Cluster*           cluster = new Cluster(std::move(buckets));
+
+  CHECK(cluster->cluster.size() == 3);
+  CHECK(cluster->cluster[0] == first);
+  CHECK(cluster->bucket_slots.used == 3);
+  CHECK(cluster->cluster_capacity >= 3);
+
+  delete cluster;
+}
+
+
+// A span is copied without its empty slots, the cluster owns the buckets
+static void testSpanConstructor() {
+  Bucket*  buckets[] = {nullptr, makeBucket(4), makeBucket(5)};
+  Cluster* cluster   = new Cluster(std::span<Bucket* const>(buckets));
+
+  CHECK(cluster->cluster.size() == 2);
+  CHECK(cluster->cluster[1] == buckets[2]);
+  CHECK(cluster->bucket_slots.used == 2);
+
+  delete cluster;
+}
+
+
+// The appends keep the buckets and the clusters in order after the existing ones
+static void testAppend() {
+  Cluster* cluster = new Cluster();
+  cluster->insertBucket(makeBucket(1));
+
+  cluster->append(Cluster::cluster_t{makeBucket(2), nullptr});
+
+  Bucket* more[] = {makeBucket(3), nullptr, makeBucket(4)};
+  cluster->append(std::span<Bucket* const>(more));
+
+  CHECK(cluster->bucket_slots.used == 4);
+  CHECK(cluster->cluster.back() == more[2]);
+  CHECK(cluster->cluster[1]->height() == 2);
+
+  Brain* brain = new Brain(Brain::brain_t{cluster, nullptr});
+  brain->append(Brain::brain_t{new Cluster()});
+
+  Cluster* clusters[] = {new Cluster(), nullptr};
+  brain->append(std::span<Cluster* const>(clusters));
+
+  CHECK(brain->cluster_slots.used == 3);
+  CHECK(brain->brain[0] == cluster);
+  CHECK(brain->brain.back() == clusters[0]);
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testDeleteEmptyCluster);
+  RUN_TEST(testDeleteClusterWithBuckets);
+  RUN_TEST(testDeleteClusterInBrain);
+  RUN_TEST(testMoveConstructor);
+  RUN_TEST(testSpanConstructor);
+  RUN_TEST(testAppend);
+
+  return finishTests();
+}
@@ -0,0 +1,253 @@
+/**
+  * @file columnar_file_test.cpp
+  * This is the documentation of the `columnar_file_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the ColumnarFile class, the round trip of a brain, the projected
+  * stacks, the row groups skipped by the ranges, the appended rows and the
+  * rejection of malformed files
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/ColumnarFile/columnar_file.hpp"
+#include "../Nativite/Engine/Brain/brain.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+
+
+// The buckets have integers, three strings and reals with empty slots
+static const test_columns_t columns{"v", 3, [](int64_t, int64_t row) -> Astruct* {
+  return row % 4 == 0 ? nullptr : new Astruct(row * 0.25);
+}};
+
+
+// A brain with an empty slot, a plain cluster and a sealed cluster with a shared dictionary
+static Brain* makeBrain() {
+  Brain* brain = new Brain();
+
+  Cluster* plain = new Cluster();
+  plain->insertBucket(makeBucket(columns, 0, 30));
+  plain->insertBucket(makeBucket(columns, 100, 30));
+
+  Cluster* sealed = new Cluster();
+  sealed->insertBucket(makeBucket(columns, 1000, 30));
+  sealed->insertBucket(makeBucket(columns, 2000, 30));
+  sealed->encodeStringStacks();
+  sealed->cluster[0]->seal(0);
+
+  brain->brain = {plain, nullptr, sealed};
+  brain->rebuildClusterSlots();
+  return brain;
+}
+
+
+// The stack `stack_index` of every bucket of the cluster of the slot `index`, decoded
+static std::vector<const Astruct*> stackValues(Brain* brain, size_t index, size_t stack_index, std::vector<Bucket*>& copies) {
+  std::vector<const Astruct*> values;
+
+  brain->readCluster(index, [&](Cluster* cluster_) {
+    cluster_->forEachBucket([&](const Bucket* bucket_) {
+      Bucket* copy = bucket_->clone();
+
+      if (stack_index >= copy->stackCount()) {
+        copies.push_back(copy);
+        return;
+      }
+      if (copy->isDictionaryStack(stack_index)) {
+        copy->decodeDictionaryStack(stack_index);
+      }
+      if (copy->isNumericStack(stack_index)) {
+        copy->decompressNumericStack(stack_index);
+      }
+
+      values.insert(values.end(), copy->bucket[stack_index].begin(), copy->bucket[stack_index].end());
+      copies.push_back(copy);
+    });
+  });
+  return values;
+}
+
+
+// Checks that a stack of the copy has the same values as the original
+static bool sameStack(Brain* brain, Brain* copy, size_t index, size_t stack_index) {
+  std::vector<Bucket*> copies;
+
+  const auto LEFT  = stackValues(brain, index, stack_index, copies);
+  const auto RIGHT = stackValues(copy, index, stack_index, copies);
+  bool       same  = LEFT.size() == RIGHT.size();
+
+  for (size_t row = 0; same && row < LEFT.size(); row++) {
+    same = (LEFT[row] == nullptr) == (RIGHT[row] == nullptr) &&
+           (LEFT[row] == nullptr || LEFT[row]->astruct == RIGHT[row]->astruct);
+  }
+
+  for (Bucket* bucket_ : copies) {
+    delete bucket_;
+  }
+  return same;
+}
+
+
+// A brain is loaded back with its slots, its buckets and its shared dictionary
+static void testRoundTrip() {
+  Brain*       brain = makeBrain();
+  ColumnarFile writer;
+
+  writer.write(brain);
+
+  CHECK(writer.clusters.size() == 3);
+  CHECK(writer.clusters[0].row_groups.size() == 2);
+  CHECK(!writer.clusters[1].present);
+  CHECK(writer.clusters[2].dictionary_length > 0);
+  CHECK(writer.clusters[0].row_groups[1].columns[0].minimum == 100);
+  CHECK(writer.clusters[0].row_groups[1].columns[0].maximum == 129);
+  CHECK(writer.clusters[0].row_groups[0].columns[2].nulls == 8);
+
+  ColumnarFile reader;
+  Brain*       copy = reader.load(writer.buffer.data(), writer.buffer.size());
+
+  CHECK(copy != nullptr);
+
+  if (copy != nullptr) {
+    CHECK(copy->brain.size() == 3);
+    CHECK(copy->brain[1] == nullptr);
+    CHECK(reader.loaded_row_groups == 4);
+    CHECK(copy->brain[2]->dictionary != nullptr);
+    CHECK(copy->brain[2]->cluster[0]->sealed);
+
+    for (size_t index : {size_t{0}, size_t{2}}) {
+      for (size_t stack_index = 0; stack_index < 3; stack_index++) {
+        CHECK(sameStack(brain, copy, index, stack_index));
+      }
+    }
+  }
+
+  delete copy;
+  delete brain;
+}
+
+
+// A load reads only the projected stacks and skips the row groups out of its ranges
+static void testProjectionAndRanges() {
+  Brain*       brain = makeBrain();
+  ColumnarFile writer;
+
+  writer.write(brain);
+
+  ColumnarFile reader;
+
+  reader.columns = {0};
+  reader.ranges  = {{0, 90, 1005}};
+
+  Brain* copy = reader.load(writer.buffer.data(), writer.buffer.size());
+
+  CHECK(copy != nullptr);
+
+  if (copy != nullptr) {
+    CHECK(reader.loaded_row_groups == 2);
+    CHECK(reader.skipped_row_groups == 2);
+
+    std::vector<Bucket*> copies;
+    int64_t              sum = 0;
+
+    for (size_t index : {size_t{0}, size_t{2}}) {
+      for (const Astruct* astruct : stackValues(copy, index, 0, copies)) {
+        sum += std::get<int64_t>(astruct->astruct);
+      }
+
+      // The other stacks are loaded empty so the indexes do not move
+      CHECK(stackValues(copy, index, 1, copies).empty());
+    }
+    CHECK(sum == (100 + 129) * 30 / 2 + (1000 + 1029) * 30 / 2);
+
+    for (Bucket* bucket_ : copies) {
+      delete bucket_;
+    }
+  }
+
+  delete copy;
+  delete brain;
+}
+
+
+// The rows of an append buffer are written with the buckets
+static void testAppendedRows() {
+  Brain*   brain    = new Brain();
+  Cluster* cluster_ = new Cluster();
+
+  brain->insertCluster(cluster_);
+  cluster_->enableAppends(1);
+
+  for (int64_t value = 0; value < 10; value++) {
+    Astruct* row[] = {new Astruct(value)};
+    CHECK(cluster_->appendRow(row));
+  }
+
+  const std::string PATH = "columnar_file_test.ntvp";
+  ColumnarFile      writer;
+
+  CHECK(writer.writeFile(brain, PATH));
+
+  ColumnarFile reader;
+  Brain*       copy = reader.loadFile(PATH);
+
+  CHECK(copy != nullptr);
+  CHECK(reader.loadFile("columnar_file_test.missing") == nullptr);
+
+  if (copy != nullptr) {
+    std::vector<Bucket*> copies;
+    CHECK(stackValues(copy, 0, 0, copies).size() == 10);
+
+    for (Bucket* bucket_ : copies) {
+      delete bucket_;
+    }
+  }
+
+  std::remove(PATH.c_str());
+  delete copy;
+  delete brain;
+}
+
+
+// Every truncation and a wrong magic are rejected without leaking
+static void testMalformed() {
+  Brain*       brain = makeBrain();
+  ColumnarFile writer;
+
+  writer.write(brain);
+
+  ColumnarFile reader;
+
+  for (size_t size = 0; size < writer.buffer.size(); size += 5) {
+    Brain* copy = reader.load(writer.buffer.data(), size);
+    CHECK(copy == nullptr);
+    delete copy;
+  }
+
+  std::vector<uint8_t> wrong = writer.buffer;
+  wrong.back() = 'X';
+  CHECK(reader.load(wrong.data(), wrong.size()) == nullptr);
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testRoundTrip);
+  RUN_TEST(testProjectionAndRanges);
+  RUN_TEST(testAppendedRows);
+  RUN_TEST(testMalformed);
+
+  return finishTests();
+}
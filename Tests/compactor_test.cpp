@@ -0,0 +1,146 @@
+/**
+  * @file compactor_test.cpp
+  * This is the documentation of the `compactor_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the sealed buckets and of the Compactor class, the order of the sealed
+  * rows, the filters and the merge of the small buckets of a cluster
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cmath>
+#include <limits>
+#include <string>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Compactor/compactor.hpp"
+
+
+// The value of a real astruct, or NaN
+static double realOf(const Astruct* astruct) {
+  return std::get<double>(astruct->astruct);
+}
+
+
+// The rows are sorted by the key with the NaN keys after every number and the
+// empty slots last, the other stacks follow their rows
+static void testSealOrder() {
+  const double NOT_A_NUMBER = std::numeric_limits<double>::quiet_NaN();
+  const double KEYS[]       = {3, NOT_A_NUMBER, -1, 7, NOT_A_NUMBER, 0.5, -20, NOT_A_NUMBER, 2};
+
+  Bucket* bucket = new Bucket();
+
+  for (size_t row = 0; row < 200; row++) {
+    const double KEY = KEYS[row % 9];
+
+    bucket->pushAstruct(0, row % 50 == 0 ? nullptr : new Astruct(KEY));
+    bucket->pushAstruct(1, new Astruct(static_cast<int64_t>(row)));
+  }
+
+  bucket->seal(0);
+  CHECK(bucket->sealed);
+  CHECK(bucket->sort_key == 0);
+
+  bucket->unseal();
+
+  const auto& keys   = bucket->bucket[0];
+  const auto& rows   = bucket->bucket[1];
+  bool        sorted = keys.size() == 200 && rows.size() == 200;
+  size_t      state  = 0; // 0 numbers, 1 NaN, 2 empty slots
+
+  for (size_t row = 0; sorted && row < keys.size(); row++) {
+    const size_t ROW_STATE = keys[row] == nullptr ? 2 : std::isnan(realOf(keys[row])) ? 1 : 0;
+
+    sorted = ROW_STATE >= state;
+    if (sorted && ROW_STATE == 0 && state == 0 && row > 0) {
+      sorted = realOf(keys[row - 1]) <= realOf(keys[row]);
+    }
+    state = ROW_STATE;
+
+    // The rows move with their keys
+    const size_t ORIGINAL = static_cast<size_t>(std::get<int64_t>(rows[row]->astruct));
+    if (keys[row] == nullptr) {
+      sorted = sorted && ORIGINAL % 50 == 0;
+    } else if (ROW_STATE == 0) {
+      sorted = sorted && KEYS[ORIGINAL % 9] == realOf(keys[row]);
+    }
+  }
+  CHECK(sorted);
+  CHECK(state == 2);
+
+  delete bucket;
+}
+
+
+// A sealed bucket is pruned by its filters
+static void testSealFilters() {
+  Bucket* bucket = new Bucket();
+
+  for (int64_t row = 0; row < 100; row++) {
+    bucket->pushAstruct(0, new Astruct(row + 1000));
+    bucket->pushAstruct(1, new Astruct("name" + std::to_string(row % 3)));
+  }
+  bucket->seal();
+
+  CHECK(bucket->isNumericStack(0));
+  CHECK(bucket->isDictionaryStack(1));
+  CHECK(bucket->mayContainRange(0, 1050, 1060));
+  CHECK(!bucket->mayContainRange(0, 0, 999));
+  CHECK(bucket->mayContain(1, "name2"));
+  CHECK(!bucket->mayContain(1, "name3"));
+
+  delete bucket;
+}
+
+
+// The full buckets are sealed and the small sealed buckets merged
+static void testCompactCluster() {
+  Brain*   brain   = new Brain();
+  Cluster* cluster = new Cluster();
+
+  for (int bucket_index = 0; bucket_index < 4; bucket_index++) {
+    Bucket* bucket = new Bucket();
+
+    for (int64_t row = 0; row < 30; row++) {
+      bucket->pushAstruct(0, new Astruct(row * 4 + bucket_index));
+    }
+    bucket->seal(0);
+    cluster->insertBucket(bucket);
+  }
+  brain->insertCluster(cluster);
+
+  Compactor compactor(brain);
+  compactor.seal_height  = 20;
+  compactor.merge_height = 100;
+  compactor.key_stack    = 0;
+
+  compactor.compactBrain();
+
+  size_t buckets = 0;
+  size_t rows    = 0;
+
+  cluster->forEachBucket([&](const Bucket* bucket_) {
+    buckets++;
+    rows += bucket_->height();
+    CHECK(bucket_->sealed);
+  });
+
+  CHECK(buckets < 4);
+  CHECK(rows == 120);
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testSealOrder);
+  RUN_TEST(testSealFilters);
+  RUN_TEST(testCompactCluster);
+
+  return finishTests();
+}
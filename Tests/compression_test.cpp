@@ -0,0 +1,213 @@
+/**
+  * @file compression_test.cpp
+  * This is the documentation of the `compression_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the NumericLayer class, the round trip of every encoding, the nulls
+  * and the statistics of the blocks
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Compression/compression.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+
+
+// Compresses `values` and checks that every block decodes to them
+static void checkIntegers(const std::vector<int64_t>& values) {
+  NumericLayer layer;
+  layer.compress(values.data(), values.size(), nullptr);
+
+  CHECK(layer.isWellFormed());
+  CHECK(layer.size == values.size());
+
+  int64_t block[NumericLayer::block_size];
+  bool    same = true;
+
+  for (size_t index = 0; index < layer.blockCount(); index++) {
+    const size_t COUNT = layer.decodeBlock(index, block);
+
+    for (size_t row = 0; row < COUNT; row++) {
+      same = same && block[row] == values[index * NumericLayer::block_size + row];
+    }
+  }
+  CHECK(same);
+}
+
+
+// Every integer encoding gives back the same values, with the encoding it is chosen for
+static void testIntegerEncodings() {
+  std::vector<int64_t> sorted;
+  std::vector<int64_t> runs;
+  std::vector<int64_t> narrow;
+  std::vector<int64_t> random;
+  std::mt19937_64      generator(7);
+
+  for (int64_t row = 0; row < 5000; row++) {
+    sorted.push_back(1000000 + row * 3);
+    runs.push_back(row / 700);
+    narrow.push_back(500 + static_cast<int64_t>(generator() % 16));
+    random.push_back(static_cast<int64_t>(generator()));
+  }
+  random[10] = std::numeric_limits<int64_t>::min();
+  random[11] = std::numeric_limits<int64_t>::max();
+
+  checkIntegers(sorted);
+  checkIntegers(runs);
+  checkIntegers(narrow);
+  checkIntegers(random);
+
+  NumericLayer layer;
+  layer.compress(runs.data(), runs.size(), nullptr);
+  CHECK(layer.blocks[0].encoding == NumericLayer::numeric_encoding_t::run_length);
+  CHECK(layer.memoryUsage() < runs.size() * sizeof(int64_t));
+}
+
+
+// A block that is not full is refused unless it is the last one, the rows of the
+// other blocks would be looked for in the wrong block
+static void testShortBlocks() {
+  std::vector<int64_t> values;
+  std::mt19937_64      generator(11);
+
+  for (int64_t row = 0; row < 3000; row++) {
+    values.push_back(static_cast<int64_t>(generator()));
+  }
+
+  NumericLayer layer;
+  layer.compress(values.data(), values.size(), nullptr);
+
+  CHECK(layer.isWellFormed());
+  CHECK(layer.blocks.back().count == 3000 - 2 * NumericLayer::block_size);
+
+  // The same number of rows, the first block is short and the last one longer
+  layer.blocks[0].count  -= 24;
+  layer.blocks[2].count  += 24;
+  layer.blocks[1].offset -= 24;
+  layer.blocks[2].offset -= 24;
+
+  CHECK(!layer.isWellFormed());
+}
+
+
+// The reals are given back bit by bit, with their statistics and their NaNs
+static void testReals() {
+  std::vector<double> values;
+
+  for (int row = 0; row < 3000; row++) {
+    values.push_back(20.5 + (row % 10) * 0.25);
+  }
+  values[5] = -0.0;
+  values[6] = std::numeric_limits<double>::infinity();
+
+  NumericLayer layer;
+  layer.compress(values.data(), values.size(), nullptr);
+
+  CHECK(layer.isWellFormed());
+  CHECK(layer.kind == NumericLayer::numeric_kind_t::real);
+
+  double block[NumericLayer::block_size];
+  bool   same = true;
+
+  for (size_t index = 0; index < layer.blockCount(); index++) {
+    const size_t COUNT = layer.decodeBlock(index, block);
+
+    for (size_t row = 0; row < COUNT; row++) {
+      const double VALUE = values[index * NumericLayer::block_size + row];
+      same = same && std::memcmp(&block[row], &VALUE, sizeof(double)) == 0;
+    }
+  }
+  CHECK(same);
+  CHECK(layer.blocks[0].real_maximum == std::numeric_limits<double>::infinity());
+  CHECK(layer.blocks[1].real_minimum == 20.5);
+  CHECK(!layer.blocks[0].has_nan);
+
+  // A NaN is kept out of the statistics and marks its block
+  values[1500] = std::numeric_limits<double>::quiet_NaN();
+
+  NumericLayer nan_layer;
+  nan_layer.compress(values.data(), values.size(), nullptr);
+
+  CHECK(nan_layer.blocks[1].has_nan);
+  CHECK(nan_layer.blocks[1].real_minimum == 20.5);
+  CHECK(nan_layer.blocks[1].real_maximum == 22.75);
+}
+
+
+// The rows without a value are kept out of the statistics
+static void testNulls() {
+  std::vector<int64_t>  values(2000, 0);
+  std::vector<uint64_t> validity((values.size() + 63) / 64, 0);
+
+  for (size_t row = 0; row < values.size(); row++) {
+    if (row % 3 != 0) {
+      values[row] = static_cast<int64_t>(row);
+      validity[row >> 6] |= uint64_t(1) << (row & 63);
+    }
+  }
+  values[0] = -99999;
+
+  NumericLayer layer;
+  layer.compress(values.data(), values.size(), validity.data());
+
+  CHECK(layer.isWellFormed());
+  CHECK(!layer.isValid(0));
+  CHECK(layer.isValid(1));
+  CHECK(!layer.isValid(1998));
+  CHECK(layer.blocks[0].minimum == 1);
+  CHECK(layer.blocks[0].has_values);
+}
+
+
+// A bucket stack is compressed and decompressed to the same astructs
+static void testBucketStack() {
+  Bucket* bucket = new Bucket();
+
+  for (int64_t row = 0; row < 1500; row++) {
+    bucket->pushAstruct(0, row % 100 == 0 ? nullptr : new Astruct(row * 2));
+  }
+
+  CHECK(bucket->compressNumericStack(0));
+  CHECK(bucket->isNumericStack(0));
+  CHECK(bucket->stackHeight(0) == 1500);
+
+  bucket->decompressNumericStack(0);
+
+  const auto& stack = bucket->bucket[0];
+  bool        same  = stack.size() == 1500;
+
+  for (size_t row = 0; same && row < stack.size(); row++) {
+    same = row % 100 == 0
+      ? stack[row] == nullptr
+      : stack[row] != nullptr && std::get<int64_t>(stack[row]->astruct) == static_cast<int64_t>(row * 2);
+  }
+  CHECK(same);
+
+  // A stack with strings is not compressed
+  bucket->pushAstruct(1, new Astruct("text"));
+  CHECK(!bucket->compressNumericStack(1));
+
+  delete bucket;
+}
+
+
+int main() {
+  RUN_TEST(testIntegerEncodings);
+  RUN_TEST(testShortBlocks);
+  RUN_TEST(testReals);
+  RUN_TEST(testNulls);
+  RUN_TEST(testBucketStack);
+
+  return finishTests();
+}
@@ -0,0 +1,204 @@
+/**
+  * @file csv_importer_test.cpp
+  * This is the documentation of the `csv_importer_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the CsvImporter class, the inferred types, the quoted fields split by
+  * the chunks of the threads, the ragged records and the buckets whose values do
+  * not fit the inferred type of a column
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/CsvImporter/csv_importer.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+
+
+// Calls `function(stacks)` for every row of every bucket of the cluster, the layers
+// are decoded to astructs first
+static void forEachRow(Cluster* cluster_, const std::function<void(const std::vector<const Astruct*>&)>& function) {
+  cluster_->forEachBucket([&](const Bucket* bucket_) {
+    Bucket* copy = bucket_->clone();
+
+    for (size_t index = 0; index < copy->stackCount(); index++) {
+      if (copy->isDictionaryStack(index)) {
+        copy->decodeDictionaryStack(index);
+      }
+      if (copy->isNumericStack(index)) {
+        copy->decompressNumericStack(index);
+      }
+    }
+
+    for (size_t row = 0; row < copy->height(); row++) {
+      std::vector<const Astruct*> stacks;
+
+      for (size_t index = 0; index < copy->stackCount(); index++) {
+        stacks.push_back(row < copy->bucket[index].size() ? copy->bucket[index][row] : nullptr);
+      }
+      function(stacks);
+    }
+    delete copy;
+  });
+}
+
+
+// An empty field is an empty slot or a null astruct
+static bool isNull(const Astruct* astruct) {
+  return astruct == nullptr || astruct->kind() == Astruct::astruct_kind_t::null;
+}
+
+
+// The types are inferred and every record is imported into sealed typed layers
+static void testImportTypes() {
+  Cluster*    cluster_ = new Cluster();
+  CsvImporter importer(cluster_);
+
+  importer.threads     = 4;
+  importer.bucket_rows = 256;
+
+  std::string input = "\xEF\xBB\xBFid,price,active,name\n";
+
+  for (int64_t id = 0; id < 2000; id++) {
+    input += std::to_string(id) + "," + std::to_string(id) + ".5," + (id % 2 == 0 ? "true" : "false") + ",";
+
+    // The quoted names have delimiters, newlines and escaped quotes
+    input += id % 7 == 0
+      ? "\"name, " + std::to_string(id % 10) + "\nsecond \"\"line\"\"\"\n"
+      : "plain" + std::to_string(id % 10) + "\n";
+  }
+
+  CHECK(importer.import(input) == 2000);
+  CHECK(importer.names == std::vector<std::string>({"id", "price", "active", "name"}));
+  CHECK(importer.types.size() == 4);
+  CHECK(importer.types[0] == CsvImporter::column_type_t::integer);
+  CHECK(importer.types[1] == CsvImporter::column_type_t::real);
+  CHECK(importer.types[2] == CsvImporter::column_type_t::boolean);
+  CHECK(importer.types[3] == CsvImporter::column_type_t::string);
+  CHECK(importer.ragged_rows.load() == 0);
+  CHECK(importer.buckets.load() == cluster_->bucket_slots.used);
+
+  size_t  rows   = 0;
+  int64_t ids    = 0;
+  double  prices = 0;
+  size_t  quoted = 0;
+
+  forEachRow(cluster_, [&](const std::vector<const Astruct*>& stacks) {
+    const int64_t ID = std::get<int64_t>(stacks[0]->astruct);
+
+    rows++;
+    ids    += ID;
+    prices += std::get<double>(stacks[1]->astruct);
+
+    CHECK(std::get<bool>(stacks[2]->astruct) == (ID % 2 == 0));
+
+    const std::string& name = std::get<std::string>(stacks[3]->astruct);
+
+    if (ID % 7 == 0) {
+      CHECK(name == "name, " + std::to_string(ID % 10) + "\nsecond \"line\"");
+      quoted++;
+    } else {
+      CHECK(name == "plain" + std::to_string(ID % 10));
+    }
+  });
+
+  CHECK(rows == 2000);
+  CHECK(ids == 2000 * 1999 / 2);
+  CHECK(prices == 2000 * 1999 / 2 + 1000.0);
+  CHECK(quoted == 286);
+
+  delete cluster_;
+}
+
+
+// The ragged records are padded or cut, the empty fields are nulls and a bucket with
+// a value that does not fit the sampled type keeps the nearest type
+static void testRaggedAndWider() {
+  Cluster*    cluster_ = new Cluster();
+  CsvImporter importer(cluster_);
+
+  importer.threads     = 1;
+  importer.sample_rows = 3;
+  importer.delimiter   = '\t';
+  importer.has_header  = false;
+
+  const std::string INPUT = "1\ta\n2\tb\n3\tc\n4.25\td\t extra\n5\n\n\t\n";
+
+  CHECK(importer.import(INPUT) == 6);
+  CHECK(importer.names == std::vector<std::string>({"0", "1"}));
+  CHECK(importer.types[0] == CsvImporter::column_type_t::integer);
+  CHECK(importer.ragged_rows.load() == 2);
+
+  double reals = 0;
+  size_t nulls = 0;
+
+  forEachRow(cluster_, [&](const std::vector<const Astruct*>& stacks) {
+    CHECK(stacks.size() == 2);
+
+    if (isNull(stacks[0])) {
+      nulls++;
+    } else {
+      CHECK(stacks[0]->kind() == Astruct::astruct_kind_t::real);
+      reals += std::get<double>(stacks[0]->astruct);
+    }
+
+    if (isNull(stacks[1])) {
+      nulls++;
+    }
+  });
+
+  CHECK(reals == 15.25);
+  CHECK(nulls == 3);
+
+  delete cluster_;
+}
+
+
+// A file is mapped and imported, a missing file imports nothing
+static void testImportFile() {
+  const std::string PATH = "csv_importer_test.csv";
+
+  {
+    std::ofstream file(PATH);
+    file << "a,b\r\n1,x\r\n2,y\r\n3,z";
+  }
+
+  Cluster*    cluster_ = new Cluster();
+  CsvImporter importer(cluster_);
+
+  importer.threads = 2;
+
+  CHECK(importer.importFile(PATH) == 3);
+  CHECK(importer.importFile("csv_importer_test.missing") == 0);
+
+  std::string names;
+
+  forEachRow(cluster_, [&](const std::vector<const Astruct*>& stacks) {
+    names += std::get<std::string>(stacks[1]->astruct);
+  });
+  CHECK(names.size() == 3);
+
+  std::remove(PATH.c_str());
+  delete cluster_;
+}
+
+
+int main() {
+  RUN_TEST(testImportTypes);
+  RUN_TEST(testRaggedAndWider);
+  RUN_TEST(testImportFile);
+
+  return finishTests();
+}
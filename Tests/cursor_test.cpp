@@ -0,0 +1,277 @@
+/**
+  * @file cursor_test.cpp
+  * This is the documentation of the `cursor_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the Cursor class, the batches of every kind of layer, the projection
+  * and the predicate on the viewed rows, the clusters moved or removed during a
+  * scan and the cancelled scans
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Cursor/cursor.hpp"
+
+
+// The buckets have five names and reals with empty slots
+static const test_columns_t columns{"name", 5, [](int64_t, int64_t row) -> Astruct* {
+  return row % 3 == 0 ? nullptr : new Astruct(row * 0.5);
+}};
+
+
+// A brain with an empty slot, a plain cluster and an encoded cluster with a sealed bucket
+static Brain* makeBrain() {
+  Brain* brain = new Brain();
+
+  Cluster* plain = new Cluster();
+  plain->insertBucket(makeBucket(columns, 0, 300));
+  plain->insertBucket(makeBucket(columns, 300, 200));
+
+  Cluster* encoded = new Cluster();
+  encoded->insertBucket(makeBucket(columns, 500, 1500));
+  encoded->insertBucket(makeBucket(columns, 2000, 100));
+  encoded->encodeStringStacks();
+  encoded->cluster[0]->seal(0);
+
+  brain->brain = {nullptr, plain, encoded};
+  brain->rebuildClusterSlots();
+  return brain;
+}
+
+
+// Every row of every layer is read once, the batches are bounded
+static void testScanAll() {
+  Brain* brain = makeBrain();
+  Cursor cursor(brain);
+
+  cursor.threads    = 2;
+  cursor.batch_rows = 64;
+  cursor.open();
+
+  Cursor::batch_t batch;
+  int64_t         ids   = 0;
+  size_t          rows  = 0;
+  size_t          names = 0;
+
+  while (cursor.next(batch)) {
+    CHECK(!batch.rows.empty() && batch.rows.size() <= 64);
+
+    for (const auto& row : batch.rows) {
+      CHECK(row.size() == 3);
+
+      const int64_t ID = std::get<int64_t>(row[0]->astruct);
+
+      ids += ID;
+      rows++;
+      names += std::get<std::string>(row[1]->astruct) == "name" + std::to_string(ID % 5);
+    }
+  }
+
+  CHECK(rows == 2100);
+  CHECK(names == 2100);
+  CHECK(ids == 2100 * 2099 / 2);
+  CHECK(cursor.scanned_rows.load() == 2100);
+
+  cursor.close();
+  delete brain;
+}
+
+
+// The predicate runs on the viewed projected stacks, the rows it drops are not copied
+static void testPredicateAndColumns() {
+  Brain* brain = makeBrain();
+  Cursor cursor(brain);
+
+  cursor.columns   = {2, 0, 7};
+  cursor.predicate = [](const Cursor::view_t& view) {
+    return view[1] != nullptr && std::get<int64_t>(view[1]->astruct) % 10 == 0 && view[0] != nullptr;
+  };
+  cursor.open();
+
+  Cursor::batch_t batch;
+  size_t          rows = 0;
+
+  while (cursor.next(batch)) {
+    for (const auto& row : batch.rows) {
+      CHECK(row.size() == 3);
+      CHECK(row[0] != nullptr && row[0]->kind() == Astruct::astruct_kind_t::real);
+      CHECK(std::get<int64_t>(row[1]->astruct) % 10 == 0);
+      CHECK(row[2] == nullptr);
+      rows++;
+    }
+  }
+
+  CHECK(rows == cursor.produced_rows.load());
+  CHECK(cursor.scanned_rows.load() == 2100);
+  CHECK(rows > 0 && rows < 210);
+
+  cursor.close();
+  delete brain;
+}
+
+
+// A cluster moved to another slot during its scan is read to the end and unpinned
+// where it is now, the clusters moved to a slot that was already taken are read too
+static void testUnpinMovedCluster() {
+  Brain* brain = makeBrain();
+  Cursor cursor(brain);
+
+  Cluster* plain   = brain->brain[1];
+  Cluster* encoded = brain->brain[2];
+
+  cursor.threads        = 1;
+  cursor.batch_rows     = 1;
+  cursor.queue_capacity = 1;
+  cursor.open();
+
+  Cursor::batch_t batch;
+  CHECK(cursor.next(batch));
+
+  size_t rows = batch.rows.size();
+
+  // The producer waits for the queue with the plain cluster pinned
+  CHECK(brain->compactClusters() == 1);
+  CHECK(brain->brain[0] == plain);
+
+  while (cursor.next(batch)) {
+    rows += batch.rows.size();
+  }
+  cursor.close();
+
+  CHECK(rows == 2100);
+  CHECK(cursor.truncated_clusters.load() == 0);
+  CHECK(plain->pinned_exports.load() == 0);
+  CHECK(encoded->pinned_exports.load() == 0);
+
+  delete brain;
+}
+
+
+// The rest of a cluster moved in the middle of its scan is read from its new slot
+static void testResumeMovedCluster() {
+  Brain*   brain    = new Brain();
+  Cluster* cluster_ = new Cluster();
+
+  cluster_->insertBucket(makeBucket(columns, 0, 3000));
+  brain->brain = {nullptr, cluster_};
+  brain->rebuildClusterSlots();
+
+  Cursor cursor(brain);
+
+  cursor.threads        = 1;
+  cursor.batch_rows     = 100;
+  cursor.queue_capacity = 1;
+  cursor.open();
+
+  Cursor::batch_t batch;
+  CHECK(cursor.next(batch));
+  CHECK(batch.cluster_index == 1);
+
+  int64_t ids  = 0;
+  size_t  rows = 0;
+
+  auto count = [&]() {
+    for (const auto& row : batch.rows) {
+      ids += std::get<int64_t>(row[0]->astruct);
+      rows++;
+    }
+  };
+  count();
+
+  CHECK(brain->compactClusters() == 1);
+
+  while (cursor.next(batch)) {
+    count();
+  }
+  cursor.close();
+
+  CHECK(rows == 3000);
+  CHECK(ids == 3000 * 2999 / 2);
+  CHECK(cursor.truncated_clusters.load() == 0);
+  CHECK(cluster_->pinned_exports.load() == 0);
+
+  delete brain;
+}
+
+
+// A cluster removed in the middle of its scan can not be read anymore, it is reported
+static void testRemovedClusterIsReported() {
+  Brain* brain = makeBrain();
+  Cursor cursor(brain);
+
+  cursor.threads        = 1;
+  cursor.batch_rows     = 100;
+  cursor.queue_capacity = 1;
+  cursor.open();
+
+  Cursor::batch_t batch;
+  CHECK(cursor.next(batch));
+
+  size_t   rows    = batch.rows.size();
+  Cluster* removed = brain->removeCluster(1);
+
+  while (cursor.next(batch)) {
+    rows += batch.rows.size();
+  }
+  cursor.close();
+
+  CHECK(cursor.truncated_clusters.load() == 1);
+  CHECK(rows < 2100 && rows >= 1600);
+  CHECK(brain->brain[2]->pinned_exports.load() == 0);
+
+  delete removed;
+  delete brain;
+}
+
+
+// A cursor closed in the middle of a scan deletes its batches and releases its clusters
+static void testClose() {
+  Brain* brain = makeBrain();
+  Cursor cursor(brain);
+
+  cursor.batch_rows = 10;
+  cursor.open();
+
+  Cursor::batch_t batch;
+  CHECK(cursor.next(batch));
+
+  cursor.close();
+  CHECK(!cursor.next(batch));
+  CHECK(batch.rows.empty());
+
+  CHECK(brain->brain[1]->pinned_exports.load() == 0);
+  CHECK(brain->brain[2]->pinned_exports.load() == 0);
+
+  // A closed cursor can be opened again
+  cursor.open();
+
+  size_t rows = 0;
+
+  while (cursor.next(batch)) {
+    rows += batch.rows.size();
+  }
+  CHECK(rows == 2100);
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testScanAll);
+  RUN_TEST(testPredicateAndColumns);
+  RUN_TEST(testUnpinMovedCluster);
+  RUN_TEST(testResumeMovedCluster);
+  RUN_TEST(testRemovedClusterIsReported);
+  RUN_TEST(testClose);
+
+  return finishTests();
+}
@@ -0,0 +1,162 @@
+/**
+  * @file dictionary_test.cpp
+  * This is the documentation of the `dictionary_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the Dictionary and DictionaryLayer classes, the codes of the strings,
+  * the copies and the empty slots and null astructs of the encoded stacks
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Dictionary/dictionary.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+#include "../Nativite/Engine/Serializer/serializer.hpp"
+
+
+// Every distinct string has one code and its bytes are stored once
+static void testEncode() {
+  Dictionary dictionary;
+
+  CHECK(dictionary.encode("red") == 0);
+  CHECK(dictionary.encode("green") == 1);
+  CHECK(dictionary.encode("red") == 0);
+  CHECK(dictionary.encode("") == 2);
+
+  CHECK(dictionary.size() == 3);
+  CHECK(dictionary.codes.size() == 3);
+  CHECK(dictionary.bytes.size() == 8);
+
+  CHECK(dictionary.find("green") == 1);
+  CHECK(dictionary.find("blue") == Dictionary::null_code);
+  CHECK(dictionary.decode(0) == "red");
+  CHECK(dictionary.decode(2) == "");
+
+  // The lookups keep working when `bytes` grows and moves
+  for (int index = 0; index < 1000; index++) {
+    dictionary.encode("value" + std::to_string(index));
+  }
+  CHECK(dictionary.find("red") == 0);
+  CHECK(dictionary.find("value999") == 1002);
+}
+
+
+// A copy hashes its codes through its own strings
+static void testCopy() {
+  Dictionary* dictionary = new Dictionary();
+  dictionary->encode("one");
+  dictionary->encode("two");
+
+  Dictionary copy(*dictionary);
+  delete dictionary;
+
+  CHECK(copy.find("two") == 1);
+  CHECK(copy.encode("three") == 2);
+  CHECK(copy.encode("one") == 0);
+  CHECK(copy.size() == 3);
+}
+
+
+// The codes of the special slots are not strings
+static void testSpecialCodes() {
+  CHECK(!Dictionary::isString(Dictionary::null_code));
+  CHECK(!Dictionary::isString(Dictionary::json_null_code));
+  CHECK(Dictionary::isString(0));
+}
+
+
+// A bucket with a stack of strings, empty slots and null astructs
+static Bucket* makeBucket() {
+  Bucket* bucket = new Bucket();
+
+  bucket->pushAstruct(0, new Astruct("a"));
+  bucket->pushAstruct(0, nullptr);
+  bucket->pushAstruct(0, new Astruct(nullptr));
+  bucket->pushAstruct(0, new Astruct("b"));
+  return bucket;
+}
+
+
+// Checks the stack of `makeBucket` after it was decoded
+static void checkDecoded(Bucket* bucket) {
+  const auto& stack = bucket->bucket[0];
+
+  CHECK(stack.size() >= 4);
+  CHECK(stack[0] != nullptr && std::get<std::string>(stack[0]->astruct) == "a");
+  CHECK(stack[1] == nullptr);
+  CHECK(stack[2] != nullptr && stack[2]->kind() == Astruct::astruct_kind_t::null);
+  CHECK(stack[3] != nullptr && std::get<std::string>(stack[3]->astruct) == "b");
+}
+
+
+// The empty slots and the null astructs keep apart through an encoding
+static void testEmptyAndNull() {
+  Bucket* bucket = makeBucket();
+
+  CHECK(bucket->encodeDictionaryStack(0));
+
+  const auto& codes = bucket->dictionary_layers[0]->codes;
+  CHECK(codes[1] == Dictionary::null_code);
+  CHECK(codes[2] == Dictionary::json_null_code);
+
+  // A pushed astruct is encoded with the same codes
+  bucket->pushAstruct(0, nullptr);
+  bucket->pushAstruct(0, new Astruct(nullptr));
+  CHECK(codes[4] == Dictionary::null_code);
+  CHECK(codes[5] == Dictionary::json_null_code);
+
+  bucket->decodeDictionaryStack(0);
+  checkDecoded(bucket);
+  CHECK(bucket->bucket[0][4] == nullptr);
+  CHECK(bucket->bucket[0][5] != nullptr);
+
+  delete bucket;
+}
+
+
+// The empty slots and the null astructs keep apart through a serialization
+static void testSerializedEmptyAndNull() {
+  Cluster* cluster = new Cluster();
+  Bucket*  bucket  = makeBucket();
+
+  bucket->encodeDictionaryStack(0);
+  cluster->insertBucket(bucket);
+
+  Serializer writer;
+  writer.serialize(cluster);
+
+  Serializer reader;
+  Cluster*   copy = reader.deserializeCluster(writer.buffer.data(), writer.buffer.size());
+
+  CHECK(copy != nullptr);
+
+  if (copy != nullptr) {
+    Bucket* copy_bucket = copy->cluster[0];
+
+    CHECK(copy_bucket->isDictionaryStack(0));
+    copy_bucket->decodeDictionaryStack(0);
+    checkDecoded(copy_bucket);
+  }
+
+  delete copy;
+  delete cluster;
+}
+
+
+int main() {
+  RUN_TEST(testEncode);
+  RUN_TEST(testCopy);
+  RUN_TEST(testSpecialCodes);
+  RUN_TEST(testEmptyAndNull);
+  RUN_TEST(testSerializedEmptyAndNull);
+
+  return finishTests();
+}
@@ -0,0 +1,122 @@
+/**
+  * @file directory_test.cpp
+  * This is the documentation of the `directory_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the ClusterDirectory class, the metadata and the zones of the clusters
+  * and the bounded size of the zones refreshed again and again
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Directory/directory.hpp"
+#include "../Nativite/Engine/Brain/brain.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+
+
+// A sealed bucket of `stacks` integer stacks with the rows [first, first + 100)
+static Bucket* makeBucket(int64_t first, size_t stacks) {
+  Bucket* bucket = new Bucket();
+
+  for (int64_t row = 0; row < 100; row++) {
+    for (size_t stack = 0; stack < stacks; stack++) {
+      bucket->pushAstruct(stack, new Astruct(first + row));
+    }
+  }
+  bucket->seal();
+  return bucket;
+}
+
+
+// A cluster with a single sealed bucket
+static Cluster* makeCluster(int64_t first, size_t stacks) {
+  Cluster* cluster = new Cluster();
+  cluster->insertBucket(makeBucket(first, stacks));
+  return cluster;
+}
+
+
+// The slots hold the metadata and the zones prune the clusters
+static void testRebuild() {
+  Brain* brain = new Brain();
+
+  brain->brain = {makeCluster(0, 2), nullptr, makeCluster(1000, 2)};
+  brain->rebuildClusterSlots();
+
+  ClusterDirectory directory;
+  directory.rebuild(brain);
+
+  CHECK(directory.size() == 3);
+  CHECK(directory.row_counts[0] == 100);
+  CHECK(directory.row_counts[1] == 0);
+  CHECK(directory.sealed_counts[2] == 1);
+  CHECK(directory.totalRows() == 200);
+  CHECK(directory.zones.size() == 4);
+
+  std::vector<uint32_t> slots;
+  directory.pruneRange(1, 1050, 1060, slots);
+  CHECK(slots.size() == 1 && slots[0] == 2);
+
+  delete brain;
+}
+
+
+// Refreshing the same slots again and again keeps the zones bounded and right
+static void testRefreshReusesZones() {
+  Brain* brain = new Brain();
+
+  brain->brain = {makeCluster(0, 3), makeCluster(1000, 3)};
+  brain->rebuildClusterSlots();
+
+  ClusterDirectory directory;
+  directory.rebuild(brain);
+
+  for (int round = 0; round < 1000; round++) {
+    directory.refresh(0, brain->brain[0]);
+    directory.refresh(1, brain->brain[1]);
+  }
+  CHECK(directory.zones.size() == 6);
+
+  // A slot whose zones grow is moved to the end, the pool is compacted later
+  brain->brain[0]->insertBucket(makeBucket(500, 5));
+
+  for (int round = 0; round < 1000; round++) {
+    directory.refresh(0, brain->brain[0]);
+    directory.refresh(1, brain->brain[1]);
+  }
+  CHECK(directory.zones.size() <= 2 * (5 + 3));
+  CHECK(directory.zone_counts[0] == 5);
+
+  CHECK(directory.mayContainRange(0, 4, 550, 560));
+  CHECK(!directory.mayContainRange(0, 4, 0, 50));
+  CHECK(directory.mayContainRange(0, 0, 0, 50));
+  CHECK(directory.mayContainRange(1, 2, 1000, 1000));
+  CHECK(!directory.mayContainRange(1, 2, 0, 999));
+
+  // An emptied slot gives back its zones
+  directory.remove(0);
+  directory.refresh(1, brain->brain[1]);
+  CHECK(directory.zones.size() == 3);
+  CHECK(!directory.mayContainRange(0, 0, 0, 50));
+  CHECK(directory.mayContainRange(1, 0, 1000, 1000));
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testRebuild);
+  RUN_TEST(testRefreshReusesZones);
+
+  return finishTests();
+}
@@ -0,0 +1,135 @@
+/**
+  * @file epoch_test.cpp
+  * This is the documentation of the `epoch_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the EpochManager and EpochGuard classes, the retired objects wait for
+  * the readers of their epoch and are freed once
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Epoch/epoch.hpp"
+#include "../Nativite/Engine/Brain/brain.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+
+
+// The freed objects, counted by their destructor
+static std::atomic<size_t> freed_objects{0};
+
+// An object that counts its destruction
+struct counted_t {
+  ~counted_t() {
+    freed_objects++;
+  }
+};
+
+
+// A retired object is kept while a guard of its epoch lives and freed after
+static void testGuardKeepsObject() {
+  EpochManager manager;
+  freed_objects = 0;
+
+  auto* record = manager.acquireRecord();
+  manager.enter(record);
+
+  manager.retire(new counted_t());
+  manager.collect();
+  manager.collect();
+  CHECK(freed_objects == 0);
+  CHECK(manager.pendingCount() == 1);
+
+  manager.exit(record);
+  manager.collect();
+  manager.collect();
+  CHECK(freed_objects == 1);
+  CHECK(manager.pendingCount() == 0);
+
+  manager.releaseRecord(record);
+}
+
+
+// The nested guards of a thread only announce the epoch once
+static void testNestedGuards() {
+  freed_objects = 0;
+
+  {
+    EpochGuard outer;
+    {
+      EpochGuard inner;
+    }
+
+    EpochManager::global().retire(new counted_t());
+    EpochManager::global().collect();
+    EpochManager::global().collect();
+    CHECK(freed_objects == 0);
+  }
+
+  EpochManager::global().collect();
+  EpochManager::global().collect();
+  CHECK(freed_objects == 1);
+}
+
+
+// The objects retired by many threads are all freed, and freed once
+static void testConcurrentRetire() {
+  const size_t THREADS = 4;
+  const size_t OBJECTS = 2000;
+
+  freed_objects = 0;
+
+  std::vector<std::thread> threads;
+
+  for (size_t thread = 0; thread < THREADS; thread++) {
+    threads.emplace_back([&] {
+      for (size_t object = 0; object < OBJECTS; object++) {
+        EpochGuard guard;
+        EpochManager::global().retire(new counted_t());
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EpochManager::global().drain();
+  CHECK(freed_objects == THREADS * OBJECTS);
+}
+
+
+// The readers of the brain hold its locks and take no guard, so they do not
+// hold back the collections
+static void testLockedReadersTakeNoGuard() {
+  Brain* brain = new Brain();
+  brain->insertCluster(new Cluster());
+
+  freed_objects = 0;
+
+  brain->readCluster(0, [&](const Cluster*) {
+    EpochManager::global().retire(new counted_t());
+    EpochManager::global().collect();
+    EpochManager::global().collect();
+    CHECK(freed_objects == 1);
+  });
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testGuardKeepsObject);
+  RUN_TEST(testNestedGuards);
+  RUN_TEST(testConcurrentRetire);
+  RUN_TEST(testLockedReadersTakeNoGuard);
+
+  return finishTests();
+}
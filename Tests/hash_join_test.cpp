@@ -0,0 +1,195 @@
+/**
+  * @file hash_join_test.cpp
+  * This is the documentation of the `hash_join_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the HashJoin class, the joins in memory and spilled to files, the typed
+  * keys, the empty and null keys, the projected columns and the chosen build side
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/HashJoin/hash_join.hpp"
+
+
+// The left brain, the ids 0 to 999 with a name in two clusters and rows without a key
+static Brain* makeLeft() {
+  Brain* brain = new Brain();
+
+  for (int64_t first : {0, 500}) {
+    Cluster* cluster_ = new Cluster();
+    Bucket*  bucket_  = new Bucket();
+
+    for (int64_t id = first; id < first + 500; id++) {
+      bucket_->pushAstruct(0, new Astruct(id));
+      bucket_->pushAstruct(1, new Astruct("l" + std::to_string(id)));
+    }
+
+    // The empty and the null keys never match
+    bucket_->pushAstruct(0, nullptr);
+    bucket_->pushAstruct(1, new Astruct("empty"));
+    bucket_->pushAstruct(0, new Astruct(nullptr));
+    bucket_->pushAstruct(1, new Astruct("null"));
+
+    cluster_->insertBucket(bucket_);
+    brain->insertCluster(cluster_);
+  }
+  return brain;
+}
+
+
+// The right brain, the keys `row % 1200` of 2400 rows and a real key that is not an integer
+static Brain* makeRight() {
+  Brain*   brain    = new Brain();
+  Cluster* cluster_ = new Cluster();
+
+  for (int64_t first : {0, 1200}) {
+    Bucket* bucket_ = new Bucket();
+
+    for (int64_t row = first; row < first + 1200; row++) {
+      bucket_->pushAstruct(0, new Astruct(row % 1200));
+      bucket_->pushAstruct(1, new Astruct(row));
+    }
+    cluster_->insertBucket(bucket_);
+  }
+
+  Bucket* real = new Bucket();
+  real->pushAstruct(0, new Astruct(5.0));
+  real->pushAstruct(1, new Astruct(int64_t{-1}));
+  cluster_->insertBucket(real);
+
+  brain->insertCluster(cluster_);
+  return brain;
+}
+
+
+// Checks the joined rows, every id below 1000 matches two right rows
+static void checkResults(const std::vector<HashJoin::row_t>& results) {
+  CHECK(results.size() == 2000);
+
+  int64_t ids    = 0;
+  size_t  errors = 0;
+
+  for (const auto& row : results) {
+    if (row.size() != 4) {
+      errors++;
+      continue;
+    }
+
+    const int64_t ID = std::get<int64_t>(row[0]->astruct);
+
+    ids    += ID;
+    errors += std::get<std::string>(row[1]->astruct) != "l" + std::to_string(ID);
+    errors += std::get<int64_t>(row[2]->astruct) != ID;
+    errors += std::get<int64_t>(row[3]->astruct) % 1200 != ID;
+  }
+
+  CHECK(errors == 0);
+  CHECK(ids == 2 * (999 * 1000 / 2));
+}
+
+
+// A join whose sides fit in memory is never written to a file
+static void testInMemory() {
+  Brain*   left  = makeLeft();
+  Brain*   right = makeRight();
+  HashJoin join;
+
+  join.left.brain  = left;
+  join.left.keys   = {0};
+  join.right.brain = right;
+  join.right.keys  = {0};
+  join.threads     = 3;
+  join.radix_bits  = 3;
+
+  checkResults(join.join());
+
+  CHECK(join.spilled_bytes.load() == 0);
+  CHECK(join.build_rows.load() + join.probe_rows.load() == 1000 + 2401);
+
+  delete left;
+  delete right;
+}
+
+
+// The sides over the memory limit are spilled and read back, their files are removed
+static void testSpilled() {
+  const std::string DIRECTORY = "hash_join_test_spill";
+  std::filesystem::create_directory(DIRECTORY);
+
+  Brain*   left  = makeLeft();
+  Brain*   right = makeRight();
+  HashJoin join;
+
+  join.left.brain      = left;
+  join.left.keys       = {0};
+  join.right.brain     = right;
+  join.right.keys      = {0};
+  join.memory_limit    = 1 << 12;
+  join.frame_bytes     = 1 << 10;
+  join.spill_directory = DIRECTORY;
+
+  checkResults(join.join());
+
+  CHECK(join.spilled_bytes.load() > 0);
+  CHECK(std::filesystem::is_empty(DIRECTORY));
+
+  std::filesystem::remove_all(DIRECTORY);
+  delete left;
+  delete right;
+}
+
+
+// The projected columns of each side, the forced build side and the clusters of a side
+static void testColumnsAndBuildSide() {
+  Brain*   left  = makeLeft();
+  Brain*   right = makeRight();
+  HashJoin join;
+
+  join.left.brain    = left;
+  join.left.keys     = {0};
+  join.left.columns  = {1};
+  join.left.clusters = {1};
+  join.right.brain   = right;
+  join.right.keys    = {0};
+  join.right.columns = {1, 4};
+  join.build_side    = HashJoin::build_side_t::right;
+
+  auto& results = join.join();
+
+  CHECK(results.size() == 1000);
+
+  size_t errors = 0;
+
+  for (const auto& row : results) {
+    errors += row.size() != 3 || row[2] != nullptr;
+    errors += std::get<std::string>(row[0]->astruct) != "l" + std::to_string(std::get<int64_t>(row[1]->astruct) % 1200);
+  }
+  CHECK(errors == 0);
+
+  // The keys of both sides must be paired
+  join.right.keys = {0, 1};
+  CHECK(join.join().empty());
+
+  delete left;
+  delete right;
+}
+
+
+int main() {
+  RUN_TEST(testInMemory);
+  RUN_TEST(testSpilled);
+  RUN_TEST(testColumnsAndBuildSide);
+
+  return finishTests();
+}
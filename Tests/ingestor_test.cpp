@@ -0,0 +1,153 @@
+/**
+  * @file ingestor_test.cpp
+  * This is the documentation of the `ingestor_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the Ingestor class, the records that go through every stage, the
+  * malformed and unrouted rows and the rows submitted to a stopped pipeline
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Ingestor/ingestor.hpp"
+#include "../Nativite/Engine/Brain/brain.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+
+
+// Parses a record of digits into a row of one integer
+static bool parseInteger(std::string_view record, Ingestor::row_t& row) {
+  if (record.empty()) {
+    return false;
+  }
+
+  int64_t value = 0;
+
+  for (char digit : record) {
+    if (digit < '0' || digit > '9') {
+      return false;
+    }
+    value = value * 10 + (digit - '0');
+  }
+
+  row.push_back(new Astruct(value));
+  return true;
+}
+
+
+// Routes the even integers to the cluster 0 and the odd integers to the cluster 1
+static size_t routeParity(const Ingestor::row_t& row) {
+  return static_cast<size_t>(std::get<int64_t>(row[0]->astruct) % 2);
+}
+
+
+// A brain with two clusters
+static Brain* makeBrain() {
+  Brain* brain = new Brain();
+
+  brain->insertCluster(new Cluster());
+  brain->insertCluster(new Cluster());
+  return brain;
+}
+
+
+// The rows of the buckets of the cluster of the slot `index`
+static size_t clusterRows(Brain* brain, size_t index) {
+  size_t rows = 0;
+
+  brain->readCluster(index, [&](Cluster* cluster_) {
+    cluster_->forEachBucket([&](const Bucket* bucket_) {
+      rows += bucket_->height();
+    });
+  });
+  return rows;
+}
+
+
+// The records are parsed, routed and appended, the malformed ones are rejected
+static void testIngest() {
+  Brain*   brain = makeBrain();
+  Ingestor ingestor(brain, parseInteger, routeParity);
+
+  ingestor.batch_rows = 64;
+
+  Ingestor::records_t records;
+
+  for (int64_t value = 0; value < 1000; value++) {
+    records.push_back(std::to_string(value));
+  }
+  records.push_back("x1");
+  records.push_back("");
+
+  CHECK(ingestor.ingest(std::move(records)) == 1000);
+  CHECK(ingestor.parsed_rows.load() == 1000);
+  CHECK(ingestor.rejected_rows.load() == 2);
+  CHECK(clusterRows(brain, 0) == 500);
+  CHECK(clusterRows(brain, 1) == 500);
+
+  delete brain;
+}
+
+
+// The parsed rows skip the parse stage, the rows of a missing cluster are rejected
+static void testSubmitRows() {
+  Brain*   brain = makeBrain();
+  Ingestor ingestor(brain, parseInteger, [](const Ingestor::row_t& row) {
+    return static_cast<size_t>(std::get<int64_t>(row[0]->astruct) % 3);
+  });
+
+  ingestor.start();
+
+  Ingestor::rows_t rows;
+
+  for (int64_t value = 0; value < 30; value++) {
+    rows.push_back({new Astruct(value)});
+  }
+
+  CHECK(ingestor.submitRows(std::move(rows)));
+  CHECK(ingestor.finish() == 20);
+  CHECK(ingestor.rejected_rows.load() == 10);
+  CHECK(clusterRows(brain, 0) + clusterRows(brain, 1) == 20);
+
+  delete brain;
+}
+
+
+// The rows submitted to a stopped pipeline are deleted, the caller does not own them
+static void testSubmitRowsStopped() {
+  Brain*   brain = makeBrain();
+  Ingestor ingestor(brain, parseInteger, routeParity);
+
+  Ingestor::rows_t rows = {{new Astruct(int64_t{1})}, {new Astruct(int64_t{2})}};
+
+  CHECK(!ingestor.submitRows(std::move(rows)));
+  CHECK(ingestor.rejected_rows.load() == 2);
+
+  ingestor.start();
+  ingestor.finish();
+
+  CHECK(!ingestor.submitRows(Ingestor::rows_t{{new Astruct(int64_t{3})}}));
+  CHECK(ingestor.rejected_rows.load() == 3);
+  CHECK(ingestor.appended_rows.load() == 0);
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testIngest);
+  RUN_TEST(testSubmitRows);
+  RUN_TEST(testSubmitRowsStopped);
+
+  return finishTests();
+}
@@ -0,0 +1,223 @@
+/**
+  * @file json_loader_test.cpp
+  * This is the documentation of the `json_loader_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the JsonLoader class, the documents parsed by the two stages, the
+  * strings that cross the blocks of the first stage, the malformed documents and
+  * the NDJSON lines loaded into a brain by the ingestor
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/JsonLoader/json_loader.hpp"
+#include "../Nativite/Engine/Ingestor/ingestor.hpp"
+#include "../Nativite/Engine/Brain/brain.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+
+
+// Routes every row to the cluster 0
+static size_t routeFirst(const Ingestor::row_t&) {
+  return 0;
+}
+
+
+// The ingestor of the loaders, the records are already parsed
+static bool parseNothing(std::string_view, Ingestor::row_t&) {
+  return false;
+}
+
+
+// The rows of the cluster 0 of the brain, as the astructs of their stacks
+static std::vector<std::vector<const Astruct*>> loadedRows(Brain* brain) {
+  std::vector<std::vector<const Astruct*>> rows;
+
+  brain->readCluster(0, [&](Cluster* cluster_) {
+    cluster_->forEachBucket([&](const Bucket* bucket_) {
+      for (size_t row = 0; row < bucket_->height(); row++) {
+        std::vector<const Astruct*> values;
+
+        for (size_t stack = 0; stack < bucket_->stackCount(); stack++) {
+          values.push_back(row < bucket_->bucket[stack].size() ? bucket_->bucket[stack][row] : nullptr);
+        }
+        rows.push_back(std::move(values));
+      }
+    });
+  });
+  return rows;
+}
+
+
+// The scalars, the arrays and the objects of a document
+static void testParseValues() {
+  JsonLoader loader(nullptr);
+
+  Astruct* document = loader.parse(
+    "{\"id\": 42, \"ratio\": -1.5e2, \"ok\": true, \"none\": null,\n"
+    " \"tags\": [\"a\", \"b\\n\\\"c\\\"\", \"\\u00e9\"], \"big\": 99999999999999999999}"
+  );
+
+  CHECK(document != nullptr);
+
+  if (document != nullptr) {
+    const auto& object = std::get<Astruct::astruct_object_t>(document->astruct);
+
+    CHECK(object.size() == 6);
+    CHECK(object[0].first == "id" && std::get<int64_t>(object[0].second->astruct) == 42);
+    CHECK(std::get<double>(object[1].second->astruct) == -150.0);
+    CHECK(std::get<bool>(object[2].second->astruct));
+    CHECK(object[3].second->kind() == Astruct::astruct_kind_t::null);
+
+    const auto& tags = std::get<Astruct::astruct_array_t>(object[4].second->astruct);
+
+    CHECK(tags.size() == 3);
+    CHECK(std::get<std::string>(tags[1]->astruct) == "b\n\"c\"");
+    CHECK(std::get<std::string>(tags[2]->astruct) == "\xc3\xa9");
+
+    // An integer out of range is read as a real
+    CHECK(object[5].second->kind() == Astruct::astruct_kind_t::real);
+  }
+
+  delete document;
+}
+
+
+// The strings and the escapes that cross the blocks of 64 bytes are indexed once
+static void testLongStrings() {
+  JsonLoader loader(nullptr);
+
+  for (size_t padding = 50; padding < 80; padding++) {
+    const std::string TEXT = std::string(padding, 'x') + "\\\\\\\"{[,:" + std::string(padding, 'y');
+    Astruct*          value = loader.parse("[\"" + TEXT + "\", 7]");
+
+    CHECK(value != nullptr);
+
+    if (value != nullptr) {
+      const auto& array = std::get<Astruct::astruct_array_t>(value->astruct);
+
+      CHECK(array.size() == 2);
+      CHECK(std::get<std::string>(array[0]->astruct) == std::string(padding, 'x') + "\\\"{[,:" + std::string(padding, 'y'));
+      CHECK(std::get<int64_t>(array[1]->astruct) == 7);
+    }
+    delete value;
+  }
+}
+
+
+// The malformed documents are refused without leaking
+static void testMalformed() {
+  JsonLoader loader(nullptr);
+
+  const std::vector<std::string> DOCUMENTS = {
+    "", "{", "[1, 2", "{\"a\" 1}", "[1,]", "\"open", "tru", "1 2", "{\"a\": 1}}", "[-]", "\"\\q\""
+  };
+
+  for (const auto& document : DOCUMENTS) {
+    Astruct* value = loader.parse(document);
+
+    CHECK(value == nullptr);
+    delete value;
+  }
+
+  loader.max_depth = 4;
+
+  Astruct* deep = loader.parse("[[[[[[1]]]]]]");
+  CHECK(deep == nullptr);
+  delete deep;
+}
+
+
+// Every line is a row of the columns, the missing members are empty slots and the
+// malformed lines are counted
+static void testLoadColumns() {
+  Brain* brain = new Brain();
+  brain->insertCluster(new Cluster());
+
+  Ingestor   ingestor(brain, parseNothing, routeFirst);
+  JsonLoader loader(&ingestor);
+
+  loader.columns = {"id", "name"};
+  loader.threads = 3;
+
+  std::string input;
+
+  for (int64_t id = 0; id < 300; id++) {
+    input += "{\"name\": \"n" + std::to_string(id) + "\", \"extra\": [1], \"id\": " + std::to_string(id) + "}\n";
+  }
+  input += "{\"id\": 300}\n";
+  input += "{broken\n";
+  input += "[1, 2]\n";
+
+  CHECK(loader.load(input) == 301);
+  CHECK(loader.malformed_rows.load() == 2);
+  CHECK(ingestor.finish() == 301);
+
+  const auto ROWS = loadedRows(brain);
+  int64_t    sum  = 0;
+
+  CHECK(ROWS.size() == 301);
+
+  for (const auto& row : ROWS) {
+    CHECK(row.size() == 2);
+    sum += std::get<int64_t>(row[0]->astruct);
+
+    if (std::get<int64_t>(row[0]->astruct) == 300) {
+      CHECK(row[1] == nullptr);
+    } else {
+      CHECK(std::get<std::string>(row[1]->astruct) == "n" + std::to_string(std::get<int64_t>(row[0]->astruct)));
+    }
+  }
+  CHECK(sum == 300 * 301 / 2);
+
+  delete brain;
+}
+
+
+// A file is mapped and loaded, a missing file loads nothing
+static void testLoadFile() {
+  const std::string PATH = "json_loader_test.ndjson";
+
+  {
+    std::ofstream file(PATH);
+    file << "1\n\"two\"\n[3]\n{\"four\": 4}";
+  }
+
+  Brain* brain = new Brain();
+  brain->insertCluster(new Cluster());
+
+  Ingestor   ingestor(brain, parseNothing, routeFirst);
+  JsonLoader loader(&ingestor);
+
+  loader.threads = 1;
+
+  CHECK(loader.loadFile(PATH) == 4);
+  CHECK(loader.loadFile("json_loader_test.missing") == 0);
+  CHECK(ingestor.finish() == 4);
+  CHECK(loadedRows(brain).size() == 4);
+
+  std::remove(PATH.c_str());
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testParseValues);
+  RUN_TEST(testLongStrings);
+  RUN_TEST(testMalformed);
+  RUN_TEST(testLoadColumns);
+  RUN_TEST(testLoadFile);
+
+  return finishTests();
+}
@@ -0,0 +1,138 @@
+/**
+  * @file lean_cluster_test.cpp
+  * This is the documentation of the `lean_cluster_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the LeanCluster and LeanSlots classes, the single allocation of the
+  * buckets and the terminal of a cluster and its conversions from and to the
+  * Cluster class
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <variant>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/LeanCluster/lean_cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+#include "../Nativite/Engine/Astruct/astruct.hpp"
+
+
+// A bucket with a single stack of `rows` integers
+static Bucket* makeBucket(int64_t rows) {
+  Bucket* bucket = new Bucket();
+
+  for (int64_t row = 0; row < rows; row++) {
+    bucket->pushAstruct(0, new Astruct(row));
+  }
+  return bucket;
+}
+
+
+// The slots and the terminal of a cluster are one allocation that grows like a vector
+static void testClusterSlotsAreLean() {
+  Cluster* cluster = new Cluster(Cluster::cluster_t{makeBucket(1), makeBucket(2)});
+
+  LeanCluster* lean = cluster->cluster.lean;
+
+  CHECK(cluster->cluster.size() == 2);
+  CHECK(cluster->terminalCapacity() == 17);
+  CHECK(
+    reinterpret_cast<char*>(lean->terminal()) ==
+    reinterpret_cast<char*>(lean) + sizeof(LeanCluster) + lean->bucket_capacity * sizeof(Bucket*)
+  );
+  CHECK(lean->memoryUsage() == sizeof(LeanCluster) + (lean->bucket_capacity + 17) * sizeof(void*));
+
+  for (int64_t rows = 3; rows <= 20; rows++) {
+    cluster->insertBucket(makeBucket(rows));
+  }
+  CHECK(cluster->cluster.size() == 20);
+  CHECK(cluster->cluster.capacity() >= 20);
+  CHECK(cluster->cluster[19]->height() == 20);
+
+  Bucket* removed = cluster->removeBucket(4);
+  size_t  visited = 0;
+
+  cluster->forEachBucket([&visited](Bucket*) { visited++; });
+  CHECK(cluster->cluster[4] == nullptr);
+  CHECK(visited == 19);
+
+  CHECK(cluster->insertBucket(removed) == 4);
+
+  delete cluster;
+}
+
+
+// The terminal is a ring, the oldest astruct is deleted when it is full or shrinks
+static void testTerminalRing() {
+  Cluster* cluster = new Cluster();
+
+  cluster->configureTerminal(3, false);
+  CHECK(cluster->terminalCapacity() == 3);
+  CHECK(!cluster->automaticTerminal());
+
+  LeanCluster* lean = cluster->cluster.lean;
+
+  for (int64_t value = 0; value < 5; value++) {
+    lean->pushTerminal(new Astruct(value));
+  }
+  CHECK(lean->terminal_count == 3);
+  CHECK(std::get<int64_t>(lean->terminalAt(0)->astruct) == 2);
+  CHECK(std::get<int64_t>(lean->terminalAt(2)->astruct) == 4);
+
+  cluster->configureTerminal(2, true);
+  lean = cluster->cluster.lean;
+
+  CHECK(lean->terminal_count == 2);
+  CHECK(std::get<int64_t>(lean->terminalAt(0)->astruct) == 3);
+  CHECK(std::get<int64_t>(lean->terminalAt(1)->astruct) == 4);
+  CHECK(cluster->automaticTerminal());
+
+  delete cluster;
+}
+
+
+// A cluster hands its allocation to a lean cluster and takes it back without copies
+static void testRoundTrip() {
+  Cluster* cluster = new Cluster(Cluster::cluster_t{makeBucket(1), makeBucket(2), makeBucket(3)});
+
+  delete cluster->removeBucket(1);
+  cluster->cluster.lean->pushTerminal(new Astruct(int64_t(7)));
+
+  LeanCluster* lean = LeanCluster::fromCluster(cluster);
+
+  CHECK(lean->bucket_count == 2);
+  CHECK(lean->terminal_count == 1);
+  CHECK(cluster->cluster.empty());
+  CHECK(cluster->cluster.lean != lean);
+  delete cluster;
+
+  std::vector<int64_t> heights;
+
+  lean->forEachBucket([&heights](Bucket* bucket) { heights.push_back(bucket->height()); });
+  CHECK((heights == std::vector<int64_t>{1, 3}));
+
+  Cluster* back = LeanCluster::toCluster(lean);
+
+  CHECK(back->cluster.lean == lean);
+  CHECK(back->bucket_slots.used == 2);
+  CHECK(back->cluster[1]->height() == 3);
+  CHECK(std::get<int64_t>(lean->terminalAt(0)->astruct) == 7);
+
+  delete back;
+}
+
+
+int main() {
+  RUN_TEST(testClusterSlotsAreLean);
+  RUN_TEST(testTerminalRing);
+  RUN_TEST(testRoundTrip);
+
+  return finishTests();
+}
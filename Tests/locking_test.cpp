@@ -0,0 +1,134 @@
+/**
+  * @file locking_test.cpp
+  * This is the documentation of the `locking_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the reader-writer locking of Brain and Cluster, the readers, the writers
+  * of the clusters and the writers of the structure run at the same time
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <atomic>
+#include <thread>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Brain/brain.hpp"
+#include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+
+
+// A bucket with a single row
+static Bucket* makeBucket(int64_t value) {
+  Bucket* bucket = new Bucket();
+  bucket->pushAstruct(0, new Astruct(value));
+  return bucket;
+}
+
+
+// The readers always see whole buckets while the writers insert buckets
+// and clusters
+static void testReadersAndWriters() {
+  const size_t CLUSTERS = 4;
+  const size_t INSERTS  = 500;
+
+  Brain* brain = new Brain();
+
+  for (size_t index = 0; index < CLUSTERS; index++) {
+    brain->insertCluster(new Cluster());
+  }
+
+  std::atomic<bool>        done{false};
+  std::atomic<size_t>      broken{0};
+  std::vector<std::thread> threads;
+
+  for (size_t reader = 0; reader < 3; reader++) {
+    threads.emplace_back([&] {
+      while (!done.load()) {
+        brain->readClusters([&](const Cluster* cluster_) {
+          cluster_->forEachBucket([&](const Bucket* bucket_) {
+            broken += bucket_->height() == 1 ? 0 : 1;
+          });
+        });
+
+        // The shared locks prefer the readers, the writers get their turn here
+        std::this_thread::yield();
+      }
+    });
+  }
+
+  // Two writers per cluster, the counters are not atomic so the lock of the
+  // cluster must keep them apart
+  std::vector<size_t>   counters(CLUSTERS, 0);
+  std::vector<Cluster*> clusters(brain->brain.begin(), brain->brain.begin() + CLUSTERS);
+
+  for (size_t writer = 0; writer < 2 * CLUSTERS; writer++) {
+    threads.emplace_back([&, writer] {
+      const size_t INDEX = writer % CLUSTERS;
+
+      for (size_t insert = 0; insert < INSERTS; insert++) {
+        if (writer < CLUSTERS) {
+          clusters[INDEX]->insertBucket(makeBucket(static_cast<int64_t>(insert)));
+        }
+        brain->writeCluster(INDEX, [&](Cluster*) { counters[INDEX]++; });
+      }
+    });
+  }
+
+  std::thread structure([&] {
+    for (size_t insert = 0; insert < 50; insert++) {
+      brain->insertCluster(new Cluster());
+    }
+  });
+
+  structure.join();
+  for (size_t index = 3; index < threads.size(); index++) {
+    threads[index].join();
+  }
+  done = true;
+  for (size_t index = 0; index < 3; index++) {
+    threads[index].join();
+  }
+
+  CHECK(broken == 0);
+  CHECK(brain->cluster_slots.used == CLUSTERS + 50);
+
+  size_t buckets = 0;
+  brain->readClusters([&](const Cluster* cluster_) {
+    buckets += cluster_->bucket_slots.used;
+  });
+  CHECK(buckets == CLUSTERS * INSERTS);
+
+  for (auto counter : counters) {
+    CHECK(counter == 2 * INSERTS);
+  }
+
+  delete brain;
+}
+
+
+// A slot that is empty is not read nor written
+static void testEmptySlot() {
+  Brain* brain = new Brain();
+  brain->insertCluster(new Cluster());
+  delete brain->removeCluster(0);
+
+  CHECK(!brain->readCluster(0, [](const Cluster*) {}));
+  CHECK(!brain->writeCluster(0, [](Cluster*) {}));
+  CHECK(!brain->readCluster(10, [](const Cluster*) {}));
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testReadersAndWriters);
+  RUN_TEST(testEmptySlot);
+
+  return finishTests();
+}
@@ -1,4 +1,5 @@
 #include "../Nativite/Engine/Cluster/cluster.hpp"
+#include "../Nativite/Engine/Brain/brain.hpp"
 #include <iostream>
 
 
@@ -0,0 +1,169 @@
+/**
+  * @file mvcc_test.cpp
+  * This is the documentation of the `mvcc_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the Mvcc, Snapshot and Transaction classes, the versions seen by the
+  * snapshots, the conflicts of the commits and the removed buckets that only the
+  * snapshots read
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Mvcc/mvcc.hpp"
+#include "../Nativite/Engine/Serializer/serializer.hpp"
+
+
+// A bucket with the rows [first, first + rows)
+static Bucket* makeBucket(int64_t first, int64_t rows) {
+  Bucket* bucket = new Bucket();
+
+  for (int64_t row = 0; row < rows; row++) {
+    bucket->pushAstruct(0, new Astruct(first + row));
+  }
+  return bucket;
+}
+
+
+// A brain with a cluster of two buckets of 10 rows
+static Brain* makeBrain() {
+  Brain*   brain   = new Brain();
+  Cluster* cluster = new Cluster();
+
+  cluster->insertBucket(makeBucket(0, 10));
+  cluster->insertBucket(makeBucket(100, 10));
+  brain->insertCluster(cluster);
+  return brain;
+}
+
+
+// The rows of the live buckets of the cluster
+static size_t liveRows(const Cluster* cluster_) {
+  size_t rows = 0;
+  cluster_->forEachBucket([&](const Bucket* bucket_) { rows += bucket_->height(); });
+  return rows;
+}
+
+
+// The rows seen by a snapshot
+static size_t snapshotRows(const Snapshot& snapshot) {
+  size_t rows = 0;
+  snapshot.forEachBucket([&](size_t, const Bucket* bucket_) { rows += bucket_->height(); });
+  return rows;
+}
+
+
+// An update is seen by the new snapshots and not by the older ones
+static void testUpdate() {
+  Brain* brain = makeBrain();
+  Mvcc   mvcc(brain);
+
+  Snapshot before(&mvcc);
+
+  Transaction transaction(&mvcc);
+  Bucket*     copy = transaction.write(0, 0);
+  CHECK(copy != nullptr);
+  copy->pushAstruct(0, new Astruct(int64_t{10}));
+
+  const Mvcc::timestamp_t COMMIT = transaction.commit();
+  CHECK(COMMIT != Mvcc::aborted);
+  CHECK(COMMIT > before.time());
+
+  Snapshot after(&mvcc);
+  CHECK(snapshotRows(before) == 20);
+  CHECK(snapshotRows(after) == 21);
+  CHECK(liveRows(brain->brain[0]) == 21);
+
+  delete brain;
+}
+
+
+// A removed bucket is only read by the snapshots that still see it, the
+// traversals and the serialization skip it
+static void testRemovedBucket() {
+  Brain* brain = makeBrain();
+  Mvcc   mvcc(brain);
+
+  Snapshot* before = new Snapshot(&mvcc);
+
+  Transaction transaction(&mvcc);
+  CHECK(transaction.remove(0, 1));
+  CHECK(transaction.commit() != Mvcc::aborted);
+
+  Cluster* cluster = brain->brain[0];
+
+  // The bucket stays in its slot for the snapshot
+  CHECK(cluster->cluster[1] != nullptr);
+  CHECK(!cluster->cluster[1]->isLive());
+  CHECK(snapshotRows(*before) == 20);
+  CHECK(liveRows(cluster) == 10);
+
+  Serializer writer;
+  writer.serialize(brain);
+
+  Serializer reader;
+  Brain*     copy = reader.deserializeBrain(writer.buffer.data(), writer.buffer.size());
+
+  CHECK(copy != nullptr);
+  if (copy != nullptr) {
+    CHECK(liveRows(copy->brain[0]) == 10);
+  }
+  delete copy;
+
+  // Once no snapshot sees it, the bucket leaves its slot
+  delete before;
+  CHECK(mvcc.collect() == 1);
+  CHECK(cluster->cluster[1] == nullptr);
+  CHECK(liveRows(cluster) == 10);
+
+  delete brain;
+}
+
+
+// The first commit wins, the other one is aborted and an empty commit is not
+static void testCommitResults() {
+  Brain* brain = makeBrain();
+  Mvcc   mvcc(brain);
+
+  Transaction empty(&mvcc);
+  const Mvcc::timestamp_t EMPTY = empty.commit();
+  CHECK(EMPTY != Mvcc::aborted);
+  CHECK(EMPTY == mvcc.now());
+
+  Transaction first(&mvcc);
+  Transaction second(&mvcc);
+
+  first.write(0, 0)->pushAstruct(0, new Astruct(int64_t{1}));
+  second.write(0, 0)->pushAstruct(0, new Astruct(int64_t{2}));
+
+  CHECK(first.commit() != Mvcc::aborted);
+  CHECK(second.commit() == Mvcc::aborted);
+
+  // A removed bucket can not be written nor removed again
+  Transaction remove(&mvcc);
+  CHECK(remove.remove(0, 1));
+  CHECK(remove.commit() != Mvcc::aborted);
+
+  Transaction late(&mvcc);
+  CHECK(late.write(0, 1) == nullptr);
+  CHECK(!late.remove(0, 1));
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testUpdate);
+  RUN_TEST(testRemovedBucket);
+  RUN_TEST(testCommitResults);
+
+  return finishTests();
+}
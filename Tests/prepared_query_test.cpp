@@ -0,0 +1,270 @@
+/**
+  * @file prepared_query_test.cpp
+  * This is the documentation of the `prepared_query_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the PreparedQuery class, the same rows as the planner, the NaNs of the
+  * sealed blocks, the bound parameters, the plan refreshed when the slots of the
+  * brain change and the executions on many threads
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/PreparedQuery/prepared_query.hpp"
+
+
+using query_t = QueryPlanner::query_t;
+
+
+// The buckets have four names and reals with NaNs and infinities
+static const test_columns_t columns{"n", 4, nonFiniteReal};
+
+
+// A cluster of sealed encoded buckets of 1500 rows from the id `first`
+static Cluster* makeSealed(int64_t first) {
+  Cluster* sealed = new Cluster();
+
+  sealed->insertBucket(makeBucket(columns, first, 1500));
+  sealed->insertBucket(makeBucket(columns, first + 1500, 1500));
+  sealed->encodeStringStacks();
+  sealed->cluster[0]->seal();
+  sealed->cluster[1]->seal();
+  return sealed;
+}
+
+
+// A brain with a plain cluster, an empty slot and a cluster of sealed encoded buckets
+static Brain* makeBrain() {
+  Brain* brain = new Brain();
+
+  Cluster* plain = new Cluster();
+  plain->insertBucket(makeBucket(columns, 0, 1000));
+  plain->insertBucket(makeBucket(columns, 1000, 1000));
+
+  brain->brain = {plain, nullptr, makeSealed(2000)};
+  brain->rebuildClusterSlots();
+  return brain;
+}
+
+
+// Deletes the astructs of rows and returns how many rows there were
+static size_t deleteRows(std::vector<PreparedQuery::row_t>&& rows) {
+  const size_t COUNT = rows.size();
+
+  for (auto& row : rows) {
+    for (auto astruct : row) {
+      delete astruct;
+    }
+  }
+  return COUNT;
+}
+
+
+// The prepared query reads the same rows as the planner, projected and cut at the limit
+static void testSameRows() {
+  Brain*       brain = makeBrain();
+  QueryPlanner planner(brain);
+
+  planner.threads = 2;
+  planner.analyze();
+
+  query_t query;
+  query.ranges  = {{2, 10, 19.5}, {0, 0, 4999}};
+  query.matches = {{1, "n2"}};
+  query.columns = {0, 5};
+
+  PreparedQuery prepared(&planner, query);
+
+  auto   rows   = prepared.execute();
+  size_t errors = 0;
+
+  // The ids 10, 14 and 18 of every hundred
+  CHECK(rows.size() == 50 * 3);
+
+  for (const auto& row : rows) {
+    const int64_t ID = std::get<int64_t>(row[0]->astruct);
+
+    errors += row.size() != 2 || row[1] != nullptr;
+    errors += ID % 4 != 2 || ID % 100 < 10 || ID % 100 > 19;
+  }
+  CHECK(errors == 0);
+  CHECK(deleteRows(std::move(rows)) == deleteRows(planner.execute(query)));
+
+  query.limit = 7;
+
+  PreparedQuery limited(&planner, query);
+  CHECK(deleteRows(limited.execute()) == 7);
+
+  delete brain;
+}
+
+
+// A range never matches a NaN, also in the sealed blocks whose other reals are all in it
+static void testNaN() {
+  Brain*       brain = makeBrain();
+  QueryPlanner planner(brain);
+
+  planner.analyze();
+
+  query_t query;
+  query.ranges = {{2, -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()}};
+
+  PreparedQuery prepared(&planner, query);
+
+  CHECK(deleteRows(prepared.execute()) == 5000 - 50);
+  CHECK(deleteRows(planner.execute(query)) == 5000 - 50);
+
+  // The NaNs and the infinities are out of a finite range
+  prepared.bindRange(0, 0, 99);
+  CHECK(deleteRows(prepared.execute()) == 5000 - 100);
+
+  delete brain;
+}
+
+
+// The bound parameters replace the values of the conditions and keep the plan
+static void testBind() {
+  Brain*       brain = makeBrain();
+  QueryPlanner planner(brain);
+
+  planner.analyze();
+
+  query_t query;
+  query.ranges  = {{0, 0, 99}};
+  query.matches = {{1, "n1"}};
+
+  PreparedQuery prepared(&planner, query);
+
+  const size_t CLUSTERS = prepared.plan.clusters.size();
+
+  CHECK(deleteRows(prepared.execute()) == 25);
+
+  prepared.bindRange(0, 2500, 2999);
+  prepared.bindMatch(0, "n3");
+
+  auto   rows   = prepared.execute();
+  size_t errors = 0;
+
+  CHECK(rows.size() == 125);
+
+  for (const auto& row : rows) {
+    const int64_t ID = std::get<int64_t>(row[0]->astruct);
+    errors += ID < 2500 || ID > 2999 || ID % 4 != 3;
+  }
+  CHECK(errors == 0);
+  deleteRows(std::move(rows));
+
+  prepared.bindMatch(0, "missing");
+  CHECK(deleteRows(prepared.execute()) == 0);
+  CHECK(prepared.plan.clusters.size() == CLUSTERS);
+
+  delete brain;
+}
+
+
+// A cluster added, or removed and replaced in its slot, is planned once and scanned
+static void testReplan() {
+  Brain*       brain = makeBrain();
+  QueryPlanner planner(brain);
+
+  planner.analyze();
+
+  query_t query;
+  query.ranges = {{0, 0, 100000}};
+
+  PreparedQuery prepared(&planner, query);
+
+  CHECK(deleteRows(prepared.execute()) == 5000);
+
+  // The empty slot is filled, the number of slots does not change
+  CHECK(brain->insertCluster(makeSealed(5000)) == 1);
+
+  CHECK(deleteRows(prepared.execute()) == 8000);
+  CHECK(prepared.plan.clusters.size() == 3);
+
+  // The plan is kept by the next execution
+  const QueryPlanner::plan_t PLAN = prepared.plan;
+
+  CHECK(deleteRows(prepared.execute()) == 8000);
+  CHECK(prepared.plan.clusters == PLAN.clusters);
+
+  // A cluster removed and another one inserted in its slot
+  Cluster* removed = brain->removeCluster(1);
+  CHECK(brain->insertCluster(makeSealed(9000)) == 1);
+  delete removed;
+
+  auto   rows = prepared.execute();
+  size_t ids  = 0;
+
+  for (const auto& row : rows) {
+    ids += std::get<int64_t>(row[0]->astruct) >= 9000;
+  }
+  CHECK(rows.size() == 8000);
+  CHECK(ids == 3000);
+  deleteRows(std::move(rows));
+
+  delete brain;
+}
+
+
+// The executions on many threads plan the query again once and read the same rows
+static void testThreads() {
+  Brain*       brain = makeBrain();
+  QueryPlanner planner(brain);
+
+  planner.threads = 2;
+  planner.analyze();
+
+  query_t query;
+  query.ranges  = {{2, 10, 59}};
+  query.matches = {{1, "n0"}};
+
+  PreparedQuery prepared(&planner, query);
+
+  CHECK(brain->insertCluster(makeSealed(5000)) == 1);
+
+  std::vector<size_t>      counts(4, 0);
+  std::vector<std::thread> threads;
+
+  for (size_t index = 0; index < counts.size(); index++) {
+    threads.emplace_back([&prepared, &counts, index]() {
+      for (int run = 0; run < 3; run++) {
+        counts[index] += deleteRows(prepared.execute());
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  // The ids 12 to 56 of every hundred that are multiples of 4, in 8000 rows
+  for (size_t count : counts) {
+    CHECK(count == 3 * 80 * 12);
+  }
+  CHECK(prepared.plan.clusters.size() == 3);
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testSameRows);
+  RUN_TEST(testNaN);
+  RUN_TEST(testBind);
+  RUN_TEST(testReplan);
+  RUN_TEST(testThreads);
+
+  return finishTests();
+}
@@ -0,0 +1,129 @@
+/**
+  * @file printer_test.cpp
+  * This is the documentation of the `printer_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the Printer class, the square layout, the pages and the reuse of
+  * the buffer of the printer of the thread
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <sstream>
+#include <string>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Printer/printer.hpp"
+
+
+// A brain of four slots, two of them empty
+static Brain* makeBrain() {
+  Brain* brain = new Brain();
+
+  brain->brain = {new Cluster(), nullptr, new Cluster(), nullptr};
+  brain->rebuildClusterSlots();
+  return brain;
+}
+
+
+// A brain is printed in a square of two slots per row
+static void testBrainSquare() {
+  Brain*             brain = makeBrain();
+  std::ostringstream output;
+
+  output << brain;
+  CHECK(output.str() == "Brain([\n  item, empty, \n  item, empty\n])");
+
+  delete brain;
+}
+
+
+// A page prints its slots and reports the hidden ones
+static void testPage() {
+  Brain*             brain = makeBrain();
+  std::ostringstream output;
+
+  {
+    Printer printer(output, 64);
+    printer.page(1, 2);
+    printer.print(brain);
+  }
+
+  CHECK(output.str() == "Brain([\n  item, empty\n  ... 2 slots before, 0 slots after\n])");
+
+  delete brain;
+}
+
+
+// A bucket prints its plain, dictionary and numeric stacks with the same values
+static void testBucket() {
+  Bucket* bucket = new Bucket();
+
+  bucket->pushAstruct(0, new Astruct(int64_t{7}));
+  bucket->pushAstruct(0, nullptr);
+  bucket->pushAstruct(1, new Astruct("seven"));
+
+  std::ostringstream plain;
+  {
+    Printer printer(plain);
+    printer.print(bucket);
+  }
+
+  Dictionary* dictionary = new Dictionary();
+  bucket->encodeDictionaryStack(1, dictionary);
+  bucket->compressNumericStack(0);
+
+  std::ostringstream encoded;
+  {
+    Printer printer(encoded);
+    printer.print(bucket);
+  }
+
+  CHECK(plain.str() == "Bucket([\n  [7, empty],\n  [\"seven\"]\n])");
+  CHECK(encoded.str() == plain.str());
+
+  delete bucket;
+  delete dictionary;
+}
+
+
+// The operators print through the printer of the thread, its buffer is allocated once
+// and a page set on it does not leak into the next print
+static void testThreadPrinter() {
+  Brain*             brain = makeBrain();
+  std::ostringstream first;
+  std::ostringstream second;
+
+  first << brain;
+  const char* BUFFER = Printer::threadPrinter(first).buffer.data();
+
+  Printer::threadPrinter(first).page(0, 1);
+  second << brain;
+
+  CHECK(Printer::threadPrinter(second).buffer.data() == BUFFER);
+  CHECK(second.str() == first.str());
+
+  Cluster*           cluster = new Cluster(nullptr, 0);
+  std::ostringstream third;
+  third << cluster;
+  CHECK(third.str() == "Cluster([\n  empty, empty, empty, empty, \n  empty, empty, empty, empty, \n"
+                       "  empty, empty, empty, empty, \n  empty, empty, empty\n])");
+  CHECK(Printer::threadPrinter(third).buffer.data() == BUFFER);
+
+  delete cluster;
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testBrainSquare);
+  RUN_TEST(testPage);
+  RUN_TEST(testBucket);
+  RUN_TEST(testThreadPrinter);
+
+  return finishTests();
+}
@@ -0,0 +1,296 @@
+/**
+  * @file query_planner_test.cpp
+  * This is the documentation of the `query_planner_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the QueryPlanner class, the statistics of the clusters with numbers that
+  * are not finite, the same rows for every strategy, the projection and the limit,
+  * and the rows cached in the sharded terminals
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Planner/query_planner.hpp"
+#include "../Nativite/Engine/ShardedTerminal/sharded_terminal.hpp"
+
+
+using query_t    = QueryPlanner::query_t;
+using strategy_t = QueryPlanner::strategy_t;
+
+
+// The buckets have four names and reals with NaNs and infinities
+static const test_columns_t columns{"n", 4, nonFiniteReal};
+
+
+// A brain with a plain cluster, an empty slot and a cluster of sealed encoded buckets
+static Brain* makeBrain() {
+  Brain* brain = new Brain();
+
+  Cluster* plain = new Cluster();
+  plain->insertBucket(makeBucket(columns, 0, 1000));
+  plain->insertBucket(makeBucket(columns, 1000, 1000));
+
+  Cluster* sealed = new Cluster();
+  sealed->insertBucket(makeBucket(columns, 2000, 1500));
+  sealed->insertBucket(makeBucket(columns, 3500, 1500));
+  sealed->encodeStringStacks();
+  sealed->cluster[0]->seal();
+  sealed->cluster[1]->seal();
+
+  brain->brain = {plain, nullptr, sealed};
+  brain->rebuildClusterSlots();
+  return brain;
+}
+
+
+// Deletes the astructs of rows
+static void deleteRows(std::vector<QueryPlanner::row_t>& rows) {
+  for (auto& row : rows) {
+    for (auto astruct : row) {
+      delete astruct;
+    }
+  }
+  rows.clear();
+}
+
+
+// The statistics of every cluster, the numbers that are not finite are not in the histograms
+static void testAnalyze() {
+  Brain*       brain = makeBrain();
+  QueryPlanner planner(brain);
+
+  planner.threads        = 2;
+  planner.histogram_bins = 10;
+  planner.analyze();
+
+  CHECK(planner.statistics.size() == 3);
+  CHECK(planner.statistics[1].cluster == nullptr);
+
+  for (size_t slot : {size_t{0}, size_t{2}}) {
+    const auto& statistics = planner.statistics[slot];
+
+    CHECK(statistics.cluster == brain->brain[slot]);
+    CHECK(statistics.buckets == 2);
+    CHECK(statistics.stacks.size() == 3);
+
+    const auto& ids   = statistics.stacks[0];
+    const auto& reals = statistics.stacks[2];
+
+    CHECK(ids.numbers == statistics.rows);
+    CHECK(ids.distinct > statistics.rows * 9 / 10 && ids.distinct <= statistics.rows);
+    CHECK(statistics.stacks[1].strings == statistics.rows);
+    CHECK(statistics.stacks[1].distinct == 4);
+
+    CHECK(reals.values == statistics.rows);
+    CHECK(reals.numbers == statistics.rows - statistics.rows / 50);
+    CHECK(reals.minimum == 0 && reals.maximum == 99);
+    CHECK(std::accumulate(reals.histogram.begin(), reals.histogram.end(), uint64_t{0}) == reals.numbers);
+  }
+
+  delete brain;
+}
+
+
+// Every strategy reads the same rows, projected and cut at the limit
+static void testStrategies() {
+  Brain*       brain = makeBrain();
+  QueryPlanner planner(brain);
+
+  planner.threads = 2;
+  planner.analyze();
+
+  query_t query;
+  query.ranges  = {{2, 10, 19.5}};
+  query.matches = {{1, "n2"}};
+  query.columns = {0, 5};
+
+  QueryPlanner::plan_t plan = planner.plan(query);
+
+  CHECK(plan.clusters.size() == 2);
+  CHECK(plan.alternatives.size() == 4);
+  CHECK(plan.estimated_rows > 0);
+
+  for (strategy_t strategy : {strategy_t::dfs, strategy_t::bfs, strategy_t::flow_m, strategy_t::tps}) {
+    plan.strategy = strategy;
+    plan.threads  = 2;
+
+    auto   rows   = planner.execute(query, plan);
+    size_t errors = 0;
+
+    // The ids 10, 14 and 18 of every hundred
+    CHECK(rows.size() == 50 * 3);
+
+    for (const auto& row : rows) {
+      const int64_t ID = std::get<int64_t>(row[0]->astruct);
+
+      errors += row.size() != 2 || row[1] != nullptr;
+      errors += ID % 4 != 2 || ID % 100 < 10 || ID % 100 > 19;
+    }
+    CHECK(errors == 0);
+    deleteRows(rows);
+
+    query.limit = 7;
+
+    rows = planner.execute(query, plan);
+    CHECK(rows.size() == 7);
+    deleteRows(rows);
+
+    query.limit = 0;
+  }
+
+  // A range over every number never matches a NaN
+  query_t all;
+  all.ranges = {{2, -std::numeric_limits<double>::infinity(), std::numeric_limits<double>::infinity()}};
+
+  auto rows = planner.execute(all);
+  CHECK(rows.size() == 5000 - 50);
+  deleteRows(rows);
+
+  delete brain;
+}
+
+
+// A miss caches the whole rows in a terminal, a hit projects them and only a cached key
+// chooses the terminal
+static void testTerminal() {
+  Brain*       brain = makeBrain();
+  QueryPlanner planner(brain);
+
+  // A single thread keeps the order of the clusters
+  planner.threads = 1;
+  planner.analyze();
+
+  ShardedTerminal* terminal = brain->brain[2]->shardTerminal();
+
+  // A terminal full of other keys is not a reason to probe it
+  for (int index = 0; index < 64; index++) {
+    terminal->insert("other" + std::to_string(index), new Astruct(Astruct::astruct_array_t{}));
+  }
+
+  query_t query;
+  query.ranges    = {{0, 100, 129}};
+  query.columns   = {1};
+  query.cache_key = "ids 100 to 129";
+
+  QueryPlanner::plan_t plan = planner.plan(query);
+
+  CHECK(plan.access_path != QueryPlanner::access_path_t::terminal);
+  CHECK(plan.cache_slot == 2);
+
+  auto rows = planner.execute(query, plan);
+
+  CHECK(rows.size() == 30);
+  CHECK(rows[0].size() == 1 && std::get<std::string>(rows[0][0]->astruct) == "n0");
+  CHECK(terminal->contains(QueryPlanner::cacheKey(query)));
+  deleteRows(rows);
+
+  // The cached rows are whole, so another projection of the same key is served
+  query.columns = {2, 0};
+  query.limit   = 5;
+  plan          = planner.plan(query);
+
+  CHECK(plan.access_path == QueryPlanner::access_path_t::terminal);
+
+  rows = planner.execute(query, plan);
+
+  CHECK(rows.size() == 5);
+  CHECK(rows[0].size() == 2 && std::get<int64_t>(rows[0][1]->astruct) == 100);
+  CHECK(std::get<double>(rows[4][0]->astruct) == 4);
+  deleteRows(rows);
+
+  // The rows cut by the limit are not cached
+  query.cache_key = "cut";
+  rows            = planner.execute(query);
+
+  CHECK(rows.size() == 5);
+  CHECK(!terminal->contains(QueryPlanner::cacheKey(query)));
+  deleteRows(rows);
+
+  delete brain;
+}
+
+
+// The cached rows are keyed by the conditions of the query and are stale after a
+// write to a cluster of the plan or to the structure of the brain
+static void testTerminalInvalidation() {
+  Brain*       brain = makeBrain();
+  QueryPlanner planner(brain);
+
+  planner.threads = 1;
+  planner.analyze();
+  brain->brain[2]->shardTerminal();
+
+  query_t query;
+  query.ranges    = {{0, 100, 129}};
+  query.cache_key = "shared";
+
+  auto rows = planner.execute(query);
+  CHECK(rows.size() == 30);
+  deleteRows(rows);
+  CHECK(planner.plan(query).access_path == QueryPlanner::access_path_t::terminal);
+
+  // Another query with the same `cache_key` does not read the rows of the first one
+  query_t other = query;
+  other.ranges  = {{0, 200, 209}};
+
+  CHECK(planner.plan(other).access_path != QueryPlanner::access_path_t::terminal);
+
+  rows = planner.execute(other);
+  CHECK(rows.size() == 10);
+  CHECK(std::get<int64_t>(rows[0][0]->astruct) == 200);
+  deleteRows(rows);
+
+  // A write to a cluster of the plan makes the cached rows stale
+  brain->brain[0]->insertBucket(makeBucket(columns, 100, 10));
+
+  QueryPlanner::plan_t plan = planner.plan(query);
+  CHECK(plan.access_path != QueryPlanner::access_path_t::terminal);
+
+  rows = planner.execute(query, plan);
+  CHECK(rows.size() == 40);
+  deleteRows(rows);
+
+  plan = planner.plan(query);
+  CHECK(plan.access_path == QueryPlanner::access_path_t::terminal);
+
+  rows = planner.execute(query, plan);
+  CHECK(rows.size() == 40);
+  deleteRows(rows);
+
+  // A new cluster makes them stale too, even for a plan made before it
+  Cluster* added = new Cluster();
+  added->insertBucket(makeBucket(columns, 120, 5));
+  brain->insertCluster(added);
+
+  rows = planner.execute(query, plan);
+  CHECK(rows.size() == 40);
+  deleteRows(rows);
+
+  rows = planner.execute(query);
+  CHECK(rows.size() == 45);
+  deleteRows(rows);
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testAnalyze);
+  RUN_TEST(testStrategies);
+  RUN_TEST(testTerminal);
+  RUN_TEST(testTerminalInvalidation);
+
+  return finishTests();
+}
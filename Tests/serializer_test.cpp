@@ -0,0 +1,255 @@
+/**
+  * @file serializer_test.cpp
+  * This is the documentation of the `serializer_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the Serializer class, the round trip of brains and clusters and the
+  * rejection of malformed input
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/Serializer/serializer.hpp"
+
+
+// Checks that two astructs hold the same value, nullptr is an empty slot
+static bool sameAstruct(const Astruct* left, const Astruct* right) {
+  if (left == nullptr || right == nullptr) {
+    return left == right;
+  }
+
+  if (left->kind() != right->kind()) {
+    return false;
+  }
+
+  switch (left->kind()) {
+    case Astruct::astruct_kind_t::array: {
+      const auto& left_array  = std::get<Astruct::astruct_array_t>(left->astruct);
+      const auto& right_array = std::get<Astruct::astruct_array_t>(right->astruct);
+
+      if (left_array.size() != right_array.size()) {
+        return false;
+      }
+      for (size_t index = 0; index < left_array.size(); index++) {
+        if (!sameAstruct(left_array[index], right_array[index])) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    case Astruct::astruct_kind_t::object: {
+      const auto& left_object  = std::get<Astruct::astruct_object_t>(left->astruct);
+      const auto& right_object = std::get<Astruct::astruct_object_t>(right->astruct);
+
+      if (left_object.size() != right_object.size()) {
+        return false;
+      }
+      for (size_t index = 0; index < left_object.size(); index++) {
+        if (
+          left_object[index].first != right_object[index].first ||
+          !sameAstruct(left_object[index].second, right_object[index].second)
+        ) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    default:
+      return left->astruct == right->astruct;
+  }
+}
+
+
+// A bucket with every kind of astruct, a string stack and an integer stack
+static Bucket* makeBucket(int64_t first) {
+  Bucket* bucket = new Bucket();
+
+  for (int64_t row = 0; row < 40; row++) {
+    bucket->pushAstruct(0, new Astruct(first + row));
+    bucket->pushAstruct(1, new Astruct("name" + std::to_string(row % 4)));
+    bucket->pushAstruct(2, row % 5 == 0 ? nullptr : new Astruct(row * 0.5));
+  }
+
+  bucket->pushAstruct(3, new Astruct(true));
+  bucket->pushAstruct(3, new Astruct(nullptr));
+  bucket->pushAstruct(3, new Astruct(Astruct::astruct_array_t{new Astruct(int64_t{1}), new Astruct("two")}));
+  bucket->pushAstruct(3, new Astruct(Astruct::astruct_object_t{{"key", new Astruct(-7.25)}}));
+  return bucket;
+}
+
+
+// Checks that two buckets have the same stacks, the layers are read as astructs
+static bool sameBucket(Bucket* left, Bucket* right) {
+  if (left->stackCount() != right->stackCount() || left->height() != right->height()) {
+    return false;
+  }
+
+  Bucket* left_copy  = left->clone();
+  Bucket* right_copy = right->clone();
+  bool    same       = true;
+
+  for (size_t index = 0; index < left_copy->stackCount(); index++) {
+    if (left_copy->isDictionaryStack(index)) {
+      left_copy->decodeDictionaryStack(index);
+    }
+    if (left_copy->isNumericStack(index)) {
+      left_copy->decompressNumericStack(index);
+    }
+    if (right_copy->isDictionaryStack(index)) {
+      right_copy->decodeDictionaryStack(index);
+    }
+    if (right_copy->isNumericStack(index)) {
+      right_copy->decompressNumericStack(index);
+    }
+
+    const auto& left_stack  = left_copy->bucket[index];
+    const auto& right_stack = right_copy->bucket[index];
+
+    same = same && left_stack.size() == right_stack.size();
+
+    for (size_t row = 0; same && row < left_stack.size(); row++) {
+      same = sameAstruct(left_stack[row], right_stack[row]);
+    }
+  }
+
+  delete left_copy;
+  delete right_copy;
+  return same;
+}
+
+
+// A brain with an empty slot, a plain cluster and an encoded and sealed cluster
+static Brain* makeBrain() {
+  Brain* brain = new Brain();
+
+  Cluster* plain = new Cluster();
+  plain->insertBucket(makeBucket(0));
+  plain->insertBucket(makeBucket(100));
+
+  Cluster* encoded = new Cluster();
+  encoded->insertBucket(makeBucket(200));
+  encoded->encodeStringStacks();
+  encoded->insertBucket(makeBucket(300));
+  encoded->cluster[1]->seal(0);
+
+  brain->brain = {plain, nullptr, encoded, nullptr};
+  brain->rebuildClusterSlots();
+  return brain;
+}
+
+
+// A brain is read back with the same slots and the same buckets
+static void testBrainRoundTrip() {
+  Brain*     brain = makeBrain();
+  Serializer writer;
+
+  writer.serialize(brain);
+
+  Serializer reader;
+  Brain*     copy = reader.deserializeBrain(writer.buffer.data(), writer.buffer.size());
+
+  CHECK(copy != nullptr);
+
+  if (copy != nullptr) {
+    CHECK(copy->brain.size() == brain->brain.size());
+
+    for (size_t slot = 0; slot < brain->brain.size() && slot < copy->brain.size(); slot++) {
+      CHECK((brain->brain[slot] == nullptr) == (copy->brain[slot] == nullptr));
+
+      if (brain->brain[slot] == nullptr || copy->brain[slot] == nullptr) {
+        continue;
+      }
+
+      const auto& buckets      = brain->brain[slot]->cluster;
+      const auto& copy_buckets = copy->brain[slot]->cluster;
+
+      CHECK(buckets.size() == copy_buckets.size());
+
+      for (size_t index = 0; index < buckets.size() && index < copy_buckets.size(); index++) {
+        CHECK((buckets[index] == nullptr) == (copy_buckets[index] == nullptr));
+
+        if (buckets[index] != nullptr && copy_buckets[index] != nullptr) {
+          CHECK(sameBucket(buckets[index], copy_buckets[index]));
+          CHECK(buckets[index]->sealed == copy_buckets[index]->sealed);
+        }
+      }
+    }
+
+    // The format is deterministic, the copy is written with the same bytes
+    Serializer again;
+    again.serialize(copy);
+    CHECK(again.buffer == writer.buffer);
+  }
+
+  delete copy;
+  delete brain;
+}
+
+
+// A single cluster is read back with its shared dictionary
+static void testClusterRoundTrip() {
+  Brain*     brain   = makeBrain();
+  Cluster*   cluster = brain->brain[2];
+  Serializer writer;
+
+  writer.serialize(cluster);
+
+  Serializer reader;
+  Cluster*   copy = reader.deserializeCluster(writer.buffer.data(), writer.buffer.size());
+
+  CHECK(copy != nullptr);
+
+  if (copy != nullptr) {
+    CHECK(copy->dictionary != nullptr);
+    CHECK(copy->bucket_slots.used == cluster->bucket_slots.used);
+    CHECK(sameBucket(copy->cluster[0], cluster->cluster[0]));
+    CHECK(sameBucket(copy->cluster[1], cluster->cluster[1]));
+  }
+
+  delete copy;
+  delete brain;
+}
+
+
+// Every truncation and a wrong magic are rejected without leaking
+static void testMalformedInput() {
+  Brain*     brain = makeBrain();
+  Serializer writer;
+
+  writer.serialize(brain);
+
+  Serializer reader;
+
+  for (size_t size = 0; size < writer.buffer.size(); size += 7) {
+    Brain* copy = reader.deserializeBrain(writer.buffer.data(), size);
+    CHECK(copy == nullptr);
+    delete copy;
+  }
+
+  std::vector<uint8_t> wrong = writer.buffer;
+  wrong[0] = 'X';
+  CHECK(reader.deserializeBrain(wrong.data(), wrong.size()) == nullptr);
+  CHECK(reader.deserializeCluster(writer.buffer.data(), writer.buffer.size()) == nullptr);
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testBrainRoundTrip);
+  RUN_TEST(testClusterRoundTrip);
+  RUN_TEST(testMalformedInput);
+
+  return finishTests();
+}
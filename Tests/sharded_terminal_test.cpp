@@ -0,0 +1,159 @@
+/**
+  * @file sharded_terminal_test.cpp
+  * This is the documentation of the `sharded_terminal_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the ShardedTerminal class, the cached astructs by key, the eviction
+  * of a full shard and the readers that run with the writers
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/ShardedTerminal/sharded_terminal.hpp"
+#include "../Nativite/Engine/Astruct/astruct.hpp"
+
+
+// The integer cached for `key`, or -1
+static int64_t cachedValue(const ShardedTerminal& terminal, const std::string& key) {
+  int64_t value = -1;
+
+  terminal.find(key, [&](const Astruct* astruct) {
+    value = std::get<int64_t>(astruct->astruct);
+  });
+  return value;
+}
+
+
+// The astructs are found by key, replaced and erased
+static void testInsertFindErase() {
+  ShardedTerminal terminal(64, 4);
+
+  CHECK(terminal.shard_count == 4);
+
+  terminal.insert("one", new Astruct(int64_t{1}));
+  terminal.insert("two", new Astruct(int64_t{2}));
+
+  CHECK(terminal.size() == 2);
+  CHECK(cachedValue(terminal, "one") == 1);
+  CHECK(!terminal.contains("three"));
+
+  terminal.insert("one", new Astruct(int64_t{11}));
+  CHECK(terminal.size() == 2);
+  CHECK(cachedValue(terminal, "one") == 11);
+
+  CHECK(terminal.erase("two"));
+  CHECK(!terminal.erase("two"));
+  CHECK(!terminal.contains("two"));
+
+  terminal.clear();
+  CHECK(terminal.size() == 0);
+}
+
+
+// A full terminal evicts and keeps at most its capacity
+static void testEviction() {
+  ShardedTerminal terminal(16, 2);
+
+  for (int64_t key = 0; key < 200; key++) {
+    terminal.insert("key" + std::to_string(key), new Astruct(key));
+  }
+
+  CHECK(terminal.size() <= terminal.capacity());
+  CHECK(terminal.size() > 0);
+
+  // The last key of a shard is never the one evicted by its own insertion
+  CHECK(cachedValue(terminal, "key199") == 199);
+}
+
+
+// A key is found in the probe slots of its hash, the erased slots are reused
+static void testProbeSlots() {
+  ShardedTerminal terminal(4096, 1);
+  size_t          found = 0;
+
+  for (int64_t key = 0; key < 500; key++) {
+    terminal.insert("key" + std::to_string(key), new Astruct(key));
+  }
+  for (int64_t key = 0; key < 500; key++) {
+    found += cachedValue(terminal, "key" + std::to_string(key)) == key ? 1 : 0;
+  }
+  CHECK(found == 500);
+  CHECK(terminal.size() == 500);
+
+  for (int64_t key = 0; key < 500; key += 2) {
+    CHECK(terminal.erase("key" + std::to_string(key)));
+  }
+  for (int64_t key = 0; key < 500; key += 2) {
+    terminal.insert("key" + std::to_string(key), new Astruct(key + 1000));
+  }
+
+  CHECK(terminal.size() == 500);
+  CHECK(cachedValue(terminal, "key10") == 1010);
+  CHECK(cachedValue(terminal, "key11") == 11);
+}
+
+
+// The readers always see whole entries while the writers replace them
+static void testConcurrentReaders() {
+  ShardedTerminal terminal(256, 8);
+
+  for (int64_t key = 0; key < 64; key++) {
+    terminal.insert("key" + std::to_string(key), new Astruct(key));
+  }
+
+  std::atomic<bool>        done{false};
+  std::atomic<size_t>      broken{0};
+  std::vector<std::thread> threads;
+
+  for (size_t reader = 0; reader < 3; reader++) {
+    threads.emplace_back([&] {
+      while (!done.load()) {
+        for (int64_t key = 0; key < 64; key++) {
+          const int64_t VALUE = cachedValue(terminal, "key" + std::to_string(key));
+
+          // The writers store the key or the key plus a multiple of 1000
+          if (VALUE != -1 && VALUE % 1000 != key) {
+            broken++;
+          }
+        }
+      }
+    });
+  }
+
+  std::thread writer([&] {
+    for (int64_t round = 1; round <= 200; round++) {
+      for (int64_t key = 0; key < 64; key++) {
+        terminal.insert("key" + std::to_string(key), new Astruct(round * 1000 + key));
+      }
+    }
+  });
+
+  writer.join();
+  done = true;
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  CHECK(broken == 0);
+  CHECK(cachedValue(terminal, "key5") == 200005);
+}
+
+
+int main() {
+  RUN_TEST(testInsertFindErase);
+  RUN_TEST(testEviction);
+  RUN_TEST(testProbeSlots);
+  RUN_TEST(testConcurrentReaders);
+
+  return finishTests();
+}
@@ -0,0 +1,104 @@
+/**
+  * @file test.hpp
+  * This is the documentation of the `test.hpp` file
+  *
+  * @brief Description
+  * The checks of the tests of the engine, every `*_test.cpp` file is an executable
+  * that runs its tests and returns a non zero code if a check failed, and the
+  * builder of the buckets shared by the tests of the queries
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+#pragma once
+
+// C++ libraries imports
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <string>
+
+// Nativite engine imports
+#include "../Nativite/Engine/Epoch/epoch.hpp"
+#include "../Nativite/Engine/Bucket/bucket.hpp"
+#include "../Nativite/Engine/Astruct/astruct.hpp"
+
+
+// The failed checks of the test executable
+inline size_t failed_checks = 0;
+
+
+// Checks a condition, a failed check is printed and the test goes on
+#define CHECK(condition)                                                              \
+  do {                                                                                \
+    if (!(condition)) {                                                               \
+      std::cerr << __FILE__ << ":" << __LINE__ << ": CHECK(" #condition ") failed\n"; \
+      failed_checks++;                                                                \
+    }                                                                                 \
+  } while (false)
+
+
+// Runs a test function and prints its name
+#define RUN_TEST(test)                  \
+  do {                                  \
+    std::cout << "Running " #test "\n"; \
+    test();                             \
+  } while (false)
+
+
+// Ends a test executable, the retired objects are deleted first so the leak
+// checkers only see the real leaks
+inline int finishTests() {
+  EpochManager::global().collect();
+  EpochManager::global().collect();
+
+  if (failed_checks != 0) {
+    std::cerr << failed_checks << " checks failed\n";
+    return 1;
+  }
+  std::cout << "All checks passed\n";
+  return 0;
+}
+
+
+// The stacks of the buckets of the tests of the queries, an integer id, a name and
+// optionally a real, only the names and the reals change between the tests
+struct test_columns_t {
+  std::string prefix = "name"; /**< The prefix of the names */
+  int64_t     names  = 0;      /**< The distinct names, the name of an id is the id modulo
+                                    `names`, or the id itself if it is 0 */
+
+  std::function<Astruct*(int64_t id, int64_t row)> real; /**< The real of a row, nullptr is an empty
+                                                              slot, no real stack if it is empty */
+};
+
+
+// A bucket of `rows` rows, the ids from `first` and the names and reals of `columns`
+inline Bucket* makeBucket(const test_columns_t& columns, int64_t first, int64_t rows) {
+  Bucket* bucket_ = new Bucket();
+
+  for (int64_t row = 0; row < rows; row++) {
+    const int64_t ID = first + row;
+
+    bucket_->pushAstruct(0, new Astruct(ID));
+    bucket_->pushAstruct(1, new Astruct(columns.prefix + std::to_string(columns.names == 0 ? ID : ID % columns.names)));
+
+    if (columns.real) {
+      bucket_->pushAstruct(2, columns.real(ID, row));
+    }
+  }
+  return bucket_;
+}
+
+
+// The real of an id modulo 100, every 50th real is a NaN or an infinity
+inline Astruct* nonFiniteReal(int64_t id, int64_t) {
+  if (id % 50 == 7) {
+    return new Astruct(id % 100 == 7 ? std::numeric_limits<double>::quiet_NaN() : std::numeric_limits<double>::infinity());
+  }
+  return new Astruct(static_cast<double>(id % 100));
+}
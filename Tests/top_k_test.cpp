@@ -0,0 +1,189 @@
+/**
+  * @file top_k_test.cpp
+  * This is the documentation of the `top_k_test.cpp` file
+  *
+  * @brief Description
+  * Tests of the TopK class, the best scores of both orders, the integer scores that
+  * a double can not tell apart, the predicate on the viewed rows, the LIMIT search
+  * and the blocks and buckets pruned by the threshold
+  *
+  * COPYRIGHT: Copyright © 2025 Tomascord
+  *
+  * LICENSE: Apache 2.0, See: @see @link LICENSE.md @endlink
+*/
+
+// C++ libraries imports
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Nativite engine imports
+#include "test.hpp"
+#include "../Nativite/Engine/TopK/top_k.hpp"
+
+
+// The buckets have the scores and one name per score, without reals
+static const test_columns_t columns{"name", 0, nullptr};
+
+
+// A brain with an empty slot, a plain cluster and a cluster of sealed buckets, the best
+// bucket first
+static Brain* makeBrain() {
+  Brain* brain = new Brain();
+
+  Cluster* plain = new Cluster();
+  plain->insertBucket(makeBucket(columns, 0, 500));
+  plain->insertBucket(makeBucket(columns, 500, 500));
+
+  Cluster* sealed = new Cluster();
+  sealed->insertBucket(makeBucket(columns, 5000, 3000));
+  sealed->insertBucket(makeBucket(columns, 1000, 4000));
+  sealed->cluster[0]->seal();
+  sealed->cluster[1]->seal();
+
+  brain->brain = {plain, nullptr, sealed};
+  brain->rebuildClusterSlots();
+  return brain;
+}
+
+
+// The best scores of both orders, sorted and with their projected rows
+static void testTopScores() {
+  Brain* brain = makeBrain();
+  TopK   search(brain);
+
+  search.k           = 5;
+  search.score_stack = 0;
+  search.threads     = 2;
+
+  auto& results = search.search();
+
+  CHECK(results.size() == 5);
+
+  for (size_t index = 0; index < results.size(); index++) {
+    const int64_t SCORE = 7999 - static_cast<int64_t>(index);
+
+    CHECK(results[index].score.is_integer && results[index].score.integer == SCORE);
+    CHECK(results[index].row.size() == 2);
+    CHECK(std::get<std::string>(results[index].row[1]->astruct) == "name" + std::to_string(SCORE));
+  }
+
+  // The sealed blocks and buckets below the threshold are not decoded
+  CHECK(search.pruned_blocks.load() + search.pruned_buckets.load() > 0);
+  CHECK(search.scanned_rows.load() < 8000);
+
+  search.descending = false;
+  search.columns    = {1};
+
+  search.search();
+
+  CHECK(results.size() == 5);
+
+  for (size_t index = 0; index < results.size(); index++) {
+    CHECK(results[index].score.integer == static_cast<int64_t>(index));
+    CHECK(results[index].row.size() == 1);
+    CHECK(std::get<std::string>(results[index].row[0]->astruct) == "name" + std::to_string(index));
+  }
+
+  delete brain;
+}
+
+
+// The integer scores over 2^53 are ranked exactly, also against the real scores
+static void testExactIntegers() {
+  const int64_t BIG = int64_t{1} << 53;
+
+  Brain*   brain    = new Brain();
+  Cluster* cluster_ = new Cluster();
+  Bucket*  bucket_  = new Bucket();
+
+  bucket_->pushAstruct(0, new Astruct(BIG + 1));
+  bucket_->pushAstruct(0, new Astruct(static_cast<double>(BIG)));
+  bucket_->pushAstruct(0, new Astruct(BIG + 3));
+  bucket_->pushAstruct(0, new Astruct(BIG + 2));
+  bucket_->pushAstruct(0, new Astruct(static_cast<double>(BIG) + 4.0));
+
+  cluster_->insertBucket(bucket_);
+  brain->insertCluster(cluster_);
+
+  TopK search(brain);
+
+  search.k           = 4;
+  search.score_stack = 0;
+
+  auto& results = search.search();
+
+  CHECK(results.size() == 4);
+  CHECK(!results[0].score.is_integer && results[0].score.real == static_cast<double>(BIG) + 4.0);
+  CHECK(results[1].score.is_integer && results[1].score.integer == BIG + 3);
+  CHECK(results[2].score.integer == BIG + 2);
+  CHECK(results[3].score.integer == BIG + 1);
+
+  search.k          = 2;
+  search.descending = false;
+
+  search.search();
+
+  CHECK(results.size() == 2);
+  CHECK(!results[0].score.is_integer && results[0].score.real == static_cast<double>(BIG));
+  CHECK(results[1].score.is_integer && results[1].score.integer == BIG + 1);
+
+  delete brain;
+}
+
+
+// The predicate runs on the viewed rows, the rows it drops are not ranked
+static void testPredicate() {
+  Brain* brain = makeBrain();
+  TopK   search(brain);
+
+  search.k           = 3;
+  search.score_stack = 0;
+  search.predicate   = [](const Cursor::view_t& view) {
+    return view[0] != nullptr && std::get<int64_t>(view[0]->astruct) % 100 == 0;
+  };
+
+  auto& results = search.search();
+
+  CHECK(results.size() == 3);
+  CHECK(results[0].score.integer == 7900);
+  CHECK(results[1].score.integer == 7800);
+  CHECK(results[2].score.integer == 7700);
+
+  delete brain;
+}
+
+
+// A LIMIT search takes any `k` rows that match the predicate
+static void testLimit() {
+  Brain* brain = makeBrain();
+  TopK   search(brain);
+
+  search.k         = 7;
+  search.predicate = [](const Cursor::view_t& view) {
+    return std::get<int64_t>(view[0]->astruct) % 2 == 1;
+  };
+
+  auto& results = search.search();
+
+  CHECK(results.size() == 7);
+
+  for (const auto& entry : results) {
+    CHECK(std::get<int64_t>(entry.row[0]->astruct) % 2 == 1);
+  }
+
+  search.k = 0;
+  CHECK(search.search().empty());
+
+  delete brain;
+}
+
+
+int main() {
+  RUN_TEST(testTopScores);
+  RUN_TEST(testExactIntegers);
+  RUN_TEST(testPredicate);
+  RUN_TEST(testLimit);
+
+  return finishTests();
+}